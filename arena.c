@@ -0,0 +1,87 @@
+// arena.c
+
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_DEFAULT_CHUNK  (64 * 1024)
+#define ARENA_MAX_CHUNK      (4 * 1024 * 1024)
+#define ARENA_ALIGN          (sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double))
+
+static size_t align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+void arena_init(Arena *a, size_t first_chunk_size) {
+    memset(a, 0, sizeof(*a));
+    a->next_chunk_size = first_chunk_size ? first_chunk_size : ARENA_DEFAULT_CHUNK;
+}
+
+static ArenaChunk *arena_new_chunk(Arena *a, size_t min_size) {
+    if (a->next_chunk_size == 0) a->next_chunk_size = ARENA_DEFAULT_CHUNK;
+    size_t size = a->next_chunk_size;
+    if (size < min_size) size = min_size;
+
+    // Cabecera y zona útil en un solo malloc; calloc deja todo en cero,
+    // así que cada petición sale ya inicializada como con el calloc original.
+    size_t header = align_up(sizeof(ArenaChunk));
+    ArenaChunk *c = (ArenaChunk *)calloc(1, header + size);
+    if (c == NULL) {
+        perror("Error de memoria al reservar bloque de la arena");
+        exit(EXIT_FAILURE);
+    }
+    c->size = size;
+    c->used = 0;
+    c->data = (unsigned char *)c + header;
+    c->next = a->head;
+    a->head = c;
+
+    a->num_chunks++;
+    a->bytes_reserved += header + size;
+
+    // Crecimiento geométrico: O(log n) bloques para n bytes
+    if (a->next_chunk_size < ARENA_MAX_CHUNK) a->next_chunk_size *= 2;
+    return c;
+}
+
+void *arena_alloc(Arena *a, size_t size) {
+    size_t need = align_up(size ? size : 1);
+    ArenaChunk *c = a->head;
+
+    if (c == NULL || c->size - c->used < need) {
+        c = arena_new_chunk(a, need);
+    }
+
+    void *p = c->data + c->used;
+    c->used += need;
+
+    a->num_allocs++;
+    a->bytes_requested += size;
+    return p;
+}
+
+char *arena_strdup(Arena *a, const char *s) {
+    if (!s) return NULL;
+    size_t len = strlen(s) + 1;
+    char *copy = (char *)arena_alloc(a, len);
+    memcpy(copy, s, len);
+    return copy;
+}
+
+void arena_free_all(Arena *a) {
+    ArenaChunk *c = a->head;
+    while (c != NULL) {
+        ArenaChunk *next = c->next;
+        free(c);
+        c = next;
+    }
+    arena_init(a, 0);
+}
+
+void arena_report(const Arena *a, const char *label, FILE *out) {
+    fprintf(out,
+            "Arena %s: %zu asignaciones (%zu bytes) servidas con %zu malloc (%zu bytes reservados)\n",
+            label, a->num_allocs, a->bytes_requested,
+            a->num_chunks, a->bytes_reserved);
+}
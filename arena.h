@@ -0,0 +1,65 @@
+// arena.h
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Arena (bump allocator) por compilación.
+ *
+ * La memoria se pide al sistema en bloques ("chunks") que crecen de forma
+ * geométrica; cada petición solo avanza un puntero dentro del bloque actual.
+ * No hay liberación individual: todo se libera de una vez con arena_free_all.
+ */
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;  // bloque anterior (lista de bloques)
+    size_t size;              // bytes útiles del bloque
+    size_t used;              // bytes ya entregados
+    unsigned char *data;      // inicio de la zona útil
+} ArenaChunk;
+
+typedef struct Arena {
+    ArenaChunk *head;         // bloque actual
+    size_t next_chunk_size;   // tamaño del próximo bloque a reservar
+
+    // Contadores de asignación
+    size_t num_allocs;        // peticiones atendidas por la arena
+    size_t bytes_requested;   // bytes pedidos por los usuarios de la arena
+    size_t num_chunks;        // llamadas a malloc (una por bloque)
+    size_t bytes_reserved;    // bytes reservados al sistema
+} Arena;
+
+/**
+ * @brief Inicializa una arena vacía (no reserva memoria todavía).
+ * @param a Arena a inicializar.
+ * @param first_chunk_size Tamaño del primer bloque (0 = valor por defecto).
+ */
+void arena_init(Arena *a, size_t first_chunk_size);
+
+/**
+ * @brief Reserva 'size' bytes alineados y puestos a cero.
+ * @return void* Puntero válido hasta arena_free_all. Aborta si no hay memoria.
+ */
+void *arena_alloc(Arena *a, size_t size);
+
+/**
+ * @brief Copia una cadena terminada en '\0' dentro de la arena.
+ * @return char* Copia, o NULL si s es NULL.
+ */
+char *arena_strdup(Arena *a, const char *s);
+
+/**
+ * @brief Libera todos los bloques de la arena y reinicia sus contadores.
+ */
+void arena_free_all(Arena *a);
+
+/**
+ * @brief Imprime los contadores de la arena.
+ * @param label Nombre con el que se identifica la arena en el reporte.
+ */
+void arena_report(const Arena *a, const char *label, FILE *out);
+
+#endif // ARENA_H
@@ -4,129 +4,290 @@
 #include <stdio.h>
 
 #include "ast.h"
+#include "stats.h"
 
-ASTStmt *ast_root = NULL;
+#define AST_INITIAL_CAP 1024
 
-static char *dupstr(const char *s) {
-    if (!s) return NULL;
-    size_t len = strlen(s) + 1;
-    char *copy = (char *)malloc(len);
-    if (copy) memcpy(copy, s, len);
-    return copy;
+static void *grow_array(ASTStore *ast, void *array, uint32_t *cap, size_t elem_size) {
+    uint32_t new_cap = *cap ? *cap * 2 : AST_INITIAL_CAP;
+    void *p = realloc(array, (size_t)new_cap * elem_size);
+    if (p == NULL) {
+        perror("Error de memoria al crecer el AST");
+        exit(EXIT_FAILURE);
+    }
+    // El índice 0 (AST_NONE) queda reservado y en cero
+    if (*cap == 0) memset(p, 0, elem_size);
+    *cap = new_cap;
+    ast->num_grows++;
+    return p;
+}
+
+static inline uint64_t alloc_begin(const ASTStore *ast) {
+    return ast->timed ? stats_wall_ns() : 0;
+}
+
+static inline void alloc_end(ASTStore *ast, uint64_t t0) {
+    if (!ast->timed) return;
+    ast->alloc_ns += stats_wall_ns() - t0;
+    ast->alloc_calls++;
+}
+
+static ASTExprId new_expr(ASTStore *ast, ASTExprKind kind, MeowType t) {
+    uint64_t t0 = alloc_begin(ast);
+    if (ast->num_exprs == 0) ast->num_exprs = 1;
+    if (ast->num_exprs >= ast->cap_exprs) {
+        ast->exprs = (ASTExpr *)grow_array(ast, ast->exprs, &ast->cap_exprs,
+                                          sizeof(ASTExpr));
+    }
+    ASTExprId id = ast->num_exprs++;
+    ASTExpr *e = &ast->exprs[id];
+    memset(e, 0, sizeof(*e));
+    e->kind = (uint8_t)kind;
+    e->type = (uint8_t)t;
+    alloc_end(ast, t0);
+    return id;
+}
+
+static ASTStmtId new_stmt(ASTStore *ast, ASTStmtKind kind) {
+    uint64_t t0 = alloc_begin(ast);
+    if (ast->num_stmts == 0) ast->num_stmts = 1;
+    if (ast->num_stmts >= ast->cap_stmts) {
+        ast->stmts = (ASTStmt *)grow_array(ast, ast->stmts, &ast->cap_stmts,
+                                          sizeof(ASTStmt));
+    }
+    ASTStmtId id = ast->num_stmts++;
+    ASTStmt *s = &ast->stmts[id];
+    memset(s, 0, sizeof(*s));
+    s->kind = (uint8_t)kind;
+    s->next = AST_NONE;
+    alloc_end(ast, t0);
+    return id;
+}
+
+void ast_init(ASTStore *ast) {
+    memset(ast, 0, sizeof(*ast));
+}
+
+void ast_free_all(ASTStore *ast) {
+    free(ast->exprs);
+    free(ast->stmts);
+    memset(ast, 0, sizeof(*ast));
+}
+
+void ast_report(const ASTStore *ast, FILE *out) {
+    fprintf(out,
+            "AST: %u expresiones (%zu bytes c/u), %u sentencias (%zu bytes c/u), "
+            "%zu reubicaciones, %zu bytes reservados\n",
+            ast->num_exprs ? ast->num_exprs - 1 : 0, sizeof(ASTExpr),
+            ast->num_stmts ? ast->num_stmts - 1 : 0, sizeof(ASTStmt),
+            ast->num_grows,
+            (size_t)ast->cap_exprs * sizeof(ASTExpr) +
+            (size_t)ast->cap_stmts * sizeof(ASTStmt));
 }
 
 // ------------- Expresiones -------------
 
-ASTExpr *ast_make_var(const char *name, MeowType t) {
-    ASTExpr *e = (ASTExpr *)calloc(1, sizeof(ASTExpr));
-    e->kind = AST_EXPR_VAR;
-    e->type = t;
-    e->u.var = dupstr(name);
-    return e;
+ASTExprId ast_make_var(ASTStore *ast, const char *name, MeowType t) {
+    ASTExprId id = new_expr(ast, AST_EXPR_VAR, t);
+    ast_expr(ast, id)->u.name = name;
+    return id;
 }
 
-ASTExpr *ast_make_int(int value) {
-    ASTExpr *e = (ASTExpr *)calloc(1, sizeof(ASTExpr));
-    e->kind = AST_EXPR_INT;
-    e->type = TYPE_INT;
-    e->u.ival = value;
-    return e;
+ASTExprId ast_make_int(ASTStore *ast, int value) {
+    ASTExprId id = new_expr(ast, AST_EXPR_INT, TYPE_INT);
+    ast_expr(ast, id)->u.ival = value;
+    return id;
 }
 
-ASTExpr *ast_make_bool(int value) {
-    ASTExpr *e = (ASTExpr *)calloc(1, sizeof(ASTExpr));
-    e->kind = AST_EXPR_BOOL;
-    e->type = TYPE_BOOL;
-    e->u.ival = value ? 1 : 0;
-    return e;
+ASTExprId ast_make_bool(ASTStore *ast, int value) {
+    ASTExprId id = new_expr(ast, AST_EXPR_BOOL, TYPE_BOOL);
+    ast_expr(ast, id)->u.ival = value ? 1 : 0;
+    return id;
 }
 
-ASTExpr *ast_make_binop(ASTBinOp op, ASTExpr *left, ASTExpr *right, MeowType t) {
-    ASTExpr *e = (ASTExpr *)calloc(1, sizeof(ASTExpr));
-    e->kind = AST_EXPR_BINOP;
-    e->type = t;
-    e->u.bin.op = op;
+ASTExprId ast_make_binop(ASTStore *ast, ASTBinOp op, ASTExprId left, ASTExprId right, MeowType t) {
+    ASTExprId id = new_expr(ast, AST_EXPR_BINOP, t);
+    ASTExpr *e = ast_expr(ast, id);
+    e->op = (uint8_t)op;
     e->u.bin.left = left;
     e->u.bin.right = right;
-    return e;
+    return id;
 }
 
-// ------------- Sentencias -------------
+ASTExprId ast_make_float(ASTStore *ast, float value) {
+    ASTExprId id = new_expr(ast, AST_EXPR_FLOAT, TYPE_FLOAT);
+    ast_expr(ast, id)->u.fval = value;
+    return id;
+}
+
+ASTExprId ast_make_string(ASTStore *ast, const char *literal) {
+    ASTExprId id = new_expr(ast, AST_EXPR_STRING, TYPE_STRING);
+    ast_expr(ast, id)->u.sval = literal;
+    return id;
+}
+
+ASTExprId ast_make_assign_expr(ASTStore *ast, const char *name, ASTExprId value, MeowType t) {
+    ASTExprId id = new_expr(ast, AST_EXPR_ASSIGN, t);
+    ASTExpr *e = ast_expr(ast, id);
+    e->u.name = name;
+    e->child = value;
+    return id;
+}
+
+ASTExprId ast_make_index(ASTStore *ast, const char *name, ASTExprId index, MeowType t) {
+    ASTExprId id = new_expr(ast, AST_EXPR_INDEX, t);
+    ASTExpr *e = ast_expr(ast, id);
+    e->u.name = name;
+    e->child = index;
+    return id;
+}
 
-ASTStmt *ast_make_stmt(ASTStmtKind kind) {
-    ASTStmt *s = (ASTStmt *)calloc(1, sizeof(ASTStmt));
-    s->kind = kind;
-    s->next = NULL;
-    return s;
+ASTExprId ast_make_length(ASTStore *ast, const char *name) {
+    ASTExprId id = new_expr(ast, AST_EXPR_LENGTH, TYPE_INT);
+    ast_expr(ast, id)->u.name = name;
+    return id;
 }
 
-ASTStmt *ast_make_decl(MeowType t, const char *name, ASTExpr *init) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_DECL);
-    s->u.decl.type = t;
-    s->u.decl.name = dupstr(name);
+// ------------- Sentencias -------------
+
+ASTStmtId ast_make_decl(ASTStore *ast, MeowType t, const char *name, ASTExprId init) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_DECL);
+    ASTStmt *s = ast_stmt(ast, id);
+    s->type = (uint8_t)t;
+    s->u.decl.name = name;
     s->u.decl.init = init;
-    return s;
+    return id;
+}
+
+ASTStmtId ast_make_array_decl(ASTStore *ast, MeowType elem_type, const char *name, int length) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_DECL);
+    ASTStmt *s = ast_stmt(ast, id);
+    s->type = (uint8_t)elem_type;
+    s->u.decl.name = name;
+    s->u.decl.array_length = length;
+    return id;
+}
+
+ASTStmtId ast_make_assign(ASTStore *ast, const char *name, ASTExprId expr) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_ASSIGN);
+    ASTStmt *s = ast_stmt(ast, id);
+    s->u.assign.name = name;
+    s->u.assign.expr = expr;
+    return id;
 }
 
-ASTStmt *ast_make_assign(const char *name, ASTExpr *expr) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_ASSIGN);
-    s->u.assign.name = dupstr(name);
+ASTStmtId ast_make_index_assign(ASTStore *ast, const char *name, ASTExprId index, ASTExprId expr) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_ASSIGN);
+    ASTStmt *s = ast_stmt(ast, id);
+    s->u.assign.name = name;
+    s->u.assign.index = index;
     s->u.assign.expr = expr;
-    return s;
+    return id;
 }
 
-ASTStmt *ast_make_while(ASTExpr *cond, ASTStmt *body) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_WHILE);
+ASTStmtId ast_make_while(ASTStore *ast, ASTExprId cond, ASTStmtId body) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_WHILE);
+    ASTStmt *s = ast_stmt(ast, id);
     s->u.while_stmt.cond = cond;
     s->u.while_stmt.body = body;
-    return s;
+    return id;
 }
 
-ASTStmt *ast_make_if(ASTExpr *cond, ASTStmt *then_branch) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_IF);
+ASTStmtId ast_make_if(ASTStore *ast, ASTExprId cond, ASTStmtId then_branch) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_IF);
+    ASTStmt *s = ast_stmt(ast, id);
     s->u.if_stmt.cond = cond;
     s->u.if_stmt.then_branch = then_branch;
-    return s;
+    return id;
 }
 
-ASTStmt *ast_make_pixel(ASTExpr *x, ASTExpr *y, ASTExpr *color) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_PIXEL);
+ASTStmtId ast_make_if_else(ASTStore *ast, ASTExprId cond, ASTStmtId then_branch, ASTStmtId else_branch) {
+    ASTStmtId id = ast_make_if(ast, cond, then_branch);
+    ast_stmt(ast, id)->u.if_stmt.else_branch = else_branch;
+    return id;
+}
+
+ASTStmtId ast_make_pixel(ASTStore *ast, ASTExprId x, ASTExprId y, ASTExprId color) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_PIXEL);
+    ASTStmt *s = ast_stmt(ast, id);
     s->u.pixel.x = x;
     s->u.pixel.y = y;
     s->u.pixel.color = color;
-    return s;
+    return id;
 }
 
-ASTStmt *ast_make_key(int key_code, const char *dest_name) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_KEY);
+ASTStmtId ast_make_key(ASTStore *ast, ASTExprId key_code, const char *dest_name) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_KEY);
+    ASTStmt *s = ast_stmt(ast, id);
     s->u.key.key_code = key_code;
-    s->u.key.dest_name = dupstr(dest_name);
-    return s;
+    s->u.key.dest_name = dest_name;
+    return id;
 }
 
-ASTStmt *ast_make_input(const char *dest_name) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_INPUT);
-    s->u.input.dest_name = dupstr(dest_name);
-    return s;
+ASTStmtId ast_make_input(ASTStore *ast, const char *dest_name) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_INPUT);
+    ast_stmt(ast, id)->u.input.dest_name = dest_name;
+    return id;
+}
+
+ASTStmtId ast_make_print(ASTStore *ast, ASTExprId expr) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_PRINT);
+    ast_stmt(ast, id)->u.print.expr = expr;
+    return id;
+}
+
+ASTStmtId ast_make_block(ASTStore *ast, ASTStmtId stmts) {
+    ASTStmtId id = new_stmt(ast, AST_STMT_BLOCK);
+    ast_stmt(ast, id)->u.block.stmts = stmts;
+    return id;
+}
+
+// ------------- Listas -------------
+
+void ast_list_append(ASTStore *ast, ASTStmtList *list, ASTStmtId stmt) {
+    if (stmt == AST_NONE) return;
+    if (list->head == AST_NONE) {
+        list->head = stmt;
+    } else {
+        ast_stmt(ast, list->tail)->next = stmt;
+    }
+    list->tail = stmt;
 }
 
-ASTStmt *ast_make_print(ASTExpr *expr) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_PRINT);
-    s->u.print.expr = expr;
-    return s;
+void ast_work_grow(ASTWork *w) {
+    size_t cap = w->cap ? w->cap * 2 : 64;
+    ASTWorkItem *items = (ASTWorkItem *)realloc(w->items, cap * sizeof(*items));
+    if (items == NULL) {
+        perror("Error de memoria al recorrer el AST");
+        exit(EXIT_FAILURE);
+    }
+    w->items = items;
+    w->cap = cap;
 }
 
-ASTStmt *ast_make_block(ASTStmt *stmts) {
-    ASTStmt *s = ast_make_stmt(AST_STMT_BLOCK);
-    s->u.block.stmts = stmts;
-    return s;
+void ast_work_free(ASTWork *w) {
+    free(w->items);
+    memset(w, 0, sizeof(*w));
 }
 
-ASTStmt *ast_append_stmt(ASTStmt *list, ASTStmt *stmt) {
-    if (!stmt) return list;
-    if (!list) return stmt;
-    ASTStmt *p = list;
-    while (p->next) p = p->next;
-    p->next = stmt;
-    return list;
+int ast_expr_pure(const ASTStore *ast, ASTExprId id, ASTWork *w) {
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        const ASTExpr *e = ast_expr(ast, ast_work_pop(w).id);
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_ASSIGN:
+                return 0;
+            case AST_EXPR_BINOP:
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+                break;
+            case AST_EXPR_INDEX:
+                ast_work_push(w, e->child, 0);
+                break;
+            default:
+                break;
+        }
+    }
+    return 1;
 }
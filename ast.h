@@ -2,8 +2,25 @@
 #ifndef AST_H
 #define AST_H
 
+#include <stdint.h>
+#include <stdio.h>
 #include "types.h"
 
+/*
+ * El AST vive en un almacén plano: dos arreglos contiguos (expresiones y
+ * sentencias) que crecen por duplicación. Los hijos se referencian con
+ * índices de 32 bits en lugar de punteros; el índice 0 está reservado y
+ * significa "sin nodo" (AST_NONE).
+ *
+ * Los punteros que devuelven ast_expr()/ast_stmt() son válidos solo hasta
+ * la siguiente llamada a un constructor (el arreglo puede reubicarse).
+ */
+
+typedef uint32_t ASTExprId;
+typedef uint32_t ASTStmtId;
+
+#define AST_NONE 0u
+
 // ====================
 //  Expresiones
 // ====================
@@ -12,24 +29,35 @@ typedef enum {
     AST_EXPR_VAR,
     AST_EXPR_INT,
     AST_EXPR_BOOL,
-    AST_EXPR_BINOP
+    AST_EXPR_BINOP,
+    AST_EXPR_FLOAT,     // literal flotante
+    AST_EXPR_STRING,    // literal de cadena (con comillas)
+    AST_EXPR_ASSIGN,    // asignación dentro de expresión: h = i = 10
+    AST_EXPR_INDEX,     // nums[i]
+    AST_EXPR_LENGTH     // nums.length
 } ASTExprKind;
 
 typedef enum {
     AST_BINOP_ADD,
-    AST_BINOP_SUB
+    AST_BINOP_SUB,
+    AST_BINOP_MUL,
+    AST_BINOP_DIV
 } ASTBinOp;
 
+// 16 bytes por nodo
 typedef struct ASTExpr {
-    ASTExprKind kind;
-    MeowType type;      // TYPE_INT, TYPE_BOOL, etc.
+    uint8_t kind;       // ASTExprKind
+    uint8_t type;       // MeowType: TYPE_INT, TYPE_BOOL, etc.
+    uint8_t op;         // ASTBinOp, para AST_EXPR_BINOP
+    ASTExprId child;    // ASSIGN: valor asignado; INDEX: expresión índice
     union {
-        char *var;      // para AST_EXPR_VAR
-        int ival;       // para AST_EXPR_INT / AST_EXPR_BOOL (0/1)
+        const char *name; // VAR / LENGTH / ASSIGN / INDEX (nombre internado)
+        int ival;         // para AST_EXPR_INT / AST_EXPR_BOOL (0/1)
+        float fval;       // para AST_EXPR_FLOAT
+        const char *sval; // para AST_EXPR_STRING (cadena internada)
         struct {
-            ASTBinOp op;
-            struct ASTExpr *left;
-            struct ASTExpr *right;
+            ASTExprId left;
+            ASTExprId right;
         } bin;
     } u;
 } ASTExpr;
@@ -40,7 +68,7 @@ typedef struct ASTExpr {
 
 typedef enum {
     AST_STMT_DECL,      // declaración (con posible inicialización)
-    AST_STMT_ASSIGN,    // asignación simple id = expr;
+    AST_STMT_ASSIGN,    // asignación simple id = expr; o id[i] = expr;
     AST_STMT_WHILE,
     AST_STMT_IF,
     AST_STMT_PIXEL,
@@ -50,76 +78,182 @@ typedef enum {
     AST_STMT_BLOCK      // { listaDeSentencias }
 } ASTStmtKind;
 
+// 24 bytes por nodo
 typedef struct ASTStmt {
-    ASTStmtKind kind;
-    struct ASTStmt *next;   // para listas de sentencias
+    uint8_t kind;           // ASTStmtKind
+    uint8_t type;           // DECL: tipo declarado (MeowType)
+    ASTStmtId next;         // siguiente sentencia de la lista
     union {
         struct {            // DECL
-            MeowType type;
-            char *name;
-            ASTExpr *init;  // puede ser NULL
+            const char *name;
+            ASTExprId init;       // puede ser AST_NONE
+            int32_t array_length; // > 0 si es arreglo
         } decl;
 
         struct {            // ASSIGN
-            char *name;
-            ASTExpr *expr;
+            const char *name;
+            ASTExprId index;      // AST_NONE salvo en name[index] = expr
+            ASTExprId expr;
         } assign;
 
         struct {            // WHILE
-            ASTExpr *cond;          // bool
-            struct ASTStmt *body;   // lista
+            ASTExprId cond;       // bool
+            ASTStmtId body;       // lista
         } while_stmt;
 
-        struct {            // IF sin else
-            ASTExpr *cond;
-            struct ASTStmt *then_branch;
+        struct {            // IF con else opcional
+            ASTExprId cond;
+            ASTStmtId then_branch;
+            ASTStmtId else_branch;  // puede ser AST_NONE
         } if_stmt;
 
         struct {            // miau_pixel(x, y, c)
-            ASTExpr *x;
-            ASTExpr *y;
-            ASTExpr *color;
+            ASTExprId x;
+            ASTExprId y;
+            ASTExprId color;
         } pixel;
 
         struct {            // miau_key( keyCode , destId )
-            int key_code;
-            char *dest_name;
+            const char *dest_name;
+            ASTExprId key_code;
         } key;
 
         struct {            // miau_input(destId)
-            char *dest_name;
+            const char *dest_name;
         } input;
 
         struct {            // miau_print(expr)
-            ASTExpr *expr;
+            ASTExprId expr;
         } print;
 
         struct {            // bloque { ... }
-            struct ASTStmt *stmts;
+            ASTStmtId stmts;
         } block;
     } u;
 } ASTStmt;
 
-// Raíz del programa
-extern ASTStmt *ast_root;
-
-// Constructores básicos
-ASTExpr *ast_make_var(const char *name, MeowType t);
-ASTExpr *ast_make_int(int value);
-ASTExpr *ast_make_bool(int value); // 0 o 1
-ASTExpr *ast_make_binop(ASTBinOp op, ASTExpr *left, ASTExpr *right, MeowType t);
-
-ASTStmt *ast_make_decl(MeowType t, const char *name, ASTExpr *init);
-ASTStmt *ast_make_assign(const char *name, ASTExpr *expr);
-ASTStmt *ast_make_while(ASTExpr *cond, ASTStmt *body);
-ASTStmt *ast_make_if(ASTExpr *cond, ASTStmt *then_branch);
-ASTStmt *ast_make_pixel(ASTExpr *x, ASTExpr *y, ASTExpr *color);
-ASTStmt *ast_make_key(int key_code, const char *dest_name);
-ASTStmt *ast_make_input(const char *dest_name);
-ASTStmt *ast_make_print(ASTExpr *expr);
-ASTStmt *ast_make_block(ASTStmt *stmts);
-
-// Utilidad para concatenar listas de sentencias
-ASTStmt *ast_append_stmt(ASTStmt *list, ASTStmt *stmt);
+// Almacén de nodos de una compilación (cada MeowContext tiene el suyo).
+// Los nombres son punteros canónicos de la tabla de internado y no se copian.
+typedef struct ASTStore {
+    ASTExpr *exprs;
+    uint32_t num_exprs, cap_exprs;
+    ASTStmt *stmts;
+    uint32_t num_stmts, cap_stmts;
+    size_t num_grows;       // reubicaciones de los arreglos (O(log n))
+
+    // Medición de la reserva de nodos (--stats); solo si 'timed'
+    int timed;
+    uint64_t alloc_calls, alloc_ns;
+} ASTStore;
+
+static inline ASTExpr *ast_expr(const ASTStore *ast, ASTExprId id) { return &ast->exprs[id]; }
+static inline ASTStmt *ast_stmt(const ASTStore *ast, ASTStmtId id) { return &ast->stmts[id]; }
+
+// Deja el almacén vacío (no reserva memoria todavía)
+void ast_init(ASTStore *ast);
+
+// Libera de una vez todos los nodos del AST
+void ast_free_all(ASTStore *ast);
+
+// Tamaño del almacén (nodos, bytes y reubicaciones)
+void ast_report(const ASTStore *ast, FILE *out);
+
+// Constructores básicos.
+// Los nombres deben venir internados (intern.h): se guardan sin copiarlos.
+ASTExprId ast_make_var(ASTStore *ast, const char *name, MeowType t);
+ASTExprId ast_make_int(ASTStore *ast, int value);
+ASTExprId ast_make_bool(ASTStore *ast, int value); // 0 o 1
+ASTExprId ast_make_binop(ASTStore *ast, ASTBinOp op, ASTExprId left, ASTExprId right, MeowType t);
+ASTExprId ast_make_float(ASTStore *ast, float value);
+ASTExprId ast_make_string(ASTStore *ast, const char *literal);
+ASTExprId ast_make_assign_expr(ASTStore *ast, const char *name, ASTExprId value, MeowType t);
+ASTExprId ast_make_index(ASTStore *ast, const char *name, ASTExprId index, MeowType t);
+ASTExprId ast_make_length(ASTStore *ast, const char *name);
+
+ASTStmtId ast_make_decl(ASTStore *ast, MeowType t, const char *name, ASTExprId init);
+ASTStmtId ast_make_array_decl(ASTStore *ast, MeowType elem_type, const char *name, int length);
+ASTStmtId ast_make_assign(ASTStore *ast, const char *name, ASTExprId expr);
+ASTStmtId ast_make_index_assign(ASTStore *ast, const char *name, ASTExprId index, ASTExprId expr);
+ASTStmtId ast_make_while(ASTStore *ast, ASTExprId cond, ASTStmtId body);
+ASTStmtId ast_make_if(ASTStore *ast, ASTExprId cond, ASTStmtId then_branch);
+ASTStmtId ast_make_if_else(ASTStore *ast, ASTExprId cond, ASTStmtId then_branch, ASTStmtId else_branch);
+ASTStmtId ast_make_pixel(ASTStore *ast, ASTExprId x, ASTExprId y, ASTExprId color);
+ASTStmtId ast_make_key(ASTStore *ast, ASTExprId key_code, const char *dest_name);
+ASTStmtId ast_make_input(ASTStore *ast, const char *dest_name);
+ASTStmtId ast_make_print(ASTStore *ast, ASTExprId expr);
+ASTStmtId ast_make_block(ASTStore *ast, ASTStmtId stmts);
+
+// ====================
+//  Listas de sentencias
+// ====================
+
+// Constructor de listas que recuerda la cola: cada append es O(1)
+typedef struct ASTStmtList {
+    ASTStmtId head;
+    ASTStmtId tail;
+} ASTStmtList;
+
+static inline ASTStmtList ast_list_empty(void) {
+    ASTStmtList l = { AST_NONE, AST_NONE };
+    return l;
+}
+
+// Agrega una sentencia suelta (su 'next' debe ser AST_NONE) al final de la lista
+void ast_list_append(ASTStore *ast, ASTStmtList *list, ASTStmtId stmt);
+
+// Recorrido de una lista de sentencias enlazadas por 'next'
+typedef struct ASTStmtIter {
+    const ASTStore *ast;
+    ASTStmtId cur;
+} ASTStmtIter;
+
+static inline ASTStmtIter ast_stmt_iter(const ASTStore *ast, ASTStmtId first) {
+    ASTStmtIter it = { ast, first };
+    return it;
+}
+
+// Devuelve la sentencia actual y avanza; AST_NONE al terminar
+static inline ASTStmtId ast_stmt_iter_next(ASTStmtIter *it) {
+    ASTStmtId id = it->cur;
+    if (id != AST_NONE) it->cur = it->ast->stmts[id].next;
+    return id;
+}
+
+// ====================
+//  Pila de trabajo de los recorridos
+// ====================
+
+/* Los recorridos del AST no son recursivos: el anidamiento del fuente solo
+   lo acota la pila del parser (-fparse-depth) y una recursión en C se
+   quedaría sin pila del hilo mucho antes. Cada entrada es un nodo y un
+   estado que interpreta el recorrido (qué parte del nodo falta). */
+typedef struct ASTWorkItem {
+    uint32_t id;            // ASTExprId o ASTStmtId
+    uint32_t state;
+} ASTWorkItem;
+
+typedef struct ASTWork {
+    ASTWorkItem *items;
+    size_t len, cap;
+} ASTWork;
+
+// Duplica la capacidad de la pila (no vuelve si no hay memoria)
+void ast_work_grow(ASTWork *w);
+
+static inline void ast_work_push(ASTWork *w, uint32_t id, uint32_t state) {
+    if (w->len == w->cap) ast_work_grow(w);
+    w->items[w->len].id = id;
+    w->items[w->len].state = state;
+    w->len++;
+}
+
+static inline ASTWorkItem ast_work_pop(ASTWork *w) {
+    return w->items[--w->len];
+}
+
+void ast_work_free(ASTWork *w);
+
+// 1 si evaluar la expresión no escribe ninguna variable ('w' es la pila a usar)
+int ast_expr_pure(const ASTStore *ast, ASTExprId id, ASTWork *w);
 
 #endif // AST_H
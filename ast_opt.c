@@ -0,0 +1,701 @@
+// ast_opt.c
+
+#include "ast_opt.h"
+#include "ast_range.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Optimización sobre el AST, antes de generar código.
+ *
+ * Los nombres de las variables (ya únicos frente al ocultamiento, ver
+ * symtab.c) son los VAR de FIS-25: dos declaraciones hermanas con el mismo
+ * nombre son la misma variable, así que todo se cuenta por nombre.
+ *
+ * 1) Se cuentan las escrituras de cada nombre.
+ * 2) Un recorrido en orden del programa pliega expresiones, propaga las
+ *    constantes (una variable con una sola escritura, su declaración con un
+ *    literal, vale eso en todo uso: el chequeo semántico garantiza que los
+ *    usos vienen después), reemplaza nums.length por el largo de la
+ *    declaración y simplifica las ramas constantes.
+ * 3) Se cuentan las lecturas y se quitan las variables sin ninguna, con sus
+ *    asignaciones; se repite porque cada asignación quitada puede dejar sin
+ *    lecturas a otra variable. Una escritura cuyo valor puede detener el
+ *    programa (10 / z, o nums[i] si ast_range.c no prueba que i cae
+ *    dentro del arreglo) no se quita: el error de ejecución se conserva,
+ *    igual que al plegar x * 0.
+ *
+ * Ningún recorrido es recursivo (ver ASTWork en ast.h): las expresiones y
+ * las listas anidadas se recorren con pilas propias del optimizador, y la
+ * simplificación, que depende del orden del programa, guarda en
+ * SimplifyFrame lo que la versión recursiva tenía en la pila de C.
+ */
+
+typedef struct {
+    uint32_t writes;         // declaraciones y asignaciones
+    uint32_t reads;
+    uint8_t pinned;          // alguna escritura no se puede quitar
+    ASTExprId value;         // literal que vale siempre, o AST_NONE
+    int32_t length;          // arreglo: largo de la última declaración (en orden del programa)
+} VarInfo;
+
+// Tabla de nombres internados -> VarInfo (direccionamiento abierto)
+typedef struct {
+    const char **keys;
+    VarInfo *vals;
+    size_t cap;
+    size_t count;
+} VarTable;
+
+// Lista a medio simplificar: un nivel de anidamiento de simplify_list
+typedef struct {
+    ASTStmtId head, tail;    // lo que ya quedó de la lista
+    ASTStmtId cur, next;     // sentencia en curso y la que le sigue
+    uint8_t step;            // STEP_*: qué parte de 'cur' falta
+    uint8_t completes;       // si la última sentencia sigue a la siguiente
+    int8_t cond;             // WHILE: condición constante (1 / 0) o -1
+    uint8_t then_completes;  // IF: si la rama then sigue de largo
+} SimplifyFrame;
+
+typedef struct {
+    ASTStore *ast;
+    VarTable vars;
+    ASTOptStats *stats;
+
+    ASTWork exprs;           // fold_expr y count_expr
+    ASTWork quiet;           // expr_quiet (se llama en medio de fold_expr)
+    ASTRanges ranges;        // índices de arreglo, del programa sin optimizar
+    int have_ranges;         // 0: ninguna lectura de arreglo cuenta como segura
+    ASTWork lists;           // count_list y drop_unread
+    SimplifyFrame *frames;
+    size_t nframes, cap_frames;
+} ASTOpt;
+
+static void *xcalloc(size_t n, size_t size) {
+    void *q = calloc(n ? n : 1, size);
+    if (q == NULL) {
+        perror("Error de memoria en el optimizador del AST");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+static size_t hash_ptr(const char *s) {
+    uint64_t h = (uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+static VarInfo *table_find(const VarTable *t, const char *name) {
+    if (t->cap == 0) return NULL;
+    size_t i = hash_ptr(name) & (t->cap - 1);
+    while (t->keys[i] != NULL) {
+        if (t->keys[i] == name) return &t->vals[i];
+        i = (i + 1) & (t->cap - 1);
+    }
+    return NULL;
+}
+
+static VarInfo *table_get(VarTable *t, const char *name);
+
+static void table_grow(VarTable *t) {
+    VarTable old = *t;
+    t->cap = old.cap ? old.cap * 2 : 64;
+    t->count = 0;
+    t->keys = (const char **)xcalloc(t->cap, sizeof(*t->keys));
+    t->vals = (VarInfo *)xcalloc(t->cap, sizeof(*t->vals));
+    for (size_t i = 0; i < old.cap; ++i) {
+        if (old.keys[i] != NULL) *table_get(t, old.keys[i]) = old.vals[i];
+    }
+    free(old.keys);
+    free(old.vals);
+}
+
+// Entrada de 'name' (en cero si es nueva)
+static VarInfo *table_get(VarTable *t, const char *name) {
+    if ((t->count + 1) * 2 > t->cap) table_grow(t);
+    size_t i = hash_ptr(name) & (t->cap - 1);
+    while (t->keys[i] != NULL && t->keys[i] != name) i = (i + 1) & (t->cap - 1);
+    if (t->keys[i] == NULL) {
+        t->keys[i] = name;
+        t->count++;
+    }
+    return &t->vals[i];
+}
+
+// Pone en cero los contadores; las constantes ya propagadas no se usan más
+static void table_reset(VarTable *t) {
+    memset(t->vals, 0, t->cap * sizeof(*t->vals));
+}
+
+static void table_free(VarTable *t) {
+    free(t->keys);
+    free(t->vals);
+    memset(t, 0, sizeof(*t));
+}
+
+static inline int is_const(const ASTExpr *e) {
+    return e->kind == AST_EXPR_INT || e->kind == AST_EXPR_BOOL;
+}
+
+/* 1 si evaluar la expresión no escribe ninguna variable ni puede detener
+   el programa: solo entonces se puede dejar de evaluarla */
+static int expr_quiet(ASTOpt *o, ASTExprId id) {
+    return ast_range_quiet(o->have_ranges ? &o->ranges : NULL, o->ast, id, &o->quiet);
+}
+
+// 1 si el programa lee algún arreglo (basta mirar todos los nodos)
+static int reads_arrays(const ASTStore *ast) {
+    for (uint32_t i = 0; i < ast->num_exprs; ++i) {
+        if (ast->exprs[i].kind == AST_EXPR_INDEX) return 1;
+    }
+    return 0;
+}
+
+/* ================= Conteo de lecturas y escrituras ================= */
+
+static void count_expr(ASTOpt *o, ASTExprId id) {
+    ASTWork *w = &o->exprs;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        ASTExpr *e = ast_expr(o->ast, ast_work_pop(w).id);
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_VAR:
+            case AST_EXPR_LENGTH:
+                table_get(&o->vars, e->u.name)->reads++;
+                break;
+            case AST_EXPR_INDEX:
+                table_get(&o->vars, e->u.name)->reads++;
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_ASSIGN: {
+                VarInfo *v = table_get(&o->vars, e->u.name);
+                v->writes++;
+                v->pinned = 1;
+                ast_work_push(w, e->child, 0);
+                break;
+            }
+            case AST_EXPR_BINOP:
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Registra una escritura de 'name'; 'removable' = se puede quitar sin efectos
+static void count_write(ASTOpt *o, const char *name, int removable) {
+    VarInfo *v = table_get(&o->vars, name);
+    v->writes++;
+    if (!removable) v->pinned = 1;
+}
+
+// Las listas anidadas van a o->lists: el orden no cambia los contadores
+static void count_list(ASTOpt *o, ASTStmtId first) {
+    ASTWork *lists = &o->lists;
+    lists->len = 0;
+    ast_work_push(lists, first, 0);
+    while (lists->len > 0) {
+        ASTStmtIter it = ast_stmt_iter(o->ast, ast_work_pop(lists).id);
+        ASTStmtId id;
+        while ((id = ast_stmt_iter_next(&it)) != AST_NONE) {
+            ASTStmt *s = ast_stmt(o->ast, id);
+            switch ((ASTStmtKind)s->kind) {
+                case AST_STMT_DECL:
+                    // Los arreglos se dejan como están
+                    count_write(o, s->u.decl.name, s->u.decl.array_length == 0 &&
+                                (!s->u.decl.init || expr_quiet(o, s->u.decl.init)));
+                    if (s->u.decl.init) count_expr(o, s->u.decl.init);
+                    break;
+                case AST_STMT_ASSIGN:
+                    count_write(o, s->u.assign.name, !s->u.assign.index &&
+                                expr_quiet(o, s->u.assign.expr));
+                    if (s->u.assign.index) count_expr(o, s->u.assign.index);
+                    count_expr(o, s->u.assign.expr);
+                    break;
+                case AST_STMT_WHILE:
+                    count_expr(o, s->u.while_stmt.cond);
+                    ast_work_push(lists, s->u.while_stmt.body, 0);
+                    break;
+                case AST_STMT_IF:
+                    count_expr(o, s->u.if_stmt.cond);
+                    ast_work_push(lists, s->u.if_stmt.then_branch, 0);
+                    ast_work_push(lists, s->u.if_stmt.else_branch, 0);
+                    break;
+                case AST_STMT_PIXEL:
+                    count_expr(o, s->u.pixel.x);
+                    count_expr(o, s->u.pixel.y);
+                    count_expr(o, s->u.pixel.color);
+                    break;
+                case AST_STMT_KEY:
+                    count_expr(o, s->u.key.key_code);
+                    count_write(o, s->u.key.dest_name, 0);
+                    break;
+                case AST_STMT_INPUT:
+                    count_write(o, s->u.input.dest_name, 0);
+                    break;
+                case AST_STMT_PRINT:
+                    count_expr(o, s->u.print.expr);
+                    break;
+                case AST_STMT_BLOCK:
+                    ast_work_push(lists, s->u.block.stmts, 0);
+                    break;
+            }
+        }
+    }
+}
+
+/* ================= Plegado y propagación ================= */
+
+// Operación de 32 bits como la ejecuta FIS-25 (fis25sim); 0 si no se pliega
+static int fold_binop(ASTBinOp op, int32_t a, int32_t b, int32_t *out) {
+    switch (op) {
+        case AST_BINOP_ADD: *out = (int32_t)((uint32_t)a + (uint32_t)b); return 1;
+        case AST_BINOP_SUB: *out = (int32_t)((uint32_t)a - (uint32_t)b); return 1;
+        case AST_BINOP_MUL: *out = (int32_t)((uint32_t)a * (uint32_t)b); return 1;
+        case AST_BINOP_DIV:
+            if (b == 0) return 0;   // el error de ejecución se conserva
+            *out = (a == INT32_MIN && b == -1) ? a : a / b;
+            return 1;
+    }
+    return 0;
+}
+
+static inline int is_int(const ASTExpr *e, int value) {
+    return e->kind == AST_EXPR_INT && e->u.ival == value;
+}
+
+// Pliega una operación cuyos operandos ya están plegados
+static void fold_node(ASTOpt *o, ASTExpr *e) {
+    ASTStore *ast = o->ast;
+    ASTExpr *l = ast_expr(ast, e->u.bin.left);
+    ASTExpr *r = ast_expr(ast, e->u.bin.right);
+    ASTBinOp op = (ASTBinOp)e->op;
+    int32_t v;
+
+    // Los flotantes se truncan recién al traducir: solo enteros
+    if (l->kind == AST_EXPR_INT && r->kind == AST_EXPR_INT) {
+        if (fold_binop(op, l->u.ival, r->u.ival, &v)) {
+            e->kind = AST_EXPR_INT;
+            e->u.ival = v;
+            o->stats->exprs_folded++;
+        }
+        return;
+    }
+    if (e->type != TYPE_INT) return;
+
+    // Identidades: x+0, 0+x, x-0, x*1, 1*x, x/1 -> x; x*0, 0*x -> 0
+    const ASTExpr *keep = NULL;
+    if ((op == AST_BINOP_ADD || op == AST_BINOP_SUB) && is_int(r, 0)) keep = l;
+    else if (op == AST_BINOP_ADD && is_int(l, 0)) keep = r;
+    else if ((op == AST_BINOP_MUL || op == AST_BINOP_DIV) && is_int(r, 1)) keep = l;
+    else if (op == AST_BINOP_MUL && is_int(l, 1)) keep = r;
+    else if (op == AST_BINOP_MUL && is_int(r, 0) && expr_quiet(o, e->u.bin.left)) keep = r;
+    else if (op == AST_BINOP_MUL && is_int(l, 0) && expr_quiet(o, e->u.bin.right)) keep = l;
+    if (keep != NULL) {
+        *e = *keep;
+        o->stats->exprs_folded++;
+    }
+}
+
+// En postorden: cada operación se pliega después de sus operandos (estado 1)
+static void fold_expr(ASTOpt *o, ASTExprId id) {
+    ASTStore *ast = o->ast;
+    ASTWork *w = &o->exprs;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+
+    while (w->len > 0) {
+        ASTWorkItem item = ast_work_pop(w);
+        ASTExpr *e = ast_expr(ast, item.id);
+
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_VAR: {
+                VarInfo *v = table_find(&o->vars, e->u.name);
+                if (v != NULL && v->value != AST_NONE) {
+                    ASTExpr *c = ast_expr(ast, v->value);
+                    e->kind = c->kind;
+                    e->u.ival = c->u.ival;
+                    o->stats->consts_propagated++;
+                }
+                break;
+            }
+            case AST_EXPR_LENGTH: {
+                VarInfo *v = table_find(&o->vars, e->u.name);
+                if (v != NULL && v->length > 0) {
+                    e->kind = AST_EXPR_INT;
+                    e->u.ival = v->length;
+                    o->stats->exprs_folded++;
+                }
+                break;
+            }
+            case AST_EXPR_ASSIGN:
+            case AST_EXPR_INDEX:
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_BINOP:
+                if (item.state == 0) {
+                    ast_work_push(w, item.id, 1);
+                    ast_work_push(w, e->u.bin.right, 0);
+                    ast_work_push(w, e->u.bin.left, 0);
+                } else {
+                    fold_node(o, e);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Valor de una condición constante: 1 / 0, o -1 si no es constante
+static int const_cond(const ASTStore *ast, ASTExprId id) {
+    const ASTExpr *e = ast_expr(ast, id);
+    return is_const(e) ? e->u.ival != 0 : -1;
+}
+
+// Qué parte de la sentencia en curso falta (SimplifyFrame.step)
+enum {
+    STEP_START,              // nada: empieza por la sentencia f->cur
+    STEP_WHILE_BODY,         // volviendo del cuerpo de un WHILE
+    STEP_BRANCH,             // de la rama que queda de un IF constante
+    STEP_THEN,               // de la rama then (falta la else)
+    STEP_ELSE,               // de la rama else
+    STEP_BLOCK               // de un bloque
+};
+
+static void push_frame(ASTOpt *o, ASTStmtId first) {
+    if (o->nframes == o->cap_frames) {
+        o->cap_frames = o->cap_frames ? o->cap_frames * 2 : 64;
+        o->frames = (SimplifyFrame *)realloc(o->frames, o->cap_frames * sizeof(*o->frames));
+        if (o->frames == NULL) {
+            perror("Error de memoria en el optimizador del AST");
+            exit(EXIT_FAILURE);
+        }
+    }
+    SimplifyFrame *f = &o->frames[o->nframes++];
+    memset(f, 0, sizeof(*f));
+    f->head = f->tail = AST_NONE;
+    f->cur = first;
+    f->step = STEP_START;
+    f->completes = 1;
+}
+
+/* Empieza a simplificar la sentencia f->cur. Devuelve 1 si ya terminó (en
+   *keep queda 0 si hay que quitarla), o 0 si antes hay que simplificar la
+   lista *child y seguir con f->step. */
+static int simplify_begin(ASTOpt *o, SimplifyFrame *f, int *keep, ASTStmtId *child) {
+    ASTStore *ast = o->ast;
+    ASTStmt *s = ast_stmt(ast, f->cur);
+
+    switch ((ASTStmtKind)s->kind) {
+        case AST_STMT_DECL:
+            if (s->u.decl.array_length > 0) {
+                // Las declaraciones hermanas con el mismo nombre pueden tener otro largo
+                VarInfo *v = table_find(&o->vars, s->u.decl.name);
+                if (v != NULL) v->length = s->u.decl.array_length;
+            }
+            if (s->u.decl.init) {
+                fold_expr(o, s->u.decl.init);
+                VarInfo *v = table_find(&o->vars, s->u.decl.name);
+                if (v != NULL && v->writes == 1 && !v->pinned &&
+                    is_const(ast_expr(ast, s->u.decl.init))) {
+                    v->value = s->u.decl.init;
+                }
+            }
+            return 1;
+
+        case AST_STMT_ASSIGN:
+            if (s->u.assign.index) fold_expr(o, s->u.assign.index);
+            fold_expr(o, s->u.assign.expr);
+            return 1;
+
+        case AST_STMT_WHILE: {
+            fold_expr(o, s->u.while_stmt.cond);
+            int c = const_cond(ast, s->u.while_stmt.cond);
+            if (c == 0) {
+                o->stats->branches_folded++;
+                *keep = 0;
+                return 1;
+            }
+            f->cond = (int8_t)c;
+            f->step = STEP_WHILE_BODY;
+            *child = s->u.while_stmt.body;
+            return 0;
+        }
+
+        case AST_STMT_IF: {
+            fold_expr(o, s->u.if_stmt.cond);
+            int c = const_cond(ast, s->u.if_stmt.cond);
+            if (c >= 0) {
+                // Queda solo la rama que se toma, como bloque
+                ASTStmtId branch = c ? s->u.if_stmt.then_branch : s->u.if_stmt.else_branch;
+                o->stats->branches_folded++;
+                s->kind = AST_STMT_BLOCK;
+                f->step = STEP_BRANCH;
+                *child = branch;
+                return 0;
+            }
+            f->step = STEP_THEN;
+            *child = s->u.if_stmt.then_branch;
+            return 0;
+        }
+
+        case AST_STMT_PIXEL:
+            fold_expr(o, s->u.pixel.x);
+            fold_expr(o, s->u.pixel.y);
+            fold_expr(o, s->u.pixel.color);
+            return 1;
+
+        case AST_STMT_KEY:
+            fold_expr(o, s->u.key.key_code);
+            return 1;
+
+        case AST_STMT_INPUT:
+            return 1;
+
+        case AST_STMT_PRINT:
+            fold_expr(o, s->u.print.expr);
+            return 1;
+
+        case AST_STMT_BLOCK:
+            f->step = STEP_BLOCK;
+            *child = s->u.block.stmts;
+            return 0;
+    }
+    return 1;
+}
+
+/* Sigue con f->cur después de simplificar una lista anidada, que quedó en
+   'head' ('list_completes' como *completes de simplify_list). Devuelve lo
+   mismo que simplify_begin; en *completes queda 0 si la ejecución nunca
+   sigue a la sentencia siguiente. */
+static int simplify_resume(ASTOpt *o, SimplifyFrame *f, ASTStmtId head, int list_completes,
+                           int *keep, int *completes, ASTStmtId *child) {
+    ASTStmt *s = ast_stmt(o->ast, f->cur);
+
+    switch (f->step) {
+        case STEP_WHILE_BODY:
+            s->u.while_stmt.body = head;
+            if (f->cond == 1) *completes = 0;   // no hay forma de salir del bucle
+            return 1;
+        case STEP_BRANCH:
+        case STEP_BLOCK:
+            s->u.block.stmts = head;
+            *completes = list_completes;
+            *keep = head != AST_NONE;
+            return 1;
+        case STEP_THEN:
+            s->u.if_stmt.then_branch = head;
+            f->then_completes = (uint8_t)list_completes;
+            f->step = STEP_ELSE;
+            *child = s->u.if_stmt.else_branch;
+            return 0;
+        case STEP_ELSE:
+            s->u.if_stmt.else_branch = head;
+            *completes = f->then_completes || list_completes;
+            return 1;
+    }
+    return 1;
+}
+
+static long count_stmts(const ASTStore *ast, ASTStmtId first) {
+    long n = 0;
+    for (ASTStmtId id = first; id != AST_NONE; id = ast_stmt(ast, id)->next) n++;
+    return n;
+}
+
+/* Devuelve la nueva cabeza de la lista (con 'next' reenlazados); en
+   *completes queda 0 si la ejecución nunca llega al final de la lista. Cada
+   lista anidada es un marco más en o->frames. */
+static ASTStmtId simplify_list(ASTOpt *o, ASTStmtId first, int *completes) {
+    ASTStore *ast = o->ast;
+    size_t base = o->nframes;
+    ASTStmtId head = AST_NONE;    // la última lista terminada
+    int list_completes = 1;
+
+    push_frame(o, first);
+    while (o->nframes > base) {
+        SimplifyFrame *f = &o->frames[o->nframes - 1];
+        int keep = 1, stmt_completes = 1, done;
+        ASTStmtId child = AST_NONE;
+
+        if (f->step == STEP_START) {
+            if (f->cur == AST_NONE) {
+                // Lista terminada: el marco de abajo sigue con su resultado
+                if (f->tail != AST_NONE) ast_stmt(ast, f->tail)->next = AST_NONE;
+                head = f->head;
+                list_completes = f->completes;
+                o->nframes--;
+                continue;
+            }
+            f->next = ast_stmt(ast, f->cur)->next;
+            done = simplify_begin(o, f, &keep, &child);
+        } else {
+            done = simplify_resume(o, f, head, list_completes, &keep, &stmt_completes, &child);
+        }
+        if (!done) {
+            push_frame(o, child);   // puede mover o->frames
+            continue;
+        }
+
+        f->step = STEP_START;
+        if (keep) {
+            if (f->tail == AST_NONE) f->head = f->cur;
+            else ast_stmt(ast, f->tail)->next = f->cur;
+            f->tail = f->cur;
+        }
+        f->completes = (uint8_t)stmt_completes;
+        if (!stmt_completes) {
+            o->stats->stmts_unreachable += count_stmts(ast, f->next);
+            f->cur = AST_NONE;
+        } else {
+            f->cur = f->next;
+        }
+    }
+    *completes = list_completes;
+    return head;
+}
+
+/* ================= Variables sin lecturas ================= */
+
+static int unread(const ASTOpt *o, const char *name) {
+    const VarInfo *v = table_find(&o->vars, name);
+    return v != NULL && v->reads == 0 && !v->pinned;
+}
+
+// Lista que se filtra en drop_unread: el campo 'slot' de la sentencia 'owner'
+enum { SLOT_ROOT, SLOT_WHILE_BODY, SLOT_THEN, SLOT_ELSE, SLOT_BLOCK };
+
+static ASTStmtId *list_slot(ASTStore *ast, ASTStmtId owner, uint32_t slot, ASTStmtId *root) {
+    switch (slot) {
+        case SLOT_WHILE_BODY: return &ast_stmt(ast, owner)->u.while_stmt.body;
+        case SLOT_THEN:       return &ast_stmt(ast, owner)->u.if_stmt.then_branch;
+        case SLOT_ELSE:       return &ast_stmt(ast, owner)->u.if_stmt.else_branch;
+        case SLOT_BLOCK:      return &ast_stmt(ast, owner)->u.block.stmts;
+        default:              return root;
+    }
+}
+
+/* Quita declaraciones y asignaciones de variables que nadie lee. Cada lista
+   se filtra después de sus listas anidadas (estado impar en o->lists): un
+   bloque que queda vacío también se quita. */
+static void drop_unread(ASTOpt *o, ASTStmtId *root, long *removed) {
+    ASTStore *ast = o->ast;
+    ASTWork *w = &o->lists;
+    w->len = 0;
+    ast_work_push(w, AST_NONE, SLOT_ROOT << 1);
+
+    while (w->len > 0) {
+        ASTWorkItem item = ast_work_pop(w);
+        ASTStmtId *slot = list_slot(ast, item.id, item.state >> 1, root);
+
+        if ((item.state & 1) == 0) {
+            ast_work_push(w, item.id, item.state | 1);
+            for (ASTStmtId id = *slot; id != AST_NONE; id = ast_stmt(ast, id)->next) {
+                switch ((ASTStmtKind)ast_stmt(ast, id)->kind) {
+                    case AST_STMT_WHILE:
+                        ast_work_push(w, id, SLOT_WHILE_BODY << 1);
+                        break;
+                    case AST_STMT_IF:
+                        ast_work_push(w, id, SLOT_THEN << 1);
+                        ast_work_push(w, id, SLOT_ELSE << 1);
+                        break;
+                    case AST_STMT_BLOCK:
+                        ast_work_push(w, id, SLOT_BLOCK << 1);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            continue;
+        }
+
+        ASTStmtId head = AST_NONE, tail = AST_NONE;
+        ASTStmtId id = *slot;
+        while (id != AST_NONE) {
+            ASTStmt *s = ast_stmt(ast, id);
+            ASTStmtId next = s->next;
+            int keep = 1;
+
+            switch ((ASTStmtKind)s->kind) {
+                case AST_STMT_DECL:
+                    if (unread(o, s->u.decl.name)) {
+                        o->stats->decls_removed++;
+                        keep = 0;
+                    }
+                    break;
+                case AST_STMT_ASSIGN:
+                    if (unread(o, s->u.assign.name)) {
+                        o->stats->stores_removed++;
+                        keep = 0;
+                    }
+                    break;
+                case AST_STMT_BLOCK:
+                    keep = s->u.block.stmts != AST_NONE;
+                    break;
+                default:
+                    break;
+            }
+
+            if (keep) {
+                if (tail == AST_NONE) head = id;
+                else ast_stmt(ast, tail)->next = id;
+                tail = id;
+            } else {
+                (*removed)++;
+            }
+            id = next;
+        }
+        if (tail != AST_NONE) ast_stmt(ast, tail)->next = AST_NONE;
+        *slot = head;
+    }
+}
+
+ASTStmtId ast_optimize(ASTStore *ast, ASTStmtId first, ASTOptStats *stats) {
+    ASTOpt o;
+    memset(&o, 0, sizeof(o));
+    memset(stats, 0, sizeof(*stats));
+    o.ast = ast;
+    o.stats = stats;
+
+    /* Los intervalos se calculan una vez, antes de tocar nada: los nodos se
+       modifican en el lugar sin cambiar lo que valen, así que cada índice
+       sigue acotado igual después de plegarlo */
+    if (reads_arrays(ast)) {
+        ast_ranges_compute(&o.ranges, ast, first);
+        o.have_ranges = 1;
+    }
+
+    count_list(&o, first);
+    int completes;
+    first = simplify_list(&o, first, &completes);
+
+    long removed;
+    do {
+        table_reset(&o.vars);
+        count_list(&o, first);
+        removed = 0;
+        drop_unread(&o, &first, &removed);
+    } while (removed > 0);
+
+    table_free(&o.vars);
+    ast_work_free(&o.exprs);
+    ast_work_free(&o.quiet);
+    if (o.have_ranges) ast_ranges_free(&o.ranges);
+    ast_work_free(&o.lists);
+    free(o.frames);
+    return first;
+}
+
+void ast_opt_report(const ASTOptStats *s, FILE *out) {
+    fprintf(out,
+            "AST: %ld operaciones plegadas, %ld lecturas de constantes propagadas, "
+            "%ld condiciones constantes, %ld sentencias inalcanzables y %ld declaraciones "
+            "sin uso eliminadas (%ld asignaciones)\n",
+            s->exprs_folded, s->consts_propagated, s->branches_folded,
+            s->stmts_unreachable, s->decls_removed, s->stores_removed);
+}
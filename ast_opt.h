@@ -0,0 +1,40 @@
+// ast_opt.h
+
+#ifndef AST_OPT_H
+#define AST_OPT_H
+
+#include <stdio.h>
+#include "ast.h"
+
+typedef struct {
+    long exprs_folded;       // operaciones con constantes evaluadas (o identidades x+0, x*1...)
+    long consts_propagated;  // lecturas de variables constantes reemplazadas por el literal
+    long branches_folded;    // meoow / meowl con condición constante
+    long stmts_unreachable;  // sentencias después de un bucle que no termina
+    long decls_removed;      // declaraciones de variables que nadie lee
+    long stores_removed;     // asignaciones a esas variables
+} ASTOptStats;
+
+/**
+ * @brief Optimiza el programa sobre el AST, antes de traducirlo a FIS-25.
+ *
+ * - Pliega la aritmética entera con constantes (con la misma semántica de
+ *   32 bits que FIS-25; las divisiones entre cero se dejan para ejecución).
+ * - Propaga las variables int/bool que se escriben una sola vez, en su
+ *   declaración, con un valor constante, y nums.length (el largo declarado).
+ * - Reemplaza meoow (meowt/meowf) por la rama que corresponde, quita los
+ *   meowl (meowf) y lo que sigue a un bucle que nunca termina.
+ * - Elimina las declaraciones (y asignaciones) de variables que no se leen,
+ *   salvo las que pueden detener el programa (una división o una lectura
+ *   de arreglo que falla al ejecutar).
+ *
+ * Los nodos se modifican en el lugar; no se crean nodos nuevos.
+ * @param first Primera sentencia de la lista (ctx->root).
+ * @return ASTStmtId La nueva primera sentencia (AST_NONE si no queda nada).
+ */
+ASTStmtId ast_optimize(ASTStore *ast, ASTStmtId first, ASTOptStats *stats);
+
+// Resumen de una línea en 'out'
+void ast_opt_report(const ASTOptStats *stats, FILE *out);
+
+#endif // AST_OPT_H
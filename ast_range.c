@@ -0,0 +1,799 @@
+// ast_range.c
+
+#include "ast_range.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Intervalos de los índices de arreglo, para no comprobar en ejecución los
+ * accesos que no pueden salirse.
+ *
+ * Es una interpretación abstracta sobre el AST, en el orden del programa
+ * (ast_opt.c la hace antes de optimizar y ir_build.c sobre el resultado).
+ * El estado es un intervalo por variable y, por arreglo, uno para su largo
+ * y otro para todos sus elementos juntos. Todo empieza en 0, como los VAR
+ * de FIS-25, y una declaración sin valor inicial no cambia nada: es el
+ * mismo VAR de la vez anterior.
+ *
+ * Meow no tiene comparaciones: una condición es una variable bool y no
+ * acota nada. Las dos ramas de un meoow parten del mismo estado y se unen
+ * al final; un meowl se repite hasta que el estado de la cabecera deja de
+ * cambiar, y después de WIDEN_AFTER vueltas el extremo que todavía se mueve
+ * salta al siguiente umbral: los literales del programa y los largos de
+ * los arreglos (con sus vecinos), y por último el tope de int32. Así un
+ * contador que da la vuelta al llegar a nums.length se estabiliza en
+ * [0, largo - 1] en lugar de perderse en todo int32.
+ *
+ * La aritmética es la de 32 bits de FIS-25: si un resultado puede
+ * desbordar, vale cualquier int32. El resto x - (x / k) * k, con k una
+ * constante o nums.length, es la forma de acotar un índice sin
+ * comparaciones y se reconoce entera: queda entre -(|k|-1) y |k|-1, con el
+ * signo de x (un contador que da la vuelta, i = (i + 1) - ((i + 1) / n) * n,
+ * queda en [0, n-1]).
+ *
+ * Los recorridos no son recursivos (como en ast_opt.c): las sentencias
+ * compuestas pendientes van a una pila de Frame y las expresiones a un
+ * ASTWork. Si el programa pide más trabajo que WORK_BUDGET (bucles
+ * anidados muy hondo, que se vuelven a iterar por cada vuelta del de
+ * afuera) el análisis se abandona y todos los accesos se comprueban.
+ */
+
+#define WIDEN_AFTER  3                    // vueltas de un meowl antes de ensanchar
+#define WORK_BUDGET  ((uint64_t)1 << 26)  // nodos visitados + intervalos copiados
+#define NO_SLOT      (-1)
+
+static const ASTRange TOP = { INT32_MIN, INT32_MAX };
+
+// Posiciones de un nombre en el estado (NO_SLOT si no se usa así)
+typedef struct {
+    int32_t scalar;          // variable
+    int32_t length;          // arreglo: su largo
+    int32_t elems;           // arreglo: todos sus elementos
+} NameSlots;
+
+// Tabla de nombres internados -> NameSlots (direccionamiento abierto)
+typedef struct {
+    const char **keys;
+    NameSlots *vals;
+    size_t cap;
+    size_t count;
+} NameTable;
+
+typedef enum {
+    FRAME_LIST,              // las sentencias desde 'stmt'
+    FRAME_WHILE,             // terminó una vuelta del cuerpo del WHILE 'stmt'
+    FRAME_THEN,              // terminó la rama then del IF 'stmt'
+    FRAME_ELSE               // terminó la rama else
+} FrameKind;
+
+typedef struct {
+    uint8_t kind;            // FrameKind
+    int rounds;              // FRAME_WHILE: vueltas hechas
+    ASTStmtId stmt;
+    ASTRange *saved;         // WHILE: la cabecera; THEN: el estado antes de las ramas;
+                             // ELSE: el final de la rama then
+} Frame;
+
+typedef struct {
+    const ASTStore *ast;
+    ASTRanges *out;
+    NameTable names;
+    uint32_t nslots;
+    ASTRange *cur;           // estado en el punto del programa que se recorre
+    ASTRange **spare;        // estados libres para reutilizar
+    size_t nspare, cap_spare;
+    Frame *frames;
+    size_t nframes, cap_frames;
+    ASTWork work;            // eval y la recolección de nombres
+    ASTWork pairs;           // same_expr (se llama en medio de eval)
+    ASTRange *vals;          // pila de valores de eval
+    size_t nvals, cap_vals;
+    int32_t *thresholds;     // umbrales de ensanche, ordenados y sin repetir
+    size_t nthresholds, cap_thresholds;
+    uint64_t spent;
+} Analysis;
+
+static void *xrealloc(void *p, size_t size) {
+    void *q = realloc(p, size ? size : 1);
+    if (q == NULL) {
+        perror("Error de memoria en el análisis de rangos");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+/* ================= Intervalos ================= */
+
+static inline ASTRange exact(int32_t v) {
+    ASTRange r = { v, v };
+    return r;
+}
+
+// [lo, hi] calculado con 64 bits; si se sale de int32, FIS-25 da la vuelta
+static ASTRange range_of(int64_t lo, int64_t hi) {
+    if (lo < INT32_MIN || hi > INT32_MAX) return TOP;
+    ASTRange r = { (int32_t)lo, (int32_t)hi };
+    return r;
+}
+
+static ASTRange join(ASTRange a, ASTRange b) {
+    if (a.lo > a.hi) return b;
+    if (b.lo > b.hi) return a;
+    ASTRange r = { a.lo < b.lo ? a.lo : b.lo, a.hi > b.hi ? a.hi : b.hi };
+    return r;
+}
+
+static void min_max(int64_t *lo, int64_t *hi, const int64_t *c, int n) {
+    for (int i = 0; i < n; ++i) {
+        if (c[i] < *lo) *lo = c[i];
+        if (c[i] > *hi) *hi = c[i];
+    }
+}
+
+static ASTRange range_mul(ASTRange a, ASTRange b) {
+    int64_t c[4] = {
+        (int64_t)a.lo * b.lo, (int64_t)a.lo * b.hi,
+        (int64_t)a.hi * b.lo, (int64_t)a.hi * b.hi
+    };
+    int64_t lo = INT64_MAX, hi = INT64_MIN;
+    min_max(&lo, &hi, c, 4);
+    return range_of(lo, hi);
+}
+
+// Con el divisor de un solo signo los extremos están en las esquinas
+static void div_part(int64_t *lo, int64_t *hi, ASTRange a, int64_t blo, int64_t bhi) {
+    int64_t c[4] = { a.lo / blo, a.lo / bhi, a.hi / blo, a.hi / bhi };
+    min_max(lo, hi, c, 4);
+}
+
+// Dividir entre 0 detiene el programa: solo cuentan los divisores no nulos
+static ASTRange range_div(ASTRange a, ASTRange b) {
+    int64_t lo = INT64_MAX, hi = INT64_MIN;
+    if (b.lo < 0) div_part(&lo, &hi, a, b.lo, b.hi < 0 ? b.hi : -1);
+    if (b.hi > 0) div_part(&lo, &hi, a, b.lo > 0 ? b.lo : 1, b.hi);
+    if (lo > hi) return TOP;
+    return range_of(lo, hi);   // INT32_MIN / -1 no entra en int32: TOP
+}
+
+/* ================= Nombres ================= */
+
+static size_t hash_ptr(const char *s) {
+    uint64_t h = (uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+static NameSlots *names_get(NameTable *t, const char *name);
+
+static void names_grow(NameTable *t) {
+    NameTable old = *t;
+    t->cap = old.cap ? old.cap * 2 : 64;
+    t->count = 0;
+    t->keys = (const char **)calloc(t->cap, sizeof(*t->keys));
+    t->vals = (NameSlots *)calloc(t->cap, sizeof(*t->vals));
+    if (t->keys == NULL || t->vals == NULL) {
+        perror("Error de memoria en el análisis de rangos");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < old.cap; ++i) {
+        if (old.keys[i] != NULL) *names_get(t, old.keys[i]) = old.vals[i];
+    }
+    free(old.keys);
+    free(old.vals);
+}
+
+// Entrada de 'name' (sin posiciones si es nueva)
+static NameSlots *names_get(NameTable *t, const char *name) {
+    if ((t->count + 1) * 2 > t->cap) names_grow(t);
+    size_t i = hash_ptr(name) & (t->cap - 1);
+    while (t->keys[i] != NULL && t->keys[i] != name) i = (i + 1) & (t->cap - 1);
+    if (t->keys[i] == NULL) {
+        t->keys[i] = name;
+        t->vals[i].scalar = t->vals[i].length = t->vals[i].elems = NO_SLOT;
+        t->count++;
+    }
+    return &t->vals[i];
+}
+
+static void add_threshold(Analysis *a, int64_t v) {
+    if (v < INT32_MIN || v > INT32_MAX) return;
+    if (a->nthresholds == a->cap_thresholds) {
+        a->cap_thresholds = a->cap_thresholds ? a->cap_thresholds * 2 : 64;
+        a->thresholds = (int32_t *)xrealloc(a->thresholds, a->cap_thresholds * sizeof(int32_t));
+    }
+    a->thresholds[a->nthresholds++] = (int32_t)v;
+}
+
+// Un valor que aparece en el programa y sus vecinos
+static void add_thresholds(Analysis *a, int32_t v) {
+    add_threshold(a, (int64_t)v - 1);
+    add_threshold(a, v);
+    add_threshold(a, (int64_t)v + 1);
+}
+
+static int cmp_int32(const void *x, const void *y) {
+    int32_t a = *(const int32_t *)x, b = *(const int32_t *)y;
+    return (a > b) - (a < b);
+}
+
+static void sort_thresholds(Analysis *a) {
+    add_thresholds(a, 0);
+    qsort(a->thresholds, a->nthresholds, sizeof(int32_t), cmp_int32);
+    size_t n = 0;
+    for (size_t i = 0; i < a->nthresholds; ++i) {
+        if (n == 0 || a->thresholds[n - 1] != a->thresholds[i]) a->thresholds[n++] = a->thresholds[i];
+    }
+    a->nthresholds = n;
+}
+
+// Menor umbral >= v (o INT32_MAX)
+static int32_t threshold_above(const Analysis *a, int32_t v) {
+    size_t lo = 0, hi = a->nthresholds;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a->thresholds[mid] < v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < a->nthresholds ? a->thresholds[lo] : INT32_MAX;
+}
+
+// Mayor umbral <= v (o INT32_MIN)
+static int32_t threshold_below(const Analysis *a, int32_t v) {
+    size_t lo = 0, hi = a->nthresholds;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a->thresholds[mid] <= v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo > 0 ? a->thresholds[lo - 1] : INT32_MIN;
+}
+
+static void use_scalar(Analysis *a, const char *name) {
+    NameSlots *n = names_get(&a->names, name);
+    if (n->scalar == NO_SLOT) n->scalar = (int32_t)a->nslots++;
+}
+
+static void use_array(Analysis *a, const char *name) {
+    NameSlots *n = names_get(&a->names, name);
+    if (n->length == NO_SLOT) {
+        n->length = (int32_t)a->nslots++;
+        n->elems = (int32_t)a->nslots++;
+    }
+}
+
+static void collect_expr(Analysis *a, ASTExprId id) {
+    ASTWork *w = &a->work;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        const ASTExpr *e = ast_expr(a->ast, ast_work_pop(w).id);
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_VAR:
+                use_scalar(a, e->u.name);
+                break;
+            case AST_EXPR_INT:
+                add_thresholds(a, e->u.ival);
+                break;
+            case AST_EXPR_ASSIGN:
+                use_scalar(a, e->u.name);
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_LENGTH:
+                use_array(a, e->u.name);
+                break;
+            case AST_EXPR_INDEX:
+                use_array(a, e->u.name);
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_BINOP:
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Da una posición a cada nombre del programa; las listas anidadas van a 'lists'
+static void collect_names(Analysis *a, ASTStmtId first) {
+    ASTWork lists = { NULL, 0, 0 };
+    ast_work_push(&lists, first, 0);
+    while (lists.len > 0) {
+        ASTStmtIter it = ast_stmt_iter(a->ast, ast_work_pop(&lists).id);
+        ASTStmtId id;
+        while ((id = ast_stmt_iter_next(&it)) != AST_NONE) {
+            const ASTStmt *s = ast_stmt(a->ast, id);
+            switch ((ASTStmtKind)s->kind) {
+                case AST_STMT_DECL:
+                    if (s->u.decl.array_length > 0) {
+                        use_array(a, s->u.decl.name);
+                        add_thresholds(a, s->u.decl.array_length);
+                    } else {
+                        use_scalar(a, s->u.decl.name);
+                    }
+                    if (s->u.decl.init) collect_expr(a, s->u.decl.init);
+                    break;
+                case AST_STMT_ASSIGN:
+                    if (s->u.assign.index) {
+                        use_array(a, s->u.assign.name);
+                        collect_expr(a, s->u.assign.index);
+                    } else {
+                        use_scalar(a, s->u.assign.name);
+                    }
+                    collect_expr(a, s->u.assign.expr);
+                    break;
+                case AST_STMT_WHILE:
+                    collect_expr(a, s->u.while_stmt.cond);
+                    ast_work_push(&lists, s->u.while_stmt.body, 0);
+                    break;
+                case AST_STMT_IF:
+                    collect_expr(a, s->u.if_stmt.cond);
+                    ast_work_push(&lists, s->u.if_stmt.then_branch, 0);
+                    ast_work_push(&lists, s->u.if_stmt.else_branch, 0);
+                    break;
+                case AST_STMT_PIXEL:
+                    collect_expr(a, s->u.pixel.x);
+                    collect_expr(a, s->u.pixel.y);
+                    collect_expr(a, s->u.pixel.color);
+                    break;
+                case AST_STMT_KEY:
+                    collect_expr(a, s->u.key.key_code);
+                    use_scalar(a, s->u.key.dest_name);
+                    break;
+                case AST_STMT_INPUT:
+                    use_scalar(a, s->u.input.dest_name);
+                    break;
+                case AST_STMT_PRINT:
+                    collect_expr(a, s->u.print.expr);
+                    break;
+                case AST_STMT_BLOCK:
+                    ast_work_push(&lists, s->u.block.stmts, 0);
+                    break;
+            }
+        }
+    }
+    ast_work_free(&lists);
+    sort_thresholds(a);
+}
+
+// Posiciones de un nombre ya recolectado
+static const NameSlots *slots(const Analysis *a, const char *name) {
+    const NameTable *t = &a->names;
+    size_t i = hash_ptr(name) & (t->cap - 1);
+    while (t->keys[i] != name) i = (i + 1) & (t->cap - 1);
+    return &t->vals[i];
+}
+
+/* ================= Estados ================= */
+
+static ASTRange *state_new(Analysis *a) {
+    if (a->nspare > 0) return a->spare[--a->nspare];
+    return (ASTRange *)xrealloc(NULL, a->nslots * sizeof(ASTRange));
+}
+
+static void state_release(Analysis *a, ASTRange *s) {
+    if (a->nspare == a->cap_spare) {
+        a->cap_spare = a->cap_spare ? a->cap_spare * 2 : 16;
+        a->spare = (ASTRange **)xrealloc(a->spare, a->cap_spare * sizeof(*a->spare));
+    }
+    a->spare[a->nspare++] = s;
+}
+
+static void state_copy(Analysis *a, ASTRange *dst, const ASTRange *src) {
+    memcpy(dst, src, a->nslots * sizeof(ASTRange));
+    a->spent += a->nslots;
+}
+
+static void state_join(Analysis *a, ASTRange *dst, const ASTRange *src) {
+    for (uint32_t i = 0; i < a->nslots; ++i) dst[i] = join(dst[i], src[i]);
+    a->spent += a->nslots;
+}
+
+/* Une a la cabecera de un bucle el estado al final del cuerpo; con 'widen'
+   lo que crece salta al umbral siguiente. Devuelve 1 si la cabecera cambió. */
+static int state_widen(Analysis *a, ASTRange *head, const ASTRange *end, int widen) {
+    int changed = 0;
+    for (uint32_t i = 0; i < a->nslots; ++i) {
+        if (end[i].lo < head[i].lo) {
+            head[i].lo = widen ? threshold_below(a, end[i].lo) : end[i].lo;
+            changed = 1;
+        }
+        if (end[i].hi > head[i].hi) {
+            head[i].hi = widen ? threshold_above(a, end[i].hi) : end[i].hi;
+            changed = 1;
+        }
+    }
+    a->spent += a->nslots;
+    return changed;
+}
+
+/* ================= Expresiones ================= */
+
+static void push_val(Analysis *a, ASTRange r) {
+    if (a->nvals == a->cap_vals) {
+        a->cap_vals = a->cap_vals ? a->cap_vals * 2 : 64;
+        a->vals = (ASTRange *)xrealloc(a->vals, a->cap_vals * sizeof(*a->vals));
+    }
+    a->vals[a->nvals++] = r;
+}
+
+// Índice 'index' de 'name' con valores 'r', con el largo que tiene ahí el arreglo
+static void record_index(Analysis *a, const char *name, ASTExprId index, ASTRange r) {
+    int32_t length = a->cur[slots(a, name)->length].lo;
+    a->out->index[index] = join(a->out->index[index], r);
+    if (length < a->out->length[index]) a->out->length[index] = length;
+}
+
+// 1 si x e y son la misma expresión sin asignaciones (valen lo mismo seguidas)
+static int same_expr(Analysis *a, ASTExprId x, ASTExprId y) {
+    ASTWork *w = &a->pairs;
+    w->len = 0;
+    ast_work_push(w, x, y);   // el estado es la otra expresión del par
+    while (w->len > 0) {
+        ASTWorkItem item = ast_work_pop(w);
+        const ASTExpr *ex = ast_expr(a->ast, item.id);
+        const ASTExpr *ey = ast_expr(a->ast, item.state);
+        if (ex->kind != ey->kind) return 0;
+        switch ((ASTExprKind)ex->kind) {
+            case AST_EXPR_INT:
+            case AST_EXPR_BOOL:
+                if (ex->u.ival != ey->u.ival) return 0;
+                break;
+            case AST_EXPR_VAR:
+            case AST_EXPR_LENGTH:
+                if (ex->u.name != ey->u.name) return 0;
+                break;
+            case AST_EXPR_INDEX:
+                if (ex->u.name != ey->u.name) return 0;
+                ast_work_push(w, ex->child, ey->child);
+                break;
+            case AST_EXPR_BINOP:
+                if (ex->op != ey->op) return 0;
+                ast_work_push(w, ex->u.bin.left, ey->u.bin.left);
+                ast_work_push(w, ex->u.bin.right, ey->u.bin.right);
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+// Si 'e' es x - (x / k) * k, el mayor |k| posible; si no, 0
+static int64_t remainder_divisor(Analysis *a, const ASTExpr *e) {
+    const ASTStore *ast = a->ast;
+    if (e->op != AST_BINOP_SUB) return 0;
+    const ASTExpr *mul = ast_expr(ast, e->u.bin.right);
+    if (mul->kind != AST_EXPR_BINOP || mul->op != AST_BINOP_MUL) return 0;
+
+    ASTExprId quot = mul->u.bin.left, k = mul->u.bin.right;
+    if (ast_expr(ast, quot)->kind != AST_EXPR_BINOP || ast_expr(ast, quot)->op != AST_BINOP_DIV) {
+        quot = mul->u.bin.right;
+        k = mul->u.bin.left;
+    }
+    const ASTExpr *div = ast_expr(ast, quot);
+    if (div->kind != AST_EXPR_BINOP || div->op != AST_BINOP_DIV) return 0;
+    if (!same_expr(a, div->u.bin.right, k) || !same_expr(a, div->u.bin.left, e->u.bin.left)) {
+        return 0;
+    }
+
+    const ASTExpr *ke = ast_expr(ast, k);
+    if (ke->kind == AST_EXPR_INT) return ke->u.ival < 0 ? -(int64_t)ke->u.ival : ke->u.ival;
+    if (ke->kind == AST_EXPR_LENGTH) return a->cur[slots(a, ke->u.name)->length].hi;
+    return 0;
+}
+
+static ASTRange range_binop(Analysis *a, const ASTExpr *e, ASTRange l, ASTRange r) {
+    switch ((ASTBinOp)e->op) {
+        case AST_BINOP_ADD:
+            return range_of((int64_t)l.lo + r.lo, (int64_t)l.hi + r.hi);
+        case AST_BINOP_SUB: {
+            int64_t k = remainder_divisor(a, e);
+            if (k > 0) {
+                // El resto tiene el signo de x y |resto| <= min(|x|, |k| - 1)
+                int64_t lo = l.lo >= 0 ? 0 : (l.lo > -(k - 1) ? l.lo : -(k - 1));
+                int64_t hi = l.hi <= 0 ? 0 : (l.hi < k - 1 ? l.hi : k - 1);
+                return range_of(lo, hi);
+            }
+            return range_of((int64_t)l.lo - r.hi, (int64_t)l.hi - r.lo);
+        }
+        case AST_BINOP_MUL:
+            return range_mul(l, r);
+        case AST_BINOP_DIV:
+            return range_div(l, r);
+    }
+    return TOP;
+}
+
+/* Valores de la expresión en el estado actual, que se actualiza con sus
+   asignaciones (en el orden de ir_build: izquierda antes que derecha) */
+static ASTRange eval(Analysis *a, ASTExprId id) {
+    ASTWork *w = &a->work;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+
+    while (w->len > 0) {
+        ASTWorkItem item = ast_work_pop(w);
+        const ASTExpr *e = ast_expr(a->ast, item.id);
+        a->spent++;
+
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_INT:
+            case AST_EXPR_BOOL:
+                push_val(a, exact(e->u.ival));
+                break;
+            case AST_EXPR_FLOAT:
+                push_val(a, exact((int)e->u.fval));   // ir_build los trunca
+                break;
+            case AST_EXPR_STRING:
+                push_val(a, TOP);
+                break;
+            case AST_EXPR_VAR:
+                push_val(a, a->cur[slots(a, e->u.name)->scalar]);
+                break;
+            case AST_EXPR_LENGTH:
+                push_val(a, a->cur[slots(a, e->u.name)->length]);
+                break;
+            case AST_EXPR_INDEX:
+                if (item.state == 0) {
+                    ast_work_push(w, item.id, 1);
+                    ast_work_push(w, e->child, 0);
+                } else {
+                    record_index(a, e->u.name, e->child, a->vals[--a->nvals]);
+                    push_val(a, a->cur[slots(a, e->u.name)->elems]);
+                }
+                break;
+            case AST_EXPR_ASSIGN:
+                if (item.state == 0) {
+                    ast_work_push(w, item.id, 1);
+                    ast_work_push(w, e->child, 0);
+                } else {
+                    a->cur[slots(a, e->u.name)->scalar] = a->vals[a->nvals - 1];
+                }
+                break;
+            case AST_EXPR_BINOP:
+                if (item.state == 0) {
+                    ast_work_push(w, item.id, 1);
+                    ast_work_push(w, e->u.bin.right, 0);
+                    ast_work_push(w, e->u.bin.left, 0);
+                } else {
+                    ASTRange r = a->vals[--a->nvals];
+                    ASTRange l = a->vals[--a->nvals];
+                    push_val(a, range_binop(a, e, l, r));
+                }
+                break;
+        }
+    }
+    return a->vals[--a->nvals];
+}
+
+/* ================= Sentencias ================= */
+
+static void push_frame(Analysis *a, FrameKind kind, ASTStmtId stmt, ASTRange *saved) {
+    if (a->nframes == a->cap_frames) {
+        a->cap_frames = a->cap_frames ? a->cap_frames * 2 : 64;
+        a->frames = (Frame *)xrealloc(a->frames, a->cap_frames * sizeof(*a->frames));
+    }
+    Frame *f = &a->frames[a->nframes++];
+    f->kind = (uint8_t)kind;
+    f->rounds = 0;
+    f->stmt = stmt;
+    f->saved = saved;
+}
+
+// Aplica una sentencia al estado; las compuestas dejan su resto en la pila
+static void step_stmt(Analysis *a, ASTStmtId id) {
+    const ASTStmt *s = ast_stmt(a->ast, id);
+    a->spent++;
+
+    switch ((ASTStmtKind)s->kind) {
+        case AST_STMT_DECL:
+            if (s->u.decl.array_length > 0) {
+                a->cur[slots(a, s->u.decl.name)->length] = exact(s->u.decl.array_length);
+            } else if (s->u.decl.init) {
+                ASTRange v = eval(a, s->u.decl.init);
+                a->cur[slots(a, s->u.decl.name)->scalar] = v;
+            }
+            break;
+
+        case AST_STMT_ASSIGN:
+            if (s->u.assign.index) {
+                record_index(a, s->u.assign.name, s->u.assign.index, eval(a, s->u.assign.index));
+                ASTRange v = eval(a, s->u.assign.expr);
+                int32_t elems = slots(a, s->u.assign.name)->elems;
+                a->cur[elems] = join(a->cur[elems], v);
+            } else {
+                ASTRange v = eval(a, s->u.assign.expr);
+                a->cur[slots(a, s->u.assign.name)->scalar] = v;
+            }
+            break;
+
+        case AST_STMT_WHILE: {
+            ASTRange *head = state_new(a);
+            state_copy(a, head, a->cur);
+            eval(a, s->u.while_stmt.cond);
+            push_frame(a, FRAME_WHILE, id, head);
+            push_frame(a, FRAME_LIST, s->u.while_stmt.body, NULL);
+            break;
+        }
+
+        case AST_STMT_IF: {
+            eval(a, s->u.if_stmt.cond);
+            ASTRange *fork = state_new(a);
+            state_copy(a, fork, a->cur);
+            push_frame(a, FRAME_THEN, id, fork);
+            push_frame(a, FRAME_LIST, s->u.if_stmt.then_branch, NULL);
+            break;
+        }
+
+        case AST_STMT_PIXEL:
+            eval(a, s->u.pixel.x);
+            eval(a, s->u.pixel.y);
+            eval(a, s->u.pixel.color);
+            break;
+
+        case AST_STMT_KEY:
+            eval(a, s->u.key.key_code);
+            a->cur[slots(a, s->u.key.dest_name)->scalar] = TOP;
+            break;
+
+        case AST_STMT_INPUT:
+            a->cur[slots(a, s->u.input.dest_name)->scalar] = TOP;
+            break;
+
+        case AST_STMT_PRINT:
+            eval(a, s->u.print.expr);
+            break;
+
+        case AST_STMT_BLOCK:
+            push_frame(a, FRAME_LIST, s->u.block.stmts, NULL);
+            break;
+    }
+}
+
+static void interpret(Analysis *a, ASTStmtId first) {
+    push_frame(a, FRAME_LIST, first, NULL);
+
+    while (a->nframes > 0) {
+        if (a->spent > WORK_BUDGET) {
+            a->out->gave_up = 1;
+            for (size_t i = 0; i < a->nframes; ++i) {
+                if (a->frames[i].saved) state_release(a, a->frames[i].saved);
+            }
+            a->nframes = 0;
+            return;
+        }
+
+        // step_stmt y push_frame pueden mover a->frames: 'f' no se usa después
+        Frame *f = &a->frames[a->nframes - 1];
+        if (f->kind == FRAME_LIST) {
+            ASTStmtId id = f->stmt;
+            if (id == AST_NONE) {
+                a->nframes--;
+            } else {
+                f->stmt = ast_stmt(a->ast, id)->next;
+                step_stmt(a, id);
+            }
+            continue;
+        }
+
+        const ASTStmt *s = ast_stmt(a->ast, f->stmt);
+        switch ((FrameKind)f->kind) {
+            case FRAME_LIST:
+                break;
+
+            case FRAME_WHILE:
+                f->rounds++;
+                if (state_widen(a, f->saved, a->cur, f->rounds > WIDEN_AFTER)) {
+                    state_copy(a, a->cur, f->saved);
+                    eval(a, s->u.while_stmt.cond);
+                    push_frame(a, FRAME_LIST, s->u.while_stmt.body, NULL);
+                } else {
+                    // La cabecera ya no cambia: se sale desde ella, sin entrar al cuerpo
+                    state_copy(a, a->cur, f->saved);
+                    eval(a, s->u.while_stmt.cond);
+                    state_release(a, f->saved);
+                    a->nframes--;
+                }
+                break;
+
+            case FRAME_THEN:
+                if (s->u.if_stmt.else_branch) {
+                    ASTRange *then_end = a->cur;
+                    a->cur = f->saved;
+                    f->saved = then_end;
+                    f->kind = FRAME_ELSE;
+                    push_frame(a, FRAME_LIST, s->u.if_stmt.else_branch, NULL);
+                } else {
+                    state_join(a, a->cur, f->saved);
+                    state_release(a, f->saved);
+                    a->nframes--;
+                }
+                break;
+
+            case FRAME_ELSE:
+                state_join(a, a->cur, f->saved);
+                state_release(a, f->saved);
+                a->nframes--;
+                break;
+        }
+    }
+}
+
+void ast_ranges_compute(ASTRanges *r, const ASTStore *ast, ASTStmtId first) {
+    Analysis a;
+    memset(&a, 0, sizeof(a));
+    memset(r, 0, sizeof(*r));
+    a.ast = ast;
+    a.out = r;
+
+    r->nexprs = ast->num_exprs;
+    r->index = (ASTRange *)xrealloc(NULL, r->nexprs * sizeof(*r->index));
+    r->length = (int32_t *)xrealloc(NULL, r->nexprs * sizeof(*r->length));
+    for (uint32_t i = 0; i < r->nexprs; ++i) {
+        r->index[i].lo = 1;
+        r->index[i].hi = 0;
+        r->length[i] = INT32_MAX;
+    }
+
+    collect_names(&a, first);
+    a.cur = (ASTRange *)calloc(a.nslots ? a.nslots : 1, sizeof(ASTRange));   // todo en [0, 0]
+    if (a.cur == NULL) {
+        perror("Error de memoria en el análisis de rangos");
+        exit(EXIT_FAILURE);
+    }
+    interpret(&a, first);
+
+    free(a.cur);
+    for (size_t i = 0; i < a.nspare; ++i) free(a.spare[i]);
+    free(a.spare);
+    free(a.frames);
+    free(a.vals);
+    free(a.thresholds);
+    free(a.names.keys);
+    free(a.names.vals);
+    ast_work_free(&a.work);
+    ast_work_free(&a.pairs);
+}
+
+ASTRange ast_range_index(const ASTRanges *r, ASTExprId index) {
+    if (r->gave_up || index >= r->nexprs || r->index[index].lo > r->index[index].hi) return TOP;
+    return r->index[index];
+}
+
+int ast_range_in_bounds(const ASTRanges *r, ASTExprId index) {
+    ASTRange v = ast_range_index(r, index);
+    return v.lo >= 0 && v.hi < r->length[index];
+}
+
+int ast_range_quiet(const ASTRanges *r, const ASTStore *ast, ASTExprId id, ASTWork *w) {
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        const ASTExpr *e = ast_expr(ast, ast_work_pop(w).id);
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_ASSIGN:
+                return 0;
+            case AST_EXPR_INDEX:
+                if (r == NULL || !ast_range_in_bounds(r, e->child)) return 0;
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_BINOP: {
+                const ASTExpr *d = ast_expr(ast, e->u.bin.right);
+                if (e->op == AST_BINOP_DIV && (d->kind != AST_EXPR_INT || d->u.ival == 0)) return 0;
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return 1;
+}
+
+void ast_ranges_free(ASTRanges *r) {
+    free(r->index);
+    free(r->length);
+    memset(r, 0, sizeof(*r));
+}
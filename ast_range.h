@@ -0,0 +1,45 @@
+// ast_range.h
+
+#ifndef AST_RANGE_H
+#define AST_RANGE_H
+
+#include <stdint.h>
+#include "ast.h"
+
+// Valores posibles de una expresión: [lo, hi] (lo > hi = ninguno todavía)
+typedef struct {
+    int32_t lo, hi;
+} ASTRange;
+
+typedef struct {
+    ASTRange *index;         // por ASTExprId: solo las expresiones índice de un arreglo
+    int32_t *length;         // por ASTExprId del índice: el menor largo del arreglo ahí
+    uint32_t nexprs;
+    int gave_up;             // el análisis superó su presupuesto: todo índice vale cualquier int32
+} ASTRanges;
+
+/**
+ * @brief Acota los valores de cada índice de arreglo (nums[i] y
+ *        nums[i] = ...) del programa que empieza en 'first'.
+ *
+ * Es una interpretación abstracta con intervalos en el orden del programa
+ * (ver ast_range.c). El resultado es conservador: un índice que en alguna
+ * ejecución vale v tiene v dentro de su intervalo.
+ */
+void ast_ranges_compute(ASTRanges *r, const ASTStore *ast, ASTStmtId first);
+
+// Intervalo del índice 'index' (todo int32 si no se pudo acotar)
+ASTRange ast_range_index(const ASTRanges *r, ASTExprId index);
+
+// 1 si el índice 'index' cae siempre dentro de su arreglo
+int ast_range_in_bounds(const ASTRanges *r, ASTExprId index);
+
+/* 1 si evaluar la expresión no escribe ninguna variable ni puede detener
+   el programa: sin divisiones entre algo que no sea un literal distinto de
+   cero ni lecturas de arreglo que 'r' no pruebe dentro del arreglo ('r'
+   puede ser NULL: ninguna lectura de arreglo es segura) */
+int ast_range_quiet(const ASTRanges *r, const ASTStore *ast, ASTExprId id, ASTWork *w);
+
+void ast_ranges_free(ASTRanges *r);
+
+#endif // AST_RANGE_H
@@ -0,0 +1,89 @@
+#!/bin/sh
+# bench/bench.sh
+#
+# Compila programas generados con meowgen (una forma por corrida: muchas
+# declaraciones, cadenas de asignaciones, bloques anidados, expresiones
+# grandes y la mezcla) y reporta líneas/s y tokens/s de la compilación
+# completa (--program, optimizando, sin caché, salida a /dev/null). Se toma la mejor de
+# varias corridas y se compara con bench/baseline.txt.
+#
+# Uso: bench/bench.sh [LÍNEAS] [REPETICIONES] [MEOWC] [MEOWGEN]
+#      (por defecto 20000 líneas, 3 repeticiones, ./meowc, ./meowgen)
+# Con BENCH_SAVE=1 reescribe la línea base con los resultados (make bench-baseline).
+
+set -e
+
+LINES=${1:-20000}
+RUNS=${2:-3}
+MEOWC=${3:-./meowc}
+MEOWGEN=${4:-./meowgen}
+BASELINE=${BENCH_BASELINE:-$(dirname "$0")/baseline.txt}
+SHAPES="decls chain nest expr mix"
+
+for tool in "$MEOWC" "$MEOWGEN"; do
+    if [ ! -x "$tool" ]; then
+        echo "No se encontró $tool (¿falta make?)" >&2
+        exit 1
+    fi
+done
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+RESULTS="$TMP/results.txt"
+: > "$RESULTS"
+
+now() { date +%s%N; }
+
+# Valor numérico de un contador del reporte --stats=json
+counter() {
+    sed -n "s/.*\"$1\":\([0-9]*\).*/\1/p" "$2" | head -n 1
+}
+
+echo "Compilación completa, mejor de $RUNS corridas ($LINES líneas por forma)"
+printf "  %-6s %8s %9s %10s %12s %12s %9s\n" \
+       forma líneas tokens "ms" "líneas/s" "tokens/s" "vs base"
+
+for shape in $SHAPES; do
+    SRC="$TMP/$shape.meow"
+    "$MEOWGEN" --shape=$shape --lines=$LINES -o "$SRC"
+
+    # Los contadores salen de una corrida aparte: --stats mide cada token y
+    # encarece el análisis
+    if ! "$MEOWC" --program --no-cache --stats=json -o /dev/null "$SRC" 2> "$TMP/stats.txt"; then
+        echo "meowc falló con $SRC:" >&2
+        head -n 20 "$TMP/stats.txt" >&2
+        exit 1
+    fi
+    lines=$(counter lines "$TMP/stats.txt")
+    tokens=$(counter tokens "$TMP/stats.txt")
+
+    best=
+    for i in $(seq "$RUNS"); do
+        t0=$(now)
+        "$MEOWC" --program --no-cache -o /dev/null "$SRC" 2>/dev/null
+        t1=$(now)
+        dt=$(( (t1 - t0) / 1000 ))   # microsegundos
+        if [ -z "$best" ] || [ "$dt" -lt "$best" ]; then best=$dt; fi
+    done
+
+    base=
+    if [ -f "$BASELINE" ]; then
+        base=$(awk -v s=$shape '$1 == s { print $5 }' "$BASELINE")
+    fi
+    awk -v s=$shape -v l=$lines -v t=$tokens -v us=$best -v base="$base" 'BEGIN {
+        lps = l / (us / 1e6); tps = t / (us / 1e6)
+        vs = base != "" ? sprintf("%+8.1f%%", (tps / base - 1) * 100) : "       -"
+        printf "  %-6s %8d %9d %10.2f %12.0f %12.0f %9s\n", s, l, t, us / 1000, lps, tps, vs
+    }'
+    echo "$shape $lines $tokens $best" >> "$RESULTS"
+done
+
+if [ -n "$BENCH_SAVE" ]; then
+    {
+        echo "# Línea base de make bench (bench/bench.sh $LINES $RUNS)."
+        echo "# Se regenera con make bench-baseline; comparar solo en la misma máquina."
+        echo "# forma líneas tokens líneas/s tokens/s"
+        awk '{ printf "%s %d %d %.0f %.0f\n", $1, $2, $3, $2 / ($4 / 1e6), $3 / ($4 / 1e6) }' "$RESULTS"
+    } > "$BASELINE"
+    echo "Línea base guardada en $BASELINE"
+fi
@@ -0,0 +1,78 @@
+#!/bin/sh
+# bench/depth_bench.sh
+#
+# Anidamiento extremo: compila con meowgen programas de un solo grupo de
+# PROFUNDIDAD niveles (bloques { }, meowl/meoow anidados, paréntesis a la
+# derecha y asignaciones encadenadas) y reporta tiempo de pared y pico de
+# memoria (--stats=json). Corre con la pila de C limitada (ulimit -s) para
+# comprobar que ninguna fase recorre el AST con recursión, y sin límite de
+# la pila del parser (-fparse-depth=0): lo único que acota es la memoria.
+# Al final verifica que un -fparse-depth chico da un error y no un crash.
+#
+# Uso: bench/depth_bench.sh [PROFUNDIDADES] [MEOWC] [MEOWGEN]
+#      (por defecto "100000 1000000", ./meowc, ./meowgen)
+# DEPTH_STACK_KB cambia la pila de C de cada corrida (por defecto 1024).
+
+set -e
+
+DEPTHS=${1:-"100000 1000000"}
+MEOWC=${2:-./meowc}
+MEOWGEN=${3:-./meowgen}
+STACK_KB=${DEPTH_STACK_KB:-1024}
+SHAPES="blocks nest parens assign"
+
+for tool in "$MEOWC" "$MEOWGEN"; do
+    if [ ! -x "$tool" ]; then
+        echo "No se encontró $tool (¿falta make?)" >&2
+        exit 1
+    fi
+done
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+
+now() { date +%s%N; }
+
+# Valor numérico de un contador del reporte --stats=json
+counter() {
+    sed -n "s/.*\"$1\":\([0-9]*\).*/\1/p" "$2" | head -n 1
+}
+
+echo "Anidamiento extremo (--program, optimizando, pila de C de $STACK_KB KB)"
+printf "  %-7s %11s %9s %10s %10s %11s\n" \
+       forma niveles líneas "ms" "pico (MB)" "bytes/nivel"
+
+for depth in $DEPTHS; do
+    for shape in $SHAPES; do
+        SRC="$TMP/$shape.meow"
+        "$MEOWGEN" --shape=$shape --depth=$depth -o "$SRC"
+
+        t0=$(now)
+        if ! (ulimit -s "$STACK_KB" && exec "$MEOWC" --program --no-cache -fparse-depth=0 \
+                  --stats=json -o /dev/null "$SRC") 2> "$TMP/stats.txt"; then
+            echo "meowc falló con $shape a $depth niveles:" >&2
+            grep -v '^{' "$TMP/stats.txt" | head -n 20 >&2
+            exit 1
+        fi
+        t1=$(now)
+
+        lines=$(counter lines "$TMP/stats.txt")
+        rss=$(counter peak_rss_kb "$TMP/stats.txt")
+        awk -v s=$shape -v d=$depth -v l=$lines -v ns=$((t1 - t0)) -v kb=$rss 'BEGIN {
+            printf "  %-7s %11d %9d %10.1f %10.1f %11.0f\n", s, d, l, ns / 1e6, kb / 1024, kb * 1024 / d
+        }'
+    done
+done
+
+# La pila del parser acotada: error sintáctico con código 2, sin crash
+"$MEOWGEN" --shape=blocks --depth=100000 -o "$TMP/bounded.meow"
+set +e
+"$MEOWC" --program --no-cache -fparse-depth=1000 -o /dev/null "$TMP/bounded.meow" 2> "$TMP/bounded.txt"
+rc=$?
+set -e
+if [ $rc -ne 2 ] || ! grep -q "anidamiento demasiado profundo" "$TMP/bounded.txt"; then
+    echo "Con -fparse-depth=1000 se esperaba el error de anidamiento (código 2), salió $rc:" >&2
+    head -n 5 "$TMP/bounded.txt" >&2
+    exit 1
+fi
+echo "  -fparse-depth=1000: $(grep -m 1 "anidamiento" "$TMP/bounded.txt" | sed 's/^[^:]*:[^:]*:[^:]*: //')"
@@ -0,0 +1,60 @@
+#!/bin/sh
+# bench/input_bench.sh
+#
+# Compara las formas de leer el fuente (--input=stream|read|mmap) sobre un
+# programa Meow generado de varios megabytes. Solo se mide el análisis
+# (--syntax-only): lo que cambia entre los modos es cómo llega el texto a flex.
+#
+# Uso: bench/input_bench.sh [MEGABYTES] [REPETICIONES] [MEOWC]
+#      (por defecto 16 MB, 5 repeticiones, ./meowc)
+
+set -e
+
+MB=${1:-16}
+RUNS=${2:-5}
+MEOWC=${3:-./meowc}
+
+if [ ! -x "$MEOWC" ]; then
+    echo "No se encontró $MEOWC (¿falta make?)" >&2
+    exit 1
+fi
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+SRC="$TMP/big.meow"
+
+# Pocas declaraciones y muchas sentencias
+# con comentarios y espacios, que es donde el scanner pasa el tiempo
+awk -v bytes=$((MB * 1024 * 1024)) 'BEGIN {
+    print "meow meow a = 1;"
+    print "meow meow b = 2;"
+    print "meow meow meow f = 0.5;"
+    n = 0
+    while (n < bytes) {
+        line = sprintf("a = a + b * %d;   // paso %d\n", n % 97, n)
+        line = line "/* bloque de comentario\n   de dos líneas */ b = (b - a) / 3;\n"
+        line = line "f = f * 2.25 + a;\n"
+        printf "%s", line
+        n += length(line)
+    }
+}' > "$SRC"
+
+SIZE=$(wc -c < "$SRC")
+LINES=$(wc -l < "$SRC")
+echo "Fuente: $SIZE bytes, $LINES líneas; mejor de $RUNS corridas"
+
+now() { date +%s%N; }
+
+for mode in stream read mmap; do
+    best=
+    for i in $(seq "$RUNS"); do
+        t0=$(now)
+        "$MEOWC" --syntax-only --input=$mode "$SRC" 2>/dev/null
+        t1=$(now)
+        dt=$(( (t1 - t0) / 1000 ))   # microsegundos
+        if [ -z "$best" ] || [ "$dt" -lt "$best" ]; then best=$dt; fi
+    done
+    awk -v m=$mode -v us=$best -v b=$SIZE 'BEGIN {
+        printf "  %-7s %9.2f ms  %8.1f MB/s\n", m, us / 1000, (b / 1048576) / (us / 1e6)
+    }'
+done
@@ -0,0 +1,141 @@
+#!/bin/sh
+# bench/scanner_bench.sh
+#
+# Compara los scanners de meowc: flex (scanner.l), flex con tablas completas
+# (-Cf) y el escrito a mano (fastscan.c, make SCANNER=fast). Cada variante
+# se compila en una copia aparte del árbol.
+#
+# 1) Diferencial: --dump-tokens (ubicación, token, texto y valor) y los errores
+#    léxicos de cada variante deben ser idénticos a los de flex sobre
+#    bench/scanner_cases, los ejemplos del repositorio y programas de
+#    meowgen. fastscan se prueba además con cada variante SIMD
+#    (MEOW_SCAN_SIMD) y leyendo por FILE* (--input=stream).
+# 2) Tiempo: mejor de varias corridas de --syntax-only sobre un programa
+#    generado y sobre uno con muchos comentarios y espacios, con el tiempo
+#    de lex que informa --time-report.
+#
+# Uso: bench/scanner_bench.sh [LÍNEAS] [REPETICIONES]
+#      (por defecto 200000 líneas, 5 repeticiones). CFLAGS cambia las
+#      opciones de compilación (por defecto -O2).
+# Sin flex instalado solo se prueba fastscan (sus variantes SIMD entre sí).
+
+set -e
+
+LINES=${1:-200000}
+RUNS=${2:-5}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_CFLAGS=${CFLAGS:--Wall -O2 -pthread}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+
+# Variantes: nombre, SCANNER y FLEX_FLAGS
+if command -v flex > /dev/null 2>&1; then
+    VARIANTS="flex fast flex-Cf"
+else
+    echo "Advertencia: flex no está instalado; solo se prueba fastscan" >&2
+    VARIANTS="fast"
+fi
+
+build() {
+    dir="$TMP/$1"
+    mkdir -p "$dir"
+    (cd "$ROOT" && cp Makefile *.c *.h *.l *.y "$dir")
+    case $1 in
+        flex)    scanner=flex; flags= ;;
+        flex-Cf) scanner=flex; flags=-Cf ;;
+        fast)    scanner=fast; flags= ;;
+    esac
+    if ! make -s -C "$dir" meowc meowgen SCANNER=$scanner FLEX_FLAGS="$flags" \
+              CFLAGS="$BUILD_CFLAGS" > "$dir/build.log" 2>&1; then
+        echo "No se pudo compilar la variante $1:" >&2
+        tail -n 20 "$dir/build.log" >&2
+        exit 1
+    fi
+}
+
+for v in $VARIANTS; do build "$v"; done
+REF=$(echo $VARIANTS | cut -d' ' -f1)
+MEOWGEN="$TMP/$REF/meowgen"
+
+# ---------------- Diferencial ----------------
+
+CORPUS="$TMP/corpus"
+mkdir -p "$CORPUS"
+cp "$ROOT"/bench/scanner_cases/*.meow "$ROOT"/*.meow "$ROOT"/examples/*.meow "$CORPUS"
+for shape in decls chain nest expr mix; do
+    "$MEOWGEN" --shape=$shape --lines=2000 --seed=7 -o "$CORPUS/gen_$shape.meow"
+done
+
+# Salida de --dump-tokens (stdout y stderr juntos, con la ruta fija).
+# modo: 'default', una variante SIMD de fastscan, o 'stream' (FILE*)
+dump() {
+    meowc=$1; src=$2; mode=$3
+    simd=; input=auto
+    case $mode in
+        default) ;;
+        stream)  input=stream ;;
+        *)       simd=$mode ;;
+    esac
+    (cd "$CORPUS" && MEOW_SCAN_SIMD=$simd "$meowc" --input=$input --dump-tokens \
+         "$(basename "$src")" 2>&1) || true
+}
+
+failures=0
+checked=0
+for src in "$CORPUS"/*.meow; do
+    dump "$TMP/$REF/meowc" "$src" default > "$TMP/ref.txt"
+    for v in $VARIANTS; do
+        modes=default
+        if [ "$v" = fast ]; then modes="scalar sse2 avx2 stream"; fi
+        for mode in $modes; do
+            dump "$TMP/$v/meowc" "$src" $mode > "$TMP/out.txt"
+            checked=$((checked + 1))
+            if ! cmp -s "$TMP/ref.txt" "$TMP/out.txt"; then
+                echo "DIFERENCIA: $v ($mode) en $(basename "$src") contra $REF:"
+                diff "$TMP/ref.txt" "$TMP/out.txt" | head -n 10
+                failures=$((failures + 1))
+            fi
+        done
+    done
+done
+echo "Diferencial: $checked comparaciones contra $REF, $failures con diferencias"
+
+# ---------------- Tiempo ----------------
+
+"$MEOWGEN" --shape=mix --lines=$LINES -o "$TMP/mix.meow"
+# Muchos comentarios y espacios (como bench/input_bench.sh)
+awk -v lines=$LINES 'BEGIN {
+    print "meow meow a = 1;"
+    print "meow meow b = 2;"
+    for (n = 0; n < lines; n += 4) {
+        printf "a = a + b * %d;        // paso %d\n", n % 97, n
+        print "/* bloque de comentario"
+        print "   de dos líneas */      b = (b - a) / 3;"
+        print ""
+    }
+}' > "$TMP/comments.meow"
+
+now() { date +%s%N; }
+
+echo "Análisis (--syntax-only), mejor de $RUNS corridas ($LINES líneas)"
+printf "  %-12s %-8s %10s %10s\n" fuente scanner "total ms" "lex ms"
+for src in mix comments; do
+    for v in $VARIANTS; do
+        meowc="$TMP/$v/meowc"
+        best=
+        for i in $(seq "$RUNS"); do
+            t0=$(now)
+            "$meowc" --syntax-only --no-cache "$TMP/$src.meow" > /dev/null 2>&1
+            t1=$(now)
+            dt=$(( (t1 - t0) / 1000 ))
+            if [ -z "$best" ] || [ "$dt" -lt "$best" ]; then best=$dt; fi
+        done
+        lex=$("$meowc" --syntax-only --no-cache --time-report "$TMP/$src.meow" 2>&1 |
+              awk '$1 == "lex" { print $2 }')
+        awk -v s=$src -v v=$v -v us=$best -v lex="$lex" \
+            'BEGIN { printf "  %-12s %-8s %10.2f %10s\n", s, v, us / 1000, lex }'
+    done
+done
+
+[ "$failures" -eq 0 ]
@@ -0,0 +1,394 @@
+// cache.c
+
+#include "cache.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CACHE_MAGIC "MEOWC\x01\r\n"    // 8 bytes; el \r\n delata transferencias en modo texto
+#define CACHE_STATS_FILE "stats"
+#define CACHE_LOCK_FILE "lock"
+
+/* Cabecera de una entrada (en el orden de bytes de la máquina: el caché es
+   local). Le siguen los diagnósticos y después el código. */
+typedef struct {
+    char magic[8];
+    uint8_t digest[SHA256_DIGEST_SIZE];   // la clave completa, por si el nombre miente
+    uint64_t diag_len;
+    uint64_t code_len;
+} CacheHeader;
+
+typedef struct {
+    char *path;
+    time_t mtime;
+    off_t size;
+} CacheEntry;
+
+static char *join(const char *a, const char *b) {
+    size_t la = strlen(a), lb = strlen(b);
+    char *p = (char *)malloc(la + lb + 2);
+    if (p == NULL) return NULL;
+    memcpy(p, a, la);
+    p[la] = '/';
+    memcpy(p + la + 1, b, lb + 1);
+    return p;
+}
+
+char *cache_default_dir(void) {
+    const char *dir = getenv("MEOW_CACHE_DIR");
+    if (dir != NULL && *dir != '\0') return strdup(dir);
+
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    if (xdg != NULL && *xdg != '\0') return join(xdg, "meowc");
+
+    const char *home = getenv("HOME");
+    if (home == NULL || *home == '\0') return NULL;
+    char *base = join(home, ".cache");
+    char *path = base ? join(base, "meowc") : NULL;
+    free(base);
+    return path;
+}
+
+// mkdir -p
+static int make_dirs(const char *dir) {
+    char *p = strdup(dir);
+    if (p == NULL) return -1;
+    for (char *s = p + 1; ; ++s) {
+        if (*s == '/' || *s == '\0') {
+            char c = *s;
+            *s = '\0';
+            if (mkdir(p, 0777) != 0 && errno != EEXIST) {
+                free(p);
+                return -1;
+            }
+            *s = c;
+            if (c == '\0') break;
+        }
+    }
+    free(p);
+    return 0;
+}
+
+int cache_open(MeowCache *c, const char *dir, size_t max_bytes) {
+    memset(c, 0, sizeof(*c));
+    if (make_dirs(dir) != 0) return -1;
+    if (access(dir, R_OK | W_OK | X_OK) != 0) return -1;
+
+    c->dir = strdup(dir);
+    if (c->dir == NULL) return -1;
+    c->max_bytes = max_bytes;
+    pthread_mutex_init(&c->lock, NULL);
+    return 0;
+}
+
+static void hash_field(Sha256 *h, const char *s) {
+    // Cada campo termina en '\0': "ab" + "c" no choca con "a" + "bc"
+    sha256_update(h, s, strlen(s) + 1);
+}
+
+void cache_key(CacheKey *key, const char *options, const char *path,
+               const char *message, const void *source, size_t len) {
+    static const char hexdigits[] = "0123456789abcdef";
+    Sha256 h;
+    uint64_t n = len;
+
+    sha256_init(&h);
+    hash_field(&h, MEOWC_VERSION);
+    hash_field(&h, options);
+    hash_field(&h, path);
+    hash_field(&h, message != NULL ? "letrero" : "programa");
+    if (message != NULL) hash_field(&h, message);
+    sha256_update(&h, &n, sizeof(n));
+    sha256_update(&h, source, len);
+    sha256_final(&h, key->digest);
+
+    for (int i = 0; i < SHA256_DIGEST_SIZE; ++i) {
+        key->hex[2 * i] = hexdigits[key->digest[i] >> 4];
+        key->hex[2 * i + 1] = hexdigits[key->digest[i] & 15];
+    }
+    key->hex[2 * SHA256_DIGEST_SIZE] = '\0';
+}
+
+// DIR/ab/cdef...
+static char *entry_path(const MeowCache *c, const CacheKey *key) {
+    size_t len = strlen(c->dir);
+    char *p = (char *)malloc(len + 2 * SHA256_DIGEST_SIZE + 3);
+    if (p == NULL) return NULL;
+    sprintf(p, "%s/%.2s/%s", c->dir, key->hex, key->hex + 2);
+    return p;
+}
+
+static void count(MeowCache *c, long *counter) {
+    pthread_mutex_lock(&c->lock);
+    (*counter)++;
+    pthread_mutex_unlock(&c->lock);
+}
+
+static int read_all(int fd, void *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = read(fd, (char *)buf + done, len - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        done += (size_t)n;
+    }
+    return 0;
+}
+
+static int write_all(int fd, const void *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = write(fd, (const char *)buf + done, len - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        done += (size_t)n;
+    }
+    return 0;
+}
+
+int cache_lookup(MeowCache *c, const CacheKey *key, Emitter *out,
+                 char **diag, size_t *diag_len) {
+    char *path = entry_path(c, key);
+    int fd = path ? open(path, O_RDONLY) : -1;
+    free(path);
+
+    CacheHeader hdr;
+    struct stat st;
+    int hit = fd >= 0 && fstat(fd, &st) == 0 &&
+              read_all(fd, &hdr, sizeof(hdr)) == 0 &&
+              memcmp(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic)) == 0 &&
+              memcmp(hdr.digest, key->digest, sizeof(hdr.digest)) == 0 &&
+              (uint64_t)st.st_size == sizeof(hdr) + hdr.diag_len + hdr.code_len;
+
+    char *text = NULL;
+    if (hit) {
+        text = (char *)malloc(hdr.diag_len + 1);
+        emitter_reserve(out, hdr.code_len);
+        hit = text != NULL &&
+              read_all(fd, text, hdr.diag_len) == 0 &&
+              read_all(fd, out->buf + out->len, hdr.code_len) == 0;
+    }
+    if (hit) {
+        out->len += hdr.code_len;
+        text[hdr.diag_len] = '\0';
+        *diag = text;
+        *diag_len = hdr.diag_len;
+        futimens(fd, NULL);   // recién usada: la última en desalojarse
+    } else {
+        free(text);
+    }
+    if (fd >= 0) close(fd);
+
+    count(c, hit ? &c->run.hits : &c->run.misses);
+    return hit;
+}
+
+void cache_store(MeowCache *c, const CacheKey *key, const char *code, size_t code_len,
+                 const char *diag, size_t diag_len) {
+    char *path = entry_path(c, key);
+    if (path == NULL) return;
+
+    // El subdirectorio se crea la primera vez que se usa
+    size_t dir_len = strlen(c->dir) + 3;
+    path[dir_len] = '\0';
+    mkdir(path, 0777);
+    path[dir_len] = '/';
+
+    char *tmp = (char *)malloc(strlen(path) + 64);
+    if (tmp == NULL) {
+        free(path);
+        return;
+    }
+    static _Atomic unsigned long serial;
+    sprintf(tmp, "%.*s.tmp-%ld-%lu", (int)dir_len + 1, path, (long)getpid(), ++serial);
+
+    CacheHeader hdr;
+    memcpy(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic));
+    memcpy(hdr.digest, key->digest, sizeof(hdr.digest));
+    hdr.diag_len = diag_len;
+    hdr.code_len = code_len;
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL, 0666);
+    int ok = fd >= 0 &&
+             write_all(fd, &hdr, sizeof(hdr)) == 0 &&
+             write_all(fd, diag, diag_len) == 0 &&
+             write_all(fd, code, code_len) == 0;
+    if (fd >= 0 && close(fd) != 0) ok = 0;
+    // rename es atómico: quien lea ve la entrada completa o ninguna
+    if (ok && rename(tmp, path) == 0) {
+        count(c, &c->run.stores);
+    } else if (fd >= 0) {
+        unlink(tmp);
+    }
+    free(tmp);
+    free(path);
+}
+
+/* ---------- Contadores acumulados y desalojo (con el directorio bloqueado) ---------- */
+
+static void read_counters(const char *path, CacheCounters *total) {
+    memset(total, 0, sizeof(*total));
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return;
+    if (fscanf(f, "hits %ld misses %ld stores %ld evictions %ld bytes_evicted %lld",
+               &total->hits, &total->misses, &total->stores, &total->evictions,
+               &total->bytes_evicted) != 5) {
+        memset(total, 0, sizeof(*total));   // archivo dañado: se empieza de nuevo
+    }
+    fclose(f);
+}
+
+static void write_counters(const char *path, const CacheCounters *total) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return;
+    fprintf(f, "hits %ld\nmisses %ld\nstores %ld\nevictions %ld\nbytes_evicted %lld\n",
+            total->hits, total->misses, total->stores, total->evictions, total->bytes_evicted);
+    fclose(f);
+}
+
+static int by_mtime(const void *a, const void *b) {
+    const CacheEntry *x = (const CacheEntry *)a, *y = (const CacheEntry *)b;
+    return (x->mtime > y->mtime) - (x->mtime < y->mtime);
+}
+
+static int is_hex2(const char *name) {
+    return strlen(name) == 2 && strspn(name, "0123456789abcdef") == 2;
+}
+
+/* Recorre DIR/ab/ y junta las entradas. Los temporales de más de una hora
+   (de un proceso que murió a mitad de escritura) se borran de paso. */
+static size_t list_entries(const char *dir, CacheEntry **entries, size_t *count_out,
+                           uint64_t *total_bytes) {
+    size_t n = 0, cap = 0;
+    *entries = NULL;
+    *total_bytes = 0;
+
+    DIR *top = opendir(dir);
+    if (top == NULL) {
+        *count_out = 0;
+        return 0;
+    }
+    time_t now = time(NULL);
+    struct dirent *d;
+    while ((d = readdir(top)) != NULL) {
+        if (!is_hex2(d->d_name)) continue;
+        char *sub = join(dir, d->d_name);
+        DIR *inner = sub ? opendir(sub) : NULL;
+        struct dirent *e;
+        while (inner != NULL && (e = readdir(inner)) != NULL) {
+            if (e->d_name[0] == '.' && (e->d_name[1] == '\0' || e->d_name[1] == '.')) continue;
+            char *path = join(sub, e->d_name);
+            struct stat st;
+            if (path == NULL || stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+                free(path);
+                continue;
+            }
+            if (e->d_name[0] == '.') {
+                if (now - st.st_mtime > 3600) unlink(path);
+                free(path);
+                continue;
+            }
+            if (n == cap) {
+                cap = cap ? cap * 2 : 256;
+                CacheEntry *bigger = (CacheEntry *)realloc(*entries, cap * sizeof(CacheEntry));
+                if (bigger == NULL) {
+                    free(path);
+                    break;
+                }
+                *entries = bigger;
+            }
+            (*entries)[n].path = path;
+            (*entries)[n].mtime = st.st_mtime;
+            (*entries)[n].size = st.st_size;
+            *total_bytes += (uint64_t)st.st_size;
+            n++;
+        }
+        if (inner != NULL) closedir(inner);
+        free(sub);
+    }
+    closedir(top);
+    *count_out = n;
+    return n;
+}
+
+// Borra las entradas menos usadas hasta quedar en el 90% del máximo
+static void evict(MeowCache *c, CacheEntry *entries, size_t n, uint64_t *total_bytes) {
+    if (*total_bytes <= c->max_bytes) return;
+    uint64_t target = (uint64_t)c->max_bytes / 10 * 9;
+
+    qsort(entries, n, sizeof(CacheEntry), by_mtime);
+    for (size_t i = 0; i < n && *total_bytes > target; ++i) {
+        if (unlink(entries[i].path) != 0) continue;
+        *total_bytes -= (uint64_t)entries[i].size;
+        c->run.evictions++;
+        c->run.bytes_evicted += entries[i].size;
+    }
+}
+
+static double percent(long part, long whole) {
+    return whole ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+void cache_close(MeowCache *c, FILE *report) {
+    if (c->dir == NULL) return;
+
+    char *lock_path = join(c->dir, CACHE_LOCK_FILE);
+    char *stats_path = join(c->dir, CACHE_STATS_FILE);
+    int lock_fd = lock_path ? open(lock_path, O_RDWR | O_CREAT, 0666) : -1;
+    if (lock_fd >= 0) flock(lock_fd, LOCK_EX);
+
+    // El directorio solo se recorre si esta ejecución escribió algo o se pidió
+    // el reporte
+    CacheEntry *entries = NULL;
+    size_t n = 0;
+    uint64_t bytes = 0;
+    if (c->run.stores > 0 || report != NULL) {
+        list_entries(c->dir, &entries, &n, &bytes);
+        evict(c, entries, n, &bytes);
+    }
+
+    CacheCounters total;
+    if (stats_path != NULL) {
+        read_counters(stats_path, &total);
+        total.hits += c->run.hits;
+        total.misses += c->run.misses;
+        total.stores += c->run.stores;
+        total.evictions += c->run.evictions;
+        total.bytes_evicted += c->run.bytes_evicted;
+        write_counters(stats_path, &total);
+    }
+
+    if (lock_fd >= 0) {
+        flock(lock_fd, LOCK_UN);
+        close(lock_fd);
+    }
+
+    if (report != NULL) {
+        size_t live = n - (size_t)c->run.evictions;
+        fprintf(report, "Caché %s: %zu entradas, %.1f KB de %.1f KB\n", c->dir, live,
+                (double)bytes / 1024.0, (double)c->max_bytes / 1024.0);
+        if (stats_path != NULL) {
+            fprintf(report, "  acumulado: %ld aciertos, %ld fallos (%.1f%% de aciertos), "
+                            "%ld guardadas, %ld desalojadas (%.1f KB)\n",
+                    total.hits, total.misses, percent(total.hits, total.hits + total.misses),
+                    total.stores, total.evictions, (double)total.bytes_evicted / 1024.0);
+        }
+        fprintf(report, "  esta ejecución: %ld aciertos, %ld fallos, %ld guardadas, "
+                        "%ld desalojadas\n",
+                c->run.hits, c->run.misses, c->run.stores, c->run.evictions);
+    }
+
+    for (size_t i = 0; i < n; ++i) free(entries[i].path);
+    free(entries);
+    free(lock_path);
+    free(stats_path);
+    pthread_mutex_destroy(&c->lock);
+    free(c->dir);
+    c->dir = NULL;
+}
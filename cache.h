@@ -0,0 +1,99 @@
+// cache.h
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "emitter.h"
+#include "sha256.h"
+
+/*
+ * Caché de compilación en disco, direccionado por contenido.
+ *
+ * La clave es el SHA-256 de la versión del compilador, las opciones que
+ * cambian la salida, la ruta del fuente (aparece en los mensajes), el
+ * mensaje del letrero (o el modo --program) y los bytes del fuente. Cada
+ * entrada guarda el código generado y los diagnósticos de esa compilación,
+ * así que un acierto reproduce la corrida sin analizar el fuente.
+ *
+ * Las entradas viven en DIR/ab/cdef... (los dos primeros dígitos de la clave
+ * hacen de subdirectorio) y se escriben en un temporal que después se
+ * renombra: varios procesos o hilos pueden usar el mismo directorio a la
+ * vez. Al usar una entrada se actualiza su fecha de modificación; cuando el
+ * directorio pasa del tamaño máximo se borran las menos usadas
+ * recientemente. Todo es local: no hay red de por medio.
+ */
+
+// Sube con cada cambio del compilador que altere la salida o los mensajes
+#define MEOWC_VERSION "meowc 1.14"
+
+#define CACHE_DEFAULT_MAX_MB 64
+
+typedef struct {
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    char hex[2 * SHA256_DIGEST_SIZE + 1];
+} CacheKey;
+
+typedef struct {
+    long hits;
+    long misses;
+    long stores;
+    long evictions;
+    long long bytes_evicted;
+} CacheCounters;
+
+typedef struct MeowCache {
+    char *dir;
+    size_t max_bytes;
+    pthread_mutex_t lock;     // protege 'run' (meowc -j)
+    CacheCounters run;        // contadores de esta ejecución
+} MeowCache;
+
+/**
+ * @brief Directorio por defecto: $MEOW_CACHE_DIR, si no
+ *        $XDG_CACHE_HOME/meowc, si no $HOME/.cache/meowc.
+ * @return char* Ruta reservada con malloc, o NULL si no hay ninguna.
+ */
+char *cache_default_dir(void);
+
+/**
+ * @brief Prepara el caché en 'dir' (lo crea si hace falta).
+ * @return int 0 si se puede usar, -1 si no (errno queda puesto).
+ */
+int cache_open(MeowCache *c, const char *dir, size_t max_bytes);
+
+/**
+ * @brief Calcula la clave de una compilación.
+ * @param options Texto con las opciones que cambian la salida.
+ * @param message Mensaje del letrero, o NULL en modo --program.
+ */
+void cache_key(CacheKey *key, const char *options, const char *path,
+               const char *message, const void *source, size_t len);
+
+/**
+ * @brief Busca la entrada de 'key'. Si está, agrega el código a 'out' y deja
+ *        los diagnósticos en '*diag' (reservados con malloc).
+ * @return int 1 si hubo acierto, 0 si no.
+ */
+int cache_lookup(MeowCache *c, const CacheKey *key, Emitter *out,
+                 char **diag, size_t *diag_len);
+
+/**
+ * @brief Guarda una compilación exitosa. Los errores de escritura se ignoran
+ *        (el caché solo acelera).
+ */
+void cache_store(MeowCache *c, const CacheKey *key, const char *code, size_t code_len,
+                 const char *diag, size_t diag_len);
+
+/**
+ * @brief Suma los contadores de esta ejecución a los del directorio, desaloja
+ *        entradas si se pasó del tamaño máximo y libera el caché.
+ * @param report Si no es NULL, escribe ahí el reporte de --cache-stats:
+ *        entradas, tamaño y contadores acumulados y de esta ejecución.
+ */
+void cache_close(MeowCache *c, FILE *report);
+
+#endif // CACHE_H
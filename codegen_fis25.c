@@ -1,14 +1,62 @@
 // codegen_fis25.c
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "codegen_fis25.h"
 #include "ast.h"
+#include "ast_opt.h"
+#include "fis25.h"
+#include "fis25_alloc.h"
+#include "fis25bin.h"
+#include "fis25_cost.h"
+#include "fis25_loop.h"
+#include "fis25_opt.h"
+#include "intern.h"
+#include "ir.h"
+
+/*
+ * Las instrucciones se construyen en un Fis25Program en memoria; al final
+ * pasan por el optimizador de mirilla (si está activo) y se imprimen.
+ *
+ * El estado de la traducción en curso es propio de cada hilo: con -j varias
+ * llamadas a codegen_fis25 corren a la vez, cada una con su contexto.
+ */
+
+static _Thread_local Fis25Program *prog;
+static _Thread_local const ASTStore *ast;   // AST del contexto que se traduce
+static _Thread_local Diagnostics *diags;    // diagnósticos del contexto
+
+static Fis25Operand var(const char *name)  { return fis_var(fis25_var(prog, name, NULL)); }
+static Fis25Operand lbl(const char *name)  { return fis_lbl(fis25_label(prog, name)); }
+static Fis25Operand imm(int v)             { return fis_imm(v); }
+
+static void declare(const char *name, const char *comment)
+{
+    fis25_var(prog, name, comment);
+}
+
+static void emit_c(Fis25Op op, Fis25Operand a, Fis25Operand b, Fis25Operand c,
+                   const char *comment)
+{
+    fis25_emit(prog, op, a, b, c, comment);
+}
+
+static void emit(Fis25Op op, Fis25Operand a, Fis25Operand b, Fis25Operand c)
+{
+    fis25_emit(prog, op, a, b, c, NULL);
+}
+
+static void assign(Fis25Operand src, Fis25Operand dst) { emit(FIS_ASSIGN, src, fis_none(), dst); }
+static void if_goto(Fis25Operand cond, Fis25Operand l)  { emit(FIS_IF, cond, fis_none(), l); }
+static void go(Fis25Operand l)                          { emit(FIS_GOTO, fis_none(), fis_none(), l); }
+static void label(Fis25Operand l)                       { emit(FIS_LABEL, fis_none(), fis_none(), l); }
+static void note(const char *text)                      { fis25_note(prog, text ? intern(text) : NULL); }
 
 /*
  * Generador de código FIS-25 para la Opción C: Letrero Dinámico (Marquee).
  *
- * - El mensaje ya viene filtrado desde main.c (solo 0–9, '.', '$').
+ * - El mensaje ya viene filtrado (codegen_marquee_message: solo 0–9, '.', '$').
  * - Se dibuja una “barra” de píxeles: un píxel por carácter,
  *   separado por 1 columna, para visualizar el desplazamiento.
  * - Control manual: el texto SOLO se mueve cuando el usuario
@@ -21,9 +69,57 @@
  *   KEY 7 -> D  (mover a la derecha)
  */
 
-void codegen_fis25(ASTStmt *root, const char *msg)
+/*
+ * Tira de píxeles del letrero: PIXEL (base + IDX*spacing, y, color) para
+ * IDX = 0..TEXT_LEN-1; al terminar sigue en la etiqueta 'done'.
+ */
+static void marquee_strip(Fis25Operand base, Fis25Operand color, const char *loop,
+                          const char *step, const char *done, int spacing)
+{
+    assign(imm(0), var("IDX"));
+    label(lbl(loop));
+    emit(FIS_LT, var("IDX"), var("TEXT_LEN"), var("COND"));
+    if_goto(var("COND"), lbl(step));
+    go(lbl(done));
+    note(NULL);
+
+    label(lbl(step));
+    emit(FIS_MUL, var("IDX"), imm(spacing), var("TMP"));    /* TMP = IDX * spacing           */
+    emit(FIS_ADD, base, var("TMP"), var("PIX_X"));         /* PIX_X = base + IDX*spacing    */
+    emit(FIS_PIXEL, var("PIX_X"), var("y"), color);
+    emit(FIS_ADD, var("IDX"), var("ONE"), var("IDX"));
+    go(lbl(loop));
+    note(NULL);
+
+    label(lbl(done));
+}
+
+void codegen_marquee_message(const char *raw, char *msg, size_t msg_size, FILE *warn)
+{
+    size_t j = 0;
+
+    for (size_t i = 0; raw[i] != '\0' && j < msg_size - 1; ++i) {
+        char c = raw[i];
+        if (c == '\n' || c == '\r')
+            continue;
+
+        if ((c >= '0' && c <= '9') || c == '.' || c == '$') {
+            msg[j++] = c;
+        } else if (warn) {
+            fprintf(warn, "Advertencia: ignorando caracter no permitido '%c'\n", c);
+        }
+    }
+    msg[j] = '\0';
+
+    if (j == 0) {
+        if (warn) fprintf(warn, "Mensaje vacío tras filtrado. Usando mensaje por defecto '0'.\n");
+        strcpy(msg, "0");
+    }
+}
+
+static void codegen_marquee(const char *msg, MarqueeRedraw redraw)
 {
-    (void)root;  /* por ahora no usamos el AST */
+    char text[160];
 
     if (!msg || msg[0] == '\0') {
         msg = "0";
@@ -38,132 +134,414 @@ void codegen_fis25(ASTStmt *root, const char *msg)
     int max_x = 63;               /* pantalla 0..63 */
 
     /* ================= CABECERA ================= */
-    printf("// Opción C: Letrero Dinámico (Marquee)\n");
-    printf("// Mensaje: \"%s\"\n", msg);
-    printf("// Cada carácter ocupa 1 píxel + 1 espacio -> ancho total = %d\n",
-           total_width);
-    printf("// Controles: A = izquierda (KEY 6), D = derecha (KEY 7)\n\n");
+    note("Opción C: Letrero Dinámico (Marquee)");
+    snprintf(text, sizeof(text), "Mensaje: \"%s\"", msg);
+    note(text);
+    snprintf(text, sizeof(text),
+             "Cada carácter ocupa 1 píxel + 1 espacio -> ancho total = %d", total_width);
+    note(text);
+    note("Controles: A = izquierda (KEY 6), D = derecha (KEY 7)");
+    note(NULL);
 
     /* ================= VARIABLES ================= */
-    printf("VAR x            // offset horizontal del letrero\n");
-    printf("VAR y            // fila en la pantalla\n");
-    printf("VAR color        // color del letrero (1 = encendido)\n");
-
-    printf("VAR left_now     // estado actual tecla A (KEY 6)\n");
-    printf("VAR right_now    // estado actual tecla D (KEY 7)\n");
-    printf("VAR left_prev    // estado previo tecla A\n");
-    printf("VAR right_prev   // estado previo tecla D\n");
-
-    printf("VAR ONE          // constante 1\n");
-    printf("VAR STEP         // paso en columnas por movimiento\n");
-    printf("VAR MIN_X        // límite izquierdo\n");
-    printf("VAR MAX_X        // límite derecho\n");
-    printf("VAR TMP          // temporal\n");
-    printf("VAR COND         // resultado de comparaciones\n");
-    printf("VAR CLR_X        // para limpiar la fila\n");
-    printf("VAR IDX          // índice del carácter\n");
-    printf("VAR PIX_X        // columna actual de pixel a dibujar\n");
-    printf("VAR TEXT_LEN     // longitud del mensaje\n\n");
+    prog->var_decl_pos = prog->len;
+    declare("x",          "offset horizontal del letrero");
+    declare("y",          "fila en la pantalla");
+    declare("color",      "color del letrero (1 = encendido)");
+
+    declare("left_now",   "estado actual tecla A (KEY 6)");
+    declare("right_now",  "estado actual tecla D (KEY 7)");
+    declare("left_prev",  "estado previo tecla A");
+    declare("right_prev", "estado previo tecla D");
+
+    declare("ONE",        "constante 1");
+    declare("STEP",       "paso en columnas por movimiento");
+    declare("MIN_X",      "límite izquierdo");
+    declare("MAX_X",      "límite derecho");
+    declare("TMP",        "temporal");
+    declare("COND",       "resultado de comparaciones");
+    if (redraw == MARQUEE_REDRAW_FULL) {
+        declare("CLR_X",  "para limpiar la fila");
+    }
+    declare("IDX",        "índice del carácter");
+    declare("PIX_X",      "columna actual de pixel a dibujar");
+    declare("TEXT_LEN",   "longitud del mensaje");
+    if (redraw == MARQUEE_REDRAW_INCREMENTAL) {
+        declare("PREV_X", "offset dibujado en pantalla");
+    }
+    note(NULL);
 
     /* ================= INICIALIZACIÓN ================= */
-    printf("// Posición inicial del letrero\n");
-    printf("ASSIGN 20 x\n");
-    printf("ASSIGN 30 y\n");
-    printf("ASSIGN 1 color\n");
-
-    printf("// Estados iniciales del teclado\n");
-    printf("ASSIGN 0 left_now\n");
-    printf("ASSIGN 0 right_now\n");
-    printf("ASSIGN 0 left_prev\n");
-    printf("ASSIGN 0 right_prev\n");
-
-    printf("ASSIGN 1 ONE\n");
-    printf("ASSIGN 1 STEP\n");          /* 1 columna por pulsación (cambio pequeño y visible) */
-    printf("ASSIGN %d MIN_X\n", min_x);
-    printf("ASSIGN %d MAX_X\n", max_x);
-    printf("ASSIGN %zu TEXT_LEN\n", len);
-    printf("\n");
+    note("Posición inicial del letrero");
+    assign(imm(20), var("x"));
+    assign(imm(30), var("y"));
+    assign(imm(1), var("color"));
+
+    note("Estados iniciales del teclado");
+    assign(imm(0), var("left_now"));
+    assign(imm(0), var("right_now"));
+    assign(imm(0), var("left_prev"));
+    assign(imm(0), var("right_prev"));
+
+    assign(imm(1), var("ONE"));
+    assign(imm(1), var("STEP"));          /* 1 columna por pulsación (cambio pequeño y visible) */
+    assign(imm(min_x), var("MIN_X"));
+    assign(imm(max_x), var("MAX_X"));
+    assign(imm((int)len), var("TEXT_LEN"));
+    if (redraw == MARQUEE_REDRAW_INCREMENTAL) {
+        /* Fuera de pantalla: fuerza el primer dibujo y su borrado no se ve */
+        assign(imm(max_x + 1), var("PREV_X"));
+    }
+    note(NULL);
 
     /* ================= BUCLE PRINCIPAL ================= */
-    printf("LABEL MAIN_LOOP\n");
-
-    /* ---- Limpiar la fila antes de dibujar ---- */
-    printf("    ASSIGN 0 CLR_X\n");
-    printf("LABEL CLEAR_ROW\n");
-    printf("    PIXEL CLR_X y 0\n");        /* apaga (CLR_X, y)             */
-    printf("    ADD CLR_X ONE CLR_X\n");
-    printf("    LT CLR_X 64 COND\n");
-    printf("    IF COND GOTO CLEAR_ROW\n\n");
-
-    /* ---- Dibujar el mensaje como una tira de píxeles ---- */
-    printf("    ASSIGN 0 IDX\n");
-    printf("LABEL DRAW_LOOP\n");
-    printf("    LT IDX TEXT_LEN COND\n");
-    printf("    IF COND GOTO DRAW_STEP\n");
-    printf("    GOTO AFTER_DRAW\n\n");
-
-    printf("LABEL DRAW_STEP\n");
-    printf("    MUL IDX %d TMP\n", CHAR_SPACING); /* TMP = IDX * CHAR_SPACING      */
-    printf("    ADD x TMP PIX_X\n");              /* PIX_X = x + IDX*CHAR_SPACING  */
-    printf("    PIXEL PIX_X y color\n");          /* enciende píxel                */
-    printf("    ADD IDX ONE IDX\n");
-    printf("    GOTO DRAW_LOOP\n\n");
-
-    printf("LABEL AFTER_DRAW\n\n");
+    label(lbl("MAIN_LOOP"));
+
+    if (redraw == MARQUEE_REDRAW_INCREMENTAL) {
+        /* ---- Redibujar solo si cambió el offset ---- */
+        emit(FIS_EQ, var("x"), var("PREV_X"), var("COND"));
+        if_goto(var("COND"), lbl("AFTER_DRAW"));
+        note(NULL);
+
+        /* Apagar solo los píxeles encendidos en el offset anterior */
+        marquee_strip(var("PREV_X"), imm(0), "ERASE_LOOP", "ERASE_STEP", "REDRAW", CHAR_SPACING);
+        marquee_strip(var("x"), var("color"), "DRAW_LOOP", "DRAW_STEP", "DRAW_DONE", CHAR_SPACING);
+        assign(var("x"), var("PREV_X"));
+        note(NULL);
+
+        label(lbl("AFTER_DRAW"));
+        note(NULL);
+    } else {
+        /* ---- Limpiar la fila antes de dibujar ---- */
+        assign(imm(0), var("CLR_X"));
+        label(lbl("CLEAR_ROW"));
+        emit(FIS_PIXEL, var("CLR_X"), var("y"), imm(0));        /* apaga (CLR_X, y)             */
+        emit(FIS_ADD, var("CLR_X"), var("ONE"), var("CLR_X"));
+        emit(FIS_LT, var("CLR_X"), imm(64), var("COND"));
+        if_goto(var("COND"), lbl("CLEAR_ROW"));
+        note(NULL);
+
+        /* ---- Dibujar el mensaje como una tira de píxeles ---- */
+        marquee_strip(var("x"), var("color"), "DRAW_LOOP", "DRAW_STEP", "AFTER_DRAW", CHAR_SPACING);
+        note(NULL);
+    }
 
     /* ---- Leer teclas A (6) y D (7) ---- */
-    printf("    KEY 6 left_now    // A -> izquierda\n");
-    printf("    KEY 7 right_now   // D -> derecha\n\n");
+    emit_c(FIS_KEY, imm(6), fis_none(), var("left_now"), "A -> izquierda");
+    emit_c(FIS_KEY, imm(7), fis_none(), var("right_now"), "D -> derecha");
+    note(NULL);
 
     /* ========= DETECCIÓN DE FLANCOS (0 -> 1) ========= */
     /* Queremos UN paso por pulsación, no por iteración. */
 
     /* Flanco de PRESIONAR A: left_prev == 0 && left_now == 1 */
-    printf("    EQ left_prev 0 TMP\n");
-    printf("    IF TMP GOTO A_PREV_ZERO\n");
-    printf("    GOTO CHECK_RIGHT\n\n");
+    emit(FIS_EQ, var("left_prev"), imm(0), var("TMP"));
+    if_goto(var("TMP"), lbl("A_PREV_ZERO"));
+    go(lbl("CHECK_RIGHT"));
+    note(NULL);
 
-    printf("LABEL A_PREV_ZERO\n");
-    printf("    EQ left_now 1 TMP\n");
-    printf("    IF TMP GOTO MOVE_LEFT\n");
-    printf("    GOTO CHECK_RIGHT\n\n");
+    label(lbl("A_PREV_ZERO"));
+    emit(FIS_EQ, var("left_now"), imm(1), var("TMP"));
+    if_goto(var("TMP"), lbl("MOVE_LEFT"));
+    go(lbl("CHECK_RIGHT"));
+    note(NULL);
 
     /* Flanco de PRESIONAR D: right_prev == 0 && right_now == 1 */
-    printf("LABEL CHECK_RIGHT\n");
-    printf("    EQ right_prev 0 TMP\n");
-    printf("    IF TMP GOTO D_PREV_ZERO\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("CHECK_RIGHT"));
+    emit(FIS_EQ, var("right_prev"), imm(0), var("TMP"));
+    if_goto(var("TMP"), lbl("D_PREV_ZERO"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
-    printf("LABEL D_PREV_ZERO\n");
-    printf("    EQ right_now 1 TMP\n");
-    printf("    IF TMP GOTO MOVE_RIGHT\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("D_PREV_ZERO"));
+    emit(FIS_EQ, var("right_now"), imm(1), var("TMP"));
+    if_goto(var("TMP"), lbl("MOVE_RIGHT"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
     /* ================= MOVIMIENTO IZQUIERDA ================= */
-    printf("LABEL MOVE_LEFT\n");
-    printf("    SUB x STEP x\n");           /* x = x - STEP                      */
-    printf("    LT x MIN_X COND\n");
-    printf("    IF COND GOTO CLAMP_LEFT\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("MOVE_LEFT"));
+    emit(FIS_SUB, var("x"), var("STEP"), var("x"));           /* x = x - STEP                      */
+    emit(FIS_LT, var("x"), var("MIN_X"), var("COND"));
+    if_goto(var("COND"), lbl("CLAMP_LEFT"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
-    printf("LABEL CLAMP_LEFT\n");
-    printf("    ASSIGN MIN_X x\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("CLAMP_LEFT"));
+    assign(var("MIN_X"), var("x"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
     /* ================= MOVIMIENTO DERECHA ================= */
-    printf("LABEL MOVE_RIGHT\n");
-    printf("    ADD x STEP x\n");           /* x = x + STEP                      */
-    printf("    GT x MAX_X COND\n");
-    printf("    IF COND GOTO CLAMP_RIGHT\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("MOVE_RIGHT"));
+    emit(FIS_ADD, var("x"), var("STEP"), var("x"));           /* x = x + STEP                      */
+    emit(FIS_GT, var("x"), var("MAX_X"), var("COND"));
+    if_goto(var("COND"), lbl("CLAMP_RIGHT"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
-    printf("LABEL CLAMP_RIGHT\n");
-    printf("    ASSIGN MAX_X x\n");
-    printf("    GOTO END_KEYS\n\n");
+    label(lbl("CLAMP_RIGHT"));
+    assign(var("MAX_X"), var("x"));
+    go(lbl("END_KEYS"));
+    note(NULL);
 
     /* ========= ACTUALIZAR ESTADO PREVIO Y REPETIR ========= */
-    printf("LABEL END_KEYS\n");
-    printf("    ASSIGN left_now  left_prev\n");
-    printf("    ASSIGN right_now right_prev\n");
-    printf("    GOTO MAIN_LOOP\n\n");
+    label(lbl("END_KEYS"));
+    assign(var("left_now"), var("left_prev"));
+    assign(var("right_now"), var("right_prev"));
+    go(lbl("MAIN_LOOP"));
+    note(NULL);
+}
+
+/* =====================================================================
+ *  Traducción del programa del usuario (AST -> IR -> FIS-25)
+ *
+ *  ir_build arma el grafo de bloques (ir.h) y aquí se selecciona: cada
+ *  instrucción de la IR es una de FIS-25, cada bloque con nombre es un
+ *  LABEL y los saltos al bloque siguiente se omiten.
+ *
+ *  - Cada declaración escalar produce un VAR con su nombre único y cada
+ *    arreglo un VAR por elemento (nombre$eK).
+ *  - Las expresiones se evalúan en temporales $tN que se reutilizan
+ *    entre sentencias (disciplina de pila).
+ * ===================================================================== */
+
+/* Construye y verifica la IR de ctx->root (ya optimizado si corresponde) */
+static int build_ir(IrProgram *ir, ASTStmtId root)
+{
+    int errors = ir_build(ir, ast, root, diags);
+    if (errors == 0) errors = ir_verify(ir, diags);
+    return errors;
+}
+
+static Fis25Operand select_value(const IrProgram *ir, IrValue v)
+{
+    switch ((IrValueKind)v.kind) {
+        case IR_CONST: return imm(v.val);
+        case IR_SYM:   return var(ir->syms[v.val].name);
+        case IR_STR:   return fis_str(fis25_string(prog, ir->strings[v.val]));
+        case IR_NONE:  break;
+    }
+    return fis_none();
+}
+
+static Fis25Operand block_label(const IrProgram *ir, uint32_t b)
+{
+    if (ir->blocks[b].label) return lbl(ir->blocks[b].label);
+    char buf[32];
+    snprintf(buf, sizeof(buf), "BLOCK_%u", (unsigned)b);
+    return lbl(buf);
+}
+
+static void select_program(const IrProgram *ir)
+{
+    static const Fis25Op ops[IR_NUM_OPS] = {
+        [IR_COPY] = FIS_ASSIGN, [IR_ADD] = FIS_ADD, [IR_SUB] = FIS_SUB,
+        [IR_MUL] = FIS_MUL, [IR_DIV] = FIS_DIV, [IR_LT] = FIS_LT,
+        [IR_GT] = FIS_GT, [IR_EQ] = FIS_EQ, [IR_PIXEL] = FIS_PIXEL,
+        [IR_KEY] = FIS_KEY, [IR_INPUT] = FIS_INPUT, [IR_PRINT] = FIS_PRINT,
+    };
+
+    /* ================= CABECERA Y VARIABLES ================= */
+    note("Programa Meow traducido a FIS-25");
+    note(NULL);
+    prog->var_decl_pos = prog->len;
+    note(NULL);
+
+    /* Los VAR, en el orden en que la IR vio cada símbolo */
+    for (size_t i = 0; i < ir->nsyms; ++i) {
+        declare(ir->syms[i].name, ir->syms[i].temp ? "temporal" : NULL);
+    }
+
+    /* ================= CÓDIGO ================= */
+    for (uint32_t b = 0; b < ir->nblocks; ++b) {
+        const IrBlock *blk = &ir->blocks[b];
+        if (blk->label) label(lbl(blk->label));
+
+        for (uint32_t i = blk->start; i < blk->end; ++i) {
+            const IrInsn *in = &ir->insns[i];
+            Fis25Operand a = select_value(ir, in->a);
+            Fis25Operand x = select_value(ir, in->b);
+            Fis25Operand dst = select_value(ir, in->dst);
+            switch ((IrOp)in->op) {
+                case IR_PIXEL: emit(FIS_PIXEL, a, x, select_value(ir, in->c)); break;
+                case IR_PRINT: emit(FIS_PRINT, a, fis_none(), fis_none()); break;
+                case IR_KEY:   emit(FIS_KEY, a, fis_none(), dst); break;
+                default:       emit(ops[in->op], a, x, dst); break;
+            }
+        }
+
+        switch ((IrTerm)blk->term) {
+            case IR_TERM_JUMP:
+                if (blk->succ[0] != b + 1) go(block_label(ir, blk->succ[0]));
+                break;
+            case IR_TERM_BRANCH:
+                if_goto(select_value(ir, blk->cond), block_label(ir, blk->succ[0]));
+                if (blk->succ[1] != b + 1) go(block_label(ir, blk->succ[1]));
+                break;
+            case IR_TERM_NONE:
+            case IR_TERM_HALT:
+                break;
+        }
+    }
+}
+
+static int codegen_program(ASTStmtId root)
+{
+    IrProgram ir;
+    ir_init(&ir);
+    int errors = build_ir(&ir, root);
+    if (errors == 0) select_program(&ir);
+    ir_free(&ir);
+    return errors;
+}
+
+static size_t count_executable(const Fis25Program *p)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < p->len; ++i) {
+        if (fis25_is_executable((Fis25Op)p->code[i].op)) n++;
+    }
+    return n;
+}
+
+/* El programa se simplifica primero sobre el AST: lo que no se traduce
+   no hay que limpiarlo después en FIS-25. Devuelve la raíz a traducir. */
+static ASTStmtId optimize_ast(MeowContext *ctx, const CodegenOptions *opts, FILE *report)
+{
+    ASTStmtId root = ctx->root;
+    if (opts->optimize) {
+        ASTOptStats ast_stats;
+        StatsMark mark;
+        stats_begin(&ctx->stats, &mark);
+        root = ast_optimize(&ctx->ast, root, &ast_stats);
+        stats_end(&ctx->stats, PHASE_OPT, &mark);
+        if (report) ast_opt_report(&ast_stats, report);
+    }
+    return root;
+}
+
+/* Costo estático de una iteración del bucle principal sobre el código final
+   (--frame-budget, --frame-report). Pasarse del tope, o no poder acotarlo,
+   es un error; en ese caso la tabla se muestra igual para ver qué bucle
+   conviene achicar. Devuelve el número de errores. */
+static int check_frame_cost(MeowContext *ctx, const Fis25Program *p, const CodegenOptions *opts)
+{
+    Fis25CostReport r;
+    unsigned before = diag_errors(&ctx->diags);
+
+    fis25_cost_analyze(p, "MAIN_LOOP", &r);
+    if (opts->frame_budget > 0) {
+        const char *frame = r.frame_label >= 0 ? p->labels[r.frame_label] : NULL;
+        if (r.problem != NULL) {
+            diag_report(&ctx->diags, DIAG_ERROR, "de codegen FIS-25", DIAG_NO_LOC,
+                        "no se puede medir el costo por frame (--frame-budget): %s.", r.problem);
+        } else if (frame == NULL) {
+            diag_report(&ctx->diags, DIAG_ERROR, "de codegen FIS-25", DIAG_NO_LOC,
+                        "el programa no tiene bucle principal: --frame-budget no se puede comprobar.");
+        } else if (r.frame.hi == FIS25_COST_UNBOUNDED) {
+            diag_report(&ctx->diags, DIAG_ERROR, "de codegen FIS-25", DIAG_NO_LOC,
+                        "el costo de una iteración de %s no tiene cota (un bucle sin número de "
+                        "vueltas conocido); el tope es %ld (--frame-budget).",
+                        frame, opts->frame_budget);
+        } else if (r.frame.hi > opts->frame_budget) {
+            diag_report(&ctx->diags, DIAG_ERROR, "de codegen FIS-25", DIAG_NO_LOC,
+                        "una iteración de %s puede costar %lld instrucciones; el tope es %ld "
+                        "(--frame-budget).", frame, (long long)r.frame.hi, opts->frame_budget);
+        }
+    }
+    int errors = (int)(diag_errors(&ctx->diags) - before);
+    if (opts->frame_report || errors > 0) fis25_cost_print(p, &r, ctx->diag);
+    fis25_cost_free(&r);
+    return errors;
+}
+
+int codegen_fis25(MeowContext *ctx, const char *message, const CodegenOptions *opts,
+                  Emitter *out)
+{
+    Fis25Program program;
+    MeowStats *st = &ctx->stats;
+    StatsMark mark;
+    int errors = 0;
+
+    fis25_init(&program);
+    prog = &program;
+    ast = &ctx->ast;
+    diags = &ctx->diags;
+    // Los reportes del optimizador son notas: se omiten si se piden menos mensajes
+    FILE *report = diag_enabled(diags, DIAG_NOTE) ? ctx->diag : NULL;
+
+    ASTStmtId root = message == NULL ? optimize_ast(ctx, opts, report) : AST_NONE;
+
+    stats_begin(st, &mark);
+    if (message != NULL) {
+        codegen_marquee(message, opts->redraw);
+    } else {
+        errors = codegen_program(root);
+    }
+    stats_end(st, PHASE_CODEGEN, &mark);
+    st->fis_lowered = count_executable(&program);
+
+    stats_begin(st, &mark);
+    if (opts->optimize && errors == 0) {
+        Fis25OptStats stats;
+        Fis25LoopStats loop_stats;
+        Fis25LoopOptions loop_opts = { opts->unroll_budget };
+
+        fis25_peephole(&program, &stats);
+        if (report) fis25_opt_report(&stats, report);
+
+        /* Los bucles se reconocen mejor tras la primera limpieza; lo que
+           dejan (copias, estado de salida) lo recoge una segunda pasada. */
+        fis25_loop_opt(&program, &loop_opts, &loop_stats);
+        if (report) fis25_loop_report(&loop_stats, report);
+        if (loop_stats.loops_unrolled || loop_stats.muls_reduced || loop_stats.insns_hoisted) {
+            fis25_peephole(&program, &stats);
+            if (report) fis25_opt_report(&stats, report);
+        }
+
+        /* Con el código ya final, los temporales comparten VAR */
+        Fis25AllocStats alloc_stats;
+        fis25_alloc_vars(&program, &alloc_stats);
+        if (report) fis25_alloc_report(&alloc_stats, report);
+    }
+    stats_end(st, PHASE_OPT, &mark);
+    st->fis_final = count_executable(&program);
+    st->fis_vars = program.nvars;
+
+    if (errors == 0 && (opts->frame_budget > 0 || opts->frame_report)) {
+        errors += check_frame_cost(ctx, &program, opts);
+    }
+
+    stats_begin(st, &mark);
+    if (opts->emit == EMIT_BIN) {
+        if (fis25_bin_write(&program, out, ctx->diag) != 0) errors++;
+    } else {
+        fis25_write(&program, out);
+    }
+    stats_end(st, PHASE_EMIT, &mark);
+
+    fis25_free(&program);
+    prog = NULL;
+    ast = NULL;
+    diags = NULL;
+    return errors;
+}
+
+int codegen_dump_ir(MeowContext *ctx, const CodegenOptions *opts, FILE *out)
+{
+    IrProgram ir;
+    ast = &ctx->ast;
+    diags = &ctx->diags;
+    FILE *report = diag_enabled(diags, DIAG_NOTE) ? ctx->diag : NULL;
+
+    ASTStmtId root = optimize_ast(ctx, opts, report);
+    ir_init(&ir);
+    int errors = build_ir(&ir, root);
+    if (errors == 0) ir_dump(&ir, out);
+    ir_free(&ir);
+
+    ast = NULL;
+    diags = NULL;
+    return errors;
 }
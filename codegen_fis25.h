@@ -1,8 +1,57 @@
 #ifndef CODEGEN_FIS25_H
 #define CODEGEN_FIS25_H
 
+#include <stdio.h>
 #include "ast.h"
+#include "context.h"
+#include "emitter.h"
 
-void codegen_fis25(ASTStmt *root, const char *message);
+/* Cómo se redibuja el letrero en cada iteración de MAIN_LOOP */
+typedef enum {
+    MARQUEE_REDRAW_FULL,        /* limpia la fila completa y dibuja todo el texto */
+    MARQUEE_REDRAW_INCREMENTAL  /* solo si cambió x: apaga el offset anterior y dibuja el nuevo */
+} MarqueeRedraw;
+
+/* Formato de la salida */
+typedef enum {
+    EMIT_TEXT,                  /* FIS-25 en texto */
+    EMIT_BIN                    /* codificación binaria de fis25bin.h */
+} EmitFormat;
+
+typedef struct {
+    int optimize;               /* 1 = pasar el optimizador de mirilla antes de imprimir */
+    MarqueeRedraw redraw;
+    int unroll_budget;          /* tope de instrucciones al desenrollar bucles (0 = no desenrollar) */
+    EmitFormat emit;
+    long frame_budget;          /* tope de instrucciones por iteración de MAIN_LOOP (0 = sin tope) */
+    int frame_report;           /* 1 = tabla de costo por etiqueta del frame en ctx->diag */
+} CodegenOptions;
+
+/*
+ * Genera código FIS-25 y lo agrega al búfer 'out' (no escribe nada por sí mismo).
+ *  - message != NULL: letrero dinámico (Opción C) con ese mensaje.
+ *  - message == NULL: traducción del programa de ctx->root.
+ * Los errores y advertencias van a ctx->diags, los reportes del optimizador
+ * (solo si se piden notas) y la tabla de costo por frame a ctx->diag, y los tiempos de traducción,
+ * optimización y emisión a ctx->stats. Es reentrante: puede llamarse a
+ * la vez desde varios hilos con contextos distintos.
+ * Devuelve el número de errores de traducción (0 = éxito).
+ */
+int codegen_fis25(MeowContext *ctx, const char *message, const CodegenOptions *opts,
+                  Emitter *out);
+
+/*
+ * Deja en 'msg' (de msg_size bytes) los caracteres de 'raw' que el letrero
+ * sabe dibujar (0-9, '.', '$'), avisando en 'warn' (si no es NULL) de cada
+ * uno que descarta. Si no queda ninguno el mensaje es "0".
+ */
+void codegen_marquee_message(const char *raw, char *msg, size_t msg_size, FILE *warn);
+
+/*
+ * Escribe en 'out' la representación intermedia (ir.h) del programa de
+ * ctx->root, después de las optimizaciones sobre el AST si opts->optimize.
+ * Devuelve el número de errores de traducción.
+ */
+int codegen_dump_ir(MeowContext *ctx, const CodegenOptions *opts, FILE *out);
 
 #endif
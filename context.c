@@ -0,0 +1,240 @@
+// context.c
+
+#include "context.h"
+#include "intern.h"
+#include "parser.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Interfaz del scanner reentrante que genera flex (scanner.l); fastscan.c
+   implementa la misma (make SCANNER=fast) */
+struct yy_buffer_state;
+int   yylex_init_extra(MeowContext *extra, yyscan_t *scanner);
+int   yylex_destroy(yyscan_t scanner);
+void  yyset_in(FILE *in, yyscan_t scanner);
+void  yyset_lineno(int line, yyscan_t scanner);
+int   yyget_lineno(yyscan_t scanner);
+char *yyget_text(yyscan_t scanner);
+struct yy_buffer_state *yy_scan_buffer(char *base, size_t size, yyscan_t scanner);
+void  yy_delete_buffer(struct yy_buffer_state *b, yyscan_t scanner);
+
+void yyerror(YYLTYPE *loc, MeowContext *ctx, yyscan_t scanner, const char *s) {
+    DiagLoc where = { loc->first_line, loc->first_column };
+    const char *text = yyget_text(scanner);
+    // Bison avisa así cuando la pila llega a YYMAXDEPTH (o falla malloc)
+    if (strcmp(s, "memory exhausted") == 0) {
+        if (ctx->parse_depth > 0) {
+            diag_report(&ctx->diags, DIAG_ERROR, "sintáctico", where,
+                        "anidamiento demasiado profundo: la pila del parser pasó de %zu "
+                        "entradas (se puede subir con -fparse-depth=N)", ctx->parse_depth);
+        } else {
+            diag_report(&ctx->diags, DIAG_ERROR, "sintáctico", where,
+                        "anidamiento demasiado profundo: no hay memoria para la pila del parser");
+        }
+        return;
+    }
+    if (*text == '\0') {
+        diag_report(&ctx->diags, DIAG_ERROR, "sintáctico", where, "%s al final del archivo", s);
+    } else {
+        diag_report(&ctx->diags, DIAG_ERROR, "sintáctico", where, "%s cerca de '%s'", s, text);
+    }
+}
+
+int meow_lex(MeowContext *ctx, YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner) {
+    int token;
+    // Con el límite de errores alcanzado el parser ve el fin del archivo
+    if (ctx->diags.stopped) return 0;
+    if (ctx->stats.enabled) {
+        uint64_t t0 = stats_wall_ns();
+        token = yylex(yylval, yylloc, scanner);
+        ctx->stats.lex_ns += stats_wall_ns() - t0;
+        ctx->stats.lex_calls++;
+    } else {
+        token = yylex(yylval, yylloc, scanner);
+    }
+    if (token > 0) ctx->stats.tokens++;   // 0 = fin de archivo
+    return token;
+}
+
+void meow_context_init(MeowContext *ctx, const char *path, int buffer_diag, int timed) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->path = path;
+    ctx->root = AST_NONE;
+    ctx->parse_depth = MEOW_DEFAULT_PARSE_DEPTH;
+
+    ctx->diag = stderr;
+    if (buffer_diag) {
+        FILE *mem = open_memstream(&ctx->diag_buf, &ctx->diag_len);
+        if (mem != NULL) ctx->diag = mem;   // si falla, los mensajes van directo
+    }
+
+    diag_init(&ctx->diags, path, ctx->diag);
+    ast_init(&ctx->ast);
+    ctx->ast.timed = timed;
+    symtab_init(&ctx->symtab, &ctx->diags);
+    stats_init(&ctx->stats, timed);
+}
+
+ptrdiff_t meow_parse_depth(const MeowContext *ctx) {
+    // Sin límite: bastante lejos de desbordar YYSTACK_BYTES; antes falla malloc
+    if (ctx->parse_depth == 0 || ctx->parse_depth > (size_t)PTRDIFF_MAX / 64) {
+        return PTRDIFF_MAX / 64;
+    }
+    return (ptrdiff_t)ctx->parse_depth;
+}
+
+/* Crea el scanner de 'ctx' sobre el fuente 'src'. *buffer queda en NULL si
+   el fuente se lee por FILE*. Devuelve 0, o 1 si no se pudo. */
+static int scanner_open(MeowContext *ctx, MeowSource *src, yyscan_t *scanner,
+                        struct yy_buffer_state **buffer) {
+    *buffer = NULL;
+    if (yylex_init_extra(ctx, scanner) != 0) {
+        perror("Error al crear el scanner");
+        return 1;
+    }
+    if (src->data != NULL) {
+        // Búfer completo en memoria: flex lo recorre sin copiarlo ni rellenarlo
+        *buffer = yy_scan_buffer(src->data, src->len + 2, *scanner);
+        if (*buffer == NULL) {
+            fprintf(ctx->diag, "%s: no se pudo crear el búfer del scanner\n", ctx->path);
+            yylex_destroy(*scanner);
+            return 1;
+        }
+        yyset_lineno(1, *scanner);   // yy_scan_buffer no inicializa la línea
+    } else {
+        yyset_in(src->stream, *scanner);
+    }
+    return 0;
+}
+
+static void scanner_close(yyscan_t scanner, struct yy_buffer_state *buffer) {
+    if (buffer != NULL) yy_delete_buffer(buffer, scanner);
+    yylex_destroy(scanner);
+}
+
+int meow_parse(MeowContext *ctx, MeowSource *src) {
+    yyscan_t scanner;
+    struct yy_buffer_state *buffer;
+    if (scanner_open(ctx, src, &scanner, &buffer) != 0) return 1;
+
+    MeowStats *st = &ctx->stats;
+    size_t intern_before = st->enabled ? intern_bytes() : 0;
+    StatsMark mark;
+    stats_begin(st, &mark);
+    int result = yyparse(ctx, scanner);
+    stats_end(st, PHASE_PARSE, &mark);
+
+    st->lines = (uint64_t)yyget_lineno(scanner);
+    st->ast_calls = ctx->ast.alloc_calls;
+    st->ast_ns = ctx->ast.alloc_ns;
+    st->ast_exprs = ctx->ast.num_exprs ? ctx->ast.num_exprs - 1 : 0;
+    st->ast_stmts = ctx->ast.num_stmts ? ctx->ast.num_stmts - 1 : 0;
+    st->ast_bytes = (size_t)ctx->ast.cap_exprs * sizeof(ASTExpr) +
+                    (size_t)ctx->ast.cap_stmts * sizeof(ASTStmt);
+    st->symbols = symtab_count(&ctx->symtab);
+    st->symtab_bytes = symtab_bytes(&ctx->symtab);
+    if (st->enabled) {
+        // Con -j la tabla es compartida: incluye lo que internaron otros hilos
+        size_t intern_after = intern_bytes();
+        st->intern_bytes = intern_after > intern_before ? intern_after - intern_before : 0;
+        stats_split_frontend(st);
+    }
+
+    scanner_close(scanner, buffer);
+    return result;
+}
+
+static const char *token_name(int token) {
+    switch (token) {
+        case T_SEMICOLON: return "T_SEMICOLON";
+        case T_ASSIGN: return "T_ASSIGN";
+        case T_PLUS: return "T_PLUS";
+        case T_MINUS: return "T_MINUS";
+        case T_MULT: return "T_MULT";
+        case T_DIV: return "T_DIV";
+        case T_LPAREN: return "T_LPAREN";
+        case T_RPAREN: return "T_RPAREN";
+        case T_LBRACKET: return "T_LBRACKET";
+        case T_RBRACKET: return "T_RBRACKET";
+        case T_DOT: return "T_DOT";
+        case T_COMMA: return "T_COMMA";
+        case T_LBRACE: return "T_LBRACE";
+        case T_RBRACE: return "T_RBRACE";
+        case T_LITERAL_INT: return "T_LITERAL_INT";
+        case T_LITERAL_FLOAT: return "T_LITERAL_FLOAT";
+        case T_LITERAL_STRING: return "T_LITERAL_STRING";
+        case T_ID: return "T_ID";
+        case T_DECLARACION: return "T_DECLARACION";
+        case T_IF: return "T_IF";
+        case T_ELSE: return "T_ELSE";
+        case T_WHILE: return "T_WHILE";
+        case T_FOR: return "T_FOR";
+        case T_FUNCTION: return "T_FUNCTION";
+        case T_RETURN: return "T_RETURN";
+        case T_MIAU_PIXEL: return "T_MIAU_PIXEL";
+        case T_MIAU_KEY: return "T_MIAU_KEY";
+        case T_MIAU_INPUT: return "T_MIAU_INPUT";
+        case T_MIAU_PRINT: return "T_MIAU_PRINT";
+        case T_TRUE: return "T_TRUE";
+        case T_FALSE: return "T_FALSE";
+        case T_INT: return "T_INT";
+        case T_FLOAT: return "T_FLOAT";
+        case T_BOOL: return "T_BOOL";
+        case T_STRING: return "T_STRING";
+        default: return "?";
+    }
+}
+
+int meow_dump_tokens(MeowContext *ctx, MeowSource *src, FILE *out) {
+    yyscan_t scanner;
+    struct yy_buffer_state *buffer;
+    if (scanner_open(ctx, src, &scanner, &buffer) != 0) return 1;
+
+    YYSTYPE value;
+    YYLTYPE loc = { 1, 1, 1, 1 };   // el valor inicial que usa el parser
+    int token;
+    while ((token = meow_lex(ctx, &value, &loc, scanner)) > 0) {
+        fprintf(out, "%d:%d-%d:%d %s '%s'", loc.first_line, loc.first_column,
+                loc.last_line, loc.last_column, token_name(token), yyget_text(scanner));
+        // El valor es lo que recibe el parser: también se compara
+        if (token == T_LITERAL_INT) {
+            fprintf(out, " %d", value.ival);
+        } else if (token == T_LITERAL_FLOAT) {
+            fprintf(out, " %.9g", (double)value.fval);
+        } else if (token == T_ID || token == T_LITERAL_STRING) {
+            fprintf(out, " %s", value.sval == intern(yyget_text(scanner)) ? "=" : "!=");
+        }
+        fputc('\n', out);
+    }
+    fprintf(out, "%d:%d EOF (línea %d)\n", loc.first_line, loc.first_column,
+            yyget_lineno(scanner));
+    ctx->stats.lines = (uint64_t)yyget_lineno(scanner);
+    scanner_close(scanner, buffer);
+    return 0;
+}
+
+void meow_context_flush_diag(MeowContext *ctx, FILE *out) {
+    if (ctx->diag == stderr) return;
+    fflush(ctx->diag);
+    if (ctx->diag_len > 0) {
+        fwrite(ctx->diag_buf, 1, ctx->diag_len, out);
+        fflush(out);
+    }
+    rewind(ctx->diag);
+}
+
+void meow_context_free(MeowContext *ctx) {
+    symtab_free(&ctx->symtab);
+    ast_free_all(&ctx->ast);
+    ctx->root = AST_NONE;
+
+    if (ctx->diag != stderr) {
+        fclose(ctx->diag);
+        free(ctx->diag_buf);
+        ctx->diag_buf = NULL;
+        ctx->diag_len = 0;
+    }
+    ctx->diag = NULL;
+}
@@ -0,0 +1,91 @@
+// context.h
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "ast.h"
+#include "diag.h"
+#include "source.h"
+#include "stats.h"
+#include "symtab.h"
+
+/* Entradas de la pila del parser por defecto (-fparse-depth). La pila
+   empieza chica y se duplica a medida que hace falta; cada nivel de
+   anidamiento del fuente ocupa unas pocas entradas (~26 bytes cada una) */
+#define MEOW_DEFAULT_PARSE_DEPTH 10000000
+// La pila inicial de bison (YYINITDEPTH) no se achica: menos no tiene efecto
+#define MEOW_MIN_PARSE_DEPTH 200
+
+/*
+ * Estado de una compilación.
+ *
+ * Todo lo que produce el análisis de un archivo (AST, tabla de símbolos,
+ * diagnósticos) vive aquí y no en variables globales; el scanner y el
+ * parser son reentrantes y reciben el contexto como parámetro. Así varios
+ * archivos pueden compilarse a la vez en hilos distintos (meowc -j N).
+ * Lo único compartido es la tabla de internado, que es segura entre hilos.
+ */
+typedef struct MeowContext {
+    const char *path;         // archivo fuente, para los mensajes
+    ASTStore ast;
+    ASTStmtId root;           // bloque raíz (AST_NONE hasta que termina el parser)
+    SymTab symtab;
+    Diagnostics diags;        // niveles, ubicaciones y límite de errores
+    MeowStats stats;          // tiempos y contadores (--time-report, --stats)
+    size_t parse_depth;       // máximo de la pila del parser (0 = lo que dé la memoria)
+
+    // Destino de los diagnósticos: directo a stderr, o un búfer en memoria
+    // que se vuelca entero al final (una sola escritura; los mensajes de
+    // compilaciones paralelas no se mezclan)
+    FILE *diag;
+    char *diag_buf;
+    size_t diag_len;
+} MeowContext;
+
+/**
+ * @brief Prepara un contexto vacío para compilar 'path'.
+ * @param buffer_diag 0 = los diagnósticos van a stderr; 1 = se guardan en
+ *        memoria hasta meow_context_flush_diag.
+ * @param timed 1 = medir los tiempos de cada fase en ctx->stats.
+ * ctx->diags queda con el nivel y el límite por defecto, y ctx->parse_depth
+ * con MEOW_DEFAULT_PARSE_DEPTH (se pueden cambiar antes de analizar).
+ */
+void meow_context_init(MeowContext *ctx, const char *path, int buffer_diag, int timed);
+
+/**
+ * @brief Analiza el fuente 'src' (ya abierto, ver source.h) con un scanner
+ *        propio del contexto y deja la raíz en ctx->root. Con ctx->stats
+ *        activo mide el análisis completo y lo reparte entre lex, parse y AST.
+ * @return int El resultado de yyparse (0 = sin errores sintácticos no
+ *         recuperados; los recuperados quedan en ctx->diags).
+ */
+int meow_parse(MeowContext *ctx, MeowSource *src);
+
+/**
+ * @brief Solo el scanner: escribe en 'out' un token por línea (ubicación, nombre,
+ *        texto y valor) y al final EOF. Es lo que compara
+ *        bench/scanner_bench.sh entre flex y fastscan.c (--dump-tokens).
+ * @return int 0, o 1 si no se pudo crear el scanner.
+ */
+int meow_dump_tokens(MeowContext *ctx, MeowSource *src, FILE *out);
+
+/**
+ * @brief Límite de la pila del parser para ctx->parse_depth (YYMAXDEPTH en
+ *        parser.y): 0 se traduce en un máximo que solo acota la memoria.
+ */
+ptrdiff_t meow_parse_depth(const MeowContext *ctx);
+
+/**
+ * @brief Escribe en 'out' los diagnósticos acumulados (si están en memoria)
+ *        con una sola llamada, y vacía el búfer.
+ */
+void meow_context_flush_diag(MeowContext *ctx, FILE *out);
+
+/**
+ * @brief Libera el AST, la tabla de símbolos y el búfer de diagnósticos.
+ */
+void meow_context_free(MeowContext *ctx);
+
+#endif // CONTEXT_H
@@ -0,0 +1,51 @@
+// diag.c
+
+#include "diag.h"
+#include <stdarg.h>
+
+static const char *level_names[DIAG_LEVELS] = { "DEBUG", "Nota", "Advertencia", "Error" };
+
+void diag_init(Diagnostics *d, const char *path, FILE *out) {
+    d->path = path;
+    d->out = out;
+    d->min_level = DIAG_NOTE;
+    d->error_limit = DIAG_DEFAULT_ERROR_LIMIT;
+    for (int i = 0; i < DIAG_LEVELS; ++i) d->count[i] = 0;
+    d->stopped = 0;
+}
+
+int diag_enabled(const Diagnostics *d, DiagLevel level) {
+    return level >= d->min_level && !d->stopped;
+}
+
+void diag_report(Diagnostics *d, DiagLevel level, const char *kind, DiagLoc loc,
+                 const char *fmt, ...) {
+    if (!diag_enabled(d, level)) return;
+
+    if (loc.line > 0) {
+        fprintf(d->out, "%s:%d:%d: ", d->path, loc.line, loc.column);
+    } else {
+        fprintf(d->out, "%s: ", d->path);
+    }
+    fputs(level_names[level], d->out);
+    if (kind != NULL) fprintf(d->out, " %s", kind);
+    fputs(": ", d->out);
+
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(d->out, fmt, ap);
+    va_end(ap);
+    fputc('\n', d->out);
+    d->count[level]++;
+
+    if (level == DIAG_ERROR && d->error_limit > 0 &&
+        d->count[DIAG_ERROR] >= (unsigned)d->error_limit) {
+        fprintf(d->out, "%s: se alcanzó el límite de %d errores (-ferror-limit); "
+                        "se detiene el análisis\n", d->path, d->error_limit);
+        d->stopped = 1;
+    }
+}
+
+unsigned diag_errors(const Diagnostics *d) {
+    return d->count[DIAG_ERROR];
+}
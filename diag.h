@@ -0,0 +1,75 @@
+// diag.h
+
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdio.h>
+
+/*
+ * Diagnósticos de una compilación: errores, advertencias, notas y mensajes
+ * de depuración, con la ubicación en el fuente.
+ *
+ * Cada mensaje tiene un nivel; los que están por debajo del mínimo ni
+ * siquiera se formatean (las líneas DEBUG por símbolo no cuestan nada si no
+ * se piden). Todo se escribe en 'out', que en meowc es un búfer en memoria
+ * del contexto: se vuelca a stderr con una sola escritura al terminar el
+ * archivo. Al llegar al límite de errores se informa una vez, se descarta
+ * lo que siga y el análisis se corta (ver meow_lex).
+ *
+ * Formato:  archivo:línea:columna: Error semántico: mensaje
+ * (sin ubicación, "archivo: ..."). Las columnas cuentan bytes desde 1.
+ */
+
+typedef enum {
+    DIAG_DEBUG,       // trazas internas (-v o MEOW_DEBUG)
+    DIAG_NOTE,        // reportes informativos (optimizador)
+    DIAG_WARNING,
+    DIAG_ERROR,
+    DIAG_LEVELS
+} DiagLevel;
+
+// Posición en el fuente; line == 0 si el mensaje no tiene ubicación
+typedef struct {
+    int line;
+    int column;
+} DiagLoc;
+
+#define DIAG_NO_LOC ((DiagLoc){ 0, 0 })
+
+// Errores informados antes de cortar el análisis (-ferror-limit=N, 0 = sin límite)
+#define DIAG_DEFAULT_ERROR_LIMIT 20
+
+typedef struct {
+    const char *path;         // archivo fuente, prefijo de cada mensaje
+    FILE *out;
+    DiagLevel min_level;      // por defecto DIAG_NOTE
+    int error_limit;
+    unsigned count[DIAG_LEVELS];  // mensajes emitidos de cada nivel
+    int stopped;              // se llegó al límite de errores
+} Diagnostics;
+
+/**
+ * @brief Prepara 'd' con el nivel mínimo DIAG_NOTE y el límite por defecto.
+ */
+void diag_init(Diagnostics *d, const char *path, FILE *out);
+
+/**
+ * @brief Indica si un mensaje de ese nivel se escribiría (para no armar
+ *        mensajes caros que se van a descartar).
+ */
+int diag_enabled(const Diagnostics *d, DiagLevel level);
+
+/**
+ * @brief Informa un diagnóstico.
+ * @param kind Complemento del nivel en el mensaje ("sintáctico",
+ *        "semántico", ...), o NULL.
+ */
+void diag_report(Diagnostics *d, DiagLevel level, const char *kind, DiagLoc loc,
+                 const char *fmt, ...) __attribute__((format(printf, 5, 6)));
+
+/**
+ * @brief Errores informados hasta ahora (incluye el que alcanzó el límite).
+ */
+unsigned diag_errors(const Diagnostics *d);
+
+#endif // DIAG_H
@@ -0,0 +1,101 @@
+// emitter.c
+
+#include "emitter.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Pares de dígitos "00".."99" para convertir enteros de dos en dos
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+void emitter_init(Emitter *e) {
+    memset(e, 0, sizeof(*e));
+}
+
+void emitter_free(Emitter *e) {
+    free(e->buf);
+    memset(e, 0, sizeof(*e));
+}
+
+void emitter_reserve(Emitter *e, size_t extra) {
+    if (e->len + extra <= e->cap) return;
+    size_t cap = e->cap ? e->cap : 4096;
+    while (cap < e->len + extra) cap *= 2;
+    char *buf = (char *)realloc(e->buf, cap);
+    if (buf == NULL) {
+        perror("Error de memoria en el búfer de salida");
+        exit(EXIT_FAILURE);
+    }
+    e->buf = buf;
+    e->cap = cap;
+}
+
+void emitter_write(Emitter *e, const char *s, size_t n) {
+    emitter_reserve(e, n);
+    memcpy(e->buf + e->len, s, n);
+    e->len += n;
+}
+
+void emitter_puts(Emitter *e, const char *s) {
+    emitter_write(e, s, strlen(s));
+}
+
+void emitter_int(Emitter *e, int32_t v) {
+    char tmp[12];
+    char *end = tmp + sizeof(tmp), *q = end;
+    uint32_t u = (v < 0) ? 0u - (uint32_t)v : (uint32_t)v;
+
+    while (u >= 100) {
+        uint32_t r = (u % 100) * 2;
+        u /= 100;
+        *--q = digit_pairs[r + 1];
+        *--q = digit_pairs[r];
+    }
+    if (u >= 10) {
+        *--q = digit_pairs[u * 2 + 1];
+        *--q = digit_pairs[u * 2];
+    } else {
+        *--q = (char)('0' + u);
+    }
+    if (v < 0) *--q = '-';
+    emitter_write(e, q, (size_t)(end - q));
+}
+
+void emitter_pad_to(Emitter *e, size_t line_start, size_t col) {
+    size_t used = e->len - line_start;
+    if (used >= col) return;
+    emitter_reserve(e, col - used);
+    memset(e->buf + e->len, ' ', col - used);
+    e->len += col - used;
+}
+
+int emitter_flush_fd(Emitter *e, int fd) {
+    size_t done = 0;
+    // Normalmente basta una llamada; write puede quedarse corto con tuberías
+    while (done < e->len) {
+        ssize_t n = write(fd, e->buf + done, e->len - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    e->len = 0;
+    return 0;
+}
+
+int emitter_write_file(Emitter *e, const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+    int rc = emitter_flush_fd(e, fd);
+    int saved = errno;
+    if (close(fd) != 0 && rc == 0) return -1;
+    errno = saved;
+    return rc;
+}
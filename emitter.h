@@ -0,0 +1,51 @@
+// emitter.h
+
+#ifndef EMITTER_H
+#define EMITTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Búfer de salida en memoria para el código generado.
+ *
+ * Todo el texto se acumula en un arreglo que crece al doble y se escribe al
+ * final con una sola llamada a write(2) (sin stdio de por medio), ya sea a un
+ * archivo (-o) o a la salida estándar.
+ */
+typedef struct {
+    char *buf;
+    size_t len, cap;
+} Emitter;
+
+void emitter_init(Emitter *e);
+void emitter_free(Emitter *e);
+
+// Asegura espacio para 'extra' bytes más
+void emitter_reserve(Emitter *e, size_t extra);
+
+static inline void emitter_putc(Emitter *e, char c) {
+    if (e->len == e->cap) emitter_reserve(e, 1);
+    e->buf[e->len++] = c;
+}
+
+void emitter_write(Emitter *e, const char *s, size_t n);
+void emitter_puts(Emitter *e, const char *s);
+// Entero en decimal (sin printf)
+void emitter_int(Emitter *e, int32_t v);
+// Rellena con espacios hasta que la línea actual tenga 'col' columnas
+void emitter_pad_to(Emitter *e, size_t line_start, size_t col);
+
+/**
+ * @brief Escribe todo el contenido en el descriptor 'fd' y vacía el búfer.
+ * @return int 0 si se escribió completo, -1 si hubo error (errno queda puesto).
+ */
+int emitter_flush_fd(Emitter *e, int fd);
+
+/**
+ * @brief Crea (o trunca) 'path' y escribe el contenido con una sola llamada.
+ * @return int 0 si se escribió completo, -1 si hubo error (errno queda puesto).
+ */
+int emitter_write_file(Emitter *e, const char *path);
+
+#endif // EMITTER_H
@@ -0,0 +1,536 @@
+// fastscan.c
+//
+// Scanner escrito a mano, alternativa a scanner.l (make SCANNER=fast).
+// Implementa la misma interfaz reentrante que genera flex (la que usa
+// context.c) y reconoce exactamente los mismos tokens, con los mismos
+// valores, ubicaciones y mensajes de error; bench/scanner_bench.sh lo
+// compara token por token contra flex.
+//
+// Lo que lo hace más rápido:
+//  - los espacios y los comentarios se saltan de a 16 (SSE2) o 32 (AVX2)
+//    bytes, contando los saltos de línea con popcount;
+//  - las palabras clave meow* / miau_* se reconocen con un hash perfecto
+//    (una sola comparación) en lugar de recorrer el autómata de flex;
+//  - el texto del token no se copia: yytext solo se arma si alguien lo pide.
+//
+// Con la variable de entorno MEOW_SCAN_SIMD=scalar|sse2|avx2 se fuerza una
+// variante (para comparar entre ellas); por defecto se usa la mejor que
+// soporte la CPU.
+
+#include "context.h"
+#include "parser.h"
+#include "intern.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FASTSCAN_SSE2 1
+#endif
+
+/* Búfer entregado con yy_scan_buffer: termina en dos bytes en 0 */
+struct yy_buffer_state {
+    const char *base;
+    size_t len;
+};
+
+typedef struct {
+    MeowContext *extra;
+    FILE *in;                 // yyset_in; se lee entero en el primer yylex
+    const char *pos;          // siguiente byte sin leer
+    const char *end;          // fin del fuente (sin los centinelas)
+    char *owned;              // copia de 'in' (NULL con yy_scan_buffer)
+    int loaded;
+    int lineno;
+    const char *line_start;   // primer byte de la línea 'line_start_no'
+    int line_start_no;
+
+    const char *tok;          // texto del último token (dentro del fuente)
+    size_t tok_len;
+    char *text;               // copia terminada en 0, ver token_text
+    size_t text_cap;
+} FastScanner;
+
+/* ================= Saltos de espacios y comentarios ================= */
+
+/* Cada variante devuelve el primer byte que no es espacio (o 'end') /
+   la primera aparición de 'c' (o 'end'), y suma a '*lines' los saltos de
+   línea que quedaron atrás. */
+typedef struct {
+    const char *(*skip_space)(const char *p, const char *end, int *lines);
+    const char *(*find)(const char *p, const char *end, char c, int *lines);
+} ScanKernels;
+
+static inline int is_space(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static const char *skip_space_scalar(const char *p, const char *end, int *lines) {
+    while (p < end && is_space((unsigned char)*p)) {
+        if (*p == '\n') ++*lines;
+        ++p;
+    }
+    return p;
+}
+
+static const char *find_scalar(const char *p, const char *end, char c, int *lines) {
+    while (p < end && *p != c) {
+        if (*p == '\n') ++*lines;
+        ++p;
+    }
+    return p;
+}
+
+#ifdef FASTSCAN_SSE2
+
+// Solo bloques completos: nunca se lee más allá de 'end'
+static const char *skip_space_sse2(const char *p, const char *end, int *lines) {
+    const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r'), nl = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i is_nl = _mm_cmpeq_epi8(v, nl);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, cr), is_nl));
+        unsigned ws_mask = (unsigned)_mm_movemask_epi8(ws);
+        unsigned nl_mask = (unsigned)_mm_movemask_epi8(is_nl);
+        if (ws_mask != 0xFFFFu) {
+            unsigned stop = (unsigned)__builtin_ctz(~ws_mask);
+            *lines += __builtin_popcount(nl_mask & ((1u << stop) - 1));
+            return p + stop;
+        }
+        *lines += __builtin_popcount(nl_mask);
+        p += 16;
+    }
+    return skip_space_scalar(p, end, lines);
+}
+
+static const char *find_sse2(const char *p, const char *end, char c, int *lines) {
+    const __m128i target = _mm_set1_epi8(c), nl = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned hit = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, target));
+        unsigned nl_mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+        if (hit != 0) {
+            unsigned stop = (unsigned)__builtin_ctz(hit);
+            *lines += __builtin_popcount(nl_mask & ((1u << stop) - 1));
+            return p + stop;
+        }
+        *lines += __builtin_popcount(nl_mask);
+        p += 16;
+    }
+    return find_scalar(p, end, c, lines);
+}
+
+__attribute__((target("avx2")))
+static const char *skip_space_avx2(const char *p, const char *end, int *lines) {
+    const __m256i sp = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r'), nl = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        __m256i is_nl = _mm256_cmpeq_epi8(v, nl);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, sp),
+                                                     _mm256_cmpeq_epi8(v, tab)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), is_nl));
+        unsigned ws_mask = (unsigned)_mm256_movemask_epi8(ws);
+        unsigned nl_mask = (unsigned)_mm256_movemask_epi8(is_nl);
+        if (ws_mask != 0xFFFFFFFFu) {
+            unsigned stop = (unsigned)__builtin_ctz(~ws_mask);
+            *lines += __builtin_popcount(nl_mask & ((1u << stop) - 1));
+            return p + stop;
+        }
+        *lines += __builtin_popcount(nl_mask);
+        p += 32;
+    }
+    return skip_space_sse2(p, end, lines);
+}
+
+__attribute__((target("avx2")))
+static const char *find_avx2(const char *p, const char *end, char c, int *lines) {
+    const __m256i target = _mm256_set1_epi8(c), nl = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned hit = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target));
+        unsigned nl_mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl));
+        if (hit != 0) {
+            unsigned stop = (unsigned)__builtin_ctz(hit);
+            *lines += __builtin_popcount(nl_mask & ((1u << stop) - 1));
+            return p + stop;
+        }
+        *lines += __builtin_popcount(nl_mask);
+        p += 32;
+    }
+    return find_sse2(p, end, c, lines);
+}
+
+#endif // FASTSCAN_SSE2
+
+static const ScanKernels kernels_scalar = { skip_space_scalar, find_scalar };
+#ifdef FASTSCAN_SSE2
+static const ScanKernels kernels_sse2 = { skip_space_sse2, find_sse2 };
+static const ScanKernels kernels_avx2 = { skip_space_avx2, find_avx2 };
+#endif
+
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+static const ScanKernels *kernels = &kernels_scalar;
+
+static void choose_kernels(void) {
+#ifdef FASTSCAN_SSE2
+    const char *forced = getenv("MEOW_SCAN_SIMD");
+    int avx2 = __builtin_cpu_supports("avx2");
+    if (forced != NULL && strcmp(forced, "scalar") == 0) {
+        kernels = &kernels_scalar;
+    } else if (forced != NULL && strcmp(forced, "sse2") == 0) {
+        kernels = &kernels_sse2;
+    } else {
+        kernels = avx2 ? &kernels_avx2 : &kernels_sse2;
+    }
+#endif
+}
+
+/* ================= Palabras clave ================= */
+
+/*
+ * Hash perfecto de las palabras clave de una sola palabra: con el largo, el
+ * último carácter y el antepenúltimo no hay dos en la misma casilla. Una
+ * palabra es clave si cae en una casilla ocupada y coincide entera; si no,
+ * es un identificador. "meow meow", "meow meow meow" y "meoow meow" se
+ * resuelven al encontrar meow / meoow (ver keyword).
+ */
+#define KW_SLOTS 32
+#define KW_MIN_LEN 3
+#define KW_MAX_LEN 10
+
+static inline unsigned kw_hash(const char *w, size_t n) {
+    return ((unsigned char)w[n - 1] + 3u * (unsigned char)w[n - 3] + 7u * (unsigned)n) &
+           (KW_SLOTS - 1);
+}
+
+static const struct {
+    const char *word;
+    unsigned char len;
+    int token;
+} kw_table[KW_SLOTS] = {
+    [1]  = { "meowrr", 6, T_FOR },
+    [2]  = { "meow", 4, T_DECLARACION },
+    [4]  = { "meowt", 5, T_TRUE },
+    [6]  = { "meowww", 6, T_STRING },
+    [7]  = { "meoow", 5, T_IF },
+    [8]  = { "mewmew", 6, T_RETURN },
+    [10] = { "miau_input", 10, T_MIAU_INPUT },
+    [18] = { "miau_key", 8, T_MIAU_KEY },
+    [19] = { "mew", 3, T_FUNCTION },
+    [21] = { "miau_print", 10, T_MIAU_PRINT },
+    [22] = { "meowf", 5, T_FALSE },
+    [26] = { "miau_pixel", 10, T_MIAU_PIXEL },
+    [28] = { "meowl", 5, T_WHILE },
+    [30] = { "meowmeow", 8, T_BOOL },
+};
+
+static inline int follows_meow(const char *p, const char *end) {
+    return end - p >= 5 && memcmp(p, " meow", 5) == 0;
+}
+
+/* Token de la palabra [p, p + n) o T_ID. Como flex, gana el texto más
+   largo: "meow meow" (aunque siga "x") antes que "meow". Puede alargar *n. */
+static int keyword(const char *p, size_t *n, const char *end) {
+    size_t len = *n;
+    if (len < KW_MIN_LEN || len > KW_MAX_LEN || p[0] != 'm') return T_ID;
+    unsigned h = kw_hash(p, len);
+    if (kw_table[h].len != len || memcmp(p, kw_table[h].word, len) != 0) return T_ID;
+
+    int token = kw_table[h].token;
+    if (token == T_DECLARACION && follows_meow(p + 4, end)) {
+        if (follows_meow(p + 9, end)) {
+            *n = 14;
+            return T_FLOAT;
+        }
+        *n = 9;
+        return T_INT;
+    }
+    if (token == T_IF && follows_meow(p + 5, end)) {
+        *n = 10;
+        return T_ELSE;
+    }
+    return token;
+}
+
+/* ================= Interfaz de flex ================= */
+
+static inline int is_digit(unsigned char c) { return (unsigned)(c - '0') < 10; }
+
+static inline int is_ident(unsigned char c) {
+    return (unsigned)((c | 32) - 'a') < 26 || is_digit(c) || c == '_';
+}
+
+int yylex_init_extra(MeowContext *extra, yyscan_t *scanner) {
+    FastScanner *s = (FastScanner *)calloc(1, sizeof(FastScanner));
+    if (s == NULL) return 1;
+    s->extra = extra;
+    s->lineno = 1;
+    s->tok = "";
+    pthread_once(&kernels_once, choose_kernels);
+    *scanner = s;
+    return 0;
+}
+
+int yylex_destroy(yyscan_t scanner) {
+    FastScanner *s = (FastScanner *)scanner;
+    free(s->owned);
+    free(s->text);
+    free(s);
+    return 0;
+}
+
+void yyset_in(FILE *in, yyscan_t scanner) { ((FastScanner *)scanner)->in = in; }
+
+void yyset_lineno(int line, yyscan_t scanner) {
+    FastScanner *s = (FastScanner *)scanner;
+    s->lineno = s->line_start_no = line;
+}
+
+int yyget_lineno(yyscan_t scanner) { return ((FastScanner *)scanner)->lineno; }
+
+/* Copia terminada en 0 del último token; vacía al final del archivo */
+static const char *token_text(FastScanner *s) {
+    if (s->tok_len + 1 > s->text_cap) {
+        size_t cap = s->text_cap ? s->text_cap : 64;
+        while (cap < s->tok_len + 1) cap *= 2;
+        char *text = (char *)realloc(s->text, cap);
+        if (text == NULL) return "";
+        s->text = text;
+        s->text_cap = cap;
+    }
+    memcpy(s->text, s->tok, s->tok_len);
+    s->text[s->tok_len] = '\0';
+    return s->text;
+}
+
+char *yyget_text(yyscan_t scanner) { return (char *)token_text((FastScanner *)scanner); }
+
+struct yy_buffer_state *yy_scan_buffer(char *base, size_t size, yyscan_t scanner) {
+    FastScanner *s = (FastScanner *)scanner;
+    // Mismo contrato que flex: los dos últimos bytes en 0
+    if (size < 2 || base[size - 2] != '\0' || base[size - 1] != '\0') return NULL;
+    struct yy_buffer_state *b = (struct yy_buffer_state *)malloc(sizeof(*b));
+    if (b == NULL) return NULL;
+    b->base = base;
+    b->len = size - 2;
+    s->pos = s->line_start = base;
+    s->end = base + b->len;
+    s->line_start_no = s->lineno;
+    s->loaded = 1;
+    return b;
+}
+
+void yy_delete_buffer(struct yy_buffer_state *b, yyscan_t scanner) {
+    (void)scanner;
+    free(b);
+}
+
+/* Con yyset_in el fuente se lee entero la primera vez */
+static void load_stream(FastScanner *s) {
+    FILE *in = s->in ? s->in : stdin;
+    size_t cap = 1 << 16, len = 0, got;
+    char *buf = (char *)malloc(cap);
+    while (buf != NULL && (got = fread(buf + len, 1, cap - len - 2, in)) > 0) {
+        len += got;
+        if (cap - len - 2 == 0) {
+            char *bigger = (char *)realloc(buf, cap * 2);
+            if (bigger == NULL) break;
+            buf = bigger;
+            cap *= 2;
+        }
+    }
+    if (buf == NULL) {
+        diag_report(&s->extra->diags, DIAG_ERROR, NULL, DIAG_NO_LOC,
+                    "sin memoria para leer el fuente");
+        buf = (char *)calloc(1, 2);
+        len = 0;
+        if (buf == NULL) abort();
+    }
+    buf[len] = buf[len + 1] = '\0';
+    s->owned = buf;
+    s->pos = s->line_start = buf;
+    s->end = buf + len;
+    s->line_start_no = s->lineno;
+    s->loaded = 1;
+}
+
+/* Fin de la cadena que abre p[0] según \"(\\.|[^\"])*\" con la coincidencia
+   más larga de flex: se puede seguir después de una comilla solo si la
+   precede una barra. NULL si no hay comilla de cierre. */
+static const char *string_end(const char *p, const char *end) {
+    const char *last = NULL;
+    for (const char *q = p + 1; q < end; ++q) {
+        if (*q != '"') continue;
+        last = q + 1;
+        if (q[-1] != '\\') break;
+    }
+    return last;
+}
+
+static int count_lines(const char *p, const char *end) {
+    int lines = 0;
+    for (; p < end; ++p) lines += *p == '\n';
+    return lines;
+}
+
+/* Columna (en bytes, desde 1) de 'q', que está en la línea 'line'. Los
+   saltos solo cuentan líneas; el comienzo de la línea se busca hacia atrás
+   cuando cambió, así que el costo es el del texto que ya se recorrió. */
+static int column_at(FastScanner *s, const char *q, int line) {
+    if (line != s->line_start_no) {
+        for (const char *r = q; r > s->line_start; --r) {
+            if (r[-1] == '\n') {
+                s->line_start = r;
+                break;
+            }
+        }
+        s->line_start_no = line;
+    }
+    return (int)(q - s->line_start) + 1;
+}
+
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner) {
+    FastScanner *s = (FastScanner *)scanner;
+    if (!s->loaded) load_stream(s);
+    const ScanKernels *k = kernels;
+    const char *p = s->pos, *end = s->end;
+    const char *start;
+    int token, line;
+
+    for (;;) {
+        if (p >= end) {
+            s->pos = p;
+            s->tok = p;
+            s->tok_len = 0;
+            yylloc->first_line = yylloc->last_line = s->lineno;
+            yylloc->first_column = yylloc->last_column = column_at(s, p, s->lineno);
+            return 0;
+        }
+        start = p;
+        line = s->lineno;
+        unsigned char c = (unsigned char)*p;
+
+        if (is_space(c)) {
+            // Un espacio suelto es lo más común: no vale la pena ir por SIMD
+            if (c == '\n') s->lineno++;
+            if (p + 1 < end && is_space((unsigned char)p[1])) {
+                p = k->skip_space(p + 1, end, &s->lineno);
+            } else {
+                p++;
+            }
+            continue;
+        }
+
+        if ((unsigned)((c | 32) - 'a') < 26 || c == '_') {
+            while (p < end && is_ident((unsigned char)*p)) p++;
+            size_t n = (size_t)(p - start);
+            token = keyword(start, &n, end);
+            p = start + n;
+            if (token == T_ID) {
+                yylval->sval = intern_n(start, n);
+            } else if (token == T_TRUE || token == T_FALSE) {
+                yylval->type = TYPE_BOOL;
+            }
+            break;
+        }
+
+        if (is_digit(c)) {
+            while (p < end && is_digit((unsigned char)*p)) p++;
+            token = T_LITERAL_INT;
+            if (end - p >= 2 && *p == '.' && is_digit((unsigned char)p[1])) {
+                p += 2;
+                while (p < end && is_digit((unsigned char)*p)) p++;
+                token = T_LITERAL_FLOAT;
+                // Exponente solo si está completo: "1.5e" es 1.5 y el id e
+                const char *q = p;
+                if (q < end && (*q == 'e' || *q == 'E')) {
+                    q++;
+                    if (q < end && (*q == '+' || *q == '-')) q++;
+                    if (q < end && is_digit((unsigned char)*q)) {
+                        while (q < end && is_digit((unsigned char)*q)) q++;
+                        p = q;
+                    }
+                }
+            }
+            s->tok = start;
+            s->tok_len = (size_t)(p - start);
+            const char *text = token_text(s);
+            if (token == T_LITERAL_INT) {
+                yylval->type = TYPE_INT;
+                yylval->ival = atoi(text);
+            } else {
+                yylval->type = TYPE_FLOAT;
+                yylval->fval = atof(text);
+            }
+            break;
+        }
+
+        if (c == '"') {
+            const char *close = string_end(p, end);
+            if (close != NULL) {
+                p = close;
+                s->lineno += count_lines(start, p);
+                yylval->type = TYPE_STRING;
+                yylval->sval = intern_n(start, (size_t)(p - start));
+                token = T_LITERAL_STRING;
+                break;
+            }
+            // Sin cierre la comilla sola es un carácter no reconocido (abajo)
+        } else if (c == '/' && p + 1 < end && p[1] == '*') {
+            p += 2;
+            for (;;) {
+                p = k->find(p, end, '*', &s->lineno);
+                if (p >= end) break;              // sin cerrar: termina el archivo
+                while (p < end && *p == '*') p++;
+                if (p < end && *p == '/') {
+                    p++;
+                    break;
+                }
+            }
+            continue;
+        } else if (c == '/' && p + 1 < end && p[1] == '/') {
+            p = k->find(p + 2, end, '\n', &s->lineno);
+            continue;
+        }
+
+        p++;
+        switch (c) {
+            case '=': token = T_ASSIGN; break;
+            case ';': token = T_SEMICOLON; break;
+            case '+': token = T_PLUS; break;
+            case '-': token = T_MINUS; break;
+            case '*': token = T_MULT; break;
+            case '/': token = T_DIV; break;
+            case '(': token = T_LPAREN; break;
+            case ')': token = T_RPAREN; break;
+            case '[': token = T_LBRACKET; break;
+            case ']': token = T_RBRACKET; break;
+            case '.': token = T_DOT; break;
+            case ',': token = T_COMMA; break;
+            case '{': token = T_LBRACE; break;
+            case '}': token = T_RBRACE; break;
+            default: {
+                char text[2] = { (char)c, '\0' };
+                diag_report(&s->extra->diags, DIAG_ERROR, "léxico",
+                            (DiagLoc){ line, column_at(s, start, line) },
+                            "Carácter no reconocido: %s", text);
+                continue;
+            }
+        }
+        break;
+    }
+
+    s->pos = p;
+    s->tok = start;
+    s->tok_len = (size_t)(p - start);
+    yylloc->first_line = line;
+    yylloc->first_column = column_at(s, start, line);
+    yylloc->last_line = s->lineno;
+    yylloc->last_column = column_at(s, p, s->lineno);
+    return token;
+}
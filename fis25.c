@@ -0,0 +1,478 @@
+// fis25.c
+
+#include "fis25.h"
+#include "intern.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *op_names[FIS_NUM_OPS] = {
+    "ASSIGN", "ADD", "SUB", "MUL", "DIV", "LT", "GT", "EQ",
+    "IF", "GOTO", "LABEL", "PIXEL", "KEY", "INPUT", "PRINT", "//"
+};
+
+const char *fis25_op_name(Fis25Op op) {
+    return (op < FIS_NUM_OPS) ? op_names[op] : "?";
+}
+
+static void *xrealloc(void *p, size_t size) {
+    void *q = realloc(p, size);
+    if (q == NULL) {
+        perror("Error de memoria en el programa FIS-25");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+// ---------------- Tabla de nombres ----------------
+
+static size_t hash_ptr(const char *s) {
+    uint64_t h = (uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+static int32_t map_get(const Fis25NameMap *m, const char *key) {
+    if (m->cap == 0) return -1;
+    size_t i = hash_ptr(key) & (m->cap - 1);
+    while (m->keys[i] != NULL) {
+        if (m->keys[i] == key) return m->vals[i];
+        i = (i + 1) & (m->cap - 1);
+    }
+    return -1;
+}
+
+static void map_put(Fis25NameMap *m, const char *key, int32_t val);
+
+static void map_grow(Fis25NameMap *m) {
+    Fis25NameMap old = *m;
+    m->cap = old.cap ? old.cap * 2 : 64;
+    m->count = 0;
+    m->keys = (const char **)calloc(m->cap, sizeof(*m->keys));
+    m->vals = (int32_t *)calloc(m->cap, sizeof(*m->vals));
+    if (m->keys == NULL || m->vals == NULL) {
+        perror("Error de memoria en el programa FIS-25");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < old.cap; ++i) {
+        if (old.keys[i] != NULL) map_put(m, old.keys[i], old.vals[i]);
+    }
+    free(old.keys);
+    free(old.vals);
+}
+
+static void map_put(Fis25NameMap *m, const char *key, int32_t val) {
+    if ((m->count + 1) * 2 > m->cap) map_grow(m);
+    size_t i = hash_ptr(key) & (m->cap - 1);
+    while (m->keys[i] != NULL && m->keys[i] != key) i = (i + 1) & (m->cap - 1);
+    if (m->keys[i] == NULL) m->count++;
+    m->keys[i] = key;
+    m->vals[i] = val;
+}
+
+static void map_free(Fis25NameMap *m) {
+    free(m->keys);
+    free(m->vals);
+    memset(m, 0, sizeof(*m));
+}
+
+// ---------------- Construcción ----------------
+
+void fis25_init(Fis25Program *p) {
+    memset(p, 0, sizeof(*p));
+}
+
+void fis25_free(Fis25Program *p) {
+    free(p->code);
+    free(p->vars);
+    free(p->labels);
+    free(p->strings);
+    map_free(&p->var_map);
+    map_free(&p->label_map);
+    memset(p, 0, sizeof(*p));
+}
+
+int32_t fis25_find_var(const Fis25Program *p, const char *name) {
+    return map_get(&p->var_map, intern(name));
+}
+
+int32_t fis25_var(Fis25Program *p, const char *name, const char *comment) {
+    name = intern(name);
+    int32_t idx = map_get(&p->var_map, name);
+    if (idx >= 0) return idx;
+
+    if (p->nvars == p->cap_vars) {
+        p->cap_vars = p->cap_vars ? p->cap_vars * 2 : 32;
+        p->vars = (Fis25Var *)xrealloc(p->vars, p->cap_vars * sizeof(*p->vars));
+    }
+    idx = (int32_t)p->nvars++;
+    p->vars[idx].name = name;
+    p->vars[idx].comment = comment;
+    map_put(&p->var_map, name, idx);
+    return idx;
+}
+
+void fis25_remap_vars(Fis25Program *p, const int32_t *slot_of, const int32_t *rep, size_t nslots) {
+    Fis25Var *vars = (Fis25Var *)xrealloc(NULL, (nslots ? nslots : 1) * sizeof(*vars));
+    for (size_t k = 0; k < nslots; ++k) vars[k] = p->vars[rep[k]];
+
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        if (in->a.kind == FIS_VAR) in->a.val = slot_of[in->a.val];
+        if (in->b.kind == FIS_VAR) in->b.val = slot_of[in->b.val];
+        if (in->c.kind == FIS_VAR) in->c.val = slot_of[in->c.val];
+    }
+
+    free(p->vars);
+    map_free(&p->var_map);
+    p->vars = vars;
+    p->nvars = p->cap_vars = nslots;
+    for (size_t k = 0; k < nslots; ++k) map_put(&p->var_map, vars[k].name, (int32_t)k);
+}
+
+int32_t fis25_label(Fis25Program *p, const char *name) {
+    name = intern(name);
+    int32_t idx = map_get(&p->label_map, name);
+    if (idx >= 0) return idx;
+
+    if (p->nlabels == p->cap_labels) {
+        p->cap_labels = p->cap_labels ? p->cap_labels * 2 : 32;
+        p->labels = (const char **)xrealloc(p->labels, p->cap_labels * sizeof(*p->labels));
+    }
+    idx = (int32_t)p->nlabels++;
+    p->labels[idx] = name;
+    map_put(&p->label_map, name, idx);
+    return idx;
+}
+
+int32_t fis25_string(Fis25Program *p, const char *literal) {
+    literal = intern(literal);
+    for (size_t i = 0; i < p->nstrings; ++i) {
+        if (p->strings[i] == literal) return (int32_t)i;
+    }
+    if (p->nstrings == p->cap_strings) {
+        p->cap_strings = p->cap_strings ? p->cap_strings * 2 : 8;
+        p->strings = (const char **)xrealloc(p->strings, p->cap_strings * sizeof(*p->strings));
+    }
+    p->strings[p->nstrings] = literal;
+    return (int32_t)p->nstrings++;
+}
+
+size_t fis25_emit(Fis25Program *p, Fis25Op op,
+                  Fis25Operand a, Fis25Operand b, Fis25Operand c,
+                  const char *comment) {
+    if (p->len == p->cap) {
+        p->cap = p->cap ? p->cap * 2 : 256;
+        p->code = (Fis25Insn *)xrealloc(p->code, p->cap * sizeof(*p->code));
+    }
+    Fis25Insn *in = &p->code[p->len];
+    in->op = (uint8_t)op;
+    in->a = a;
+    in->b = b;
+    in->c = c;
+    in->comment = comment;
+    return p->len++;
+}
+
+void fis25_note(Fis25Program *p, const char *text) {
+    fis25_emit(p, FIS_NOTE, fis_none(), fis_none(), fis_none(), text);
+}
+
+int fis25_resolve_labels(const Fis25Program *p, long *label_pos, FILE *err) {
+    int errors = 0;
+    for (size_t i = 0; i < p->nlabels; ++i) label_pos[i] = -1;
+
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op != FIS_LABEL) continue;
+        if (label_pos[in->c.val] >= 0) {
+            if (err) fprintf(err, "FIS-25: etiqueta '%s' definida más de una vez\n",
+                             p->labels[in->c.val]);
+            errors++;
+        }
+        label_pos[in->c.val] = (long)i;
+    }
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if ((in->op == FIS_IF || in->op == FIS_GOTO) && label_pos[in->c.val] < 0) {
+            if (err) fprintf(err, "FIS-25: etiqueta '%s' no definida\n",
+                             p->labels[in->c.val]);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// ---------------- Texto: lectura ----------------
+
+typedef struct {
+    const char *s;
+    const char *end;
+    int line;
+    FILE *err;
+    int errors;
+} Lexer;
+
+static void skip_spaces(Lexer *lx) {
+    while (lx->s < lx->end && (*lx->s == ' ' || *lx->s == '\t' || *lx->s == '\r')) lx->s++;
+}
+
+// Lee la siguiente palabra (identificador, número o cadena) de la línea
+static int next_word(Lexer *lx, const char **start, size_t *len) {
+    skip_spaces(lx);
+    if (lx->s >= lx->end || *lx->s == '\n') return 0;
+    if (lx->s + 1 < lx->end && lx->s[0] == '/' && lx->s[1] == '/') return 0;
+
+    const char *p = lx->s;
+    if (*p == '"') {
+        p++;
+        while (p < lx->end && *p != '"' && *p != '\n') {
+            if (*p == '\\' && p + 1 < lx->end) p++;
+            p++;
+        }
+        if (p < lx->end && *p == '"') p++;
+    } else {
+        while (p < lx->end && !isspace((unsigned char)*p)) p++;
+    }
+    *start = lx->s;
+    *len = (size_t)(p - lx->s);
+    lx->s = p;
+    return 1;
+}
+
+// Comentario final de la línea (sin "//" ni espacios), o NULL
+static const char *line_comment(Lexer *lx) {
+    skip_spaces(lx);
+    const char *comment = NULL;
+    if (lx->s + 1 < lx->end && lx->s[0] == '/' && lx->s[1] == '/') {
+        const char *p = lx->s + 2;
+        while (p < lx->end && *p == ' ') p++;
+        const char *q = p;
+        while (q < lx->end && *q != '\n') q++;
+        const char *e = q;
+        while (e > p && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r')) e--;
+        comment = intern_n(p, (size_t)(e - p));
+        lx->s = q;
+    } else if (lx->s < lx->end && *lx->s != '\n') {
+        fprintf(lx->err, "FIS-25 línea %d: texto sobrante\n", lx->line);
+        lx->errors++;
+        while (lx->s < lx->end && *lx->s != '\n') lx->s++;
+    }
+    return comment;
+}
+
+static void parse_error(Lexer *lx, const char *what, const char *w, size_t n) {
+    fprintf(lx->err, "FIS-25 línea %d: %s '%.*s'\n", lx->line, what, (int)n, w);
+    lx->errors++;
+}
+
+static int is_number(const char *w, size_t n) {
+    size_t i = (n > 0 && w[0] == '-') ? 1 : 0;
+    if (i == n) return 0;
+    for (; i < n; ++i) if (!isdigit((unsigned char)w[i])) return 0;
+    return 1;
+}
+
+// kinds: combinación de bits (1 << FIS_VAR) | (1 << FIS_IMM) | ...
+static Fis25Operand read_operand(Lexer *lx, Fis25Program *p, unsigned kinds) {
+    const char *w;
+    size_t n;
+    if (!next_word(lx, &w, &n)) {
+        fprintf(lx->err, "FIS-25 línea %d: falta un operando\n", lx->line);
+        lx->errors++;
+        return fis_none();
+    }
+    if (is_number(w, n)) {
+        if (!(kinds & (1u << FIS_IMM))) parse_error(lx, "se esperaba una variable y no", w, n);
+        return fis_imm((int32_t)strtol(w, NULL, 10));
+    }
+    if (w[0] == '"') {
+        if (!(kinds & (1u << FIS_STR))) parse_error(lx, "cadena no permitida", w, n);
+        return fis_str(fis25_string(p, intern_n(w, n)));
+    }
+    if (kinds & (1u << FIS_LBL)) {
+        return fis_lbl(fis25_label(p, intern_n(w, n)));
+    }
+    int32_t v = map_get(&p->var_map, intern_n(w, n));
+    if (v < 0) {
+        parse_error(lx, "variable no declarada", w, n);
+        return fis_imm(0);
+    }
+    return fis_var(v);
+}
+
+static int word_is(const char *w, size_t n, const char *kw) {
+    return strlen(kw) == n && memcmp(w, kw, n) == 0;
+}
+
+int fis25_parse(const char *text, size_t len, Fis25Program *p, FILE *err) {
+    const unsigned SRC = (1u << FIS_VAR) | (1u << FIS_IMM);
+    const unsigned DST = (1u << FIS_VAR);
+    const unsigned LBL = (1u << FIS_LBL);
+    int vars_seen = 0;
+    Lexer lx = { text, text + len, 1, err, 0 };
+
+    while (lx.s < lx.end) {
+        const char *w;
+        size_t n;
+
+        if (!next_word(&lx, &w, &n)) {
+            // Línea vacía o solo comentario
+            const char *comment = line_comment(&lx);
+            fis25_note(p, comment);
+        } else if (word_is(w, n, "VAR")) {
+            const char *name;
+            size_t name_len;
+            if (!next_word(&lx, &name, &name_len)) {
+                parse_error(&lx, "VAR sin nombre", w, n);
+            } else {
+                if (!vars_seen) p->var_decl_pos = p->len;
+                vars_seen = 1;
+                int32_t idx = fis25_var(p, intern_n(name, name_len), NULL);
+                p->vars[idx].comment = line_comment(&lx);
+            }
+        } else {
+            Fis25Operand a = fis_none(), b = fis_none(), c = fis_none();
+            Fis25Op op;
+
+            if (word_is(w, n, "ASSIGN")) {
+                op = FIS_ASSIGN;
+                a = read_operand(&lx, p, SRC);
+                c = read_operand(&lx, p, DST);
+            } else if (word_is(w, n, "ADD") || word_is(w, n, "SUB") ||
+                       word_is(w, n, "MUL") || word_is(w, n, "DIV") ||
+                       word_is(w, n, "LT")  || word_is(w, n, "GT")  ||
+                       word_is(w, n, "EQ")) {
+                op = word_is(w, n, "ADD") ? FIS_ADD :
+                     word_is(w, n, "SUB") ? FIS_SUB :
+                     word_is(w, n, "MUL") ? FIS_MUL :
+                     word_is(w, n, "DIV") ? FIS_DIV :
+                     word_is(w, n, "LT")  ? FIS_LT  :
+                     word_is(w, n, "GT")  ? FIS_GT  : FIS_EQ;
+                a = read_operand(&lx, p, SRC);
+                b = read_operand(&lx, p, SRC);
+                c = read_operand(&lx, p, DST);
+            } else if (word_is(w, n, "IF")) {
+                const char *g;
+                size_t gn;
+                op = FIS_IF;
+                a = read_operand(&lx, p, SRC);
+                if (!next_word(&lx, &g, &gn) || !word_is(g, gn, "GOTO")) {
+                    parse_error(&lx, "se esperaba GOTO en", w, n);
+                }
+                c = read_operand(&lx, p, LBL);
+            } else if (word_is(w, n, "GOTO")) {
+                op = FIS_GOTO;
+                c = read_operand(&lx, p, LBL);
+            } else if (word_is(w, n, "LABEL")) {
+                op = FIS_LABEL;
+                c = read_operand(&lx, p, LBL);
+            } else if (word_is(w, n, "PIXEL")) {
+                op = FIS_PIXEL;
+                a = read_operand(&lx, p, SRC);
+                b = read_operand(&lx, p, SRC);
+                c = read_operand(&lx, p, SRC);
+            } else if (word_is(w, n, "KEY")) {
+                op = FIS_KEY;
+                a = read_operand(&lx, p, SRC);
+                c = read_operand(&lx, p, DST);
+            } else if (word_is(w, n, "INPUT")) {
+                op = FIS_INPUT;
+                c = read_operand(&lx, p, DST);
+            } else if (word_is(w, n, "PRINT")) {
+                op = FIS_PRINT;
+                a = read_operand(&lx, p, SRC | (1u << FIS_STR));
+            } else {
+                parse_error(&lx, "instrucción desconocida", w, n);
+                line_comment(&lx);
+                goto next_line;
+            }
+            fis25_emit(p, op, a, b, c, line_comment(&lx));
+        }
+    next_line:
+        if (lx.s < lx.end && *lx.s == '\n') {
+            lx.s++;
+            lx.line++;
+        }
+    }
+
+    if (!vars_seen) p->var_decl_pos = 0;
+    return lx.errors;
+}
+
+// ---------------- Texto: escritura ----------------
+
+static void write_operand(const Fis25Program *p, Fis25Operand o, Emitter *e) {
+    switch (o.kind) {
+        case FIS_VAR: emitter_puts(e, p->vars[o.val].name); break;
+        case FIS_IMM: emitter_int(e, o.val); break;
+        case FIS_LBL: emitter_puts(e, p->labels[o.val]); break;
+        case FIS_STR: emitter_puts(e, p->strings[o.val]); break;
+        default: break;
+    }
+}
+
+static void write_vars(const Fis25Program *p, Emitter *e) {
+    for (size_t i = 0; i < p->nvars; ++i) {
+        size_t line = e->len;
+        emitter_write(e, "VAR ", 4);
+        emitter_puts(e, p->vars[i].name);
+        if (p->vars[i].comment) {
+            emitter_pad_to(e, line, 17);     // "VAR %-13s"
+            emitter_write(e, "// ", 3);
+            emitter_puts(e, p->vars[i].comment);
+        }
+        emitter_putc(e, '\n');
+    }
+}
+
+void fis25_write(const Fis25Program *p, Emitter *e) {
+    // ~24 bytes por instrucción evita casi todas las realocaciones
+    emitter_reserve(e, p->len * 24 + p->nvars * 24);
+    for (size_t i = 0; i <= p->len; ++i) {
+        if (i == p->var_decl_pos) write_vars(p, e);
+        if (i == p->len) break;
+
+        const Fis25Insn *in = &p->code[i];
+        switch ((Fis25Op)in->op) {
+            case FIS_NOTE:
+                if (in->comment) {
+                    emitter_write(e, "// ", 3);
+                    emitter_puts(e, in->comment);
+                }
+                emitter_putc(e, '\n');
+                continue;
+            case FIS_LABEL:
+                emitter_write(e, "LABEL ", 6);
+                emitter_puts(e, p->labels[in->c.val]);
+                break;
+            case FIS_IF:
+                emitter_write(e, "    IF ", 7);
+                write_operand(p, in->a, e);
+                emitter_write(e, " GOTO ", 6);
+                emitter_puts(e, p->labels[in->c.val]);
+                break;
+            default:
+                emitter_write(e, "    ", 4);
+                emitter_puts(e, fis25_op_name((Fis25Op)in->op));
+                if (in->a.kind != FIS_NONE) { emitter_putc(e, ' '); write_operand(p, in->a, e); }
+                if (in->b.kind != FIS_NONE) { emitter_putc(e, ' '); write_operand(p, in->b, e); }
+                if (in->c.kind != FIS_NONE) { emitter_putc(e, ' '); write_operand(p, in->c, e); }
+                break;
+        }
+        if (in->comment) {
+            emitter_write(e, "    // ", 7);
+            emitter_puts(e, in->comment);
+        }
+        emitter_putc(e, '\n');
+    }
+}
+
+void fis25_print(const Fis25Program *p, FILE *out) {
+    Emitter e;
+    emitter_init(&e);
+    fis25_write(p, &e);
+    fwrite(e.buf, 1, e.len, out);
+    emitter_free(&e);
+}
@@ -0,0 +1,168 @@
+// fis25.h
+
+#ifndef FIS25_H
+#define FIS25_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "emitter.h"
+
+/*
+ * Representación en memoria de un programa FIS-25.
+ *
+ * Formato de texto (una instrucción por línea, '//' inicia comentario):
+ *   VAR name
+ *   ASSIGN src dst
+ *   ADD|SUB|MUL|DIV a b dst        LT|GT|EQ a b dst   (dst = 1 si se cumple)
+ *   IF cond GOTO label             GOTO label          LABEL label
+ *   PIXEL x y color                KEY code dst
+ *   INPUT dst                      PRINT valor|"cadena"
+ * Los operandos de lectura pueden ser variables o enteros inmediatos.
+ */
+
+typedef enum {
+    FIS_ASSIGN,
+    FIS_ADD,
+    FIS_SUB,
+    FIS_MUL,
+    FIS_DIV,
+    FIS_LT,
+    FIS_GT,
+    FIS_EQ,
+    FIS_IF,         // IF a GOTO c
+    FIS_GOTO,       // GOTO c
+    FIS_LABEL,      // LABEL c (no se ejecuta)
+    FIS_PIXEL,      // PIXEL a b c
+    FIS_KEY,        // KEY a c
+    FIS_INPUT,      // INPUT c
+    FIS_PRINT,      // PRINT a
+    FIS_NOTE,       // comentario de línea completa o línea en blanco (no se ejecuta)
+    FIS_NUM_OPS
+} Fis25Op;
+
+typedef enum {
+    FIS_NONE,
+    FIS_VAR,        // val = índice en vars
+    FIS_IMM,        // val = entero inmediato
+    FIS_LBL,        // val = índice en labels
+    FIS_STR         // val = índice en strings (solo PRINT)
+} Fis25OperandKind;
+
+typedef struct {
+    uint8_t kind;   // Fis25OperandKind
+    int32_t val;
+} Fis25Operand;
+
+/*
+ * Uso de los operandos por instrucción:
+ *   ASSIGN: a = origen, c = destino
+ *   ADD..EQ: a, b = fuentes, c = destino
+ *   IF: a = condición, c = etiqueta;  GOTO / LABEL: c = etiqueta
+ *   PIXEL: a = x, b = y, c = color;   KEY: a = tecla, c = destino
+ *   INPUT: c = destino;               PRINT: a = valor
+ */
+typedef struct {
+    uint8_t op;             // Fis25Op
+    Fis25Operand a, b, c;
+    const char *comment;    // comentario al final (o texto de FIS_NOTE); puede ser NULL
+} Fis25Insn;
+
+typedef struct {
+    const char *name;       // nombre internado
+    const char *comment;    // puede ser NULL
+} Fis25Var;
+
+// Tabla nombre (internado) -> índice, con direccionamiento abierto
+typedef struct {
+    const char **keys;
+    int32_t *vals;
+    size_t cap, count;
+} Fis25NameMap;
+
+typedef struct {
+    Fis25Insn *code;
+    size_t len, cap;
+
+    Fis25Var *vars;
+    size_t nvars, cap_vars;
+    Fis25NameMap var_map;
+
+    const char **labels;    // nombres internados
+    size_t nlabels, cap_labels;
+    Fis25NameMap label_map;
+
+    const char **strings;   // literales con comillas (internados)
+    size_t nstrings, cap_strings;
+
+    size_t var_decl_pos;    // los VAR se imprimen antes de code[var_decl_pos]
+} Fis25Program;
+
+// ---------- Construcción ----------
+
+void fis25_init(Fis25Program *p);
+void fis25_free(Fis25Program *p);
+
+// Devuelve el índice de la variable (la declara si no existía)
+int32_t fis25_var(Fis25Program *p, const char *name, const char *comment);
+// Índice de la variable o -1 si no está declarada
+int32_t fis25_find_var(const Fis25Program *p, const char *name);
+/**
+ * @brief Renumera las variables: la variable v pasa a ser slot_of[v].
+ *
+ * El slot k toma el nombre y comentario de la variable rep[k]. Las variables
+ * con slot_of[v] == -1 se descartan (no deben aparecer en el código).
+ */
+void fis25_remap_vars(Fis25Program *p, const int32_t *slot_of, const int32_t *rep, size_t nslots);
+// Devuelve el índice de la etiqueta (la registra si no existía)
+int32_t fis25_label(Fis25Program *p, const char *name);
+int32_t fis25_string(Fis25Program *p, const char *literal);
+
+static inline Fis25Operand fis_none(void)      { Fis25Operand o = { FIS_NONE, 0 }; return o; }
+static inline Fis25Operand fis_var(int32_t v)  { Fis25Operand o = { FIS_VAR, v };  return o; }
+static inline Fis25Operand fis_imm(int32_t v)  { Fis25Operand o = { FIS_IMM, v };  return o; }
+static inline Fis25Operand fis_lbl(int32_t l)  { Fis25Operand o = { FIS_LBL, l };  return o; }
+static inline Fis25Operand fis_str(int32_t s)  { Fis25Operand o = { FIS_STR, s };  return o; }
+
+static inline int fis_same_operand(Fis25Operand x, Fis25Operand y) {
+    return x.kind == y.kind && x.val == y.val;
+}
+
+// Agrega una instrucción al final y devuelve su posición
+size_t fis25_emit(Fis25Program *p, Fis25Op op,
+                  Fis25Operand a, Fis25Operand b, Fis25Operand c,
+                  const char *comment);
+
+// Comentario de línea completa (text == NULL: línea en blanco)
+void fis25_note(Fis25Program *p, const char *text);
+
+// ---------- Consultas ----------
+
+const char *fis25_op_name(Fis25Op op);
+
+// 1 si la instrucción ocupa un ciclo al ejecutarse (no LABEL ni NOTE)
+static inline int fis25_is_executable(Fis25Op op) {
+    return op != FIS_LABEL && op != FIS_NOTE;
+}
+
+/**
+ * @brief Resuelve etiquetas a posiciones de instrucción.
+ * @param label_pos Arreglo de p->nlabels posiciones (salida; -1 = no definida).
+ * @return int 0 si todas las etiquetas usadas están definidas una sola vez.
+ */
+int fis25_resolve_labels(const Fis25Program *p, long *label_pos, FILE *err);
+
+// ---------- Texto ----------
+
+/**
+ * @brief Analiza un programa en formato de texto.
+ * @return int 0 si no hubo errores (se informan en 'err' con su número de línea).
+ */
+int fis25_parse(const char *text, size_t len, Fis25Program *p, FILE *err);
+
+// Agrega el programa en formato de texto al búfer 'e'
+void fis25_write(const Fis25Program *p, Emitter *e);
+// Igual que fis25_write, pero hacia un FILE* (un solo fwrite)
+void fis25_print(const Fis25Program *p, FILE *out);
+
+#endif // FIS25_H
@@ -0,0 +1,226 @@
+// fis25_alloc.c
+
+#include "fis25_alloc.h"
+#include "fis25_opt.h"
+#include "intern.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Asignación de VAR por coloreo del grafo de interferencia.
+ *
+ * d interfiere con v si v está viva a la salida de una instrucción que
+ * escribe d (salvo en 'ASSIGN v d', donde ambas valen lo mismo). Las
+ * variables se colorean en orden de declaración con el menor color libre,
+ * prefiriendo el de alguna variable con la que se copian. Cada VAR se llama
+ * como su primera variable que no sea un temporal del generador.
+ */
+
+// Tope de la matriz de interferencia (en palabras de 64 bits); si el
+// programa lo supera se deja como está.
+#define MAX_GRAPH_WORDS  (1u << 23)
+#define MAX_SHARED_NAMES 4
+
+static void *xcalloc(size_t n, size_t size) {
+    void *q = calloc(n ? n : 1, size);
+    if (q == NULL) {
+        perror("Error de memoria en la asignación de variables");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+static inline void bit_set(uint64_t *set, int32_t v) {
+    set[v >> 6] |= (uint64_t)1 << (v & 63);
+}
+
+static void add_edge(uint64_t *graph, size_t W, int32_t a, int32_t b) {
+    bit_set(&graph[(size_t)a * W], b);
+    bit_set(&graph[(size_t)b * W], a);
+}
+
+static void mark_used(uint8_t *used, Fis25Operand o) {
+    if (o.kind == FIS_VAR) used[o.val] = 1;
+}
+
+// Marca (on = 1) o libera (on = 0) los colores de los vecinos de v
+static void mark_neighbors(const uint64_t *row, size_t W, const int32_t *color,
+                           uint8_t *taken, uint8_t on) {
+    for (size_t w = 0; w < W; ++w) {
+        uint64_t bits = row[w];
+        while (bits) {
+            int32_t u = (int32_t)(w * 64 + (size_t)__builtin_ctzll(bits));
+            bits &= bits - 1;
+            if (color[u] >= 0) taken[color[u]] = on;
+        }
+    }
+}
+
+// Los temporales del generador ("$t3", "$sr0": '$' no aparece en los
+// identificadores de Meow) no dan nombre a un VAR si alguna variable del
+// programa lo comparte.
+static int is_temp(const Fis25Program *p, int32_t v) {
+    return p->vars[v].name[0] == '$';
+}
+
+// "comentario; también b, c" para los VAR que reúnen varias variables
+static const char *shared_comment(const Fis25Program *p, int32_t rep, int32_t first, const int32_t *next) {
+    char buf[256];
+    size_t len = 0;
+    int shown = 0;
+
+    if (p->vars[rep].comment) {
+        len = (size_t)snprintf(buf, sizeof(buf), "%s; ", p->vars[rep].comment);
+        if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    }
+    len += (size_t)snprintf(buf + len, sizeof(buf) - len, "también");
+    for (int32_t v = first; v >= 0 && len < sizeof(buf); v = next[v]) {
+        if (v == rep) continue;
+        if (shown == MAX_SHARED_NAMES) {
+            snprintf(buf + len, sizeof(buf) - len, ", ...");
+            break;
+        }
+        len += (size_t)snprintf(buf + len, sizeof(buf) - len, "%s %s",
+                                shown ? "," : "", p->vars[v].name);
+        shown++;
+    }
+    return intern(buf);
+}
+
+void fis25_alloc_vars(Fis25Program *p, Fis25AllocStats *stats) {
+    size_t n = p->nvars;
+    memset(stats, 0, sizeof(*stats));
+    stats->slots_before = stats->slots_after = (long)n;
+    if (n == 0) return;
+
+    Fis25Liveness lv;
+    if (!fis25_liveness(p, &lv)) return;
+    size_t W = lv.words;
+    if (n * W > MAX_GRAPH_WORDS) {
+        fis25_liveness_free(&lv);
+        return;
+    }
+
+    uint64_t *graph = (uint64_t *)xcalloc(n * W, sizeof(uint64_t));
+    uint64_t *out = (uint64_t *)xcalloc(W, sizeof(uint64_t));
+    uint8_t *used = (uint8_t *)xcalloc(n, 1);
+    // Copias var -> var, agrupadas por variable (ambos sentidos)
+    size_t *move_start = (size_t *)xcalloc(n + 1, sizeof(size_t));
+    int32_t *moves = (int32_t *)xcalloc(2 * p->len, sizeof(int32_t));
+
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op == FIS_NOTE || in->op == FIS_LABEL || in->op == FIS_GOTO) continue;
+        mark_used(used, in->a);
+        mark_used(used, in->b);
+        mark_used(used, in->c);
+        if (!fis25_writes_var(in)) continue;
+
+        int32_t d = in->c.val;
+        int32_t src = (in->op == FIS_ASSIGN && in->a.kind == FIS_VAR) ? in->a.val : -1;
+        fis25_live_out(p, &lv, i, out);
+        for (size_t w = 0; w < W; ++w) {
+            uint64_t bits = out[w];
+            while (bits) {
+                int32_t v = (int32_t)(w * 64 + (size_t)__builtin_ctzll(bits));
+                bits &= bits - 1;
+                if (v != d && v != src) add_edge(graph, W, d, v);
+            }
+        }
+        if (src >= 0 && src != d) {
+            move_start[d + 1]++;
+            move_start[src + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; ++v) move_start[v + 1] += move_start[v];
+    size_t *fill = (size_t *)xcalloc(n, sizeof(size_t));
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op != FIS_ASSIGN || in->a.kind != FIS_VAR || in->a.val == in->c.val) continue;
+        int32_t a = in->a.val, c = in->c.val;
+        moves[move_start[a] + fill[a]++] = c;
+        moves[move_start[c] + fill[c]++] = a;
+    }
+
+    // Coloreo greedy en orden de declaración
+    int32_t *color = (int32_t *)xcalloc(n, sizeof(int32_t));
+    uint8_t *taken = (uint8_t *)xcalloc(n, 1);
+    int32_t ncolors = 0;
+    for (size_t v = 0; v < n; ++v) color[v] = -1;
+    for (size_t v = 0; v < n; ++v) {
+        if (!used[v]) {
+            stats->unused_dropped++;
+            continue;
+        }
+        const uint64_t *row = &graph[v * W];
+        mark_neighbors(row, W, color, taken, 1);
+
+        int32_t c = -1;
+        for (size_t m = move_start[v]; m < move_start[v + 1] && c < 0; ++m) {
+            int32_t u = moves[m];
+            if (color[u] >= 0 && !taken[color[u]]) c = color[u];
+        }
+        if (c < 0) {
+            for (c = 0; c < ncolors && taken[c]; ++c) {}
+            if (c == ncolors) ncolors++;
+        }
+        color[v] = c;
+        mark_neighbors(row, W, color, taken, 0);
+    }
+
+    // Miembros de cada color (en orden); el primero que no sea temporal da el nombre
+    int32_t *first = (int32_t *)xcalloc((size_t)ncolors + 1, sizeof(int32_t));
+    int32_t *rep = (int32_t *)xcalloc((size_t)ncolors + 1, sizeof(int32_t));
+    int32_t *next = (int32_t *)xcalloc(n, sizeof(int32_t));
+    for (int32_t k = 0; k < ncolors; ++k) first[k] = rep[k] = -1;
+    for (size_t v = n; v-- > 0;) {
+        next[v] = -1;
+        int32_t k = color[v];
+        if (k < 0) continue;
+        next[v] = first[k];
+        first[k] = (int32_t)v;
+        if (rep[k] < 0 || is_temp(p, rep[k]) || !is_temp(p, (int32_t)v)) rep[k] = (int32_t)v;
+    }
+    const char **comments = (const char **)xcalloc((size_t)ncolors + 1, sizeof(char *));
+    for (int32_t k = 0; k < ncolors; ++k) {
+        comments[k] = next[first[k]] >= 0 ? shared_comment(p, rep[k], first[k], next)
+                                          : p->vars[rep[k]].comment;
+    }
+
+    fis25_remap_vars(p, color, rep, (size_t)ncolors);
+    for (int32_t k = 0; k < ncolors; ++k) p->vars[k].comment = comments[k];
+
+    // Las copias entre variables del mismo VAR ya no hacen nada
+    size_t w = 0, decl_pos = p->var_decl_pos;
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op == FIS_ASSIGN && fis_same_operand(in->a, in->c)) {
+            stats->moves_coalesced++;
+            if (i < decl_pos) p->var_decl_pos--;
+            continue;
+        }
+        p->code[w++] = *in;
+    }
+    p->len = w;
+    stats->slots_after = ncolors;
+
+    free(comments);
+    free(rep);
+    free(first);
+    free(next);
+    free(taken);
+    free(color);
+    free(fill);
+    free(moves);
+    free(move_start);
+    free(used);
+    free(out);
+    free(graph);
+    fis25_liveness_free(&lv);
+}
+
+void fis25_alloc_report(const Fis25AllocStats *s, FILE *out) {
+    fprintf(out, "Variables: %ld -> %ld VAR (%ld sin uso, %ld copias unificadas)\n",
+            s->slots_before, s->slots_after, s->unused_dropped, s->moves_coalesced);
+}
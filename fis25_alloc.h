@@ -0,0 +1,30 @@
+// fis25_alloc.h
+
+#ifndef FIS25_ALLOC_H
+#define FIS25_ALLOC_H
+
+#include <stdio.h>
+#include "fis25.h"
+
+typedef struct {
+    long slots_before;       // VAR declarados antes de asignar
+    long slots_after;
+    long unused_dropped;     // VAR que ninguna instrucción usa
+    long moves_coalesced;    // ASSIGN a b que quedaron en el mismo slot
+} Fis25AllocStats;
+
+/**
+ * @brief Reparte las variables en el menor número de VAR que encuentra.
+ *
+ * Dos variables comparten VAR si nunca están vivas a la vez (coloreo greedy
+ * del grafo de interferencia construido con la vivacidad del optimizador).
+ * Las variables relacionadas por un ASSIGN prefieren el mismo VAR y el
+ * ASSIGN desaparece. Cada VAR conserva el nombre de una de sus variables
+ * (las del programa antes que los temporales "$tN").
+ */
+void fis25_alloc_vars(Fis25Program *p, Fis25AllocStats *stats);
+
+// Resumen de una línea en 'out'
+void fis25_alloc_report(const Fis25AllocStats *stats, FILE *out);
+
+#endif // FIS25_ALLOC_H
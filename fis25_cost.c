@@ -0,0 +1,1091 @@
+// fis25_cost.c
+
+#include "fis25_cost.h"
+#include "fis25_opt.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Costo estático de un frame.
+ *
+ * El programa se parte en bloques básicos (empiezan en cada LABEL y después
+ * de cada IF/GOTO). Con los dominadores se encuentran los bucles naturales
+ * (arista u -> h con h dominando a u) y su anidamiento. Cada bucle, del más
+ * interno al más externo, se resume en un nodo de costo conocido:
+ *
+ *   costo = n * A + (n - 1) * B
+ *
+ * donde n es el número de veces que se evalúa la condición de salida (en el
+ * bloque T), A son los caminos de la cabecera a T (incluido) y B los de T de
+ * vuelta a la cabecera. n sale de simular la variable de inducción, que es
+ * lo único de lo que depende la salida. Con los bucles internos resumidos y
+ * sin las aristas hacia atrás, el cuerpo de cada bucle es acíclico: el
+ * mejor y el peor caso son su camino más corto y el más largo.
+ *
+ * Todo es iterativo (nada de recursión por nivel de anidamiento).
+ */
+
+#define MAX_TESTS (1L << 24)   // más pruebas que esto se toma como sin cota
+#define MAX_INIT_HOPS 64
+#define END_OF_PROGRAM (-1)
+#define UNBOUNDED FIS25_COST_UNBOUNDED
+
+// Lado de la prueba de salida en que cae un bloque del bucle
+enum { PART_NONE, PART_A, PART_A_ALWAYS, PART_B, PART_B_ALWAYS };
+
+typedef struct {
+    size_t start, end;        // instrucciones [start, end)
+    int64_t cost, pixels;
+    int32_t succ[2];          // END_OF_PROGRAM = sigue de largo al final
+    int nsucc;
+    int32_t loop;             // bucle más interno que lo contiene (-1 = ninguno)
+    int32_t header_of;        // bucle del que es cabecera (-1 = ninguno)
+    int32_t section;          // última etiqueta en el texto (-1 = antes de la primera)
+    int32_t rpo;              // orden en postorden inverso (-1 = inalcanzable)
+    int32_t idom;
+    Fis25Range count;         // veces por frame
+
+    // Trabajo de dag_walk
+    uint32_t mark;
+    int32_t topo;
+    int reached;
+    Fis25Range reach_cost, reach_px;
+    int mandatory;
+    uint8_t part;             // PART_* dentro del bucle que se está resumiendo
+} Block;
+
+typedef struct {
+    int32_t header;
+    int32_t parent;
+    int32_t *body;
+    size_t nbody;
+    int32_t *exits;           // destinos fuera del bucle (sin repetir)
+    size_t nexits;
+
+    int bounded;
+    int64_t tests;            // n
+    int32_t test;             // T
+    int32_t test_next;        // sucesor de T dentro del bucle (la cabecera si T es el último)
+    Fis25Range cost, pixels;  // una entrada al bucle completa
+    Fis25Range entries;       // entradas por frame
+    const char *why;
+} Loop;
+
+typedef struct {
+    const Fis25Program *p;
+    Block *blocks;
+    size_t nblocks;
+    int32_t *label_block;     // bloque que empieza en cada etiqueta
+    int32_t *pred_start, *preds;
+    Loop *loops;
+    size_t nloops;
+    int32_t *value;           // constantes de entrada
+    uint8_t *known;
+    uint32_t epoch;
+} Cost;
+
+// Resultado de recorrer una parte acíclica
+typedef struct {
+    int32_t *order;           // nodos en orden topológico
+    size_t n;
+    Fis25Range cost, pixels;
+    int ended;                // llegó a algún final
+    int stray;                // algún camino termina en otro lado que 'stop'
+} Walk;
+
+static void *xmalloc(size_t size) {
+    void *q = malloc(size ? size : 1);
+    if (q == NULL) {
+        perror("Error de memoria en el análisis de costo");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+/* ================= Aritmética con saturación ================= */
+
+static int64_t sat_add(int64_t a, int64_t b) {
+    if (a == UNBOUNDED || b == UNBOUNDED || a > UNBOUNDED - b) return UNBOUNDED;
+    return a + b;
+}
+
+static int64_t sat_mul(int64_t a, int64_t b) {
+    if (a == 0 || b == 0) return 0;
+    if (a == UNBOUNDED || b == UNBOUNDED || a > UNBOUNDED / b) return UNBOUNDED;
+    return a * b;
+}
+
+static Fis25Range range(int64_t lo, int64_t hi) {
+    Fis25Range r = { lo, hi };
+    return r;
+}
+
+static Fis25Range range_add(Fis25Range x, Fis25Range y) {
+    return range(sat_add(x.lo, y.lo), sat_add(x.hi, y.hi));
+}
+
+static Fis25Range range_mul(Fis25Range x, Fis25Range y) {
+    return range(sat_mul(x.lo, y.lo), sat_mul(x.hi, y.hi));
+}
+
+static Fis25Range range_union(Fis25Range x, Fis25Range y) {
+    return range(x.lo < y.lo ? x.lo : y.lo, x.hi > y.hi ? x.hi : y.hi);
+}
+
+/* ================= Bloques y bucles ================= */
+
+static int is_jump(uint8_t op) {
+    return op == FIS_IF || op == FIS_GOTO;
+}
+
+static void build_blocks(Cost *c, const long *label_pos) {
+    const Fis25Program *p = c->p;
+    uint8_t *leader = (uint8_t *)calloc(p->len + 1, 1);
+    int32_t *block_at = (int32_t *)xmalloc((p->len + 1) * sizeof(int32_t));
+    if (leader == NULL) {
+        perror("Error de memoria en el análisis de costo");
+        exit(EXIT_FAILURE);
+    }
+
+    leader[0] = 1;
+    for (size_t i = 0; i < p->len; ++i) {
+        if (p->code[i].op == FIS_LABEL) leader[i] = 1;
+        if (is_jump(p->code[i].op)) leader[i + 1] = 1;
+    }
+    c->nblocks = 0;
+    for (size_t i = 0; i < p->len; ++i) c->nblocks += leader[i];
+    c->blocks = (Block *)calloc(c->nblocks ? c->nblocks : 1, sizeof(Block));
+    if (c->blocks == NULL) {
+        perror("Error de memoria en el análisis de costo");
+        exit(EXIT_FAILURE);
+    }
+
+    int32_t b = -1, section = -1;
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (leader[i]) {
+            b++;
+            c->blocks[b].start = i;
+            if (in->op == FIS_LABEL) section = in->c.val;
+            c->blocks[b].section = section;
+            c->blocks[b].loop = -1;
+            c->blocks[b].header_of = -1;
+        }
+        c->blocks[b].end = i + 1;
+        block_at[i] = b;
+        if (fis25_is_executable((Fis25Op)in->op)) c->blocks[b].cost++;
+        if (in->op == FIS_PIXEL) c->blocks[b].pixels++;
+    }
+    for (size_t l = 0; l < p->nlabels; ++l) {
+        c->label_block[l] = label_pos[l] >= 0 ? block_at[label_pos[l]] : -1;
+    }
+
+    for (size_t k = 0; k < c->nblocks; ++k) {
+        Block *blk = &c->blocks[k];
+        int32_t next = k + 1 < c->nblocks ? (int32_t)k + 1 : END_OF_PROGRAM;
+        const Fis25Insn *last = NULL;
+        for (size_t i = blk->start; i < blk->end; ++i) {
+            if (p->code[i].op != FIS_NOTE) last = &p->code[i];
+        }
+        if (last != NULL && last->op == FIS_GOTO) {
+            blk->succ[blk->nsucc++] = c->label_block[last->c.val];
+        } else if (last != NULL && last->op == FIS_IF) {
+            blk->succ[blk->nsucc++] = c->label_block[last->c.val];
+            blk->succ[blk->nsucc++] = next;
+        } else {
+            blk->succ[blk->nsucc++] = next;
+        }
+    }
+    free(block_at);
+    free(leader);
+}
+
+static void build_preds(Cost *c) {
+    size_t n = c->nblocks;
+    c->pred_start = (int32_t *)calloc(n + 1, sizeof(int32_t));
+    if (c->pred_start == NULL) {
+        perror("Error de memoria en el análisis de costo");
+        exit(EXIT_FAILURE);
+    }
+    size_t total = 0;
+    for (size_t b = 0; b < n; ++b) {
+        for (int k = 0; k < c->blocks[b].nsucc; ++k) {
+            int32_t s = c->blocks[b].succ[k];
+            if (s != END_OF_PROGRAM) c->pred_start[s + 1]++, total++;
+        }
+    }
+    for (size_t b = 0; b < n; ++b) c->pred_start[b + 1] += c->pred_start[b];
+    c->preds = (int32_t *)xmalloc(total * sizeof(int32_t));
+    int32_t *fill = (int32_t *)xmalloc(n * sizeof(int32_t));
+    memcpy(fill, c->pred_start, n * sizeof(int32_t));
+    for (size_t b = 0; b < n; ++b) {
+        for (int k = 0; k < c->blocks[b].nsucc; ++k) {
+            int32_t s = c->blocks[b].succ[k];
+            if (s != END_OF_PROGRAM) c->preds[fill[s]++] = (int32_t)b;
+        }
+    }
+    free(fill);
+}
+
+// Postorden inverso desde el bloque 0 (DFS iterativa); devuelve los bloques en ese orden
+static int32_t *reverse_postorder(Cost *c, size_t *count) {
+    size_t n = c->nblocks;
+    int32_t *order = (int32_t *)xmalloc(n * sizeof(int32_t));
+    int32_t *stack = (int32_t *)xmalloc(n * sizeof(int32_t));
+    int *next = (int *)calloc(n, sizeof(int));
+    uint8_t *seen = (uint8_t *)calloc(n, 1);
+    size_t sp = 0, post = 0;
+
+    stack[sp++] = 0;
+    seen[0] = 1;
+    while (sp > 0) {
+        int32_t b = stack[sp - 1];
+        Block *blk = &c->blocks[b];
+        if (next[b] < blk->nsucc) {
+            int32_t s = blk->succ[next[b]++];
+            if (s != END_OF_PROGRAM && !seen[s]) {
+                seen[s] = 1;
+                stack[sp++] = s;
+            }
+            continue;
+        }
+        order[post++] = b;
+        sp--;
+    }
+    for (size_t i = 0; i < post / 2; ++i) {
+        int32_t t = order[i];
+        order[i] = order[post - 1 - i];
+        order[post - 1 - i] = t;
+    }
+    for (size_t b = 0; b < n; ++b) c->blocks[b].rpo = -1;
+    for (size_t i = 0; i < post; ++i) c->blocks[order[i]].rpo = (int32_t)i;
+
+    free(seen);
+    free(next);
+    free(stack);
+    *count = post;
+    return order;
+}
+
+// Dominadores inmediatos (Cooper, Harvey y Kennedy)
+static void dominators(Cost *c, const int32_t *order, size_t count) {
+    for (size_t b = 0; b < c->nblocks; ++b) c->blocks[b].idom = -1;
+    c->blocks[0].idom = 0;
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t i = 1; i < count; ++i) {
+            int32_t b = order[i];
+            int32_t idom = -1;
+            for (int32_t k = c->pred_start[b]; k < c->pred_start[b + 1]; ++k) {
+                int32_t q = c->preds[k];
+                if (c->blocks[q].idom < 0) continue;
+                if (idom < 0) {
+                    idom = q;
+                    continue;
+                }
+                int32_t x = q, y = idom;
+                while (x != y) {
+                    while (c->blocks[x].rpo > c->blocks[y].rpo) x = c->blocks[x].idom;
+                    while (c->blocks[y].rpo > c->blocks[x].rpo) y = c->blocks[y].idom;
+                }
+                idom = x;
+            }
+            if (idom != c->blocks[b].idom) {
+                c->blocks[b].idom = idom;
+                changed = 1;
+            }
+        }
+    }
+}
+
+static int dominates(const Cost *c, int32_t a, int32_t b) {
+    for (;;) {
+        if (a == b) return 1;
+        if (b == 0) return 0;
+        b = c->blocks[b].idom;
+    }
+}
+
+static int cmp_loop_size_desc(const void *x, const void *y) {
+    const Loop *a = (const Loop *)x, *b = (const Loop *)y;
+    return (a->nbody < b->nbody) - (a->nbody > b->nbody);
+}
+
+/* Bucles naturales. Devuelve 0, o -1 si el flujo es irreducible. */
+static int find_loops(Cost *c, const int32_t *order, size_t count) {
+    size_t cap = 0;
+    int32_t *stack = (int32_t *)xmalloc(c->nblocks * sizeof(int32_t));
+
+    for (size_t i = 0; i < count; ++i) {
+        int32_t h = order[i];
+        int has_latch = 0;
+        for (int32_t k = c->pred_start[h]; k < c->pred_start[h + 1]; ++k) {
+            int32_t u = c->preds[k];
+            if (c->blocks[u].rpo < 0 || c->blocks[u].rpo < c->blocks[h].rpo) continue;
+            if (!dominates(c, h, u)) {
+                free(stack);
+                return -1;   // arista hacia atrás a un bloque que no domina
+            }
+            has_latch = 1;
+        }
+        if (!has_latch) continue;
+
+        if (c->nloops == cap) {
+            cap = cap ? cap * 2 : 16;
+            c->loops = (Loop *)realloc(c->loops, cap * sizeof(Loop));
+            if (c->loops == NULL) {
+                perror("Error de memoria en el análisis de costo");
+                exit(EXIT_FAILURE);
+            }
+        }
+        Loop *lp = &c->loops[c->nloops++];
+        memset(lp, 0, sizeof(*lp));
+        lp->header = h;
+        lp->parent = -1;
+
+        // Cuerpo: lo que llega a algún latch sin pasar por h
+        uint32_t mark = ++c->epoch;
+        size_t sp = 0, cap_body = 16;
+        lp->body = (int32_t *)xmalloc(cap_body * sizeof(int32_t));
+        lp->body[lp->nbody++] = h;
+        c->blocks[h].mark = mark;
+        for (int32_t k = c->pred_start[h]; k < c->pred_start[h + 1]; ++k) {
+            int32_t u = c->preds[k];
+            if (c->blocks[u].rpo < c->blocks[h].rpo || c->blocks[u].mark == mark) continue;
+            c->blocks[u].mark = mark;
+            stack[sp++] = u;
+        }
+        while (sp > 0) {
+            int32_t u = stack[--sp];
+            if (lp->nbody == cap_body) {
+                cap_body *= 2;
+                lp->body = (int32_t *)realloc(lp->body, cap_body * sizeof(int32_t));
+                if (lp->body == NULL) {
+                    perror("Error de memoria en el análisis de costo");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            lp->body[lp->nbody++] = u;
+            for (int32_t k = c->pred_start[u]; k < c->pred_start[u + 1]; ++k) {
+                int32_t q = c->preds[k];
+                if (c->blocks[q].rpo < 0 || c->blocks[q].mark == mark) continue;
+                c->blocks[q].mark = mark;
+                stack[sp++] = q;
+            }
+        }
+    }
+    free(stack);
+
+    // Anidamiento: de mayor a menor, cada bucle queda dentro del último que
+    // reclamó su cabecera
+    if (c->nloops > 0) qsort(c->loops, c->nloops, sizeof(Loop), cmp_loop_size_desc);
+    for (size_t l = 0; l < c->nloops; ++l) {
+        Loop *lp = &c->loops[l];
+        lp->parent = c->blocks[lp->header].loop;
+        for (size_t k = 0; k < lp->nbody; ++k) c->blocks[lp->body[k]].loop = (int32_t)l;
+        c->blocks[lp->header].header_of = (int32_t)l;
+    }
+    return 0;
+}
+
+// 1 si el bloque b está dentro del bucle l (o de uno anidado en él)
+static int inside(const Cost *c, int32_t b, int32_t l) {
+    if (b == END_OF_PROGRAM) return 0;
+    for (int32_t x = c->blocks[b].loop; x != -1; x = c->loops[x].parent) {
+        if (x == l) return 1;
+    }
+    return l == -1;
+}
+
+static void collect_exits(Cost *c, Loop *lp, int32_t l) {
+    lp->exits = (int32_t *)xmalloc((2 * lp->nbody) * sizeof(int32_t));
+    for (size_t k = 0; k < lp->nbody; ++k) {
+        const Block *blk = &c->blocks[lp->body[k]];
+        for (int s = 0; s < blk->nsucc; ++s) {
+            int32_t t = blk->succ[s];
+            if (inside(c, t, l)) continue;
+            size_t j = 0;
+            while (j < lp->nexits && lp->exits[j] != t) j++;
+            if (j == lp->nexits) lp->exits[lp->nexits++] = t;
+        }
+    }
+}
+
+/* ================= Partes acíclicas ================= */
+
+/* Nodo que representa al bloque b dentro del bucle 'cur' (-1 = nivel
+   superior): el propio bloque o la cabecera del bucle hijo de cur que lo
+   contiene. -1 si b está fuera de cur. */
+static int32_t node_in(const Cost *c, int32_t b, int32_t cur) {
+    if (b == END_OF_PROGRAM) return -1;
+    int32_t l = c->blocks[b].loop, child = -1;
+    while (l != cur) {
+        if (l == -1) return -1;
+        child = l;
+        l = c->loops[l].parent;
+    }
+    return child < 0 ? b : c->loops[child].header;
+}
+
+// Bucle hijo que representa el nodo n en 'cur', o -1 si es un bloque común
+static int32_t node_loop(const Cost *c, int32_t n, int32_t cur) {
+    int32_t l = c->blocks[n].header_of;
+    return l >= 0 && l != cur ? l : -1;
+}
+
+static void node_succ(const Cost *c, int32_t n, int32_t cur, const int32_t **succ, size_t *count) {
+    int32_t l = node_loop(c, n, cur);
+    if (l >= 0) {
+        *succ = c->loops[l].exits;
+        *count = c->loops[l].nexits;
+    } else {
+        *succ = c->blocks[n].succ;
+        *count = (size_t)c->blocks[n].nsucc;
+    }
+}
+
+static void node_cost(const Cost *c, int32_t n, int32_t cur, Fis25Range *cost, Fis25Range *px) {
+    int32_t l = node_loop(c, n, cur);
+    if (l >= 0) {
+        *cost = c->loops[l].cost;
+        *px = c->loops[l].pixels;
+    } else {
+        *cost = range(c->blocks[n].cost, c->blocks[n].cost);
+        *px = range(c->blocks[n].pixels, c->blocks[n].pixels);
+    }
+}
+
+/*
+ * Caminos desde 'start' dentro del bucle 'cur' hasta 'stop' (si stop >= 0,
+ * que se incluye si include_stop), una arista de vuelta a la cabecera de
+ * cur, o una salida de cur. Deja en cada nodo si está en todos los caminos
+ * (mandatory).
+ */
+static void dag_walk(Cost *c, int32_t cur, int32_t start, int32_t stop, int include_stop, Walk *w) {
+    int32_t head = cur >= 0 ? c->loops[cur].header : -1;
+    uint32_t mark = ++c->epoch;
+    size_t cap = 64, sp = 0, n = 0;
+    int32_t *stack = (int32_t *)xmalloc(cap * sizeof(int32_t));
+    size_t *next = (size_t *)xmalloc(cap * sizeof(size_t));
+    int32_t *order = (int32_t *)xmalloc(cap * sizeof(int32_t));
+    size_t cap_order = cap;
+
+    memset(w, 0, sizeof(*w));
+
+    // Postorden (DFS iterativa) de los nodos alcanzables
+    stack[sp] = start;
+    next[sp++] = 0;
+    c->blocks[start].mark = mark;
+    while (sp > 0) {
+        int32_t u = stack[sp - 1];
+        const int32_t *succ;
+        size_t ns;
+        node_succ(c, u, cur, &succ, &ns);
+        if (u != stop && next[sp - 1] < ns) {
+            int32_t v = node_in(c, succ[next[sp - 1]++], cur);
+            if (v < 0 || v == head || c->blocks[v].mark == mark) continue;
+            c->blocks[v].mark = mark;
+            if (sp == cap) {
+                cap *= 2;
+                stack = (int32_t *)realloc(stack, cap * sizeof(int32_t));
+                next = (size_t *)realloc(next, cap * sizeof(size_t));
+                if (stack == NULL || next == NULL) {
+                    perror("Error de memoria en el análisis de costo");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            stack[sp] = v;
+            next[sp++] = 0;
+            continue;
+        }
+        if (n == cap_order) {
+            cap_order *= 2;
+            order = (int32_t *)realloc(order, cap_order * sizeof(int32_t));
+            if (order == NULL) {
+                perror("Error de memoria en el análisis de costo");
+                exit(EXIT_FAILURE);
+            }
+        }
+        order[n++] = u;
+        sp--;
+    }
+    free(stack);
+    free(next);
+    for (size_t i = 0; i < n / 2; ++i) {
+        int32_t t = order[i];
+        order[i] = order[n - 1 - i];
+        order[n - 1 - i] = t;
+    }
+
+    // Costos hasta cada nodo (incluido) y cobertura de las aristas para saber
+    // qué nodos están en todos los caminos: el nodo en la posición k lo está
+    // si ninguna arista salta de antes de k a después de k
+    int32_t *cover = (int32_t *)calloc(n + 2, sizeof(int32_t));
+    if (cover == NULL) {
+        perror("Error de memoria en el análisis de costo");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        Block *blk = &c->blocks[order[i]];
+        blk->topo = (int32_t)i;
+        blk->reached = 0;
+    }
+    Fis25Range cost, px;
+    node_cost(c, start, cur, &cost, &px);
+    if (start == stop && !include_stop) cost = px = range(0, 0);
+    c->blocks[start].reach_cost = cost;
+    c->blocks[start].reach_px = px;
+    c->blocks[start].reached = 1;
+
+    for (size_t i = 0; i < n; ++i) {
+        int32_t u = order[i];
+        Block *bu = &c->blocks[u];
+        const int32_t *succ;
+        size_t ns;
+        int ends_here = u == stop;
+
+        node_succ(c, u, cur, &succ, &ns);
+        if (!ends_here && ns == 0) {
+            // Bucle sin salida: el camino no termina
+            ends_here = 1;
+            bu->reach_cost.hi = UNBOUNDED;
+            w->stray = 1;
+        }
+        for (size_t k = 0; !ends_here && k < ns; ++k) {
+            int32_t v = node_in(c, succ[k], cur);
+            if (v < 0 || v == head) {
+                // Sale del bucle o vuelve a la cabecera: fin de un camino
+                if (w->ended) {
+                    w->cost = range_union(w->cost, bu->reach_cost);
+                    w->pixels = range_union(w->pixels, bu->reach_px);
+                } else {
+                    w->cost = bu->reach_cost;
+                    w->pixels = bu->reach_px;
+                    w->ended = 1;
+                }
+                if (stop >= 0) w->stray = 1;
+                cover[i + 1]++;
+                cover[n]--;
+                continue;
+            }
+            Block *bv = &c->blocks[v];
+            node_cost(c, v, cur, &cost, &px);
+            if (v == stop && !include_stop) cost = px = range(0, 0);
+            cost = range_add(bu->reach_cost, cost);
+            px = range_add(bu->reach_px, px);
+            if (bv->reached) {
+                bv->reach_cost = range_union(bv->reach_cost, cost);
+                bv->reach_px = range_union(bv->reach_px, px);
+            } else {
+                bv->reach_cost = cost;
+                bv->reach_px = px;
+                bv->reached = 1;
+            }
+            if ((size_t)bv->topo > i + 1) {
+                cover[i + 1]++;
+                cover[bv->topo]--;
+            }
+        }
+        if (ends_here) {
+            if (w->ended) {
+                w->cost = range_union(w->cost, bu->reach_cost);
+                w->pixels = range_union(w->pixels, bu->reach_px);
+            } else {
+                w->cost = bu->reach_cost;
+                w->pixels = bu->reach_px;
+                w->ended = 1;
+            }
+            cover[i + 1]++;
+            cover[n]--;
+        }
+    }
+    int32_t covered = 0;
+    for (size_t i = 0; i < n; ++i) {
+        covered += cover[i];
+        c->blocks[order[i]].mandatory = covered == 0;
+    }
+    free(cover);
+
+    w->order = order;
+    w->n = n;
+}
+
+
+/* ================= Resumen de un bucle ================= */
+
+static int const_of(const Cost *c, Fis25Operand o, int32_t *k) {
+    if (o.kind == FIS_IMM) {
+        *k = o.val;
+        return 1;
+    }
+    if (o.kind == FIS_VAR && c->known[o.val]) {
+        *k = c->value[o.val];
+        return 1;
+    }
+    return 0;
+}
+
+static int is_var(Fis25Operand o, int32_t v) {
+    return o.kind == FIS_VAR && o.val == v;
+}
+
+static size_t last_insn(const Cost *c, int32_t b) {
+    const Block *blk = &c->blocks[b];
+    size_t i = blk->end - 1;
+    while (i > blk->start && c->p->code[i].op == FIS_NOTE) i--;
+    return i;
+}
+
+// Marca de qué lado de la prueba quedan los bloques recorridos por w
+static void mark_part(Cost *c, const Walk *w, int32_t l, uint8_t part, uint8_t always) {
+    for (size_t k = 0; k < w->n; ++k) {
+        Block *blk = &c->blocks[w->order[k]];
+        if (node_loop(c, w->order[k], l) < 0) blk->part = blk->mandatory ? always : part;
+    }
+}
+
+/* Valor de v al entrar al bucle: la última escritura en el camino único que
+   llega a la cabecera desde afuera, si es un ASSIGN constante */
+static int initial_value(const Cost *c, int32_t l, int32_t v, int32_t *init) {
+    const Loop *lp = &c->loops[l];
+    int32_t h = lp->header, b = -1;
+    for (int32_t k = c->pred_start[h]; k < c->pred_start[h + 1]; ++k) {
+        int32_t q = c->preds[k];
+        if (inside(c, q, l) || c->blocks[q].rpo < 0) continue;
+        if (b >= 0) return 0;   // varias entradas
+        b = q;
+    }
+    for (int hops = 0; b >= 0 && hops < MAX_INIT_HOPS; ++hops) {
+        const Block *blk = &c->blocks[b];
+        if (blk->loop != lp->parent) return 0;   // un bucle hermano podría escribirla
+        for (size_t i = blk->end; i > blk->start; --i) {
+            const Fis25Insn *in = &c->p->code[i - 1];
+            if (!fis25_writes_var(in) || in->c.val != v) continue;
+            return in->op == FIS_ASSIGN && const_of(c, in->a, init);
+        }
+        if (c->pred_start[b + 1] - c->pred_start[b] != 1) return 0;
+        b = c->preds[c->pred_start[b]];
+    }
+    return 0;
+}
+
+/* Número de veces que se evalúa la salida por entrada al bucle, o 0 con el
+   motivo en lp->why */
+static int64_t count_tests(Cost *c, int32_t l, int exit_when_true) {
+    const Fis25Program *p = c->p;
+    Loop *lp = &c->loops[l];
+    size_t ifpos = last_insn(c, lp->test);
+    const Fis25Insn *br = &p->code[ifpos];
+
+    if (br->a.kind == FIS_IMM) {
+        if ((br->a.val != 0) == exit_when_true) return 1;
+        lp->why = "la condición de salida nunca se cumple";
+        return 0;
+    }
+    if (br->a.kind != FIS_VAR) {
+        lp->why = "condición de salida no reconocida";
+        return 0;
+    }
+
+    // Comparación que calcula la condición en el mismo bloque, o la variable
+    // misma (IF i sale o sigue según i != 0)
+    int32_t cond = br->a.val, iv = cond, bound = 0;
+    Fis25Op cmp = FIS_NUM_OPS;
+    size_t cmp_pos = ifpos;
+    for (size_t i = ifpos; i > c->blocks[lp->test].start; --i) {
+        const Fis25Insn *in = &p->code[i - 1];
+        if (!fis25_writes_var(in) || in->c.val != cond) continue;
+        if (in->op != FIS_LT && in->op != FIS_GT && in->op != FIS_EQ) break;
+        cmp = (Fis25Op)in->op;
+        if (in->a.kind == FIS_VAR && !c->known[in->a.val] && const_of(c, in->b, &bound)) {
+            iv = in->a.val;
+        } else if (in->b.kind == FIS_VAR && !c->known[in->b.val] && const_of(c, in->a, &bound)) {
+            iv = in->b.val;
+            if (cmp != FIS_EQ) cmp = cmp == FIS_LT ? FIS_GT : FIS_LT;   // N < i es i > N
+        } else {
+            lp->why = "la condición de salida no compara con una constante";
+            return 0;
+        }
+        cmp_pos = i - 1;
+        break;
+    }
+
+    // Única escritura de i en el bucle: ADD/SUB i s i con s constante
+    const Fis25Insn *incr = NULL;
+    int32_t incr_block = -1;
+    size_t incr_pos = 0;
+    for (size_t j = 0; j < lp->nbody; ++j) {
+        const Block *blk = &c->blocks[lp->body[j]];
+        for (size_t i = blk->start; i < blk->end; ++i) {
+            const Fis25Insn *in = &p->code[i];
+            if (!fis25_writes_var(in) || in->c.val != iv) continue;
+            if (incr != NULL) {
+                lp->why = "la variable de la condición se escribe más de una vez";
+                return 0;
+            }
+            incr = in;
+            incr_block = lp->body[j];
+            incr_pos = i;
+        }
+    }
+    int32_t step;
+    if (incr == NULL || (incr->op != FIS_ADD && incr->op != FIS_SUB) || !is_var(incr->a, iv) ||
+        !const_of(c, incr->b, &step) || step == 0) {
+        lp->why = "la condición no depende de un contador (ADD i s i)";
+        return 0;
+    }
+    uint8_t part = c->blocks[incr_block].loop == l ? c->blocks[incr_block].part : PART_NONE;
+    if (part != PART_A_ALWAYS && part != PART_B_ALWAYS) {
+        lp->why = "el contador no avanza en cada vuelta";
+        return 0;
+    }
+    int before_test = part == PART_A_ALWAYS && (incr_block != lp->test || incr_pos < cmp_pos);
+    uint32_t ustep = incr->op == FIS_SUB ? 0u - (uint32_t)step : (uint32_t)step;
+
+    int32_t v;
+    if (!initial_value(c, l, iv, &v)) {
+        lp->why = "no se conoce el valor inicial del contador";
+        return 0;
+    }
+
+    // Simulación del contador (aritmética de 32 bits, como el simulador)
+    for (int64_t n = 1; n <= MAX_TESTS; ++n) {
+        if (before_test) v = (int32_t)((uint32_t)v + ustep);
+        int holds;
+        switch (cmp) {
+            case FIS_LT: holds = v < bound; break;
+            case FIS_GT: holds = v > bound; break;
+            case FIS_EQ: holds = v == bound; break;
+            default:     holds = v != 0; break;
+        }
+        if (holds == exit_when_true) return n;
+        if (!before_test) v = (int32_t)((uint32_t)v + ustep);
+    }
+    lp->why = "demasiadas vueltas";
+    return 0;
+}
+
+static void summarize_loop(Cost *c, int32_t l) {
+    Loop *lp = &c->loops[l];
+    Fis25Range hc, hp;
+
+    // Sin cota: al menos una pasada por la cabecera
+    node_cost(c, lp->header, l, &hc, &hp);
+    lp->cost = range(hc.lo, UNBOUNDED);
+    lp->pixels = range(hp.lo, UNBOUNDED);
+
+    // Una sola arista de salida, desde un IF del propio bucle
+    int32_t test = -1, nexit_edges = 0;
+    for (size_t k = 0; k < lp->nbody; ++k) {
+        const Block *blk = &c->blocks[lp->body[k]];
+        for (int s = 0; s < blk->nsucc; ++s) {
+            if (inside(c, blk->succ[s], l)) continue;
+            nexit_edges++;
+            test = lp->body[k];
+        }
+    }
+    if (nexit_edges == 0) {
+        lp->why = "no tiene salida";
+        return;
+    }
+    if (nexit_edges > 1) {
+        lp->why = "tiene más de una salida";
+        return;
+    }
+    const Block *tb = &c->blocks[test];
+    if (tb->loop != l || tb->nsucc != 2 || c->p->code[last_insn(c, test)].op != FIS_IF) {
+        lp->why = "la salida no es una condición del bucle";
+        return;
+    }
+    int exit_when_true = !inside(c, tb->succ[0], l);
+    lp->test = test;
+    lp->test_next = node_in(c, tb->succ[exit_when_true ? 1 : 0], l);
+
+    for (size_t k = 0; k < lp->nbody; ++k) c->blocks[lp->body[k]].part = PART_NONE;
+
+    // A: de la cabecera a la prueba, que tiene que estar en todos los caminos
+    Walk a, b;
+    dag_walk(c, l, lp->header, test, 1, &a);
+    int test_always = c->blocks[test].mark == c->epoch && c->blocks[test].mandatory && !a.stray;
+    mark_part(c, &a, l, PART_A, PART_A_ALWAYS);
+    free(a.order);
+    if (!test_always) {
+        lp->why = "la salida no se prueba en cada vuelta";
+        return;
+    }
+
+    // B: de la prueba de vuelta a la cabecera
+    if (lp->test_next == lp->header) {
+        memset(&b, 0, sizeof(b));
+    } else {
+        dag_walk(c, l, lp->test_next, -1, 0, &b);
+        mark_part(c, &b, l, PART_B, PART_B_ALWAYS);
+        free(b.order);
+    }
+
+    int64_t n = count_tests(c, l, exit_when_true);
+    if (n == 0) return;
+    lp->bounded = 1;
+    lp->tests = n;
+    lp->cost = range_add(range_mul(range(n, n), a.cost), range_mul(range(n - 1, n - 1), b.cost));
+    lp->pixels = range_add(range_mul(range(n, n), a.pixels), range_mul(range(n - 1, n - 1), b.pixels));
+}
+
+/* ================= Veces por frame ================= */
+
+// Reparte 'times' ejecuciones de la parte recorrida por w entre sus nodos
+static void spread_counts(Cost *c, const Walk *w, int32_t cur, Fis25Range times) {
+    for (size_t k = 0; k < w->n; ++k) {
+        int32_t u = w->order[k];
+        Fis25Range t = c->blocks[u].mandatory ? times : range(0, times.hi);
+        int32_t l = node_loop(c, u, cur);
+        if (l >= 0) c->loops[l].entries = range_add(c->loops[l].entries, t);
+        else c->blocks[u].count = range_add(c->blocks[u].count, t);
+    }
+}
+
+/* Veces que se ejecuta cada bloque partiendo una vez de 'start' en el bucle
+   'cur': primero la parte acíclica y después, de afuera hacia adentro, cada
+   bucle según sus entradas */
+static void count_blocks(Cost *c, int32_t cur, int32_t start) {
+    Walk w;
+    dag_walk(c, cur, start, -1, 0, &w);
+    spread_counts(c, &w, cur, range(1, 1));
+    free(w.order);
+
+    // Los bucles están ordenados de mayor a menor: los de afuera primero
+    for (size_t l = 0; l < c->nloops; ++l) {
+        Loop *lp = &c->loops[l];
+        if ((int32_t)l == cur || lp->entries.hi == 0) continue;
+        if (!lp->bounded) {
+            for (size_t k = 0; k < lp->nbody; ++k) {
+                int32_t b = lp->body[k];
+                Fis25Range t = b == lp->header ? range(lp->entries.lo, UNBOUNDED) : range(0, UNBOUNDED);
+                if (c->blocks[b].loop == (int32_t)l) c->blocks[b].count = t;
+                else if (c->blocks[b].header_of >= 0) c->loops[c->blocks[b].header_of].entries = range(0, UNBOUNDED);
+            }
+            continue;
+        }
+        int64_t n = lp->tests;
+        dag_walk(c, (int32_t)l, lp->header, lp->test, 1, &w);
+        spread_counts(c, &w, (int32_t)l, range_mul(lp->entries, range(n, n)));
+        free(w.order);
+        if (lp->test_next != lp->header && n > 1) {
+            dag_walk(c, (int32_t)l, lp->test_next, -1, 0, &w);
+            spread_counts(c, &w, (int32_t)l, range_mul(lp->entries, range(n - 1, n - 1)));
+            free(w.order);
+        }
+    }
+}
+
+/* ================= Análisis ================= */
+
+static void fill_labels(Cost *c, int32_t frame, Fis25CostReport *r) {
+    const Fis25Program *p = c->p;
+    Fis25LabelCost *row_of = NULL;
+    int32_t *slot = (int32_t *)xmalloc((p->nlabels ? p->nlabels : 1) * sizeof(int32_t));
+
+    for (size_t l = 0; l < p->nlabels; ++l) slot[l] = -1;
+    // Secciones en orden de texto con algún bloque que corre en el frame
+    r->labels = (Fis25LabelCost *)xmalloc((p->nlabels ? p->nlabels : 1) * sizeof(Fis25LabelCost));
+    for (size_t b = 0; b < c->nblocks; ++b) {
+        const Block *blk = &c->blocks[b];
+        if (blk->count.hi == 0 || blk->section < 0) continue;
+        if (slot[blk->section] < 0) {
+            slot[blk->section] = (int32_t)r->nlabels;
+            row_of = &r->labels[r->nlabels++];
+            memset(row_of, 0, sizeof(*row_of));
+            row_of->label = blk->section;
+            int32_t lb = c->label_block[blk->section];
+            row_of->runs = c->blocks[lb].count;
+            int32_t l = c->blocks[lb].header_of;
+            if (l >= 0 && l != frame) {
+                const Loop *lp = &c->loops[l];
+                // Vueltas: veces que se ejecuta el cuerpo
+                row_of->trips = !lp->bounded ? -1 : lp->test_next == lp->header ? lp->tests : lp->tests - 1;
+                row_of->why = lp->why;
+            }
+        }
+        row_of = &r->labels[slot[blk->section]];
+        row_of->insns = range_add(row_of->insns, range_mul(blk->count, range(blk->cost, blk->cost)));
+        row_of->pixels = range_add(row_of->pixels, range_mul(blk->count, range(blk->pixels, blk->pixels)));
+    }
+    free(slot);
+}
+
+int fis25_cost_analyze(const Fis25Program *p, const char *frame_label, Fis25CostReport *r) {
+    Cost c;
+    int status = 0;
+
+    memset(r, 0, sizeof(*r));
+    memset(&c, 0, sizeof(c));
+    r->frame_label = -1;
+    if (p->len == 0) return 0;
+
+    c.p = p;
+    long *label_pos = (long *)xmalloc((p->nlabels ? p->nlabels : 1) * sizeof(long));
+    c.label_block = (int32_t *)xmalloc((p->nlabels ? p->nlabels : 1) * sizeof(int32_t));
+    c.value = (int32_t *)xmalloc((p->nvars ? p->nvars : 1) * sizeof(int32_t));
+    c.known = (uint8_t *)xmalloc(p->nvars ? p->nvars : 1);
+    if (fis25_resolve_labels(p, label_pos, NULL) != 0) {
+        r->problem = "hay etiquetas sin definir o repetidas";
+        free(label_pos);
+        free(c.label_block);
+        free(c.value);
+        free(c.known);
+        return -1;
+    }
+    fis25_entry_constants(p, c.value, c.known);
+    build_blocks(&c, label_pos);
+    free(label_pos);
+    build_preds(&c);
+
+    size_t reachable;
+    int32_t *order = reverse_postorder(&c, &reachable);
+    dominators(&c, order, reachable);
+    if (find_loops(&c, order, reachable) != 0) {
+        r->problem = "el flujo de control es irreducible";
+        status = -1;
+        goto done;
+    }
+    for (size_t l = 0; l < c.nloops; ++l) collect_exits(&c, &c.loops[l], (int32_t)l);
+
+    // Frame: el bucle de la etiqueta pedida o el primer bucle sin salida
+    int32_t frame = -1;
+    int32_t fl = -1;
+    for (size_t l = 0; frame_label != NULL && l < p->nlabels; ++l) {
+        if (strcmp(p->labels[l], frame_label) == 0) fl = (int32_t)l;
+    }
+    if (fl >= 0 && c.label_block[fl] >= 0 && c.blocks[c.label_block[fl]].rpo >= 0) {
+        frame = c.blocks[c.label_block[fl]].header_of;
+        if (frame < 0) {
+            r->problem = "la etiqueta del frame no empieza un bucle";
+            status = -1;
+            goto done;
+        }
+    } else {
+        for (size_t l = 0; l < c.nloops; ++l) {
+            const Loop *lp = &c.loops[l];
+            if (lp->parent != -1 || lp->nexits != 0) continue;
+            if (frame < 0 || lp->header < c.loops[frame].header) frame = (int32_t)l;
+        }
+    }
+
+    // Resúmenes, de los bucles internos a los externos
+    for (size_t l = c.nloops; l-- > 0;) {
+        if ((int32_t)l == frame) {
+            Fis25Range hc, hp;
+            node_cost(&c, c.loops[l].header, (int32_t)l, &hc, &hp);
+            c.loops[l].cost = range(hc.lo, UNBOUNDED);
+            c.loops[l].pixels = range(hp.lo, UNBOUNDED);
+            c.loops[l].why = "es el frame";
+        } else {
+            summarize_loop(&c, (int32_t)l);
+        }
+    }
+
+    Walk w;
+    if (frame < 0) {
+        // Sin frame: el programa entero, una vez
+        dag_walk(&c, -1, 0, -1, 0, &w);
+        r->frame = w.cost;
+        r->frame_pixels = w.pixels;
+        free(w.order);
+        count_blocks(&c, -1, 0);
+    } else {
+        int32_t head = c.loops[frame].header;
+        int32_t entry = node_in(&c, head, -1);
+        r->frame_label = c.blocks[head].section;
+        dag_walk(&c, -1, 0, entry, 0, &w);
+        r->setup = w.cost;
+        free(w.order);
+        dag_walk(&c, frame, head, -1, 0, &w);
+        r->frame = w.cost;
+        r->frame_pixels = w.pixels;
+        free(w.order);
+        count_blocks(&c, frame, head);
+    }
+    fill_labels(&c, frame, r);
+
+done:
+    free(order);
+    for (size_t l = 0; l < c.nloops; ++l) {
+        free(c.loops[l].body);
+        free(c.loops[l].exits);
+    }
+    free(c.loops);
+    free(c.blocks);
+    free(c.pred_start);
+    free(c.preds);
+    free(c.label_block);
+    free(c.value);
+    free(c.known);
+    return status;
+}
+
+/* ================= Tabla ================= */
+
+static void format_range(char *buf, size_t size, Fis25Range x) {
+    if (x.hi == UNBOUNDED) snprintf(buf, size, "%lld..∞", (long long)x.lo);
+    else if (x.lo == x.hi) snprintf(buf, size, "%lld", (long long)x.lo);
+    else snprintf(buf, size, "%lld..%lld", (long long)x.lo, (long long)x.hi);
+}
+
+// Imprime 'text' alineado a la derecha en 'width' columnas (cuenta caracteres UTF-8)
+static void print_cell(FILE *out, const char *text, int width) {
+    int chars = 0;
+    for (const char *s = text; *s; ++s) chars += ((unsigned char)*s & 0xC0) != 0x80;
+    fprintf(out, "%*s%s", width > chars ? width - chars : 0, "", text);
+}
+
+void fis25_cost_print(const Fis25Program *p, const Fis25CostReport *r, FILE *out) {
+    char buf[64], px[64];
+
+    if (r->problem != NULL) {
+        fprintf(out, "Costo por frame: no se puede analizar (%s)\n", r->problem);
+        return;
+    }
+    format_range(buf, sizeof(buf), r->frame);
+    format_range(px, sizeof(px), r->frame_pixels);
+    if (r->frame_label >= 0) {
+        fprintf(out, "Costo por frame (%s): %s instrucciones, %s PIXEL\n",
+                p->labels[r->frame_label], buf, px);
+        format_range(buf, sizeof(buf), r->setup);
+        fprintf(out, "Antes del primer frame: %s instrucciones\n", buf);
+    } else {
+        fprintf(out, "Costo del programa (no tiene bucle principal): %s instrucciones, %s PIXEL\n",
+                buf, px);
+    }
+    if (r->nlabels == 0) return;
+
+    fprintf(out, "  %-24s", "etiqueta");
+    print_cell(out, "veces", 14);
+    print_cell(out, "instrucciones", 16);
+    print_cell(out, "PIXEL", 14);
+    print_cell(out, "vueltas", 10);
+    fputc('\n', out);
+    for (size_t i = 0; i < r->nlabels; ++i) {
+        const Fis25LabelCost *row = &r->labels[i];
+        fprintf(out, "  %-24s", p->labels[row->label]);
+        format_range(buf, sizeof(buf), row->runs);
+        print_cell(out, buf, 14);
+        format_range(buf, sizeof(buf), row->insns);
+        print_cell(out, buf, 16);
+        format_range(buf, sizeof(buf), row->pixels);
+        print_cell(out, buf, 14);
+        if (row->trips > 0) {
+            snprintf(buf, sizeof(buf), "%lld", (long long)row->trips);
+            print_cell(out, buf, 10);
+        } else if (row->trips < 0) {
+            fprintf(out, "  sin cota: %s", row->why);
+        }
+        fputc('\n', out);
+    }
+}
+
+void fis25_cost_free(Fis25CostReport *r) {
+    free(r->labels);
+    r->labels = NULL;
+    r->nlabels = 0;
+}
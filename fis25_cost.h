@@ -0,0 +1,58 @@
+// fis25_cost.h
+
+#ifndef FIS25_COST_H
+#define FIS25_COST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "fis25.h"
+
+// Cota superior de un costo que no se puede acotar
+#define FIS25_COST_UNBOUNDED INT64_MAX
+
+typedef struct {
+    int64_t lo, hi;          // mejor y peor caso (hi puede ser FIS25_COST_UNBOUNDED)
+} Fis25Range;
+
+// Costo por frame de la sección de código que empieza en una etiqueta
+typedef struct {
+    int32_t label;           // índice en p->labels
+    Fis25Range runs;         // veces que se entra a la etiqueta en un frame
+    Fis25Range insns;        // instrucciones de la sección ejecutadas en un frame
+    Fis25Range pixels;       // PIXEL de la sección en un frame
+    int64_t trips;           // si la etiqueta es un bucle: vueltas del cuerpo por entrada (-1 = sin cota); si no, 0
+    const char *why;         // bucle sin cota: motivo
+} Fis25LabelCost;
+
+typedef struct {
+    int32_t frame_label;     // etiqueta del frame (-1: el programa no tiene bucle principal)
+    Fis25Range setup;        // de la primera instrucción a la primera entrada al frame
+    Fis25Range frame;        // una iteración del frame (o el programa entero si no hay frame)
+    Fis25Range frame_pixels;
+    Fis25LabelCost *labels;  // etiquetas del frame en orden de texto
+    size_t nlabels;
+    const char *problem;     // por qué no se pudo analizar el programa, o NULL
+} Fis25CostReport;
+
+/**
+ * @brief Cuenta estáticamente las instrucciones (ciclos del simulador: todo
+ *        menos LABEL y comentarios) y los PIXEL de una iteración del frame.
+ *
+ * El frame es el bucle de la etiqueta 'frame_label' (MAIN_LOOP) o, si no
+ * existe, el primer bucle sin salida del programa (el meowl (meowt) de un
+ * programa traducido). Dentro de él, los bucles con una sola salida cuya
+ * condición compara una variable de inducción 'ADD i s i' contra una
+ * constante (inmediato o constante con nombre como TEXT_LEN) se cuentan con
+ * su número exacto de iteraciones; el resto de las bifurcaciones (teclas,
+ * entradas) dan el mejor y el peor caso. Los bucles que no se reconocen
+ * dejan el peor caso sin cota.
+ * @return int 0 si se pudo analizar, -1 si no (motivo en r->problem).
+ */
+int fis25_cost_analyze(const Fis25Program *p, const char *frame_label, Fis25CostReport *r);
+
+// Tabla por etiqueta del análisis en 'out'
+void fis25_cost_print(const Fis25Program *p, const Fis25CostReport *r, FILE *out);
+
+void fis25_cost_free(Fis25CostReport *r);
+
+#endif // FIS25_COST_H
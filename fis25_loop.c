@@ -0,0 +1,602 @@
+// fis25_loop.c
+
+#include "fis25_loop.h"
+#include "fis25_opt.h"
+#include "intern.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Optimización de bucles FIS-25.
+ *
+ * Formas reconocidas (el cuerpo no tiene etiquetas ni saltos, s y N son
+ * constantes o variables de valor fijo, N puede ser una variable que el
+ * bucle no escribe):
+ *
+ *   condición al final          condición al principio
+ *   LABEL L                     LABEL L
+ *       cuerpo                      LT i N c
+ *       ADD i s i                   IF c GOTO B
+ *       LT i N c                    GOTO E
+ *       IF c GOTO L             LABEL B
+ *                                   cuerpo
+ *                                   ADD i s i
+ *                                   GOTO L
+ *                               LABEL E
+ *
+ * La mirilla puede dejar la segunda forma como 'GT i M c; IF c GOTO E' seguido
+ * directamente del cuerpo (con N = M + 1).
+ * También se acepta la condición 'i != 0' (sin LT, 'IF i GOTO ...' directo),
+ * con el incremento 'ADD i s i' o 'SUB i s i' de cualquier signo.
+ *
+ * Cada ronda aplica una transformación a un bucle y vuelve a analizar el
+ * programa completo; así las posiciones y la vivacidad siempre están al día.
+ */
+
+#define MAX_ROUNDS 10000
+
+typedef struct {
+    int bottom_test;
+    int nonzero;             // condición 'i != 0' (sin LT)
+    int exit_test;           // 'GT i M c; IF c GOTO E' al principio (N = M + 1)
+    size_t header;           // LABEL L
+    size_t br;               // IF ... GOTO
+    size_t cmp;              // LT i N c (no existe si nonzero)
+    size_t incr;             // ADD i s i
+    size_t body_begin;       // cuerpo = [body_begin, incr)
+    size_t end;              // IF c GOTO L  o  GOTO L
+    int32_t exit_label;      // E (solo condición al principio)
+    int32_t iv, cond;        // cond = -1 si nonzero
+    int32_t step;
+    int has_bound, has_init;
+    int32_t bound, init;
+} Loop;
+
+typedef struct {
+    Fis25Program *p;
+    const Fis25LoopOptions *opts;
+    Fis25LoopStats *st;
+
+    long *refs;              // referencias a cada etiqueta
+    int32_t *cval;           // constantes de entrada (fis25_entry_constants)
+    uint8_t *cknown;
+    Fis25Liveness lv;
+    int have_lv;
+    int32_t main_loop;
+    int sr_counter;
+} LoopCtx;
+
+static void *xrealloc(void *q, size_t size) {
+    q = realloc(q, size ? size : 1);
+    if (q == NULL) {
+        perror("Error de memoria en la optimización de bucles");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+static int is_control(uint8_t op) {
+    return op == FIS_LABEL || op == FIS_IF || op == FIS_GOTO;
+}
+
+static size_t next_real(const Fis25Program *p, size_t i) {
+    for (++i; i < p->len && p->code[i].op == FIS_NOTE; ++i) {}
+    return i;
+}
+
+static long prev_real(const Fis25Program *p, size_t i) {
+    while (i > 0) {
+        --i;
+        if (p->code[i].op != FIS_NOTE) return (long)i;
+    }
+    return -1;
+}
+
+static int is_var(Fis25Operand o, int32_t v) {
+    return o.kind == FIS_VAR && o.val == v;
+}
+
+static int reads(const Fis25Insn *in, int32_t v) {
+    switch ((Fis25Op)in->op) {
+        case FIS_PIXEL:
+            return is_var(in->a, v) || is_var(in->b, v) || is_var(in->c, v);
+        case FIS_LABEL: case FIS_GOTO: case FIS_NOTE: case FIS_INPUT:
+            return 0;
+        default:
+            return is_var(in->a, v) || is_var(in->b, v);
+    }
+}
+
+static int const_value(const LoopCtx *x, Fis25Operand o, int32_t *k) {
+    if (o.kind == FIS_IMM) {
+        *k = o.val;
+        return 1;
+    }
+    if (o.kind == FIS_VAR && x->cknown[o.val]) {
+        *k = x->cval[o.val];
+        return 1;
+    }
+    return 0;
+}
+
+static int fits_i32(int64_t v) {
+    return v >= INT32_MIN && v <= INT32_MAX;
+}
+
+// ---------------- Edición del arreglo de instrucciones ----------------
+
+static void insert_at(Fis25Program *p, size_t pos, Fis25Insn in) {
+    fis25_emit(p, FIS_NOTE, fis_none(), fis_none(), fis_none(), NULL);   // hace lugar
+    memmove(&p->code[pos + 1], &p->code[pos], (p->len - 1 - pos) * sizeof(Fis25Insn));
+    p->code[pos] = in;
+    if (p->var_decl_pos > pos) p->var_decl_pos++;
+}
+
+static void move_before(Fis25Program *p, size_t from, size_t to) {
+    Fis25Insn in = p->code[from];
+    memmove(&p->code[to + 1], &p->code[to], (from - to) * sizeof(Fis25Insn));
+    p->code[to] = in;
+}
+
+// Reemplaza las entradas [first, last] por repl[0..n)
+static void splice(Fis25Program *p, size_t first, size_t last, const Fis25Insn *repl, size_t n) {
+    size_t old_n = last - first + 1;
+    size_t new_len = p->len - old_n + n;
+    if (new_len > p->cap) {
+        p->cap = new_len;
+        p->code = (Fis25Insn *)xrealloc(p->code, p->cap * sizeof(Fis25Insn));
+    }
+    memmove(&p->code[first + n], &p->code[last + 1], (p->len - last - 1) * sizeof(Fis25Insn));
+    memcpy(&p->code[first], repl, n * sizeof(Fis25Insn));
+    if (p->var_decl_pos > last) p->var_decl_pos = p->var_decl_pos - old_n + n;
+    p->len = new_len;
+}
+
+static Fis25Insn make_insn(Fis25Op op, Fis25Operand a, Fis25Operand b, Fis25Operand c) {
+    Fis25Insn in;
+    memset(&in, 0, sizeof(in));
+    in.op = (uint8_t)op;
+    in.a = a;
+    in.b = b;
+    in.c = c;
+    return in;
+}
+
+// ---------------- Reconocimiento ----------------
+
+static int match_loop(const LoopCtx *x, size_t h, Loop *lp) {
+    const Fis25Program *p = x->p;
+    const Fis25Insn *code = p->code;
+    int32_t L = code[h].c.val;
+
+    memset(lp, 0, sizeof(*lp));
+    lp->header = h;
+    lp->exit_label = -1;
+    if (L == x->main_loop || x->refs[L] != 1) return 0;
+
+    size_t j = h + 1;
+    while (j < p->len && !is_control(code[j].op)) j++;
+    if (j >= p->len || code[j].op != FIS_IF) return 0;
+    const Fis25Insn *br = &code[j];
+
+    lp->br = j;
+    if (br->a.kind != FIS_VAR) return 0;
+
+    if (br->c.val == L) {
+        long last = prev_real(p, j);
+        if (last <= (long)h) return 0;
+        if (code[last].op == FIS_LT) {
+            long incr = prev_real(p, (size_t)last);
+            if (incr <= (long)h) return 0;
+            lp->cmp = (size_t)last;
+            lp->incr = (size_t)incr;
+        } else {
+            lp->nonzero = 1;
+            lp->incr = (size_t)last;
+        }
+        lp->bottom_test = 1;
+        lp->body_begin = h + 1;
+        lp->end = j;
+    } else {
+        size_t first = next_real(p, h);
+        if (first == j) {
+            lp->nonzero = 1;
+        } else if (next_real(p, first) == j) {
+            lp->cmp = first;
+        } else {
+            return 0;
+        }
+        size_t g = next_real(p, j);
+        size_t lb;
+        if (g < p->len && code[g].op == FIS_GOTO) {
+            lb = next_real(p, g);
+            if (lb >= p->len || code[lb].op != FIS_LABEL || code[lb].c.val != br->c.val) return 0;
+            if (x->refs[br->c.val] != 1) return 0;
+            lp->exit_label = code[g].c.val;
+        } else if (!lp->nonzero) {
+            // Condición invertida por la mirilla: el IF es el que sale
+            lb = j;
+            lp->exit_test = 1;
+            lp->exit_label = br->c.val;
+        } else {
+            return 0;
+        }
+        size_t e = lb + 1;
+        while (e < p->len && !is_control(code[e].op)) e++;
+        if (e >= p->len || code[e].op != FIS_GOTO || code[e].c.val != L) return 0;
+        long incr = prev_real(p, e);
+        if (incr <= (long)lb) return 0;
+        lp->incr = (size_t)incr;
+        lp->body_begin = lb + 1;
+        lp->end = e;
+    }
+
+    const Fis25Insn *inc = &code[lp->incr];
+    Fis25Operand bound = fis_none();
+    if (lp->nonzero) {
+        lp->iv = br->a.val;
+        lp->cond = -1;
+    } else {
+        const Fis25Insn *c = &code[lp->cmp];
+        if (c->op != (lp->exit_test ? FIS_GT : FIS_LT) || c->a.kind != FIS_VAR ||
+            !fis_same_operand(br->a, c->c)) return 0;
+        lp->iv = c->a.val;
+        lp->cond = c->c.val;
+        if (lp->iv == lp->cond) return 0;
+        bound = c->b;
+        if (is_var(bound, lp->iv) || is_var(bound, lp->cond)) return 0;
+        lp->has_bound = const_value(x, bound, &lp->bound);
+        if (lp->exit_test) {
+            // sigue mientras !(i > M), es decir, i < M + 1
+            lp->has_bound = lp->has_bound && lp->bound < INT32_MAX;
+            if (lp->has_bound) lp->bound++;
+        }
+    }
+
+    if ((inc->op != FIS_ADD && inc->op != FIS_SUB) ||
+        !is_var(inc->a, lp->iv) || !is_var(inc->c, lp->iv)) return 0;
+    if (!const_value(x, inc->b, &lp->step) || lp->step == 0 || lp->step == INT32_MIN) return 0;
+    if (inc->op == FIS_SUB) lp->step = -lp->step;
+    if (!lp->nonzero && lp->step < 0) return 0;
+
+    for (size_t i = lp->body_begin; i < lp->incr; ++i) {
+        const Fis25Insn *in = &code[i];
+        if (!fis25_writes_var(in)) continue;
+        if (in->c.val == lp->iv || in->c.val == lp->cond || is_var(bound, in->c.val)) return 0;
+    }
+
+    // Valor inicial: última escritura de i en el tramo recto anterior a L
+    for (long k = (long)h - 1; k >= 0; --k) {
+        const Fis25Insn *in = &code[k];
+        if (in->op == FIS_NOTE) continue;
+        if (is_control(in->op)) break;
+        if (fis25_writes_var(in) && in->c.val == lp->iv) {
+            lp->has_init = in->op == FIS_ASSIGN && const_value(x, in->a, &lp->init);
+            break;
+        }
+    }
+    return 1;
+}
+
+// Número de veces que se ejecuta el cuerpo y valor final de i
+static int trip_count(const Loop *lp, int64_t *trips, int32_t *final_iv) {
+    if (!lp->has_init || (!lp->nonzero && !lp->has_bound)) return 0;
+    int64_t k0 = lp->init, n = lp->bound, s = lp->step, t;
+    if (lp->nonzero) {
+        // i llega exactamente a 0 (si no, el bucle daría la vuelta al entero)
+        if ((-k0) % s != 0) return 0;
+        t = -k0 / s;
+        if (t < (lp->bottom_test ? 1 : 0)) return 0;
+    } else if (lp->bottom_test) {
+        t = 1 + ((k0 + s < n) ? (n - (k0 + s) + s - 1) / s : 0);
+    } else {
+        t = (k0 < n) ? (n - k0 + s - 1) / s : 0;
+    }
+    if (!fits_i32(k0 + t * s)) return 0;
+    *trips = t;
+    *final_iv = (int32_t)(k0 + t * s);
+    return 1;
+}
+
+// ---------------- Invariantes ----------------
+
+static int is_pure(const Fis25Insn *in) {
+    switch ((Fis25Op)in->op) {
+        case FIS_ASSIGN: case FIS_ADD: case FIS_SUB: case FIS_MUL:
+        case FIS_LT: case FIS_GT: case FIS_EQ:
+            return 1;
+        case FIS_DIV:
+            return in->b.kind == FIS_IMM && in->b.val != 0;
+        default:
+            return 0;   // KEY cambia con el tiempo; INPUT/PIXEL/PRINT tienen efectos
+    }
+}
+
+static int hoist_one(LoopCtx *x, const Loop *lp) {
+    Fis25Program *p = x->p;
+    if (!x->have_lv) return 0;
+
+    for (size_t i = lp->body_begin; i < lp->incr; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (!is_pure(in)) continue;
+        int32_t d = in->c.val;
+        if (d == lp->iv || d == lp->cond) continue;
+
+        int ok = 1;
+        for (size_t k = lp->header; k <= lp->end && ok; ++k) {
+            const Fis25Insn *o = &p->code[k];
+            // Los operandos no se escriben en el bucle y d se escribe solo aquí
+            if (fis25_writes_var(o) && k != i &&
+                (o->c.val == d || is_var(in->a, o->c.val) || is_var(in->b, o->c.val))) ok = 0;
+            // d no se lee antes de esta escritura dentro del bucle
+            if (k < i && reads(o, d)) ok = 0;
+        }
+        if (!ok || fis25_is_live_in(&x->lv, lp->header, d)) continue;
+        if (!lp->bottom_test) {
+            long e = x->lv.label_pos[lp->exit_label];
+            if (e >= 0 && fis25_is_live_in(&x->lv, (size_t)e, d)) continue;
+        }
+        move_before(p, i, lp->header);
+        x->st->insns_hoisted++;
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------- Desenrollado ----------------
+
+static int fold(Fis25Op op, int32_t a, int32_t b, int32_t *r) {
+    switch (op) {
+        case FIS_ADD: *r = (int32_t)((uint32_t)a + (uint32_t)b); return 1;
+        case FIS_SUB: *r = (int32_t)((uint32_t)a - (uint32_t)b); return 1;
+        case FIS_MUL: *r = (int32_t)((uint32_t)a * (uint32_t)b); return 1;
+        case FIS_DIV:
+            if (b == 0) return 0;
+            *r = (a == INT32_MIN && b == -1) ? a : a / b;
+            return 1;
+        case FIS_LT: *r = a < b;  return 1;
+        case FIS_GT: *r = a > b;  return 1;
+        case FIS_EQ: *r = a == b; return 1;
+        default: return 0;
+    }
+}
+
+// Sustituye i por el inmediato v; devuelve 0 si alguna lectura de i no admite inmediato
+static int subst_iv(Fis25Insn *in, int32_t iv, int32_t v) {
+    Fis25Operand k = fis_imm(v);
+    switch ((Fis25Op)in->op) {
+        case FIS_ASSIGN: case FIS_KEY: case FIS_PRINT:
+            if (is_var(in->a, iv)) in->a = k;
+            return 1;
+        case FIS_PIXEL:
+            if (is_var(in->a, iv)) in->a = k;
+            if (is_var(in->b, iv)) in->b = k;
+            if (is_var(in->c, iv)) in->c = k;
+            return 1;
+        case FIS_ADD: case FIS_SUB: case FIS_MUL: case FIS_DIV:
+        case FIS_LT: case FIS_GT: case FIS_EQ: {
+            int32_t r;
+            if (is_var(in->b, iv)) in->b = k;
+            if (!is_var(in->a, iv)) return 1;
+            if (in->b.kind == FIS_IMM) {
+                if (!fold((Fis25Op)in->op, v, in->b.val, &r)) return 0;
+                in->op = FIS_ASSIGN;
+                in->a = fis_imm(r);
+                in->b = fis_none();
+                return 1;
+            }
+            // Inmediato a la izquierda: se conmuta (v < b  <=>  b > v)
+            switch ((Fis25Op)in->op) {
+                case FIS_ADD: case FIS_MUL: case FIS_EQ: break;
+                case FIS_LT: in->op = FIS_GT; break;
+                case FIS_GT: in->op = FIS_LT; break;
+                default: return 0;
+            }
+            in->a = in->b;
+            in->b = k;
+            return 1;
+        }
+        default:
+            return 1;
+    }
+}
+
+static int unroll(LoopCtx *x, const Loop *lp) {
+    Fis25Program *p = x->p;
+    int64_t trips;
+    int32_t final_iv;
+    long body_len = 0;
+
+    if (x->opts->unroll_budget <= 0 || !trip_count(lp, &trips, &final_iv)) return 0;
+    for (size_t i = lp->body_begin; i < lp->incr; ++i) {
+        if (p->code[i].op != FIS_NOTE) body_len++;
+    }
+    if (trips * (body_len ? body_len : 1) > x->opts->unroll_budget) return 0;
+
+    size_t cap = (size_t)(trips * (body_len + 1)) + 3, n = 0;
+    Fis25Insn *out = (Fis25Insn *)xrealloc(NULL, cap * sizeof(Fis25Insn));
+    Fis25Insn *copy = (Fis25Insn *)xrealloc(NULL, (size_t)(body_len ? body_len : 1) * sizeof(Fis25Insn));
+    char text[96];
+
+    snprintf(text, sizeof(text), "%s desenrollado: %lld iteraciones",
+             p->labels[p->code[lp->header].c.val], (long long)trips);
+    out[n] = make_insn(FIS_NOTE, fis_none(), fis_none(), fis_none());
+    out[n++].comment = intern(text);
+
+    for (int64_t t = 0; t < trips; ++t) {
+        int32_t v = (int32_t)(lp->init + t * lp->step);
+        int need_iv = 0;
+        size_t m = 0;
+        for (size_t i = lp->body_begin; i < lp->incr; ++i) {
+            if (p->code[i].op == FIS_NOTE) continue;
+            copy[m] = p->code[i];
+            if (t > 0) copy[m].comment = NULL;
+            if (!subst_iv(&copy[m], lp->iv, v)) need_iv = 1;
+            m++;
+        }
+        if (need_iv) out[n++] = make_insn(FIS_ASSIGN, fis_imm(v), fis_none(), fis_var(lp->iv));
+        memcpy(&out[n], copy, m * sizeof(Fis25Insn));
+        n += m;
+    }
+    // Estado a la salida del bucle (el optimizador de mirilla lo quita si nadie lo lee):
+    // la condición vale 0 con 'LT i N c' y 1 con la prueba de salida 'GT i M c'
+    out[n++] = make_insn(FIS_ASSIGN, fis_imm(final_iv), fis_none(), fis_var(lp->iv));
+    if (lp->cond >= 0) {
+        out[n++] = make_insn(FIS_ASSIGN, fis_imm(lp->exit_test ? 1 : 0), fis_none(), fis_var(lp->cond));
+    }
+
+    splice(p, lp->header, lp->end, out, n);
+    free(out);
+    free(copy);
+    x->st->loops_unrolled++;
+    return 1;
+}
+
+// ---------------- Reducción de fuerza ----------------
+
+static int32_t new_sr_var(LoopCtx *x) {
+    char name[32];
+    do {
+        snprintf(name, sizeof(name), "$sr%d", x->sr_counter++);
+    } while (fis25_find_var(x->p, name) >= 0);
+    return fis25_var(x->p, name, "reducción de fuerza");
+}
+
+/*
+ * MUL i k t  ->  ASSIGN sr t, con sr = i*k antes del bucle y sr += s*k junto
+ * al incremento. Si después i solo se usa en su incremento y en la condición
+ * (y no se lee al salir), la condición pasa a 'LT sr N*k' (o 'IF sr') y el
+ * incremento de i desaparece.
+ */
+static int reduce_one(LoopCtx *x, const Loop *lp) {
+    Fis25Program *p = x->p;
+
+    for (size_t i = lp->body_begin; i < lp->incr; ++i) {
+        Fis25Insn *in = &p->code[i];
+        Fis25Operand kop;
+        int32_t k;
+
+        if (in->op != FIS_MUL) continue;
+        if (is_var(in->a, lp->iv))      kop = in->b;
+        else if (is_var(in->b, lp->iv)) kop = in->a;
+        else continue;
+        if (!const_value(x, kop, &k)) continue;
+
+        int64_t sk = (int64_t)lp->step * k;
+        int64_t init_k = lp->has_init ? (int64_t)lp->init * k : 0;
+        if (!fits_i32(sk) || !fits_i32(init_k)) continue;
+
+        // ¿Se puede eliminar i?  Con 'LT i N c' hace falta k > 0; con 'i != 0'
+        // basta k != 0 si i*k no se desborda (i va de init a 0).
+        int64_t trips;
+        int32_t final_iv;
+        int eliminate = x->have_lv && lp->has_init;
+        if (lp->nonzero) {
+            eliminate = eliminate && trip_count(lp, &trips, &final_iv) && k != 0;
+        } else {
+            eliminate = eliminate && lp->has_bound && k > 0 &&
+                        fits_i32((int64_t)lp->bound * k) &&
+                        fits_i32(((int64_t)lp->bound + lp->step) * k);
+        }
+        for (size_t j = lp->header; j <= lp->end && eliminate; ++j) {
+            if (j == i || j == lp->incr || j == lp->br || (!lp->nonzero && j == lp->cmp)) continue;
+            if (reads(&p->code[j], lp->iv)) eliminate = 0;
+        }
+        if (eliminate) {
+            if (lp->bottom_test) {
+                eliminate = lp->end + 1 >= p->len || !fis25_is_live_in(&x->lv, lp->end + 1, lp->iv);
+            } else {
+                long e = x->lv.label_pos[lp->exit_label];
+                eliminate = e < 0 || !fis25_is_live_in(&x->lv, (size_t)e, lp->iv);
+            }
+        }
+
+        int32_t sr = new_sr_var(x);
+        Fis25Insn update = make_insn(FIS_ADD, fis_var(sr), fis_imm((int32_t)sk), fis_var(sr));
+        in->op = FIS_ASSIGN;
+        in->a = fis_var(sr);
+        in->b = fis_none();
+
+        if (eliminate) {
+            if (lp->nonzero) {
+                p->code[lp->br].a = fis_var(sr);
+            } else {
+                p->code[lp->cmp].a = fis_var(sr);
+                p->code[lp->cmp].b = fis_imm((lp->exit_test ? lp->bound - 1 : lp->bound) * k);
+            }
+            p->code[lp->incr] = update;
+            x->st->ivs_eliminated++;
+        } else {
+            insert_at(p, lp->incr, update);
+        }
+        if (lp->has_init) {
+            insert_at(p, lp->header, make_insn(FIS_ASSIGN, fis_imm((int32_t)init_k), fis_none(), fis_var(sr)));
+        } else {
+            insert_at(p, lp->header, make_insn(FIS_MUL, fis_var(lp->iv), kop, fis_var(sr)));
+        }
+        x->st->muls_reduced++;
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------- Conductor ----------------
+
+static void analyze(LoopCtx *x) {
+    Fis25Program *p = x->p;
+    x->refs = (long *)xrealloc(x->refs, (p->nlabels ? p->nlabels : 1) * sizeof(long));
+    memset(x->refs, 0, (p->nlabels ? p->nlabels : 1) * sizeof(long));
+    for (size_t i = 0; i < p->len; ++i) {
+        uint8_t op = p->code[i].op;
+        if (op == FIS_IF || op == FIS_GOTO) x->refs[p->code[i].c.val]++;
+    }
+    x->cval = (int32_t *)xrealloc(x->cval, (p->nvars ? p->nvars : 1) * sizeof(int32_t));
+    x->cknown = (uint8_t *)xrealloc(x->cknown, p->nvars ? p->nvars : 1);
+    fis25_entry_constants(p, x->cval, x->cknown);
+    x->have_lv = fis25_liveness(p, &x->lv);
+}
+
+void fis25_loop_opt(Fis25Program *p, const Fis25LoopOptions *opts, Fis25LoopStats *stats) {
+    LoopCtx x;
+    Loop lp;
+
+    memset(&x, 0, sizeof(x));
+    memset(stats, 0, sizeof(*stats));
+    x.p = p;
+    x.opts = opts;
+    x.st = stats;
+    x.main_loop = -1;
+    for (size_t l = 0; l < p->nlabels; ++l) {
+        if (p->labels[l] == intern("MAIN_LOOP")) x.main_loop = (int32_t)l;
+    }
+
+    analyze(&x);
+    for (size_t h = 0; h < p->len; ++h) {
+        if (p->code[h].op == FIS_LABEL && match_loop(&x, h, &lp)) stats->loops_found++;
+    }
+
+    for (int round = 0; round < MAX_ROUNDS; ++round) {
+        int changed = 0;
+        if (round > 0) analyze(&x);
+
+        for (size_t h = 0; h < p->len && !changed; ++h) {
+            if (p->code[h].op != FIS_LABEL || !match_loop(&x, h, &lp)) continue;
+            changed = hoist_one(&x, &lp) || unroll(&x, &lp) || reduce_one(&x, &lp);
+        }
+        fis25_liveness_free(&x.lv);
+        if (!changed) break;
+    }
+
+    free(x.refs);
+    free(x.cval);
+    free(x.cknown);
+}
+
+void fis25_loop_report(const Fis25LoopStats *s, FILE *out) {
+    fprintf(out,
+            "Bucles: %ld reconocidos, %ld desenrollados, %ld MUL reducidos a sumas "
+            "(%ld variables de inducción eliminadas), %ld invariantes fuera del bucle\n",
+            s->loops_found, s->loops_unrolled, s->muls_reduced, s->ivs_eliminated,
+            s->insns_hoisted);
+}
@@ -0,0 +1,40 @@
+// fis25_loop.h
+
+#ifndef FIS25_LOOP_H
+#define FIS25_LOOP_H
+
+#include <stdio.h>
+#include "fis25.h"
+
+#define FIS25_DEFAULT_UNROLL_BUDGET 128
+
+typedef struct {
+    // Máximo de instrucciones que puede producir el desenrollado completo de
+    // un bucle (iteraciones x tamaño del cuerpo); 0 = no desenrollar.
+    int unroll_budget;
+} Fis25LoopOptions;
+
+typedef struct {
+    long loops_found;
+    long loops_unrolled;
+    long muls_reduced;       // MUL de la variable de inducción convertidos en sumas
+    long ivs_eliminated;     // variables de inducción sustituidas en la condición
+    long insns_hoisted;      // instrucciones invariantes sacadas del bucle
+} Fis25LoopStats;
+
+/**
+ * @brief Optimiza los bucles internos (sin saltos en el cuerpo) con una
+ *        variable de inducción 'ADD i s i' y condición 'LT i N c' o 'i != 0'.
+ *
+ * Reconoce las dos formas que generan el letrero y la traducción de
+ * meowl/meowrr (condición al final o al principio). Saca del bucle las
+ * instrucciones invariantes, desenrolla por completo los bucles con número
+ * de iteraciones constante que caben en el presupuesto y, en los demás,
+ * reduce 'MUL i k t' a una suma por iteración (eliminando i si ya no se usa).
+ */
+void fis25_loop_opt(Fis25Program *p, const Fis25LoopOptions *opts, Fis25LoopStats *stats);
+
+// Resumen de una línea en 'out'
+void fis25_loop_report(const Fis25LoopStats *stats, FILE *out);
+
+#endif // FIS25_LOOP_H
@@ -0,0 +1,675 @@
+// fis25_opt.c
+
+#include "fis25_opt.h"
+#include "intern.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Optimizador de mirilla (peephole) para FIS-25.
+ *
+ * Cada pasada recorre el programa aplicando las reglas y marca como
+ * FIS_DEAD lo que elimina; al final de la pasada se compacta el arreglo.
+ * Se repite hasta que ninguna regla cambia nada.
+ *
+ * Las reglas que necesitan saber si una variable se vuelve a leer usan un
+ * análisis de vivacidad hacia atrás sobre las instrucciones (un bitset de
+ * variables por instrucción).
+ */
+
+#define FIS_DEAD     FIS_NUM_OPS     // marca interna de entrada eliminada
+#define MAX_PASSES   64
+#define MAX_FACTS    64
+// Tope del bitset de vivacidad (en palabras de 64 bits); si el programa lo
+// supera se omiten las reglas que dependen de la vivacidad.
+#define MAX_LIVE_WORDS (1u << 23)
+
+typedef struct {
+    Fis25Program *p;
+    long *label_pos;         // posición de cada LABEL (-1 = sin definir)
+    long *label_refs;        // referencias desde IF / GOTO
+    int32_t main_loop;       // etiqueta protegida (-1 si no existe)
+
+    Fis25Liveness lv;
+    uint64_t *scratch;
+    int have_liveness;
+
+    Fis25OptStats *st;
+    int changed;
+} Opt;
+
+typedef struct {
+    int32_t dst;             // la variable dst vale lo mismo que src
+    Fis25Operand src;
+} Fact;
+
+static void *xcalloc(size_t n, size_t size) {
+    void *q = calloc(n ? n : 1, size);
+    if (q == NULL) {
+        perror("Error de memoria en el optimizador FIS-25");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+static int is_skippable(uint8_t op) {
+    return op == FIS_NOTE || op == FIS_DEAD;
+}
+
+static int is_compare(uint8_t op) {
+    return op == FIS_LT || op == FIS_GT || op == FIS_EQ;
+}
+
+static long count_executable(const Fis25Program *p) {
+    long n = 0;
+    for (size_t i = 0; i < p->len; ++i) {
+        if (fis25_is_executable((Fis25Op)p->code[i].op)) n++;
+    }
+    return n;
+}
+
+// Siguiente entrada que no es comentario ni eliminada (p->len si no hay)
+static size_t next_real(const Fis25Program *p, size_t i) {
+    for (++i; i < p->len && is_skippable(p->code[i].op); ++i) {}
+    return i;
+}
+
+// Entrada real anterior a i (-1 si no hay)
+static long prev_real(const Fis25Program *p, size_t i) {
+    while (i > 0) {
+        --i;
+        if (!is_skippable(p->code[i].op)) return (long)i;
+    }
+    return -1;
+}
+
+// Primera instrucción ejecutable desde i (salta etiquetas y comentarios)
+static size_t first_exec_from(const Fis25Program *p, size_t i) {
+    while (i < p->len && (is_skippable(p->code[i].op) || p->code[i].op == FIS_LABEL)) i++;
+    return i;
+}
+
+// 1 si la etiqueta lbl aparece entre i y la siguiente instrucción ejecutable
+static int label_follows(const Fis25Program *p, size_t i, int32_t lbl) {
+    for (size_t j = i + 1; j < p->len; ++j) {
+        uint8_t op = p->code[j].op;
+        if (is_skippable(op)) continue;
+        if (op != FIS_LABEL) return 0;
+        if (p->code[j].c.val == lbl) return 1;
+    }
+    return 0;
+}
+
+static void kill(Opt *o, size_t i) {
+    Fis25Insn *in = &o->p->code[i];
+    if (in->op == FIS_IF || in->op == FIS_GOTO) o->label_refs[in->c.val]--;
+    in->op = FIS_DEAD;
+    o->changed = 1;
+}
+
+static void retarget(Opt *o, Fis25Insn *in, int32_t lbl) {
+    o->label_refs[in->c.val]--;
+    o->label_refs[lbl]++;
+    in->c.val = lbl;
+    o->changed = 1;
+}
+
+static void refresh_labels(Opt *o) {
+    const Fis25Program *p = o->p;
+    for (size_t l = 0; l < p->nlabels; ++l) {
+        o->label_pos[l] = -1;
+        o->label_refs[l] = 0;
+    }
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op == FIS_LABEL) o->label_pos[in->c.val] = (long)i;
+        else if (in->op == FIS_IF || in->op == FIS_GOTO) o->label_refs[in->c.val]++;
+    }
+}
+
+static void compact(Fis25Program *p) {
+    size_t w = 0, decl = p->var_decl_pos;
+    for (size_t r = 0; r < p->len; ++r) {
+        if (r == p->var_decl_pos) decl = w;
+        if (p->code[r].op != FIS_DEAD) p->code[w++] = p->code[r];
+    }
+    if (p->var_decl_pos >= p->len) decl = w;
+    p->var_decl_pos = decl;
+    p->len = w;
+}
+
+// ---------------- Vivacidad ----------------
+
+static inline int bit_test(const uint64_t *set, int32_t v) {
+    return (int)((set[v >> 6] >> (v & 63)) & 1);
+}
+
+static inline void bit_set(uint64_t *set, int32_t v) {
+    set[v >> 6] |= (uint64_t)1 << (v & 63);
+}
+
+static inline void bit_clear(uint64_t *set, int32_t v) {
+    set[v >> 6] &= ~((uint64_t)1 << (v & 63));
+}
+
+static void use_operand(uint64_t *set, Fis25Operand o) {
+    if (o.kind == FIS_VAR) bit_set(set, o.val);
+}
+
+void fis25_live_out(const Fis25Program *p, const Fis25Liveness *lv, size_t i, uint64_t *out) {
+    const Fis25Insn *in = &p->code[i];
+    size_t W = lv->words;
+    memset(out, 0, W * sizeof(uint64_t));
+
+    if (in->op != FIS_GOTO && i + 1 < p->len) {
+        const uint64_t *next = &lv->live_in[(i + 1) * W];
+        for (size_t w = 0; w < W; ++w) out[w] |= next[w];
+    }
+    if (in->op == FIS_GOTO || in->op == FIS_IF) {
+        long pos = lv->label_pos[in->c.val];
+        if (pos >= 0) {
+            const uint64_t *t = &lv->live_in[(size_t)pos * W];
+            for (size_t w = 0; w < W; ++w) out[w] |= t[w];
+        }
+    }
+}
+
+int fis25_is_live_in(const Fis25Liveness *lv, size_t i, int32_t v) {
+    return bit_test(&lv->live_in[i * lv->words], v);
+}
+
+int fis25_liveness(const Fis25Program *p, Fis25Liveness *lv) {
+    size_t W = (p->nvars + 63) / 64;
+    if (W == 0) W = 1;
+    memset(lv, 0, sizeof(*lv));
+    if (p->len * W > MAX_LIVE_WORDS) return 0;
+
+    lv->words = W;
+    lv->len = p->len;
+    lv->live_in = (uint64_t *)xcalloc(p->len * W, sizeof(uint64_t));
+    lv->label_pos = (long *)xcalloc(p->nlabels, sizeof(long));
+    for (size_t l = 0; l < p->nlabels; ++l) lv->label_pos[l] = -1;
+    for (size_t i = 0; i < p->len; ++i) {
+        if (p->code[i].op == FIS_LABEL) lv->label_pos[p->code[i].c.val] = (long)i;
+    }
+
+    uint64_t *cur = (uint64_t *)xcalloc(W, sizeof(uint64_t));
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (size_t i = p->len; i-- > 0;) {
+            const Fis25Insn *in = &p->code[i];
+
+            fis25_live_out(p, lv, i, cur);
+            switch ((Fis25Op)in->op) {
+                case FIS_ASSIGN:
+                case FIS_KEY:
+                    bit_clear(cur, in->c.val);
+                    use_operand(cur, in->a);
+                    break;
+                case FIS_ADD: case FIS_SUB: case FIS_MUL: case FIS_DIV:
+                case FIS_LT:  case FIS_GT:  case FIS_EQ:
+                    bit_clear(cur, in->c.val);
+                    use_operand(cur, in->a);
+                    use_operand(cur, in->b);
+                    break;
+                case FIS_INPUT:
+                    bit_clear(cur, in->c.val);
+                    break;
+                case FIS_IF:
+                case FIS_PRINT:
+                    use_operand(cur, in->a);
+                    break;
+                case FIS_PIXEL:
+                    use_operand(cur, in->a);
+                    use_operand(cur, in->b);
+                    use_operand(cur, in->c);
+                    break;
+                default:
+                    break;   // GOTO, LABEL, comentarios: solo propagan
+            }
+            uint64_t *dst = &lv->live_in[i * W];
+            if (memcmp(dst, cur, W * sizeof(uint64_t)) != 0) {
+                memcpy(dst, cur, W * sizeof(uint64_t));
+                changed = 1;
+            }
+        }
+    }
+    free(cur);
+    return 1;
+}
+
+void fis25_liveness_free(Fis25Liveness *lv) {
+    free(lv->live_in);
+    free(lv->label_pos);
+    memset(lv, 0, sizeof(*lv));
+}
+
+// ---------------- Constantes de entrada ----------------
+
+int fis25_writes_var(const Fis25Insn *in) {
+    switch ((Fis25Op)in->op) {
+        case FIS_ASSIGN: case FIS_ADD: case FIS_SUB: case FIS_MUL: case FIS_DIV:
+        case FIS_LT: case FIS_GT: case FIS_EQ: case FIS_KEY: case FIS_INPUT:
+            return in->c.kind == FIS_VAR;
+        default:
+            return 0;
+    }
+}
+
+static int reads_var(const Fis25Insn *in, int32_t v) {
+    const Fis25Operand *ops[3] = { &in->a, &in->b, &in->c };
+    int n = (in->op == FIS_PIXEL) ? 3 : 2;
+    if (in->op == FIS_LABEL || in->op == FIS_GOTO || is_skippable(in->op)) return 0;
+    for (int k = 0; k < n; ++k) {
+        if (ops[k]->kind == FIS_VAR && ops[k]->val == v) return 1;
+    }
+    return 0;
+}
+
+void fis25_entry_constants(const Fis25Program *p, int32_t *value, uint8_t *known) {
+    long *def_count = (long *)xcalloc(p->nvars, sizeof(long));
+    size_t prefix_end = p->len;
+
+    memset(known, 0, p->nvars);
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        uint8_t op = in->op;
+        if (prefix_end == p->len && (op == FIS_LABEL || op == FIS_IF || op == FIS_GOTO)) {
+            prefix_end = i;
+        }
+        if (fis25_writes_var(in)) def_count[in->c.val]++;
+    }
+    // Única escritura: ASSIGN inmediato en el prefijo que se ejecuta una vez,
+    // sin lecturas de la variable antes de ella.
+    for (size_t i = 0; i < prefix_end; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (in->op == FIS_ASSIGN && in->a.kind == FIS_IMM && def_count[in->c.val] == 1) {
+            int32_t v = in->c.val;
+            int read_before = 0;
+            for (size_t j = 0; j < i && !read_before; ++j) read_before = reads_var(&p->code[j], v);
+            if (!read_before) {
+                known[v] = 1;
+                value[v] = in->a.val;
+            }
+        }
+    }
+    free(def_count);
+}
+
+// ---------------- Reglas ----------------
+
+// GOTO/IF a una etiqueta cuya primera instrucción es GOTO M -> saltar a M
+static void thread_jumps(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        if (in->op != FIS_GOTO && in->op != FIS_IF) continue;
+
+        int32_t orig = in->c.val, t = orig;
+        size_t hops = 0;
+        for (;;) {
+            long pos = o->label_pos[t];
+            if (pos < 0) break;
+            size_t j = first_exec_from(p, (size_t)pos);
+            if (j >= p->len || p->code[j].op != FIS_GOTO) break;
+            int32_t m = p->code[j].c.val;
+            if (m == t) break;
+            if (++hops > p->nlabels) {   // ciclo de GOTOs: no se toca
+                t = orig;
+                break;
+            }
+            t = m;
+        }
+        if (t != orig) {
+            retarget(o, in, t);
+            o->st->jumps_threaded++;
+        }
+    }
+}
+
+// GOTO/IF a la etiqueta que sigue inmediatamente -> se elimina
+static void drop_jumps_to_next(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        uint8_t op = p->code[i].op;
+        if ((op == FIS_GOTO || op == FIS_IF) && label_follows(p, i, p->code[i].c.val)) {
+            kill(o, i);
+        }
+    }
+}
+
+/*
+ * IF t GOTO A / GOTO B / LABEL A  ->  IF t' GOTO B / LABEL A
+ * cuando la comparación que produce t se puede invertir:
+ *   EQ a 0 t  ->  t' = a           (la comparación queda y puede morir después)
+ *   LT a k t  ->  GT a k-1 t       (solo si t no se lee después del IF)
+ *   GT a k t  ->  LT a k+1 t
+ */
+static void invert_branches(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        if (in->op != FIS_IF || in->a.kind != FIS_VAR) continue;
+
+        size_t j = next_real(p, i);
+        if (j >= p->len || p->code[j].op != FIS_GOTO) continue;
+        if (!label_follows(p, j, in->c.val)) continue;
+
+        long d = prev_real(p, i);
+        if (d < 0) continue;
+        Fis25Insn *def = &p->code[d];
+        if (!is_compare(def->op) || !fis_same_operand(def->c, in->a)) continue;
+
+        int32_t t = in->a.val;
+        if (def->op == FIS_EQ) {
+            Fis25Operand other;
+            if (def->b.kind == FIS_IMM && def->b.val == 0)      other = def->a;
+            else if (def->a.kind == FIS_IMM && def->a.val == 0) other = def->b;
+            else continue;
+            if (other.kind != FIS_VAR || other.val == t) continue;
+            in->a = other;
+        } else {
+            if (def->b.kind != FIS_IMM || !o->have_liveness) continue;
+            if (def->op == FIS_LT && def->b.val == INT32_MIN) continue;
+            if (def->op == FIS_GT && def->b.val == INT32_MAX) continue;
+            fis25_live_out(o->p, &o->lv, i, o->scratch);
+            if (bit_test(o->scratch, t)) continue;
+            if (def->op == FIS_LT) {
+                def->op = FIS_GT;
+                def->b.val -= 1;
+            } else {
+                def->op = FIS_LT;
+                def->b.val += 1;
+            }
+        }
+        retarget(o, in, p->code[j].c.val);
+        kill(o, j);
+        o->st->branches_inverted++;
+    }
+}
+
+static Fis25Operand fact_get(const Fact *facts, int n, int32_t v) {
+    for (int k = 0; k < n; ++k) {
+        if (facts[k].dst == v) return facts[k].src;
+    }
+    return fis_none();
+}
+
+static int fact_invalidate(Fact *facts, int n, int32_t v) {
+    int w = 0;
+    for (int k = 0; k < n; ++k) {
+        if (facts[k].dst == v) continue;
+        if (facts[k].src.kind == FIS_VAR && facts[k].src.val == v) continue;
+        facts[w++] = facts[k];
+    }
+    return w;
+}
+
+static int known_const(const Fact *facts, int n, Fis25Operand x, int32_t *k) {
+    if (x.kind == FIS_IMM) {
+        *k = x.val;
+        return 1;
+    }
+    if (x.kind == FIS_VAR) {
+        Fis25Operand f = fact_get(facts, n, x.val);
+        if (f.kind == FIS_IMM) {
+            *k = f.val;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Operandos que la instrucción lee; los inmediatos solo van donde FIS-25 los
+// acepta (nunca como primer operando aritmético).
+static int read_slots(Fis25Insn *in, Fis25Operand **slots, int *imm_ok) {
+    int n = 0;
+    switch ((Fis25Op)in->op) {
+        case FIS_ASSIGN: case FIS_KEY: case FIS_IF: case FIS_PRINT:
+            slots[n] = &in->a; imm_ok[n++] = 1;
+            break;
+        case FIS_ADD: case FIS_SUB: case FIS_MUL: case FIS_DIV:
+        case FIS_LT: case FIS_GT: case FIS_EQ:
+            slots[n] = &in->a; imm_ok[n++] = 0;
+            slots[n] = &in->b; imm_ok[n++] = 1;
+            break;
+        case FIS_PIXEL:
+            slots[n] = &in->a; imm_ok[n++] = 1;
+            slots[n] = &in->b; imm_ok[n++] = 1;
+            slots[n] = &in->c; imm_ok[n++] = 1;
+            break;
+        default:
+            break;
+    }
+    return n;
+}
+
+// Reemplaza lecturas por la copia o constante conocida
+static void propagate(Opt *o, const Fact *facts, int nf, Fis25Insn *in) {
+    Fis25Operand *slots[3];
+    int imm_ok[3];
+    int n = read_slots(in, slots, imm_ok);
+
+    for (int k = 0; k < n; ++k) {
+        if (slots[k]->kind != FIS_VAR) continue;
+        Fis25Operand f = fact_get(facts, nf, slots[k]->val);
+        if (f.kind == FIS_VAR || (f.kind == FIS_IMM && imm_ok[k])) {
+            *slots[k] = f;
+            o->changed = 1;
+        }
+    }
+}
+
+/*
+ * Constantes con nombre (ONE, STEP, MIN_X...): variables que se escriben una
+ * sola vez al inicio. Sus lecturas pasan a ser inmediatos donde el ISA lo
+ * permite; si no queda ninguna, drop_dead_stores elimina el ASSIGN.
+ */
+static void fold_named_constants(Opt *o) {
+    Fis25Program *p = o->p;
+    if (p->nvars == 0) return;
+    int32_t *value = (int32_t *)xcalloc(p->nvars, sizeof(int32_t));
+    uint8_t *known = (uint8_t *)xcalloc(p->nvars, 1);
+
+    fis25_entry_constants(p, value, known);
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Operand *slots[3];
+        int imm_ok[3];
+        int n = read_slots(&p->code[i], slots, imm_ok);
+        for (int k = 0; k < n; ++k) {
+            if (slots[k]->kind == FIS_VAR && imm_ok[k] && known[slots[k]->val]) {
+                *slots[k] = fis_imm(value[slots[k]->val]);
+                o->st->named_consts++;
+                o->changed = 1;
+            }
+        }
+    }
+    free(value);
+    free(known);
+}
+
+/*
+ * Dentro de cada bloque básico se recuerda qué variables son copia de otra o
+ * de una constante; con eso se propagan copias y constantes, se eliminan
+ * ASSIGN que no cambian nada y se pliegan las comparaciones e IF cuyos
+ * operandos son constantes.
+ */
+static void local_values(Opt *o) {
+    Fis25Program *p = o->p;
+    Fact facts[MAX_FACTS];
+    int nf = 0;
+
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        int32_t ka, kb;
+
+        propagate(o, facts, nf, in);
+        switch ((Fis25Op)in->op) {
+            case FIS_LABEL:
+            case FIS_GOTO:
+                nf = 0;
+                break;
+
+            case FIS_LT:
+            case FIS_GT:
+            case FIS_EQ:
+                if (!known_const(facts, nf, in->a, &ka) || !known_const(facts, nf, in->b, &kb)) {
+                    nf = fact_invalidate(facts, nf, in->c.val);
+                    break;
+                }
+                in->a = fis_imm(in->op == FIS_LT ? ka < kb :
+                                in->op == FIS_GT ? ka > kb : ka == kb);
+                in->b = fis_none();
+                in->op = FIS_ASSIGN;
+                o->st->consts_folded++;
+                o->changed = 1;
+                /* ahora es un ASSIGN */
+                /* fall through */
+            case FIS_ASSIGN: {
+                Fis25Operand src = in->a;
+                int32_t x = in->c.val;
+                Fis25Operand fx = fact_get(facts, nf, x);
+                if ((src.kind == FIS_VAR && src.val == x) || fis_same_operand(fx, src) ||
+                    (src.kind == FIS_VAR &&
+                     fis_same_operand(fact_get(facts, nf, src.val), fis_var(x)))) {
+                    kill(o, i);
+                    o->st->moves_removed++;
+                    break;
+                }
+                nf = fact_invalidate(facts, nf, x);
+                if (nf < MAX_FACTS) {
+                    facts[nf].dst = x;
+                    facts[nf].src = src;
+                    nf++;
+                }
+                break;
+            }
+
+            case FIS_IF:
+                if (!known_const(facts, nf, in->a, &ka)) break;
+                o->st->consts_folded++;
+                if (ka != 0) {
+                    in->op = FIS_GOTO;
+                    in->a = fis_none();
+                    o->changed = 1;
+                    nf = 0;
+                } else {
+                    kill(o, i);
+                }
+                break;
+
+            case FIS_ADD: case FIS_SUB: case FIS_MUL: case FIS_DIV:
+            case FIS_KEY: case FIS_INPUT:
+                nf = fact_invalidate(facts, nf, in->c.val);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// Todo lo que sigue a un GOTO hasta la próxima etiqueta es inalcanzable
+static void drop_unreachable(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        if (p->code[i].op != FIS_GOTO) continue;
+        size_t j;
+        for (j = i + 1; j < p->len && p->code[j].op != FIS_LABEL; ++j) {
+            if (!is_skippable(p->code[j].op)) kill(o, j);
+        }
+        i = j - 1;
+    }
+}
+
+static void drop_dead_labels(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        if (in->op != FIS_LABEL || in->c.val == o->main_loop) continue;
+        if (o->label_refs[in->c.val] == 0) {
+            kill(o, i);
+            o->st->labels_removed++;
+        }
+    }
+}
+
+// Escrituras a variables que nadie vuelve a leer (sin efectos laterales)
+static void drop_dead_stores(Opt *o) {
+    Fis25Program *p = o->p;
+    for (size_t i = 0; i < p->len; ++i) {
+        Fis25Insn *in = &p->code[i];
+        switch ((Fis25Op)in->op) {
+            case FIS_DIV:
+                // La división entre cero detiene el programa: solo si b != 0 seguro
+                if (in->b.kind != FIS_IMM || in->b.val == 0) continue;
+                break;
+            case FIS_ASSIGN: case FIS_ADD: case FIS_SUB: case FIS_MUL:
+            case FIS_LT: case FIS_GT: case FIS_EQ: case FIS_KEY:
+                break;
+            default:
+                continue;
+        }
+        fis25_live_out(o->p, &o->lv, i, o->scratch);
+        if (!bit_test(o->scratch, in->c.val)) {
+            kill(o, i);
+            o->st->moves_removed++;
+        }
+    }
+}
+
+// ---------------- Punto fijo ----------------
+
+void fis25_peephole(Fis25Program *p, Fis25OptStats *stats) {
+    Opt o;
+    memset(&o, 0, sizeof(o));
+    memset(stats, 0, sizeof(*stats));
+    o.p = p;
+    o.st = stats;
+    o.label_pos = (long *)xcalloc(p->nlabels, sizeof(long));
+    o.label_refs = (long *)xcalloc(p->nlabels, sizeof(long));
+    o.main_loop = -1;
+    for (size_t l = 0; l < p->nlabels; ++l) {
+        if (p->labels[l] == intern("MAIN_LOOP")) o.main_loop = (int32_t)l;
+    }
+
+    o.scratch = (uint64_t *)xcalloc((p->nvars + 63) / 64 + 1, sizeof(uint64_t));
+
+    stats->insns_before = count_executable(p);
+    do {
+        o.changed = 0;
+        refresh_labels(&o);
+
+        fold_named_constants(&o);
+        o.have_liveness = fis25_liveness(p, &o.lv);
+        if (o.have_liveness) drop_dead_stores(&o);
+        invert_branches(&o);
+        thread_jumps(&o);
+        drop_jumps_to_next(&o);
+        local_values(&o);
+        drop_unreachable(&o);
+        drop_dead_labels(&o);
+
+        fis25_liveness_free(&o.lv);
+        compact(p);
+        stats->passes++;
+    } while (o.changed && stats->passes < MAX_PASSES);
+    stats->insns_after = count_executable(p);
+
+    free(o.label_pos);
+    free(o.label_refs);
+    free(o.scratch);
+}
+
+void fis25_opt_report(const Fis25OptStats *s, FILE *out) {
+    fprintf(out,
+            "Peephole: %ld -> %ld instrucciones (%ld eliminadas) en %d pasadas; "
+            "%ld saltos enhebrados, %ld IF invertidos, %ld movimientos/escrituras "
+            "muertas, %ld constantes plegadas, %ld usos de constantes con nombre "
+            "sustituidos, %ld etiquetas eliminadas\n",
+            s->insns_before, s->insns_after, s->insns_before - s->insns_after, s->passes,
+            s->jumps_threaded, s->branches_inverted, s->moves_removed,
+            s->consts_folded, s->named_consts, s->labels_removed);
+}
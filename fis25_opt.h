@@ -0,0 +1,68 @@
+// fis25_opt.h
+
+#ifndef FIS25_OPT_H
+#define FIS25_OPT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "fis25.h"
+
+typedef struct {
+    long insns_before;       // instrucciones ejecutables antes de optimizar
+    long insns_after;
+    long labels_removed;
+    long jumps_threaded;
+    long branches_inverted;
+    long moves_removed;      // ASSIGN redundantes y escrituras muertas
+    long consts_folded;      // comparaciones e IF con valor constante
+    long named_consts;       // lecturas de constantes con nombre -> inmediatos
+    int passes;
+} Fis25OptStats;
+
+/**
+ * @brief Optimizador de mirilla sobre un programa FIS-25 en memoria.
+ *
+ * Aplica hasta llegar a un punto fijo: enhebrado de saltos, inversión de
+ * IF + GOTO, eliminación de saltos a la siguiente instrucción, de código
+ * inalcanzable, de etiquetas sin referencias, de ASSIGN redundantes y de
+ * escrituras muertas, plegado de comparaciones e IF con constantes y
+ * sustitución de constantes con nombre (ONE, STEP...) por inmediatos.
+ * La etiqueta MAIN_LOOP siempre se conserva (marca cada frame).
+ */
+void fis25_peephole(Fis25Program *p, Fis25OptStats *stats);
+
+// Resumen de una línea en 'out'
+void fis25_opt_report(const Fis25OptStats *stats, FILE *out);
+
+// ---------- Análisis compartidos con otras pasadas ----------
+
+// Vivacidad de variables: un bitset de 'words' palabras por instrucción
+typedef struct {
+    size_t words;
+    size_t len;
+    uint64_t *live_in;      // len * words
+    long *label_pos;        // posición de cada LABEL (-1 = sin definir)
+} Fis25Liveness;
+
+/**
+ * @brief Calcula las variables vivas a la entrada de cada instrucción.
+ * @return int 0 si el programa es demasiado grande para el análisis (lv queda vacío).
+ */
+int fis25_liveness(const Fis25Program *p, Fis25Liveness *lv);
+int fis25_is_live_in(const Fis25Liveness *lv, size_t i, int32_t var);
+// Variables vivas a la salida de la instrucción i ('out' tiene lv->words palabras)
+void fis25_live_out(const Fis25Program *p, const Fis25Liveness *lv, size_t i, uint64_t *out);
+void fis25_liveness_free(Fis25Liveness *lv);
+
+// 1 si la instrucción escribe la variable in->c
+int fis25_writes_var(const Fis25Insn *in);
+
+/**
+ * @brief Variables que valen siempre lo mismo: se escriben una sola vez, con un
+ *        ASSIGN inmediato en el tramo inicial (antes de la primera etiqueta o
+ *        salto) y no se leen antes de esa escritura.
+ * @param value,known Arreglos de p->nvars elementos (salida).
+ */
+void fis25_entry_constants(const Fis25Program *p, int32_t *value, uint8_t *known);
+
+#endif // FIS25_OPT_H
@@ -0,0 +1,384 @@
+// fis25bin.c
+
+#include "fis25bin.h"
+#include "intern.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Tipos de operando en la codificación (2 bits)
+enum { BIN_NONE, BIN_VAR, BIN_IMM, BIN_REF };
+
+static void *xcalloc(size_t n, size_t size) {
+    void *q = calloc(n ? n : 1, size);
+    if (q == NULL) {
+        perror("Error de memoria en el formato binario FIS-25");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+int fis25_bin_detect(const void *data, size_t len) {
+    return len >= 4 && memcmp(data, FIS25_BIN_MAGIC, 4) == 0;
+}
+
+// ---------------- Escritura ----------------
+
+static void put_u16(Emitter *e, uint16_t v) {
+    char b[2] = { (char)(v & 0xff), (char)(v >> 8) };
+    emitter_write(e, b, 2);
+}
+
+static void put_u32(Emitter *e, uint32_t v) {
+    char b[4] = { (char)(v & 0xff), (char)((v >> 8) & 0xff),
+                  (char)((v >> 16) & 0xff), (char)(v >> 24) };
+    emitter_write(e, b, 4);
+}
+
+static void patch_u32(Emitter *e, size_t at, uint32_t v) {
+    e->buf[at]     = (char)(v & 0xff);
+    e->buf[at + 1] = (char)((v >> 8) & 0xff);
+    e->buf[at + 2] = (char)((v >> 16) & 0xff);
+    e->buf[at + 3] = (char)(v >> 24);
+}
+
+static int put_name(Emitter *e, const char *name, FILE *err) {
+    size_t n = strlen(name);
+    if (n > UINT16_MAX) {
+        if (err) fprintf(err, "FIS-25: nombre demasiado largo para el formato binario\n");
+        return 1;
+    }
+    put_u16(e, (uint16_t)n);
+    emitter_write(e, name, n);
+    return 0;
+}
+
+int fis25_bin_write(const Fis25Program *p, Emitter *e, FILE *err) {
+    long *label_pos = (long *)xcalloc(p->nlabels, sizeof(long));
+    if (fis25_resolve_labels(p, label_pos, err) != 0) {
+        free(label_pos);
+        return 1;
+    }
+
+    // Índice de instrucción ejecutable que corresponde a cada entrada
+    uint32_t *offset = (uint32_t *)xcalloc(p->len + 1, sizeof(uint32_t));
+    uint32_t n = 0;
+    for (size_t i = 0; i < p->len; ++i) {
+        offset[i] = n;
+        if (fis25_is_executable((Fis25Op)p->code[i].op)) n++;
+    }
+    offset[p->len] = n;
+
+    uint32_t nlabels = 0;
+    for (size_t l = 0; l < p->nlabels; ++l) {
+        if (label_pos[l] >= 0) nlabels++;
+    }
+
+    size_t base = e->len;
+    emitter_reserve(e, FIS25_BIN_HEADER_SIZE + (size_t)n * FIS25_BIN_INSN_SIZE);
+    emitter_write(e, FIS25_BIN_MAGIC, 4);
+    put_u16(e, FIS25_BIN_VERSION);
+    put_u16(e, FIS25_BIN_NAMES);
+    put_u32(e, n);
+    put_u32(e, (uint32_t)p->nvars);
+    put_u32(e, (uint32_t)p->nstrings);
+    put_u32(e, nlabels);
+    put_u32(e, 0);      // bytes de cadenas (se completa abajo)
+    put_u32(e, 0);      // bytes de nombres
+
+    for (size_t i = 0; i < p->len; ++i) {
+        const Fis25Insn *in = &p->code[i];
+        if (!fis25_is_executable((Fis25Op)in->op)) continue;
+
+        const Fis25Operand *ops[3] = { &in->a, &in->b, &in->c };
+        uint8_t kinds = 0;
+        int32_t vals[3];
+        for (int k = 0; k < 3; ++k) {
+            uint8_t kind;
+            switch (ops[k]->kind) {
+                case FIS_VAR: kind = BIN_VAR; vals[k] = ops[k]->val; break;
+                case FIS_IMM: kind = BIN_IMM; vals[k] = ops[k]->val; break;
+                case FIS_LBL:
+                    kind = BIN_REF;
+                    vals[k] = (int32_t)offset[label_pos[ops[k]->val]];
+                    break;
+                case FIS_STR: kind = BIN_REF; vals[k] = ops[k]->val; break;
+                default:      kind = BIN_NONE; vals[k] = 0; break;
+            }
+            kinds |= (uint8_t)(kind << (2 * k));
+        }
+        emitter_putc(e, (char)in->op);
+        emitter_putc(e, (char)kinds);
+        put_u16(e, 0);
+        put_u32(e, (uint32_t)vals[0]);
+        put_u32(e, (uint32_t)vals[1]);
+        put_u32(e, (uint32_t)vals[2]);
+    }
+
+    size_t strings_start = e->len;
+    for (size_t s = 0; s < p->nstrings; ++s) {
+        size_t len = strlen(p->strings[s]);
+        put_u32(e, (uint32_t)len);
+        emitter_write(e, p->strings[s], len);
+    }
+
+    size_t names_start = e->len;
+    int errors = 0;
+    for (size_t v = 0; v < p->nvars; ++v) errors |= put_name(e, p->vars[v].name, err);
+    // En el orden del código, así el archivo no depende del orden en que se
+    // registraron las etiquetas
+    for (size_t i = 0; i < p->len; ++i) {
+        if (p->code[i].op != FIS_LABEL) continue;
+        put_u32(e, offset[i]);
+        errors |= put_name(e, p->labels[p->code[i].c.val], err);
+    }
+
+    patch_u32(e, base + 24, (uint32_t)(names_start - strings_start));
+    patch_u32(e, base + 28, (uint32_t)(e->len - names_start));
+    free(offset);
+    free(label_pos);
+    return errors;
+}
+
+// ---------------- Lectura ----------------
+
+typedef struct {
+    const uint8_t *d;
+    size_t len, pos;
+    int bad;                 // se leyó más allá del final de la sección
+} Reader;
+
+static uint32_t get_u32(Reader *r) {
+    if (r->len - r->pos < 4) {
+        r->bad = 1;
+        return 0;
+    }
+    const uint8_t *b = r->d + r->pos;
+    r->pos += 4;
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static uint16_t get_u16(Reader *r) {
+    if (r->len - r->pos < 2) {
+        r->bad = 1;
+        return 0;
+    }
+    const uint8_t *b = r->d + r->pos;
+    r->pos += 2;
+    return (uint16_t)(b[0] | (b[1] << 8));
+}
+
+static const char *get_bytes(Reader *r, size_t n) {
+    if (r->len - r->pos < n) {
+        r->bad = 1;
+        return NULL;
+    }
+    const char *s = (const char *)r->d + r->pos;
+    r->pos += n;
+    return s;
+}
+
+static int bin_error(FILE *err, const char *what) {
+    if (err) fprintf(err, "FIS-25 binario: %s\n", what);
+    return 1;
+}
+
+/*
+ * Tipos admitidos por operando (máscaras de BIN_*), igual que el lector de
+ * texto: las fuentes pueden ser variable o inmediato, los destinos variable.
+ */
+#define SRC ((1u << BIN_VAR) | (1u << BIN_IMM))
+#define DST (1u << BIN_VAR)
+#define REF (1u << BIN_REF)
+#define NON (1u << BIN_NONE)
+static const unsigned operand_kinds[FIS_NUM_OPS][3] = {
+    [FIS_ASSIGN] = { SRC, NON, DST },
+    [FIS_ADD]    = { SRC, SRC, DST },
+    [FIS_SUB]    = { SRC, SRC, DST },
+    [FIS_MUL]    = { SRC, SRC, DST },
+    [FIS_DIV]    = { SRC, SRC, DST },
+    [FIS_LT]     = { SRC, SRC, DST },
+    [FIS_GT]     = { SRC, SRC, DST },
+    [FIS_EQ]     = { SRC, SRC, DST },
+    [FIS_IF]     = { SRC, NON, REF },
+    [FIS_GOTO]   = { NON, NON, REF },
+    [FIS_PIXEL]  = { SRC, SRC, SRC },
+    [FIS_KEY]    = { SRC, NON, DST },
+    [FIS_INPUT]  = { NON, NON, DST },
+    [FIS_PRINT]  = { SRC | REF, NON, NON },
+};
+
+typedef struct {
+    uint32_t target;
+    int32_t label;
+} BinLabel;
+
+static int cmp_bin_labels(const void *x, const void *y) {
+    const BinLabel *a = (const BinLabel *)x, *b = (const BinLabel *)y;
+    if (a->target != b->target) return a->target < b->target ? -1 : 1;
+    return a->label - b->label;
+}
+
+int fis25_bin_load(const void *data, size_t len, Fis25Program *p, FILE *err) {
+    Reader hr = { (const uint8_t *)data, len, 0, 0 };
+    if (len < FIS25_BIN_HEADER_SIZE || !fis25_bin_detect(data, len)) {
+        return bin_error(err, "no es un programa FIS-25 binario");
+    }
+    hr.pos = 4;
+    uint16_t version = get_u16(&hr);
+    uint16_t flags = get_u16(&hr);
+    uint32_t n = get_u32(&hr);
+    uint32_t nvars = get_u32(&hr);
+    uint32_t nstrings = get_u32(&hr);
+    uint32_t nlabels = get_u32(&hr);
+    uint32_t strings_size = get_u32(&hr);
+    uint32_t names_size = get_u32(&hr);
+    if (version != FIS25_BIN_VERSION) return bin_error(err, "versión no soportada");
+
+    size_t avail = len - FIS25_BIN_HEADER_SIZE;
+    if (n > avail / FIS25_BIN_INSN_SIZE) return bin_error(err, "código truncado");
+    avail -= (size_t)n * FIS25_BIN_INSN_SIZE;
+    if (strings_size > avail || names_size > avail - strings_size) {
+        return bin_error(err, "archivo truncado");
+    }
+    // Cada cadena, variable o etiqueta ocupa al menos 4, 2 y 6 bytes; sin
+    // nombres, más variables que operandos no tendría sentido.
+    int has_names = (flags & FIS25_BIN_NAMES) != 0;
+    if (nstrings > strings_size / 4 ||
+        (has_names && (nvars > names_size / 2 || nlabels > names_size / 6)) ||
+        (!has_names && nvars > 3 * (size_t)n)) {
+        return bin_error(err, "cabecera inválida");
+    }
+    const uint8_t *code = (const uint8_t *)data + FIS25_BIN_HEADER_SIZE;
+    Reader sr = { code + (size_t)n * FIS25_BIN_INSN_SIZE, strings_size, 0, 0 };
+    Reader nr = { sr.d + strings_size, names_size, 0, 0 };
+    int errors = 0;
+
+    // Cadenas y variables, en el orden del archivo
+    for (uint32_t s = 0; s < nstrings && !sr.bad && !errors; ++s) {
+        uint32_t sl = get_u32(&sr);
+        const char *bytes = get_bytes(&sr, sl);
+        if (bytes && fis25_string(p, intern_n(bytes, sl)) != (int32_t)s) {
+            errors |= bin_error(err, "cadena repetida");
+        }
+    }
+    if (sr.bad) return bin_error(err, "sección de cadenas inválida");
+
+    for (uint32_t v = 0; v < nvars && !errors; ++v) {
+        char buf[32];
+        const char *name = buf;
+        if (has_names) {
+            uint16_t nl = get_u16(&nr);
+            const char *bytes = get_bytes(&nr, nl);
+            if (bytes == NULL) {
+                errors |= bin_error(err, "sección de nombres inválida");
+                break;
+            }
+            name = intern_n(bytes, nl);
+        } else {
+            snprintf(buf, sizeof(buf), "v%u", (unsigned)v);
+        }
+        if (fis25_var(p, name, NULL) != (int32_t)v) errors |= bin_error(err, "variable repetida");
+    }
+
+    // Etiquetas con nombre y las que hagan falta para los saltos sin nombre
+    BinLabel *labels = (BinLabel *)xcalloc((size_t)nlabels + n + 1, sizeof(BinLabel));
+    int32_t *label_at = (int32_t *)xcalloc((size_t)n + 1, sizeof(int32_t));
+    size_t nl_total = 0;
+    for (uint32_t t = 0; t <= n; ++t) label_at[t] = -1;
+    for (uint32_t l = 0; has_names && l < nlabels && !nr.bad && !errors; ++l) {
+        uint32_t target = get_u32(&nr);
+        uint16_t ln = get_u16(&nr);
+        const char *bytes = get_bytes(&nr, ln);
+        if (bytes == NULL) break;
+        if (target > n) {
+            errors |= bin_error(err, "etiqueta fuera del código");
+            break;
+        }
+        int32_t id = fis25_label(p, intern_n(bytes, ln));
+        if ((size_t)id != nl_total) {
+            errors |= bin_error(err, "etiqueta repetida");
+            break;
+        }
+        labels[nl_total].target = target;
+        labels[nl_total++].label = id;
+        if (label_at[target] < 0) label_at[target] = id;
+    }
+    if (nr.bad) errors |= bin_error(err, "sección de nombres inválida");
+
+    for (uint32_t t = 0; t < n && !errors; ++t) {
+        const uint8_t *in = code + (size_t)t * FIS25_BIN_INSN_SIZE;
+        uint8_t op = in[0], kinds = in[1];
+        if (op >= FIS_NUM_OPS || op == FIS_LABEL || op == FIS_NOTE || (kinds >> 6) != 0) {
+            errors |= bin_error(err, "instrucción inválida");
+            break;
+        }
+        for (int k = 0; k < 3; ++k) {
+            unsigned kind = (kinds >> (2 * k)) & 3u;
+            Reader vr = { in + 4 + 4 * k, 4, 0, 0 };
+            uint32_t val = get_u32(&vr);
+            if (!(operand_kinds[op][k] & (1u << kind))) {
+                errors |= bin_error(err, "operando de tipo inválido");
+            } else if (kind == BIN_VAR && val >= nvars) {
+                errors |= bin_error(err, "variable fuera de rango");
+            } else if (kind == BIN_REF && op == FIS_PRINT && val >= nstrings) {
+                errors |= bin_error(err, "cadena fuera de rango");
+            } else if (kind == BIN_REF && op != FIS_PRINT && !errors) {
+                if (val > n) {
+                    errors |= bin_error(err, "salto fuera del código");
+                } else if (label_at[val] < 0) {
+                    char name[32];
+                    int suffix = 0;
+                    snprintf(name, sizeof(name), "L%u", (unsigned)val);
+                    while (fis25_label(p, name) != (int32_t)nl_total) {
+                        snprintf(name, sizeof(name), "L%u_%d", (unsigned)val, ++suffix);
+                    }
+                    labels[nl_total].target = val;
+                    labels[nl_total].label = (int32_t)nl_total;
+                    label_at[val] = (int32_t)nl_total++;
+                }
+            }
+        }
+    }
+    if (errors) {
+        free(labels);
+        free(label_at);
+        return 1;
+    }
+
+    // LABEL delante de su destino, en orden de destino
+    qsort(labels, nl_total, sizeof(BinLabel), cmp_bin_labels);
+    size_t next_label = 0;
+    p->var_decl_pos = 0;
+    for (uint32_t t = 0; t <= n; ++t) {
+        while (next_label < nl_total && labels[next_label].target == t) {
+            fis25_emit(p, FIS_LABEL, fis_none(), fis_none(),
+                       fis_lbl(labels[next_label++].label), NULL);
+        }
+        if (t == n) break;
+
+        const uint8_t *in = code + (size_t)t * FIS25_BIN_INSN_SIZE;
+        Fis25Operand ops[3];
+        for (int k = 0; k < 3; ++k) {
+            Reader vr = { in + 4 + 4 * k, 4, 0, 0 };
+            int32_t val = (int32_t)get_u32(&vr);
+            switch ((in[1] >> (2 * k)) & 3u) {
+                case BIN_VAR: ops[k] = fis_var(val); break;
+                case BIN_IMM: ops[k] = fis_imm(val); break;
+                case BIN_REF:
+                    ops[k] = (in[0] == FIS_PRINT) ? fis_str(val) : fis_lbl(label_at[val]);
+                    break;
+                default: ops[k] = fis_none(); break;
+            }
+        }
+        fis25_emit(p, (Fis25Op)in[0], ops[0], ops[1], ops[2], NULL);
+    }
+
+    free(labels);
+    free(label_at);
+    return 0;
+}
+
+int fis25_load(const void *data, size_t len, Fis25Program *p, FILE *err) {
+    if (fis25_bin_detect(data, len)) return fis25_bin_load(data, len, p, err);
+    return fis25_parse((const char *)data, len, p, err);
+}
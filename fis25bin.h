@@ -0,0 +1,60 @@
+// fis25bin.h
+
+#ifndef FIS25BIN_H
+#define FIS25BIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "emitter.h"
+#include "fis25.h"
+
+/*
+ * Formato binario de FIS-25 (todo en little-endian).
+ *
+ *   Cabecera (32 bytes)
+ *     0  "FS25"             4  u16 versión      6  u16 banderas
+ *     8  u32 instrucciones 12  u32 variables   16  u32 cadenas
+ *    20  u32 etiquetas     24  u32 bytes de cadenas
+ *    28  u32 bytes de nombres
+ *   Código: una entrada de 16 bytes por instrucción ejecutable
+ *     u8 op, u8 tipos de operando (2 bits por a, b, c), u16 0, i32 a, b, c
+ *     Tipos: 0 ninguno, 1 variable (número de slot), 2 inmediato,
+ *            3 referencia (destino de IF/GOTO como índice de instrucción,
+ *              o índice de cadena en PRINT)
+ *   Cadenas: u32 longitud + bytes del literal (con comillas)
+ *   Nombres (si FIS25_BIN_NAMES): por variable u16 longitud + bytes; por
+ *     etiqueta u32 destino + u16 longitud + bytes
+ *
+ * No hay LABEL ni comentarios en el código: las etiquetas solo sobreviven en
+ * la sección de nombres, para el desensamblador y los reportes.
+ */
+
+#define FIS25_BIN_MAGIC       "FS25"
+#define FIS25_BIN_VERSION     1
+#define FIS25_BIN_HEADER_SIZE 32
+#define FIS25_BIN_INSN_SIZE   16
+#define FIS25_BIN_NAMES       0x0001u
+
+// 1 si los datos empiezan con la firma del formato binario
+int fis25_bin_detect(const void *data, size_t len);
+
+/**
+ * @brief Codifica el programa: resuelve las etiquetas a índices de
+ *        instrucción y numera variables y cadenas.
+ * @return int 0 si no hubo errores (etiquetas sin definir o repetidas se informan en 'err').
+ */
+int fis25_bin_write(const Fis25Program *p, Emitter *e, FILE *err);
+
+/**
+ * @brief Carga un programa binario en 'p' (vacío). Las etiquetas se
+ *        reconstruyen como LABEL delante de su destino (con su nombre si el
+ *        archivo los trae, o L<n> si no), así fis25_write lo desensambla.
+ * @return int 0 si el archivo es válido (los errores se informan en 'err').
+ */
+int fis25_bin_load(const void *data, size_t len, Fis25Program *p, FILE *err);
+
+// Carga texto o binario según la firma (fis25_parse o fis25_bin_load)
+int fis25_load(const void *data, size_t len, Fis25Program *p, FILE *err);
+
+#endif // FIS25BIN_H
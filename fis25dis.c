@@ -0,0 +1,108 @@
+// fis25dis.c
+//
+// Desensamblador FIS-25: lee un programa en el formato binario de fis25bin.h
+// (o en texto) y lo escribe en texto, o de nuevo en binario con --emit=bin.
+// Sirve para inspeccionar la salida de 'meowc --emit=bin' y para comprobar la
+// ida y vuelta texto -> binario -> texto.
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "emitter.h"
+#include "fis25.h"
+#include "fis25bin.h"
+#include "intern.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--emit=text|bin] [-o salida] programa\n"
+            "  --emit=text  escribe FIS-25 en texto (por defecto)\n"
+            "  --emit=bin   escribe el formato binario\n"
+            "  -o ARCHIVO   salida (por defecto stdout)\n",
+            prog);
+}
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    size_t cap = 1 << 16, n = 0, r;
+    char *buf = (char *)malloc(cap);
+    while (buf && (r = fread(buf + n, 1, cap - n, f)) > 0) {
+        n += r;
+        if (n == cap) {
+            cap *= 2;
+            buf = (char *)realloc(buf, cap);
+        }
+    }
+    fclose(f);
+    if (buf == NULL) {
+        perror("Error de memoria leyendo el programa");
+        return NULL;
+    }
+    *len = n;
+    return buf;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL, *output_path = NULL;
+    int emit_bin = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--emit=text") == 0) {
+            emit_bin = 0;
+        } else if (strcmp(argv[i], "--emit=bin") == 0) {
+            emit_bin = 1;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    size_t len;
+    char *data = read_file(path, &len);
+    if (data == NULL) return 1;
+
+    Fis25Program prog;
+    fis25_init(&prog);
+    int status = 0;
+    if (fis25_load(data, len, &prog, stderr) != 0) {
+        fprintf(stderr, "fis25dis: el programa tiene errores\n");
+        status = 1;
+    }
+    free(data);
+
+    Emitter out;
+    emitter_init(&out);
+    if (status == 0) {
+        if (emit_bin) status = fis25_bin_write(&prog, &out, stderr) != 0;
+        else          fis25_write(&prog, &out);
+    }
+    if (status == 0) {
+        int rc = output_path ? emitter_write_file(&out, output_path)
+                             : emitter_flush_fd(&out, STDOUT_FILENO);
+        if (rc != 0) {
+            fprintf(stderr, "Error escribiendo %s: %s\n",
+                    output_path ? output_path : "stdout", strerror(errno));
+            status = 1;
+        }
+    }
+
+    emitter_free(&out);
+    fis25_free(&prog);
+    intern_free_all();
+    return status;
+}
@@ -0,0 +1,443 @@
+// fis25sim.c
+//
+// Simulador FIS-25 sin interfaz gráfica: ejecuta un programa (en texto o en el
+// formato binario de fis25bin.h) sobre un framebuffer de 64x64 con un guion de
+// teclas y reporta cuántas instrucciones cuesta cada iteración de MAIN_LOOP,
+// cuántas escrituras PIXEL hace y cuántas veces se pasa por cada etiqueta.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "fis25.h"
+#include "fis25bin.h"
+#include "intern.h"
+
+#define SCREEN_W 64
+#define SCREEN_H 64
+#define NUM_KEYS 8
+
+typedef struct {
+    long frame;
+    int key;
+    int value;
+} KeyEvent;
+
+typedef struct {
+    KeyEvent *events;
+    size_t n, cap;
+} KeyScript;
+
+typedef struct {
+    // Opciones
+    long max_frames;
+    long max_steps;
+    const char *loop_label;
+    int dump_fb;
+
+    // Entrada para INPUT
+    int32_t *inputs;
+    size_t ninputs, next_input;
+} SimOptions;
+
+typedef struct {
+    long steps;              // instrucciones ejecutadas (sin LABEL ni comentarios)
+    long setup_steps;        // antes de la primera entrada a MAIN_LOOP
+    long frames;             // iteraciones completas de MAIN_LOOP
+    long frame_min, frame_max;
+    long loop_steps;         // suma de las iteraciones completas
+    long pixel_writes;
+    long pixel_offscreen;
+    long *label_hits;
+} SimStats;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [opciones] programa.fis\n"
+            "  --frames N       iteraciones de MAIN_LOOP a simular (por defecto 100)\n"
+            "  --max-steps N    límite de instrucciones ejecutadas (por defecto 100000000)\n"
+            "  --keys ARCHIVO   guion de teclas: líneas \"frame tecla valor\"\n"
+            "  --key F:K:V      en el frame F la tecla K pasa a valor V (repetible)\n"
+            "  --input LISTA    valores para INPUT separados por comas\n"
+            "  --loop-label L   etiqueta que marca cada frame (por defecto MAIN_LOOP)\n"
+            "  --dump-fb        imprime el framebuffer final\n",
+            prog);
+}
+
+static void add_event(KeyScript *ks, long frame, int key, int value) {
+    if (key < 0 || key >= NUM_KEYS) {
+        fprintf(stderr, "Advertencia: tecla %d fuera de rango (0-%d), se ignora\n",
+                key, NUM_KEYS - 1);
+        return;
+    }
+    if (ks->n == ks->cap) {
+        ks->cap = ks->cap ? ks->cap * 2 : 16;
+        ks->events = (KeyEvent *)realloc(ks->events, ks->cap * sizeof(KeyEvent));
+        if (ks->events == NULL) {
+            perror("Error de memoria en el guion de teclas");
+            exit(EXIT_FAILURE);
+        }
+    }
+    ks->events[ks->n].frame = frame;
+    ks->events[ks->n].key = key;
+    ks->events[ks->n].value = value;
+    ks->n++;
+}
+
+static int load_key_script(KeyScript *ks, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        long frame;
+        int key, value;
+        lineno++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\0') continue;
+        if (sscanf(p, "%ld %d %d", &frame, &key, &value) != 3) {
+            fprintf(stderr, "%s:%d: se esperaba \"frame tecla valor\"\n", path, lineno);
+            fclose(f);
+            return 1;
+        }
+        add_event(ks, frame, key, value);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int cmp_events(const void *a, const void *b) {
+    const KeyEvent *x = (const KeyEvent *)a;
+    const KeyEvent *y = (const KeyEvent *)b;
+    return (x->frame > y->frame) - (x->frame < y->frame);
+}
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    size_t cap = 1 << 16, n = 0, r;
+    char *buf = (char *)malloc(cap);
+    while (buf && (r = fread(buf + n, 1, cap - n, f)) > 0) {
+        n += r;
+        if (n == cap) {
+            cap *= 2;
+            buf = (char *)realloc(buf, cap);
+        }
+    }
+    fclose(f);
+    if (buf == NULL) {
+        perror("Error de memoria leyendo el programa");
+        return NULL;
+    }
+    *len = n;
+    return buf;
+}
+
+static inline int32_t value_of(const int32_t *vars, Fis25Operand o) {
+    return o.kind == FIS_IMM ? o.val : vars[o.val];
+}
+
+static void print_string(const char *lit) {
+    // Literal con comillas: se imprime el contenido
+    size_t n = strlen(lit);
+    if (n >= 2 && lit[0] == '"' && lit[n - 1] == '"') {
+        fwrite(lit + 1, 1, n - 2, stdout);
+    } else {
+        fputs(lit, stdout);
+    }
+    fputc('\n', stdout);
+}
+
+static int run(const Fis25Program *p, const long *label_pos, SimOptions *opt,
+               KeyScript *ks, int32_t fb[SCREEN_H][SCREEN_W], SimStats *st) {
+    int32_t *vars = (int32_t *)calloc(p->nvars ? p->nvars : 1, sizeof(int32_t));
+    int keys[NUM_KEYS] = { 0 };
+    size_t next_event = 0;
+    long frame = 0;
+    long frame_start = -1;   // st->steps al entrar al frame actual
+    int32_t loop_label = -1;
+    int status = 0;
+
+    if (vars == NULL) {
+        perror("Error de memoria en el simulador");
+        return 1;
+    }
+    for (size_t i = 0; i < p->nlabels; ++i) {
+        if (strcmp(p->labels[i], opt->loop_label) == 0) loop_label = (int32_t)i;
+    }
+
+    // Eventos del frame 0 (o de todo el programa si no hay MAIN_LOOP)
+    while (next_event < ks->n && ks->events[next_event].frame <= 0) {
+        keys[ks->events[next_event].key] = ks->events[next_event].value;
+        next_event++;
+    }
+
+    size_t pc = 0;
+    while (pc < p->len) {
+        const Fis25Insn *in = &p->code[pc];
+
+        switch ((Fis25Op)in->op) {
+            case FIS_NOTE:
+                pc++;
+                continue;
+
+            case FIS_LABEL:
+                st->label_hits[in->c.val]++;
+                if (in->c.val == loop_label) {
+                    if (frame_start < 0) {
+                        st->setup_steps = st->steps;
+                    } else {
+                        long cost = st->steps - frame_start;
+                        if (st->frames == 0 || cost < st->frame_min) st->frame_min = cost;
+                        if (st->frames == 0 || cost > st->frame_max) st->frame_max = cost;
+                        st->loop_steps += cost;
+                        st->frames++;
+                        frame++;
+                        if (st->frames >= opt->max_frames) goto done;
+                    }
+                    frame_start = st->steps;
+                    while (next_event < ks->n && ks->events[next_event].frame <= frame) {
+                        keys[ks->events[next_event].key] = ks->events[next_event].value;
+                        next_event++;
+                    }
+                }
+                pc++;
+                continue;
+
+            default:
+                break;
+        }
+
+        if (st->steps >= opt->max_steps) {
+            fprintf(stderr, "fis25sim: se alcanzó el límite de %ld instrucciones\n",
+                    opt->max_steps);
+            status = 2;
+            goto done;
+        }
+        st->steps++;
+
+        int32_t a = 0, b = 0;
+        switch ((Fis25Op)in->op) {
+            case FIS_ASSIGN:
+                vars[in->c.val] = value_of(vars, in->a);
+                break;
+            case FIS_ADD:
+            case FIS_SUB:
+            case FIS_MUL:
+            case FIS_DIV:
+            case FIS_LT:
+            case FIS_GT:
+            case FIS_EQ:
+                a = value_of(vars, in->a);
+                b = value_of(vars, in->b);
+                switch ((Fis25Op)in->op) {
+                    case FIS_ADD: vars[in->c.val] = (int32_t)((uint32_t)a + (uint32_t)b); break;
+                    case FIS_SUB: vars[in->c.val] = (int32_t)((uint32_t)a - (uint32_t)b); break;
+                    case FIS_MUL: vars[in->c.val] = (int32_t)((uint32_t)a * (uint32_t)b); break;
+                    case FIS_DIV:
+                        if (b == 0) {
+                            fprintf(stderr, "fis25sim: división entre cero en la instrucción %zu\n", pc);
+                            status = 3;
+                            goto done;
+                        }
+                        vars[in->c.val] = (a == INT32_MIN && b == -1) ? a : a / b;
+                        break;
+                    case FIS_LT: vars[in->c.val] = a < b;  break;
+                    case FIS_GT: vars[in->c.val] = a > b;  break;
+                    case FIS_EQ: vars[in->c.val] = a == b; break;
+                    default: break;
+                }
+                break;
+            case FIS_IF:
+                if (value_of(vars, in->a) != 0) {
+                    pc = (size_t)label_pos[in->c.val];
+                    continue;
+                }
+                break;
+            case FIS_GOTO:
+                pc = (size_t)label_pos[in->c.val];
+                continue;
+            case FIS_PIXEL: {
+                int32_t x = value_of(vars, in->a);
+                int32_t y = value_of(vars, in->b);
+                st->pixel_writes++;
+                if (x >= 0 && x < SCREEN_W && y >= 0 && y < SCREEN_H) {
+                    fb[y][x] = value_of(vars, in->c);
+                } else {
+                    st->pixel_offscreen++;
+                }
+                break;
+            }
+            case FIS_KEY: {
+                int32_t k = value_of(vars, in->a);
+                vars[in->c.val] = (k >= 0 && k < NUM_KEYS) ? keys[k] : 0;
+                break;
+            }
+            case FIS_INPUT:
+                vars[in->c.val] = opt->next_input < opt->ninputs
+                                      ? opt->inputs[opt->next_input++] : 0;
+                break;
+            case FIS_PRINT:
+                if (in->a.kind == FIS_STR) print_string(p->strings[in->a.val]);
+                else printf("%d\n", value_of(vars, in->a));
+                break;
+            default:
+                break;
+        }
+        pc++;
+    }
+
+done:
+    free(vars);
+    return status;
+}
+
+static void report(const Fis25Program *p, const SimStats *st, FILE *out) {
+    fprintf(out, "=== fis25sim ===\n");
+    fprintf(out, "instrucciones ejecutadas: %ld\n", st->steps);
+    if (st->frames > 0 || st->setup_steps > 0) {
+        fprintf(out, "instrucciones de inicialización: %ld\n", st->setup_steps);
+    }
+    fprintf(out, "iteraciones de MAIN_LOOP: %ld\n", st->frames);
+    if (st->frames > 0) {
+        // Las instrucciones de un último frame incompleto no se promedian
+        fprintf(out, "instrucciones por iteración: min %ld, max %ld, promedio %.2f\n",
+                st->frame_min, st->frame_max, (double)st->loop_steps / (double)st->frames);
+        fprintf(out, "PIXEL por iteración: %.2f\n",
+                (double)st->pixel_writes / (double)st->frames);
+    }
+    fprintf(out, "escrituras PIXEL: %ld (%ld fuera de pantalla)\n",
+            st->pixel_writes, st->pixel_offscreen);
+    /* En el orden del código: la tabla de etiquetas de un programa binario
+       no queda en el mismo orden que la del texto */
+    fprintf(out, "pasos por etiqueta:\n");
+    for (size_t pc = 0; pc < p->len; ++pc) {
+        const Fis25Insn *in = &p->code[pc];
+        if (in->op != FIS_LABEL) continue;
+        fprintf(out, "  %-20s %ld\n", p->labels[in->c.val], st->label_hits[in->c.val]);
+    }
+}
+
+static void dump_framebuffer(int32_t fb[SCREEN_H][SCREEN_W], FILE *out) {
+    for (int y = 0; y < SCREEN_H; ++y) {
+        for (int x = 0; x < SCREEN_W; ++x) {
+            fputc(fb[y][x] ? '#' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
+
+static int parse_inputs(SimOptions *opt, const char *list) {
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long v = strtol(p, &end, 10);
+        if (end == p) {
+            fprintf(stderr, "--input: valor inválido en '%s'\n", p);
+            return 1;
+        }
+        opt->inputs = (int32_t *)realloc(opt->inputs, (opt->ninputs + 1) * sizeof(int32_t));
+        if (opt->inputs == NULL) {
+            perror("Error de memoria en --input");
+            exit(EXIT_FAILURE);
+        }
+        opt->inputs[opt->ninputs++] = (int32_t)v;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    SimOptions opt = { 100, 100000000L, "MAIN_LOOP", 0, NULL, 0, 0 };
+    KeyScript ks = { NULL, 0, 0 };
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--frames") == 0 && val) {
+            opt.max_frames = atol(val);
+            i++;
+        } else if (strcmp(arg, "--max-steps") == 0 && val) {
+            opt.max_steps = atol(val);
+            i++;
+        } else if (strcmp(arg, "--keys") == 0 && val) {
+            if (load_key_script(&ks, val) != 0) return 1;
+            i++;
+        } else if (strcmp(arg, "--key") == 0 && val) {
+            long frame;
+            int key, value;
+            if (sscanf(val, "%ld:%d:%d", &frame, &key, &value) != 3) {
+                fprintf(stderr, "--key espera F:K:V\n");
+                return 1;
+            }
+            add_event(&ks, frame, key, value);
+            i++;
+        } else if (strcmp(arg, "--input") == 0 && val) {
+            if (parse_inputs(&opt, val) != 0) return 1;
+            i++;
+        } else if (strcmp(arg, "--loop-label") == 0 && val) {
+            opt.loop_label = val;
+            i++;
+        } else if (strcmp(arg, "--dump-fb") == 0) {
+            opt.dump_fb = 1;
+        } else if (arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            path = arg;
+        }
+    }
+    if (path == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    size_t len;
+    char *text = read_file(path, &len);
+    if (text == NULL) return 1;
+
+    Fis25Program prog;
+    fis25_init(&prog);
+    int loaded = fis25_load(text, len, &prog, stderr) == 0;
+    free(text);
+    if (!loaded) {
+        fprintf(stderr, "fis25sim: el programa tiene errores\n");
+        fis25_free(&prog);
+        intern_free_all();
+        return 1;
+    }
+
+    long *label_pos = (long *)malloc((prog.nlabels ? prog.nlabels : 1) * sizeof(long));
+    if (label_pos == NULL || fis25_resolve_labels(&prog, label_pos, stderr) != 0) {
+        return 1;
+    }
+
+    if (ks.n > 1) qsort(ks.events, ks.n, sizeof(KeyEvent), cmp_events);
+
+    static int32_t fb[SCREEN_H][SCREEN_W];
+    SimStats st;
+    memset(&st, 0, sizeof(st));
+    st.label_hits = (long *)calloc(prog.nlabels ? prog.nlabels : 1, sizeof(long));
+
+    int status = run(&prog, label_pos, &opt, &ks, fb, &st);
+    report(&prog, &st, stderr);
+    if (opt.dump_fb) dump_framebuffer(fb, stdout);
+
+    free(st.label_hits);
+    free(label_pos);
+    free(ks.events);
+    free(opt.inputs);
+    fis25_free(&prog);
+    intern_free_all();
+    return status;
+}
@@ -0,0 +1,129 @@
+// intern.c
+
+#include "intern.h"
+#include "arena.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERN_INITIAL_CAP 1024   // potencia de 2
+
+typedef struct {
+    const char *str;   // NULL = cubeta vacía
+    uint32_t hash;
+    uint32_t len;
+} InternSlot;
+
+// Tabla de direccionamiento abierto con sondeo lineal
+static InternSlot *slots = NULL;
+static size_t capacity = 0;       // siempre potencia de 2
+static size_t count = 0;
+
+// Almacenamiento de las cadenas
+static Arena intern_arena = { 0 };
+
+// Contadores
+static size_t num_lookups = 0;
+static size_t num_hits = 0;
+
+// La tabla es compartida por todas las compilaciones de un proceso (-j):
+// así los punteros canónicos valen entre hilos y se comparan igual.
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// FNV-1a de 32 bits
+static uint32_t hash_bytes(const char *s, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void grow_table(void) {
+    size_t new_cap = capacity ? capacity * 2 : INTERN_INITIAL_CAP;
+    InternSlot *new_slots = (InternSlot *)calloc(new_cap, sizeof(InternSlot));
+    if (new_slots == NULL) {
+        perror("Error de memoria al crecer la tabla de internado");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < capacity; ++i) {
+        if (slots[i].str == NULL) continue;
+        size_t j = slots[i].hash & (new_cap - 1);
+        while (new_slots[j].str != NULL) j = (j + 1) & (new_cap - 1);
+        new_slots[j] = slots[i];
+    }
+
+    free(slots);
+    slots = new_slots;
+    capacity = new_cap;
+}
+
+const char *intern_n(const char *s, size_t len) {
+    // El hash no toca la tabla: se calcula fuera de la sección crítica
+    uint32_t h = hash_bytes(s, len);
+
+    pthread_mutex_lock(&intern_lock);
+
+    // Factor de carga máximo 1/2
+    if ((count + 1) * 2 > capacity) grow_table();
+
+    size_t i = h & (capacity - 1);
+    num_lookups++;
+
+    while (slots[i].str != NULL) {
+        if (slots[i].hash == h && slots[i].len == len &&
+            memcmp(slots[i].str, s, len) == 0) {
+            num_hits++;
+            const char *found = slots[i].str;
+            pthread_mutex_unlock(&intern_lock);
+            return found;
+        }
+        i = (i + 1) & (capacity - 1);
+    }
+
+    char *copy = (char *)arena_alloc(&intern_arena, len + 1);
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+
+    slots[i].str = copy;
+    slots[i].hash = h;
+    slots[i].len = (uint32_t)len;
+    count++;
+    pthread_mutex_unlock(&intern_lock);
+    return copy;
+}
+
+const char *intern(const char *s) {
+    if (!s) return NULL;
+    return intern_n(s, strlen(s));
+}
+
+void intern_free_all(void) {
+    free(slots);
+    slots = NULL;
+    capacity = 0;
+    count = 0;
+    num_lookups = 0;
+    num_hits = 0;
+    arena_free_all(&intern_arena);
+}
+
+void intern_report(FILE *out) {
+    pthread_mutex_lock(&intern_lock);
+    fprintf(out,
+            "Internado: %zu cadenas únicas, %zu búsquedas (%zu aciertos), capacidad %zu\n",
+            count, num_lookups, num_hits, capacity);
+    arena_report(&intern_arena, "internado", out);
+    pthread_mutex_unlock(&intern_lock);
+}
+
+size_t intern_bytes(void) {
+    pthread_mutex_lock(&intern_lock);
+    size_t bytes = capacity * sizeof(InternSlot) + intern_arena.bytes_reserved;
+    pthread_mutex_unlock(&intern_lock);
+    return bytes;
+}
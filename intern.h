@@ -0,0 +1,47 @@
+// intern.h
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Tabla global de internado de cadenas (identificadores y literales).
+ *
+ * Cada ortografía distinta se guarda una sola vez y se devuelve siempre el
+ * mismo puntero canónico: dos nombres internados son iguales si y solo si sus
+ * punteros son iguales. El scanner, el AST y la tabla de símbolos comparten
+ * estos punteros sin volver a copiarlos.
+ *
+ * intern/intern_n pueden llamarse desde varios hilos a la vez (la tabla
+ * está protegida por un mutex); intern_free_all solo cuando ya no queda
+ * ninguna compilación en curso.
+ */
+
+/**
+ * @brief Interna los 'len' primeros bytes de 's'.
+ * @return const char* Puntero canónico terminado en '\0' (vive hasta intern_free_all).
+ */
+const char *intern_n(const char *s, size_t len);
+
+/**
+ * @brief Interna una cadena terminada en '\0'.
+ * @return const char* Puntero canónico, o NULL si s es NULL.
+ */
+const char *intern(const char *s);
+
+/**
+ * @brief Libera la tabla y todas las cadenas internadas.
+ */
+void intern_free_all(void);
+
+/**
+ * @brief Imprime estadísticas de la tabla (cadenas únicas, búsquedas, aciertos).
+ */
+void intern_report(FILE *out);
+
+// Bytes reservados por la tabla y su arena (para --stats)
+size_t intern_bytes(void);
+
+#endif // INTERN_H
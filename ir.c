@@ -0,0 +1,355 @@
+// ir.c
+
+#include "ir.h"
+#include "intern.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *op_names[IR_NUM_OPS] = {
+    "copy", "add", "sub", "mul", "div", "lt", "gt", "eq",
+    "pixel", "key", "input", "print"
+};
+
+const char *ir_op_name(IrOp op) {
+    return (op < IR_NUM_OPS) ? op_names[op] : "?";
+}
+
+static void *xrealloc(void *p, size_t size) {
+    void *q = realloc(p, size ? size : 1);
+    if (q == NULL) {
+        perror("Error de memoria en la representación intermedia");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+void ir_init(IrProgram *ir) {
+    memset(ir, 0, sizeof(*ir));
+}
+
+void ir_free(IrProgram *ir) {
+    free(ir->insns);
+    free(ir->blocks);
+    free(ir->syms);
+    free(ir->strings);
+    free(ir->pred_start);
+    free(ir->preds);
+    free(ir->sym_keys);
+    free(ir->sym_vals);
+    memset(ir, 0, sizeof(*ir));
+}
+
+// ---------------- Símbolos y cadenas ----------------
+
+static size_t hash_ptr(const char *s) {
+    uint64_t h = (uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+static void sym_map_put(IrProgram *ir, const char *name, int32_t idx) {
+    size_t i = hash_ptr(name) & (ir->sym_cap - 1);
+    while (ir->sym_keys[i] != NULL) i = (i + 1) & (ir->sym_cap - 1);
+    ir->sym_keys[i] = name;
+    ir->sym_vals[i] = idx;
+}
+
+int32_t ir_sym(IrProgram *ir, const char *name, int temp) {
+    name = intern(name);
+    if (ir->sym_cap > 0) {
+        size_t i = hash_ptr(name) & (ir->sym_cap - 1);
+        while (ir->sym_keys[i] != NULL) {
+            if (ir->sym_keys[i] == name) return ir->sym_vals[i];
+            i = (i + 1) & (ir->sym_cap - 1);
+        }
+    }
+
+    if ((ir->nsyms + 1) * 2 > ir->sym_cap) {
+        free(ir->sym_keys);
+        free(ir->sym_vals);
+        ir->sym_cap = ir->sym_cap ? ir->sym_cap * 2 : 64;
+        ir->sym_keys = (const char **)calloc(ir->sym_cap, sizeof(*ir->sym_keys));
+        ir->sym_vals = (int32_t *)calloc(ir->sym_cap, sizeof(*ir->sym_vals));
+        if (ir->sym_keys == NULL || ir->sym_vals == NULL) {
+            perror("Error de memoria en la representación intermedia");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t k = 0; k < ir->nsyms; ++k) sym_map_put(ir, ir->syms[k].name, (int32_t)k);
+    }
+    if (ir->nsyms == ir->cap_syms) {
+        ir->cap_syms = ir->cap_syms ? ir->cap_syms * 2 : 32;
+        ir->syms = (IrSym *)xrealloc(ir->syms, ir->cap_syms * sizeof(*ir->syms));
+    }
+    int32_t idx = (int32_t)ir->nsyms++;
+    ir->syms[idx].name = name;
+    ir->syms[idx].temp = (uint8_t)(temp != 0);
+    sym_map_put(ir, name, idx);
+    return idx;
+}
+
+int32_t ir_string(IrProgram *ir, const char *literal) {
+    literal = intern(literal);
+    for (size_t i = 0; i < ir->nstrings; ++i) {
+        if (ir->strings[i] == literal) return (int32_t)i;
+    }
+    if (ir->nstrings == ir->cap_strings) {
+        ir->cap_strings = ir->cap_strings ? ir->cap_strings * 2 : 8;
+        ir->strings = (const char **)xrealloc(ir->strings, ir->cap_strings * sizeof(*ir->strings));
+    }
+    ir->strings[ir->nstrings] = literal;
+    return (int32_t)ir->nstrings++;
+}
+
+// ---------------- Grafo de control ----------------
+
+static int num_succ(const IrBlock *b) {
+    switch ((IrTerm)b->term) {
+        case IR_TERM_JUMP:   return 1;
+        case IR_TERM_BRANCH: return 2;
+        default:             return 0;
+    }
+}
+
+void ir_compute_preds(IrProgram *ir) {
+    size_t n = ir->nblocks;
+    uint32_t *start = (uint32_t *)xrealloc(ir->pred_start, (n + 1) * sizeof(uint32_t));
+    memset(start, 0, (n + 1) * sizeof(uint32_t));
+
+    // Conteo por bloque, sumas prefijas y reparto (formato CSR)
+    for (size_t b = 0; b < n; ++b) {
+        const IrBlock *blk = &ir->blocks[b];
+        for (int k = 0; k < num_succ(blk); ++k) start[blk->succ[k] + 1]++;
+    }
+    for (size_t b = 0; b < n; ++b) start[b + 1] += start[b];
+
+    uint32_t *preds = (uint32_t *)xrealloc(ir->preds, start[n] * sizeof(uint32_t));
+    uint32_t *fill = (uint32_t *)xrealloc(NULL, (n ? n : 1) * sizeof(uint32_t));
+    memcpy(fill, start, n * sizeof(uint32_t));
+    for (size_t b = 0; b < n; ++b) {
+        const IrBlock *blk = &ir->blocks[b];
+        for (int k = 0; k < num_succ(blk); ++k) preds[fill[blk->succ[k]]++] = (uint32_t)b;
+    }
+    free(fill);
+
+    ir->pred_start = start;
+    ir->preds = preds;
+}
+
+// ---------------- Verificador ----------------
+
+/* Operandos esperados por operación: dst, a, b, c.
+   'v' = constante o símbolo, 's' = símbolo, '-' = ninguno,
+   'p' = valor o cadena (print), 'n' = símbolo: el primer operando
+   aritmético no puede ser constante, como en FIS-25 */
+static const char *operand_shapes[IR_NUM_OPS] = {
+    [IR_COPY]  = "sv--",
+    [IR_ADD]   = "snv-", [IR_SUB] = "snv-", [IR_MUL] = "snv-", [IR_DIV] = "snv-",
+    [IR_LT]    = "svv-", [IR_GT]  = "svv-", [IR_EQ]  = "svv-",
+    [IR_PIXEL] = "-vvv",
+    [IR_KEY]   = "sv--",
+    [IR_INPUT] = "s---",
+    [IR_PRINT] = "-p--",
+};
+
+typedef struct {
+    const IrProgram *ir;
+    Diagnostics *diags;
+    int problems;
+    uint32_t *defined_in;   // por símbolo: bloque + 1 donde se escribió el temporal
+} Verifier;
+
+static void problem(Verifier *v, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void problem(Verifier *v, const char *fmt, ...) {
+    char msg[200];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    diag_report(v->diags, DIAG_ERROR, "interno", DIAG_NO_LOC, "IR inválido: %s", msg);
+    v->problems++;
+}
+
+// 'read' = el operando se lee (un temporal tiene que estar escrito antes)
+static void check_value(Verifier *v, IrValue x, char shape, int read, size_t block, size_t insn) {
+    const IrProgram *ir = v->ir;
+    int ok;
+    switch (shape) {
+        case '-': ok = x.kind == IR_NONE; break;
+        case 's': ok = x.kind == IR_SYM; break;
+        case 'n': ok = x.kind == IR_SYM; break;
+        case 'v': ok = x.kind == IR_SYM || x.kind == IR_CONST; break;
+        case 'p': ok = x.kind == IR_SYM || x.kind == IR_CONST || x.kind == IR_STR; break;
+        default:  ok = 0; break;
+    }
+    if (!ok) {
+        problem(v, "operando de tipo incorrecto en '%s' (instrucción %zu)",
+                ir_op_name((IrOp)ir->insns[insn].op), insn);
+        return;
+    }
+    if (x.kind == IR_SYM && (x.val < 0 || (size_t)x.val >= ir->nsyms)) {
+        problem(v, "símbolo fuera de rango en '%s' (instrucción %zu)",
+                ir_op_name((IrOp)ir->insns[insn].op), insn);
+    } else if (x.kind == IR_STR && (x.val < 0 || (size_t)x.val >= ir->nstrings)) {
+        problem(v, "cadena fuera de rango en '%s' (instrucción %zu)",
+                ir_op_name((IrOp)ir->insns[insn].op), insn);
+    } else if (read && x.kind == IR_SYM && ir->syms[x.val].temp &&
+               v->defined_in[x.val] != block + 1) {
+        problem(v, "el temporal %s se lee sin escribirse antes en el bloque (instrucción %zu)",
+                ir->syms[x.val].name, insn);
+    }
+}
+
+int ir_verify(const IrProgram *ir, Diagnostics *diags) {
+    Verifier v = { ir, diags, 0, NULL };
+    v.defined_in = (uint32_t *)calloc(ir->nsyms ? ir->nsyms : 1, sizeof(uint32_t));
+    if (v.defined_in == NULL) {
+        perror("Error de memoria en la representación intermedia");
+        exit(EXIT_FAILURE);
+    }
+
+    if (ir->nblocks == 0) problem(&v, "programa sin bloques");
+    uint32_t expected_start = 0;
+    for (size_t b = 0; b < ir->nblocks; ++b) {
+        const IrBlock *blk = &ir->blocks[b];
+        const char *name = blk->label ? blk->label : "(sin nombre)";
+        if (blk->start != expected_start || blk->end < blk->start || blk->end > ir->ninsns) {
+            problem(&v, "el bloque %s (b%zu) no continúa el tramo de instrucciones", name, b);
+        }
+        expected_start = blk->end;
+
+        switch ((IrTerm)blk->term) {
+            case IR_TERM_JUMP:
+            case IR_TERM_BRANCH:
+                for (int k = 0; k < num_succ(blk); ++k) {
+                    if (blk->succ[k] >= ir->nblocks) {
+                        problem(&v, "el bloque %s (b%zu) salta a un bloque inexistente", name, b);
+                    }
+                }
+                break;
+            case IR_TERM_HALT:
+                if (b + 1 != ir->nblocks) {
+                    problem(&v, "el bloque %s (b%zu) termina el programa antes del final", name, b);
+                }
+                break;
+            default:
+                problem(&v, "el bloque %s (b%zu) no tiene terminador", name, b);
+                break;
+        }
+
+        for (uint32_t i = blk->start; i < blk->end && i < ir->ninsns; ++i) {
+            const IrInsn *in = &ir->insns[i];
+            if (in->op >= IR_NUM_OPS) {
+                problem(&v, "operación desconocida (instrucción %u)", i);
+                continue;
+            }
+            const char *shape = operand_shapes[in->op];
+            check_value(&v, in->a, shape[1], 1, b, i);
+            check_value(&v, in->b, shape[2], 1, b, i);
+            check_value(&v, in->c, shape[3], 1, b, i);
+            check_value(&v, in->dst, shape[0], 0, b, i);
+            if (in->dst.kind == IR_SYM && (size_t)in->dst.val < ir->nsyms) {
+                v.defined_in[in->dst.val] = (uint32_t)b + 1;
+            }
+        }
+        if (blk->term == IR_TERM_BRANCH) {
+            IrValue c = blk->cond;
+            if (c.kind != IR_SYM || (size_t)c.val >= ir->nsyms) {
+                problem(&v, "la bifurcación del bloque %s (b%zu) no tiene condición", name, b);
+            } else if (ir->syms[c.val].temp && v.defined_in[c.val] != b + 1) {
+                problem(&v, "la condición del bloque %s (b%zu) es un temporal sin escribir", name, b);
+            }
+        }
+    }
+    if (ir->nblocks > 0 && expected_start != ir->ninsns) {
+        problem(&v, "hay instrucciones fuera de todo bloque");
+    }
+
+    free(v.defined_in);
+    return v.problems;
+}
+
+// ---------------- Volcado ----------------
+
+static void dump_value(const IrProgram *ir, IrValue x, FILE *out) {
+    switch ((IrValueKind)x.kind) {
+        case IR_CONST: fprintf(out, "%d", x.val); break;
+        case IR_SYM: {
+            const char *name = ir->syms[x.val].name;
+            // $tN se muestra como %tN, para distinguirlo de las variables
+            if (ir->syms[x.val].temp && strncmp(name, "$t", 2) == 0) fprintf(out, "%%t%s", name + 2);
+            else fputs(name, out);
+            break;
+        }
+        case IR_STR:   fputs(ir->strings[x.val], out); break;
+        case IR_NONE:  fputs("_", out); break;
+    }
+}
+
+static void dump_block_ref(const IrProgram *ir, uint32_t b, FILE *out) {
+    fprintf(out, "b%u", b);
+    if (ir->blocks[b].label) fprintf(out, "(%s)", ir->blocks[b].label);
+}
+
+void ir_dump(const IrProgram *ir, FILE *out) {
+    size_t ntemps = 0;
+    for (size_t s = 0; s < ir->nsyms; ++s) ntemps += ir->syms[s].temp;
+    fprintf(out, "; IR: %zu bloques, %zu instrucciones, %zu variables, %zu temporales\n",
+            ir->nblocks, ir->ninsns, ir->nsyms - ntemps, ntemps);
+
+    for (size_t b = 0; b < ir->nblocks; ++b) {
+        const IrBlock *blk = &ir->blocks[b];
+        fprintf(out, "\nb%zu", b);
+        if (blk->label) fprintf(out, " %s", blk->label);
+        fputs(":", out);
+        if (ir->pred_start != NULL) {
+            uint32_t p0 = ir->pred_start[b], p1 = ir->pred_start[b + 1];
+            fputs("    ; preds:", out);
+            if (b == 0) fputs(" entrada", out);
+            else if (p0 == p1) fputs(" ninguno (inalcanzable)", out);
+            for (uint32_t p = p0; p < p1; ++p) fprintf(out, " b%u", ir->preds[p]);
+        }
+        fputc('\n', out);
+
+        for (uint32_t i = blk->start; i < blk->end; ++i) {
+            const IrInsn *in = &ir->insns[i];
+            fputs("    ", out);
+            if (in->dst.kind != IR_NONE) {
+                dump_value(ir, in->dst, out);
+                fputs(" = ", out);
+            }
+            fputs(ir_op_name((IrOp)in->op), out);
+            const IrValue *ops[3] = { &in->a, &in->b, &in->c };
+            const char *sep = " ";
+            for (int k = 0; k < 3; ++k) {
+                if (ops[k]->kind == IR_NONE) continue;
+                fputs(sep, out);
+                dump_value(ir, *ops[k], out);
+                sep = ", ";
+            }
+            fputc('\n', out);
+        }
+
+        switch ((IrTerm)blk->term) {
+            case IR_TERM_JUMP:
+                fputs("    jump ", out);
+                dump_block_ref(ir, blk->succ[0], out);
+                break;
+            case IR_TERM_BRANCH:
+                fputs("    branch ", out);
+                dump_value(ir, blk->cond, out);
+                fputs(" ? ", out);
+                dump_block_ref(ir, blk->succ[0], out);
+                fputs(" : ", out);
+                dump_block_ref(ir, blk->succ[1], out);
+                break;
+            case IR_TERM_HALT:
+                fputs("    halt", out);
+                break;
+            default:
+                fputs("    (sin terminador)", out);
+                break;
+        }
+        fputc('\n', out);
+    }
+}
@@ -0,0 +1,150 @@
+// ir.h
+
+#ifndef IR_H
+#define IR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "ast.h"
+#include "diag.h"
+
+/*
+ * Representación intermedia de tres direcciones entre el AST y FIS-25.
+ *
+ * El programa es una lista de bloques básicos en el orden en que se
+ * emiten. Cada bloque tiene un tramo contiguo de instrucciones sin saltos
+ * y termina explícitamente: salto, bifurcación o fin del programa. Las
+ * aristas del grafo de control son los sucesores de cada terminador (y
+ * sus inversas, ir_preds).
+ *
+ * Las operaciones son las de FIS-25 (dst = a op b) y respetan sus
+ * restricciones: el primer operando aritmético nunca es una constante.
+ * Así la selección de instrucciones es uno a uno y las optimizaciones que
+ * se escriban sobre el grafo valen para el código final.
+ *
+ * Los operandos son constantes o símbolos: variables del programa y
+ * temporales (%tN en el volcado, $tN en FIS-25). Los temporales se
+ * reutilizan de una sentencia a otra (disciplina de pila): un temporal
+ * vive solo dentro del bloque en que se define. Una sentencia que elige
+ * un elemento de arreglo con un árbol de saltos se reparte en varios
+ * bloques; sus valores intermedios son variables $aN, no temporales.
+ * Cada elemento de un arreglo es la variable nombre$eK.
+ */
+
+typedef enum {
+    IR_COPY,        // dst = a
+    IR_ADD,         // dst = a + b
+    IR_SUB,
+    IR_MUL,
+    IR_DIV,
+    IR_LT,          // dst = a < b (0/1)
+    IR_GT,
+    IR_EQ,
+    IR_PIXEL,       // pixel(a, b, c)
+    IR_KEY,         // dst = tecla a
+    IR_INPUT,       // dst = valor de entrada
+    IR_PRINT,       // print a (valor o cadena)
+    IR_NUM_OPS
+} IrOp;
+
+typedef enum {
+    IR_NONE,
+    IR_CONST,       // val = entero
+    IR_SYM,         // val = índice en syms
+    IR_STR          // val = índice en strings (solo print)
+} IrValueKind;
+
+typedef struct {
+    uint8_t kind;   // IrValueKind
+    int32_t val;
+} IrValue;
+
+typedef struct {
+    uint8_t op;     // IrOp
+    IrValue dst;    // IR_NONE en pixel y print
+    IrValue a, b, c;
+} IrInsn;
+
+typedef enum {
+    IR_TERM_NONE,   // todavía abierto (solo durante la construcción)
+    IR_TERM_JUMP,   // succ[0]
+    IR_TERM_BRANCH, // cond != 0 ? succ[0] : succ[1]
+    IR_TERM_HALT    // fin del programa
+} IrTerm;
+
+typedef struct {
+    const char *label;      // nombre (WHILE_0, END_IF_3...) o NULL
+    uint32_t start, end;    // instrucciones [start, end)
+    uint8_t term;           // IrTerm
+    IrValue cond;           // IR_TERM_BRANCH
+    uint32_t succ[2];
+} IrBlock;
+
+typedef struct {
+    const char *name;       // internado
+    uint8_t temp;           // temporal del generador
+} IrSym;
+
+typedef struct {
+    IrInsn *insns;
+    size_t ninsns, cap_insns;
+    IrBlock *blocks;        // en orden de emisión (el bloque 0 es la entrada)
+    size_t nblocks, cap_blocks;
+    IrSym *syms;            // en el orden en que aparecen (el de los VAR de FIS-25)
+    size_t nsyms, cap_syms;
+    const char **strings;   // literales internados (con comillas)
+    size_t nstrings, cap_strings;
+
+    // Predecesores (ir_compute_preds): los de b son preds[pred_start[b] .. pred_start[b + 1])
+    uint32_t *pred_start;
+    uint32_t *preds;
+
+    // Tabla nombre -> símbolo (direccionamiento abierto)
+    const char **sym_keys;
+    int32_t *sym_vals;
+    size_t sym_cap;
+} IrProgram;
+
+static inline IrValue ir_none(void)         { IrValue v = { IR_NONE, 0 }; return v; }
+static inline IrValue ir_const(int32_t k)   { IrValue v = { IR_CONST, k }; return v; }
+static inline IrValue ir_sym_value(int32_t s) { IrValue v = { IR_SYM, s }; return v; }
+
+static inline int ir_same_value(IrValue x, IrValue y) {
+    return x.kind == y.kind && x.val == y.val;
+}
+
+void ir_init(IrProgram *ir);
+void ir_free(IrProgram *ir);
+
+// Índice del símbolo 'name' (lo agrega al final si es nuevo)
+int32_t ir_sym(IrProgram *ir, const char *name, int temp);
+int32_t ir_string(IrProgram *ir, const char *literal);
+
+/**
+ * @brief Traduce la lista de sentencias 'root' a IR (vacío al llamarla).
+ *
+ * Los errores (construcciones que FIS-25 no puede representar) y la
+ * advertencia por flotantes se informan en 'diags'.
+ * @return int Número de errores.
+ */
+int ir_build(IrProgram *ir, const ASTStore *ast, ASTStmtId root, Diagnostics *diags);
+
+// Calcula ir->pred_start / ir->preds (ir_build ya lo hace)
+void ir_compute_preds(IrProgram *ir);
+
+/**
+ * @brief Comprueba la forma del programa: tramos de instrucciones,
+ *        terminadores y sucesores, operandos de cada operación y que todo
+ *        temporal se lea después de escribirse en el mismo bloque.
+ * @return int Número de problemas (cada uno se informa en 'diags' como
+ *         error interno).
+ */
+int ir_verify(const IrProgram *ir, Diagnostics *diags);
+
+// Volcado de texto legible (--dump-ir)
+void ir_dump(const IrProgram *ir, FILE *out);
+
+const char *ir_op_name(IrOp op);
+
+#endif // IR_H
@@ -0,0 +1,925 @@
+// ir_build.c
+
+#include "ir.h"
+#include "ast_range.h"
+#include "intern.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Traducción AST -> IR.
+ *
+ * Las sentencias se emiten en orden sobre el bloque abierto. Los bloques
+ * que son destino de saltos se crean al necesitarlos (a veces antes de
+ * colocarlos: END_WHILE_n se conoce al evaluar la condición) y se numeran
+ * al final según el orden en que se colocaron. Después de un salto no hay
+ * bloque abierto; si algo se emite ahí (código muerto, como el cuerpo de
+ * un meowl (meowf)) va a un bloque sin nombre.
+ *
+ * Los nombres de bloque y de temporales son los del código FIS-25
+ * (WHILE_n, THEN_n, ELSE_n, END_IF_n...; $tN).
+ *
+ * La traducción no es recursiva: lo que queda pendiente de una expresión
+ * (EvalFrame) o de una sentencia compuesta (Task) va a pilas del Builder,
+ * así el anidamiento del fuente no está acotado por la pila de C.
+ *
+ * Arreglos: cada elemento es una variable (nums$e0, nums$e1...). Un
+ * índice que se conoce al compilar (literal, o un intervalo de un solo
+ * valor según ast_range.c) nombra el elemento directamente. FIS-25 no
+ * tiene direccionamiento indexado, así que un índice que se conoce recién
+ * al ejecutar elige el elemento con un árbol de comparaciones (LT contra
+ * la mitad del intervalo que queda); los extremos que el análisis de
+ * rangos no descarta saltan a ARRAY_OOB, que avisa y termina el programa.
+ * La sentencia que tiene un acceso así ocupa varios bloques, por eso sus
+ * valores intermedios no van a temporales sino a variables $aN.
+ */
+
+#define NO_BLOCK UINT32_MAX
+
+// Evaluación pendiente de una expresión
+typedef enum {
+    EVAL_OPERAND,            // falta empezar a evaluar 'id' como operando
+    EVAL_BINOP,              // lower_into de una operación
+    EVAL_INDEX,              // leer nums[i] sobre 'dst' (índice dinámico)
+    EVAL_COPY,               // copiar a 'dst' el operando recién evaluado
+    EVAL_RESULT              // el operando que se evaluaba vale 'dst'
+} EvalKind;
+
+typedef struct {
+    uint8_t kind;            // EvalKind
+    uint8_t step;            // EVAL_BINOP: 0 = falta el izquierdo, 1 = el derecho, 2 = operar;
+                             // EVAL_INDEX: 0 = falta el índice, 1 = elegir el elemento
+    int mark;                // EVAL_BINOP / EVAL_INDEX: temp_top al empezar
+    ASTExprId id;
+    IrValue dst;
+    IrValue left;            // EVAL_BINOP: operando izquierdo ya evaluado
+} EvalFrame;
+
+// Lo que falta de una lista de sentencias o de una sentencia compuesta
+typedef enum {
+    TASK_LIST,               // las sentencias desde 'stmt'
+    TASK_ELSE,               // terminó la rama then de un IF con else ('stmt')
+    TASK_END_WHILE,          // terminó el cuerpo de un WHILE
+    TASK_END_IF              // terminaron las ramas de un IF
+} TaskKind;
+
+typedef struct {
+    uint8_t kind;            // TaskKind
+    ASTStmtId stmt;
+    uint32_t head, end, els; // bloques de la sentencia
+} Task;
+
+typedef struct {
+    IrProgram *ir;
+    const ASTStore *ast;
+    ASTStmtId root;
+    Diagnostics *diags;
+    uint32_t cur;            // bloque abierto, o NO_BLOCK
+    uint32_t *order;         // por bloque: posición en que se colocó (NO_BLOCK = todavía no)
+    size_t cap_order;
+    uint32_t nplaced;
+    int label_counter;
+    int temp_top;
+    int errors;
+    int warned_float;
+
+    EvalFrame *eval;
+    size_t neval, cap_eval;
+    IrValue result;          // valor del último operando evaluado
+    Task *tasks;
+    size_t ntasks, cap_tasks;
+
+    // Arreglos declarados: nombre -> largo de la última declaración (en orden del programa)
+    const char **array_keys;
+    int32_t *array_lens;
+    size_t array_cap, narrays;
+    ASTRanges ranges;        // se calculan con el primer índice que no es literal
+    int have_ranges;
+    int split;               // la sentencia en curso tiene accesos con índice dinámico
+    uint32_t oob;            // ARRAY_OOB, o NO_BLOCK si ningún acceso puede salirse
+    const char **assigned;   // por expresión (ver assigned_vars), al primer uso
+    ASTWork scan;
+} Builder;
+
+static void *xrealloc(void *p, size_t size) {
+    void *q = realloc(p, size ? size : 1);
+    if (q == NULL) {
+        perror("Error de memoria en la representación intermedia");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+/* ================= Bloques ================= */
+
+static uint32_t new_block(Builder *b, const char *label) {
+    IrProgram *ir = b->ir;
+    if (ir->nblocks == ir->cap_blocks) {
+        ir->cap_blocks = ir->cap_blocks ? ir->cap_blocks * 2 : 64;
+        ir->blocks = (IrBlock *)xrealloc(ir->blocks, ir->cap_blocks * sizeof(*ir->blocks));
+    }
+    if (ir->nblocks == b->cap_order) {
+        b->cap_order = b->cap_order ? b->cap_order * 2 : 64;
+        b->order = (uint32_t *)xrealloc(b->order, b->cap_order * sizeof(*b->order));
+    }
+    uint32_t id = (uint32_t)ir->nblocks++;
+    IrBlock *blk = &ir->blocks[id];
+    memset(blk, 0, sizeof(*blk));
+    blk->label = label;
+    blk->term = IR_TERM_NONE;
+    b->order[id] = NO_BLOCK;
+    return id;
+}
+
+// Cierra el bloque abierto (si lo hay; si no, uno vacío sin nombre)
+static void terminate(Builder *b, IrTerm term, IrValue cond, uint32_t s0, uint32_t s1);
+
+// Coloca 'id' a continuación; el bloque abierto sigue de largo hacia él
+static void place_block(Builder *b, uint32_t id) {
+    if (b->cur != NO_BLOCK) terminate(b, IR_TERM_JUMP, ir_none(), id, 0);
+    b->ir->blocks[id].start = (uint32_t)b->ir->ninsns;
+    b->order[id] = b->nplaced++;
+    b->cur = id;
+}
+
+static void ensure_open(Builder *b) {
+    if (b->cur == NO_BLOCK) place_block(b, new_block(b, NULL));
+}
+
+static void terminate(Builder *b, IrTerm term, IrValue cond, uint32_t s0, uint32_t s1) {
+    ensure_open(b);
+    IrBlock *blk = &b->ir->blocks[b->cur];
+    blk->end = (uint32_t)b->ir->ninsns;
+    blk->term = (uint8_t)term;
+    blk->cond = cond;
+    blk->succ[0] = s0;
+    blk->succ[1] = s1;
+    b->cur = NO_BLOCK;
+}
+
+static void jump(Builder *b, uint32_t target) {
+    terminate(b, IR_TERM_JUMP, ir_none(), target, 0);
+}
+
+static const char *num_label(const char *prefix, int n) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%s_%d", prefix, n);
+    return intern(buf);
+}
+
+// Renumera los bloques en el orden en que se colocaron
+static void finish_blocks(Builder *b) {
+    IrProgram *ir = b->ir;
+    IrBlock *blocks = (IrBlock *)xrealloc(NULL, ir->nblocks * sizeof(*blocks));
+    size_t n = 0;
+    for (size_t i = 0; i < ir->nblocks; ++i) {
+        if (b->order[i] == NO_BLOCK) continue;   // creado pero nunca colocado
+        blocks[b->order[i]] = ir->blocks[i];
+        n++;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        blocks[i].succ[0] = blocks[i].term >= IR_TERM_JUMP ? b->order[blocks[i].succ[0]] : 0;
+        blocks[i].succ[1] = blocks[i].term == IR_TERM_BRANCH ? b->order[blocks[i].succ[1]] : 0;
+    }
+    free(ir->blocks);
+    ir->blocks = blocks;
+    ir->nblocks = ir->cap_blocks = n;
+}
+
+/* ================= Instrucciones ================= */
+
+static void emit(Builder *b, IrOp op, IrValue dst, IrValue a, IrValue x, IrValue c) {
+    ensure_open(b);
+    IrProgram *ir = b->ir;
+    if (ir->ninsns == ir->cap_insns) {
+        ir->cap_insns = ir->cap_insns ? ir->cap_insns * 2 : 256;
+        ir->insns = (IrInsn *)xrealloc(ir->insns, ir->cap_insns * sizeof(*ir->insns));
+    }
+    IrInsn *in = &ir->insns[ir->ninsns++];
+    in->op = (uint8_t)op;
+    in->dst = dst;
+    in->a = a;
+    in->b = x;
+    in->c = c;
+}
+
+static IrValue var(Builder *b, const char *name) {
+    return ir_sym_value(ir_sym(b->ir, name, 0));
+}
+
+/* Un temporal vive en un solo bloque; en una sentencia partida por un
+   acceso a arreglo el mismo lugar de la pila es una variable $aN */
+static IrValue new_temp(Builder *b) {
+    char buf[32];
+    if (b->split) {
+        snprintf(buf, sizeof(buf), "$a%d", b->temp_top++);
+        return ir_sym_value(ir_sym(b->ir, buf, 0));
+    }
+    snprintf(buf, sizeof(buf), "$t%d", b->temp_top++);
+    return ir_sym_value(ir_sym(b->ir, buf, 1));
+}
+
+static void lower_error(Builder *b, const char *what) {
+    diag_report(b->diags, DIAG_ERROR, "de codegen FIS-25", DIAG_NO_LOC, "%s.", what);
+    b->errors++;
+}
+
+static void emit_copy(Builder *b, IrValue src, IrValue dst) {
+    if (ir_same_value(src, dst)) return;
+    emit(b, IR_COPY, dst, src, ir_none(), ir_none());
+}
+
+/* ================= Arreglos ================= */
+
+static size_t hash_ptr(const char *s) {
+    uint64_t h = (uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+// Largo de la declaración de 'name' que está a la vista (0 si no es un arreglo)
+static int32_t array_length(const Builder *b, const char *name) {
+    if (b->array_cap == 0) return 0;
+    size_t i = hash_ptr(name) & (b->array_cap - 1);
+    while (b->array_keys[i] != NULL) {
+        if (b->array_keys[i] == name) return b->array_lens[i];
+        i = (i + 1) & (b->array_cap - 1);
+    }
+    return 0;
+}
+
+static void set_array_length(Builder *b, const char *name, int32_t len) {
+    if ((b->narrays + 1) * 2 > b->array_cap) {
+        const char **keys = b->array_keys;
+        int32_t *lens = b->array_lens;
+        size_t cap = b->array_cap;
+        b->array_cap = cap ? cap * 2 : 16;
+        b->array_keys = (const char **)xrealloc(NULL, b->array_cap * sizeof(*keys));
+        b->array_lens = (int32_t *)xrealloc(NULL, b->array_cap * sizeof(*lens));
+        memset(b->array_keys, 0, b->array_cap * sizeof(*keys));
+        b->narrays = 0;
+        for (size_t i = 0; i < cap; ++i) {
+            if (keys[i] != NULL) set_array_length(b, keys[i], lens[i]);
+        }
+        free(keys);
+        free(lens);
+    }
+    size_t i = hash_ptr(name) & (b->array_cap - 1);
+    while (b->array_keys[i] != NULL && b->array_keys[i] != name) i = (i + 1) & (b->array_cap - 1);
+    if (b->array_keys[i] == NULL) {
+        b->array_keys[i] = name;
+        b->narrays++;
+    }
+    b->array_lens[i] = len;
+}
+
+// El elemento k de 'name' es la variable name$ek
+static IrValue element(Builder *b, const char *name, int32_t k) {
+    char buf[300];
+    snprintf(buf, sizeof(buf), "%s$e%d", name, k);
+    return var(b, buf);
+}
+
+static ASTRange index_range(Builder *b, ASTExprId index) {
+    if (!b->have_ranges) {
+        ast_ranges_compute(&b->ranges, b->ast, b->root);
+        b->have_ranges = 1;
+    }
+    return ast_range_index(&b->ranges, index);
+}
+
+/* Si el índice se conoce al compilar deja el elemento en *k y devuelve 1;
+   entonces el índice no se evalúa (si no es un literal, tiene que no tener
+   efectos). Un literal fuera del arreglo solo puede venir de ast_opt (parser.y
+   rechaza los del fuente, p. ej. a[1 + 1] plegado): sigue el camino dinámico,
+   que salta a ARRAY_OOB igual que sin optimizar. */
+static int static_index(Builder *b, const char *name, ASTExprId index, int32_t *k) {
+    const ASTExpr *e = ast_expr(b->ast, index);
+    int32_t len = array_length(b, name);
+
+    if (e->kind == AST_EXPR_INT) {
+        *k = e->u.ival;
+        return *k >= 0 && *k < len;
+    }
+    ASTRange r = index_range(b, index);
+    if (r.lo == r.hi && r.lo >= 0 && r.lo < len && ast_range_quiet(&b->ranges, b->ast, index, &b->scan)) {
+        *k = r.lo;
+        return 1;
+    }
+    return 0;
+}
+
+// 1 si el índice es un literal dentro del arreglo 'name'
+static int literal_in_array(Builder *b, const char *name, ASTExprId index) {
+    const ASTExpr *e = ast_expr(b->ast, index);
+    return e->kind == AST_EXPR_INT && e->u.ival >= 0 && e->u.ival < array_length(b, name);
+}
+
+// 1 si la expresión lee un arreglo con un índice que no es un literal dentro de él
+static int has_dynamic_index(Builder *b, ASTExprId id) {
+    ASTWork *w = &b->scan;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        const ASTExpr *e = ast_expr(b->ast, ast_work_pop(w).id);
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_INDEX:
+                if (!literal_in_array(b, e->u.name, e->child)) return 1;
+                break;
+            case AST_EXPR_ASSIGN:
+                ast_work_push(w, e->child, 0);
+                break;
+            case AST_EXPR_BINOP:
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+                break;
+            default:
+                break;
+        }
+    }
+    return 0;
+}
+
+// 1 si la sentencia (sin contar sus listas anidadas) ocupará varios bloques
+static int stmt_splits(Builder *b, const ASTStmt *s) {
+    switch ((ASTStmtKind)s->kind) {
+        case AST_STMT_DECL:
+            return s->u.decl.init && has_dynamic_index(b, s->u.decl.init);
+        case AST_STMT_ASSIGN:
+            if (s->u.assign.index &&
+                (!literal_in_array(b, s->u.assign.name, s->u.assign.index) ||
+                 has_dynamic_index(b, s->u.assign.index))) {
+                return 1;
+            }
+            return has_dynamic_index(b, s->u.assign.expr);
+        case AST_STMT_WHILE:
+            return has_dynamic_index(b, s->u.while_stmt.cond);
+        case AST_STMT_IF:
+            return has_dynamic_index(b, s->u.if_stmt.cond);
+        case AST_STMT_PIXEL:
+            return has_dynamic_index(b, s->u.pixel.x) || has_dynamic_index(b, s->u.pixel.y) ||
+                   has_dynamic_index(b, s->u.pixel.color);
+        case AST_STMT_KEY:
+            return has_dynamic_index(b, s->u.key.key_code);
+        case AST_STMT_PRINT:
+            return has_dynamic_index(b, s->u.print.expr);
+        case AST_STMT_INPUT:
+        case AST_STMT_BLOCK:
+            break;
+    }
+    return 0;
+}
+
+static uint32_t oob_block(Builder *b) {
+    if (b->oob == NO_BLOCK) b->oob = new_block(b, "ARRAY_OOB");
+    return b->oob;
+}
+
+// Un acceso con índice dinámico: el elemento 'idx' de 'name' se copia a
+// 'value' o, si 'store', 'value' se copia al elemento
+typedef struct {
+    const char *name;
+    int32_t len;
+    int n;                   // número del acceso (etiquetas INDEX_n_...)
+    uint32_t end;
+    IrValue idx, value;
+    int store;
+} Access;
+
+// Sale a 'taken' si 'idx op k'; si no, sigue en el bloque siguiente
+static void branch_on(Builder *b, IrOp op, IrValue idx, int32_t k, uint32_t taken) {
+    int mark = b->temp_top;
+    IrValue t = new_temp(b);
+    emit(b, op, t, idx, ir_const(k), ir_none());
+    uint32_t next = new_block(b, NULL);
+    terminate(b, IR_TERM_BRANCH, t, taken, next);
+    place_block(b, next);
+    b->temp_top = mark;
+}
+
+static const char *range_label(int n, int64_t lo, int64_t hi) {
+    char buf[64];
+    if (lo == hi) snprintf(buf, sizeof(buf), "INDEX_%d_%lld", n, (long long)lo);
+    else snprintf(buf, sizeof(buf), "INDEX_%d_%lld_%lld", n, (long long)lo, (long long)hi);
+    return intern(buf);
+}
+
+/* Elige el elemento sabiendo que el índice está en [lo, hi]. Cada nivel
+   parte el intervalo a la mitad: la recursión tiene a lo sumo ~34 niveles. */
+static void index_tree(Builder *b, const Access *x, int64_t lo, int64_t hi) {
+    if (hi < 0 || lo >= x->len) {
+        jump(b, oob_block(b));
+        return;
+    }
+    if (lo < 0) {
+        branch_on(b, IR_LT, x->idx, 0, oob_block(b));
+        index_tree(b, x, 0, hi);
+        return;
+    }
+    if (hi >= x->len) {
+        branch_on(b, IR_GT, x->idx, x->len - 1, oob_block(b));
+        index_tree(b, x, lo, x->len - 1);
+        return;
+    }
+    if (lo == hi) {
+        IrValue slot = element(b, x->name, (int32_t)lo);
+        if (x->store) emit_copy(b, x->value, slot);
+        else emit_copy(b, slot, x->value);
+        jump(b, x->end);
+        return;
+    }
+    int64_t mid = lo + (hi - lo + 1) / 2;
+    uint32_t low = new_block(b, range_label(x->n, lo, mid - 1));
+    branch_on(b, IR_LT, x->idx, (int32_t)mid, low);
+    index_tree(b, x, mid, hi);
+    place_block(b, low);
+    index_tree(b, x, lo, mid - 1);
+}
+
+static void select_element(Builder *b, const char *name, ASTExprId index, IrValue idx,
+                           IrValue value, int store) {
+    Access x;
+    x.name = name;
+    x.len = array_length(b, name);
+    x.n = b->label_counter++;
+    x.end = new_block(b, num_label("END_INDEX", x.n));
+    x.idx = idx;
+    x.value = value;
+    x.store = store;
+
+    ASTRange r = index_range(b, index);
+    if (idx.kind == IR_CONST) r.lo = r.hi = idx.val;
+    index_tree(b, &x, r.lo, r.hi);
+    place_block(b, x.end);
+}
+
+static IrOp binop_op(ASTBinOp op) {
+    switch (op) {
+        case AST_BINOP_ADD: return IR_ADD;
+        case AST_BINOP_SUB: return IR_SUB;
+        case AST_BINOP_MUL: return IR_MUL;
+        case AST_BINOP_DIV: return IR_DIV;
+    }
+    return IR_ADD;
+}
+
+static void push_eval(Builder *b, EvalKind kind, ASTExprId id, IrValue dst) {
+    if (b->neval == b->cap_eval) {
+        b->cap_eval = b->cap_eval ? b->cap_eval * 2 : 64;
+        b->eval = (EvalFrame *)xrealloc(b->eval, b->cap_eval * sizeof(*b->eval));
+    }
+    EvalFrame *f = &b->eval[b->neval++];
+    f->kind = (uint8_t)kind;
+    f->step = 0;
+    f->mark = b->temp_top;
+    f->id = id;
+    f->dst = dst;
+    f->left = ir_none();
+}
+
+static void begin_into(Builder *b, ASTExprId id, IrValue dst);
+
+/* Empieza a evaluar e como operando (constante, variable o temporal): si es
+   una hoja el valor queda en b->result; si no, se apilan los marcos que lo
+   calculan y lo dejan ahí */
+static void begin_operand(Builder *b, ASTExprId id) {
+    const ASTExpr *e = ast_expr(b->ast, id);
+
+    switch ((ASTExprKind)e->kind) {
+        case AST_EXPR_INT:
+        case AST_EXPR_BOOL:
+            b->result = ir_const(e->u.ival);
+            return;
+
+        case AST_EXPR_FLOAT:
+            if (!b->warned_float) {
+                diag_report(b->diags, DIAG_WARNING, NULL, DIAG_NO_LOC,
+                            "FIS-25 solo maneja enteros; los flotantes se truncan.");
+                b->warned_float = 1;
+            }
+            b->result = ir_const((int)e->u.fval);
+            return;
+
+        case AST_EXPR_VAR:
+            b->result = var(b, e->u.name);
+            return;
+
+        case AST_EXPR_STRING:
+            lower_error(b, "las cadenas solo pueden usarse como literal en miau_print");
+            b->result = ir_const(0);
+            return;
+
+        case AST_EXPR_ASSIGN: {
+            IrValue dst = var(b, e->u.name);
+            push_eval(b, EVAL_RESULT, id, dst);
+            begin_into(b, e->child, dst);
+            return;
+        }
+
+        case AST_EXPR_INDEX: {
+            int32_t k;
+            if (static_index(b, e->u.name, e->child, &k)) {
+                b->result = element(b, e->u.name, k);
+                return;
+            }
+            IrValue t = new_temp(b);
+            push_eval(b, EVAL_RESULT, id, t);
+            push_eval(b, EVAL_INDEX, id, t);
+            return;
+        }
+
+        case AST_EXPR_LENGTH:
+            b->result = ir_const(array_length(b, e->u.name));
+            return;
+
+        case AST_EXPR_BINOP: {
+            IrValue t = new_temp(b);
+            push_eval(b, EVAL_RESULT, id, t);
+            begin_into(b, id, t);
+            return;
+        }
+    }
+    b->result = ir_const(0);
+}
+
+/* Empieza a evaluar e directamente sobre dst. Solo apila: una cadena de
+   asignaciones (a = b = c = ...) no anida llamadas con begin_operand */
+static void begin_into(Builder *b, ASTExprId id, IrValue dst) {
+    const ASTExpr *e = ast_expr(b->ast, id);
+    int32_t k;
+    if (e->kind == AST_EXPR_BINOP) {
+        push_eval(b, EVAL_BINOP, id, dst);
+    } else if (e->kind == AST_EXPR_INDEX && !b->ir->syms[dst.val].temp &&
+               !static_index(b, e->u.name, e->child, &k)) {
+        push_eval(b, EVAL_INDEX, id, dst);   // cada hoja del árbol escribe dst
+    } else {
+        push_eval(b, EVAL_COPY, id, dst);
+        push_eval(b, EVAL_OPERAND, id, ir_none());
+    }
+}
+
+/* Qué variables asigna evaluar cada expresión: ASSIGNS_NONE, el nombre de
+   la única que asigna o ASSIGNS_MANY (NULL: todavía no se calculó). Cada
+   nodo se recorre una sola vez, así que una suma anidada a la derecha sigue
+   siendo lineal */
+static const char ASSIGNS_NONE[] = "ninguna";
+static const char ASSIGNS_MANY[] = "varias";
+
+static const char *merge_assigned(const char *x, const char *y) {
+    if (x == ASSIGNS_NONE || x == y) return y;
+    if (y == ASSIGNS_NONE) return x;
+    return ASSIGNS_MANY;
+}
+
+static const char *assigned_vars(Builder *b, ASTExprId id) {
+    if (!b->assigned) {
+        size_t size = b->ast->num_exprs * sizeof(*b->assigned);
+        b->assigned = (const char **)xrealloc(NULL, size);
+        memset(b->assigned, 0, size);
+    }
+    const char **a = b->assigned;
+    ASTWork *w = &b->scan;
+    w->len = 0;
+    ast_work_push(w, id, 0);
+    while (w->len > 0) {
+        ASTWorkItem it = ast_work_pop(w);
+        if (a[it.id]) continue;
+        const ASTExpr *e = ast_expr(b->ast, it.id);
+        if (it.state == 0 && (e->kind == AST_EXPR_ASSIGN || e->kind == AST_EXPR_INDEX ||
+                              e->kind == AST_EXPR_BINOP)) {
+            // Primero los hijos
+            ast_work_push(w, it.id, 1);
+            if (e->kind == AST_EXPR_BINOP) {
+                ast_work_push(w, e->u.bin.left, 0);
+                ast_work_push(w, e->u.bin.right, 0);
+            } else {
+                ast_work_push(w, e->child, 0);
+            }
+            continue;
+        }
+        switch ((ASTExprKind)e->kind) {
+            case AST_EXPR_ASSIGN:
+                a[it.id] = merge_assigned(e->u.name, a[e->child]);
+                break;
+            case AST_EXPR_INDEX:
+                a[it.id] = a[e->child];
+                break;
+            case AST_EXPR_BINOP:
+                a[it.id] = merge_assigned(a[e->u.bin.left], a[e->u.bin.right]);
+                break;
+            default:
+                a[it.id] = ASSIGNS_NONE;
+                break;
+        }
+    }
+    return a[id];
+}
+
+/* Operando izquierdo 'l' ya evaluado. Una variable del programa se lee
+   recién al operar: si el operando derecho la asigna, se copia antes a un
+   temporal ((x + 0) - (x = 2) resta de x su valor anterior, con o sin -O) */
+static IrValue left_snapshot(Builder *b, IrValue l, ASTExprId right) {
+    if (l.kind != IR_SYM || b->ir->syms[l.val].temp) return l;
+    const char *assigned = assigned_vars(b, right);
+    if (assigned == ASSIGNS_NONE ||
+        (assigned != ASSIGNS_MANY && assigned != b->ir->syms[l.val].name)) return l;
+    IrValue t = new_temp(b);
+    emit_copy(b, l, t);
+    return t;
+}
+
+/* Una operación con los dos operandos ya evaluados */
+static void finish_binop(Builder *b, const EvalFrame *f, IrValue r) {
+    ASTBinOp op = (ASTBinOp)ast_expr(b->ast, f->id)->op;
+    IrValue l = f->left;
+
+    // Como en FIS-25, una constante no puede ser el primer operando
+    if (l.kind == IR_CONST) {
+        if ((op == AST_BINOP_ADD || op == AST_BINOP_MUL) && r.kind != IR_CONST) {
+            IrValue tmp = l; l = r; r = tmp;      /* conmutativa */
+        } else {
+            IrValue t = new_temp(b);
+            emit_copy(b, l, t);
+            l = t;
+        }
+    }
+
+    emit(b, binop_op(op), f->dst, l, r, ir_none());
+
+    b->temp_top = f->mark;   /* los temporales de los operandos ya no se usan */
+}
+
+/* Resuelve los marcos apilados por encima de 'base', en el mismo orden en
+   que los emitiría el recorrido recursivo */
+static void run_eval(Builder *b, size_t base) {
+    while (b->neval > base) {
+        EvalFrame *f = &b->eval[b->neval - 1];
+        const ASTExpr *e = ast_expr(b->ast, f->id);
+
+        switch ((EvalKind)f->kind) {
+            case EVAL_OPERAND: {
+                ASTExprId id = f->id;
+                b->neval--;
+                begin_operand(b, id);
+                break;
+            }
+
+            case EVAL_RESULT:
+                b->result = f->dst;
+                b->neval--;
+                break;
+
+            case EVAL_COPY:
+                b->neval--;
+                emit_copy(b, b->result, f->dst);
+                break;
+
+            case EVAL_BINOP:
+                // begin_operand puede mover b->eval: 'f' no se usa después
+                if (f->step == 0) {
+                    f->step = 1;
+                    begin_operand(b, e->u.bin.left);
+                } else if (f->step == 1) {
+                    f->left = left_snapshot(b, b->result, e->u.bin.right);
+                    f->step = 2;
+                    begin_operand(b, e->u.bin.right);
+                } else {
+                    EvalFrame done = *f;
+                    b->neval--;
+                    finish_binop(b, &done, b->result);
+                }
+                break;
+
+            case EVAL_INDEX:
+                if (f->step == 0) {
+                    f->step = 1;
+                    begin_operand(b, e->child);
+                } else {
+                    int mark = f->mark;
+                    IrValue dst = f->dst;
+                    b->neval--;
+                    select_element(b, e->u.name, e->child, b->result, dst, 0);
+                    b->temp_top = mark;
+                }
+                break;
+        }
+    }
+}
+
+/* Devuelve un operando con el valor de e (constante, variable o temporal) */
+static IrValue lower_operand(Builder *b, ASTExprId id) {
+    size_t base = b->neval;
+    begin_operand(b, id);
+    run_eval(b, base);
+    return b->result;
+}
+
+/* Evalúa e directamente sobre dst */
+static void lower_into(Builder *b, ASTExprId id, IrValue dst) {
+    size_t base = b->neval;
+    begin_into(b, id, dst);
+    run_eval(b, base);
+}
+
+/* name[index] = expr. El índice se evalúa antes que el valor; si es una
+   variable que el valor cambia, se guarda antes su valor. */
+static void lower_store(Builder *b, const char *name, ASTExprId index, ASTExprId expr) {
+    int32_t k;
+    if (static_index(b, name, index, &k)) {
+        lower_into(b, expr, element(b, name, k));
+        return;
+    }
+    IrValue idx = lower_operand(b, index);
+    ASTExprKind kind = (ASTExprKind)ast_expr(b->ast, index)->kind;
+    if ((kind == AST_EXPR_VAR || kind == AST_EXPR_ASSIGN) && !ast_expr_pure(b->ast, expr, &b->scan)) {
+        IrValue t = new_temp(b);
+        emit_copy(b, idx, t);
+        idx = t;
+    }
+    IrValue value = lower_operand(b, expr);
+    select_element(b, name, index, idx, value, 1);
+}
+
+/* Sigue en un bloque nuevo 'prefix_n' si la condición es cierta y salta a
+   'if_false' si no. Con una condición constante no hay bifurcación. */
+static void lower_cond(Builder *b, ASTExprId cond, const char *prefix, int n, uint32_t if_false) {
+    IrValue c = lower_operand(b, cond);
+    if (c.kind == IR_CONST) {
+        if (!c.val) jump(b, if_false);
+        return;
+    }
+    uint32_t body = new_block(b, num_label(prefix, n));
+    terminate(b, IR_TERM_BRANCH, c, body, if_false);
+    place_block(b, body);
+}
+
+static void push_task(Builder *b, TaskKind kind, ASTStmtId stmt,
+                      uint32_t head, uint32_t end, uint32_t els) {
+    if (b->ntasks == b->cap_tasks) {
+        b->cap_tasks = b->cap_tasks ? b->cap_tasks * 2 : 64;
+        b->tasks = (Task *)xrealloc(b->tasks, b->cap_tasks * sizeof(*b->tasks));
+    }
+    Task *t = &b->tasks[b->ntasks++];
+    t->kind = (uint8_t)kind;
+    t->stmt = stmt;
+    t->head = head;
+    t->end = end;
+    t->els = els;
+}
+
+/* Traduce una sentencia; las listas anidadas y lo que va después de ellas
+   quedan como tareas en b->tasks (ver lower_stmt_list) */
+static void lower_stmt(Builder *b, ASTStmtId id) {
+    const ASTStmt *s = ast_stmt(b->ast, id);
+    b->temp_top = 0;
+    b->split = b->narrays > 0 && stmt_splits(b, s);
+
+    switch ((ASTStmtKind)s->kind) {
+        case AST_STMT_DECL: {
+            if (s->u.decl.array_length > 0) {
+                // Los VAR de los elementos, en orden
+                set_array_length(b, s->u.decl.name, s->u.decl.array_length);
+                for (int32_t k = 0; k < s->u.decl.array_length; ++k) element(b, s->u.decl.name, k);
+                break;
+            }
+            IrValue dst = var(b, s->u.decl.name);   // el VAR se declara aquí
+            if (s->u.decl.init) lower_into(b, s->u.decl.init, dst);
+            break;
+        }
+
+        case AST_STMT_ASSIGN: {
+            if (s->u.assign.index) {
+                lower_store(b, s->u.assign.name, s->u.assign.index, s->u.assign.expr);
+                break;
+            }
+            IrValue dst = var(b, s->u.assign.name);
+            lower_into(b, s->u.assign.expr, dst);
+            break;
+        }
+
+        case AST_STMT_WHILE: {
+            int n = b->label_counter++;
+            uint32_t head = new_block(b, num_label("WHILE", n));
+            uint32_t end = new_block(b, num_label("END_WHILE", n));
+            place_block(b, head);
+            lower_cond(b, s->u.while_stmt.cond, "WHILE_BODY", n, end);
+            push_task(b, TASK_END_WHILE, AST_NONE, head, end, 0);
+            push_task(b, TASK_LIST, s->u.while_stmt.body, 0, 0, 0);
+            break;
+        }
+
+        case AST_STMT_IF: {
+            int n = b->label_counter++;
+            ASTStmtId else_branch = s->u.if_stmt.else_branch;
+            uint32_t end = new_block(b, num_label("END_IF", n));
+            uint32_t els = else_branch ? new_block(b, num_label("ELSE", n)) : end;
+            lower_cond(b, s->u.if_stmt.cond, "THEN", n, els);
+            if (else_branch) push_task(b, TASK_ELSE, else_branch, 0, end, els);
+            else push_task(b, TASK_END_IF, AST_NONE, 0, end, 0);
+            push_task(b, TASK_LIST, s->u.if_stmt.then_branch, 0, 0, 0);
+            break;
+        }
+
+        case AST_STMT_PIXEL: {
+            IrValue x = lower_operand(b, s->u.pixel.x);
+            IrValue y = lower_operand(b, s->u.pixel.y);
+            IrValue c = lower_operand(b, s->u.pixel.color);
+            emit(b, IR_PIXEL, ir_none(), x, y, c);
+            break;
+        }
+
+        case AST_STMT_KEY: {
+            IrValue k = lower_operand(b, s->u.key.key_code);
+            emit(b, IR_KEY, var(b, s->u.key.dest_name), k, ir_none(), ir_none());
+            break;
+        }
+
+        case AST_STMT_INPUT:
+            emit(b, IR_INPUT, var(b, s->u.input.dest_name), ir_none(), ir_none(), ir_none());
+            break;
+
+        case AST_STMT_PRINT: {
+            const ASTExpr *e = ast_expr(b->ast, s->u.print.expr);
+            IrValue v;
+            if (e->kind == AST_EXPR_STRING) {
+                v.kind = IR_STR;
+                v.val = ir_string(b->ir, e->u.sval);
+            } else {
+                v = lower_operand(b, s->u.print.expr);
+            }
+            emit(b, IR_PRINT, ir_none(), v, ir_none(), ir_none());
+            break;
+        }
+
+        case AST_STMT_BLOCK:
+            push_task(b, TASK_LIST, s->u.block.stmts, 0, 0, 0);
+            break;
+    }
+}
+
+/* Cada TASK_LIST deja apilado el resto de la lista antes de traducir su
+   primera sentencia, así lo que esta apile (sus listas anidadas y el
+   cierre de la sentencia) se hace antes de seguir con la siguiente */
+static void lower_stmt_list(Builder *b, ASTStmtId first) {
+    size_t base = b->ntasks;
+    push_task(b, TASK_LIST, first, 0, 0, 0);
+
+    while (b->ntasks > base) {
+        Task t = b->tasks[--b->ntasks];
+        switch ((TaskKind)t.kind) {
+            case TASK_LIST:
+                if (t.stmt == AST_NONE) break;
+                push_task(b, TASK_LIST, ast_stmt(b->ast, t.stmt)->next, 0, 0, 0);
+                lower_stmt(b, t.stmt);
+                break;
+            case TASK_ELSE:
+                jump(b, t.end);
+                place_block(b, t.els);
+                push_task(b, TASK_END_IF, AST_NONE, 0, t.end, 0);
+                push_task(b, TASK_LIST, t.stmt, 0, 0, 0);
+                break;
+            case TASK_END_WHILE:
+                jump(b, t.head);
+                place_block(b, t.end);
+                break;
+            case TASK_END_IF:
+                place_block(b, t.end);
+                break;
+        }
+    }
+}
+
+int ir_build(IrProgram *ir, const ASTStore *ast, ASTStmtId root, Diagnostics *diags) {
+    Builder b;
+    memset(&b, 0, sizeof(b));
+    b.ir = ir;
+    b.ast = ast;
+    b.root = root;
+    b.diags = diags;
+    b.cur = NO_BLOCK;
+    b.oob = NO_BLOCK;
+
+    ensure_open(&b);   // bloque de entrada
+    lower_stmt_list(&b, root);
+    if (b.oob != NO_BLOCK) {
+        // Un índice fuera del arreglo avisa y termina el programa
+        uint32_t end = new_block(&b, "END_PROGRAM");
+        if (b.cur != NO_BLOCK) jump(&b, end);
+        place_block(&b, b.oob);
+        IrValue msg = { IR_STR, ir_string(ir, "\"indice de arreglo fuera de rango\"") };
+        emit(&b, IR_PRINT, ir_none(), msg, ir_none(), ir_none());
+        place_block(&b, end);
+    }
+    terminate(&b, IR_TERM_HALT, ir_none(), 0, 0);
+
+    finish_blocks(&b);
+    free(b.order);
+    free(b.eval);
+    free(b.tasks);
+    free(b.array_keys);
+    free(b.array_lens);
+    free(b.assigned);
+    if (b.have_ranges) ast_ranges_free(&b.ranges);
+    ast_work_free(&b.scan);
+    ir_compute_preds(ir);
+    return b.errors;
+}
@@ -1,31 +1,73 @@
+#include <errno.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include "symtab.h"
 #include "types.h"
 #include "ast.h"
+#include "context.h"
+#include "intern.h"
 #include "codegen_fis25.h"
+#include "emitter.h"
+#include "fis25_loop.h"
+#include "source.h"
+#include "cache.h"
+#include "server.h"
 
-extern FILE *yyin;
-extern int   yylineno;
-extern char *yytext;
-extern int   yyparse(void);
-extern int   yydebug;
-extern ASTStmt *ast_root;
+extern int yydebug;
 
-void yyerror(const char *s) {
-    fprintf(stderr, "Error sintáctico en línea %d: %s cerca de '%s'\n",
-            yylineno, s, yytext);
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [--program] [-O0] [--redraw=full|incremental] [--unroll-budget=N] "
+                    "[--emit=text|bin] [-o salida.fis] <archivo.meow>\n", prog);
+    fprintf(stderr, "     %s [opciones] [-j N] <a.meow> <b.meow> ...\n", prog);
+    fprintf(stderr, "     %s [opciones] --server[=SOCKET]\n", prog);
+    fprintf(stderr, "  -o ARCHIVO  escribe el código FIS-25 en ARCHIVO (por defecto stdout)\n");
+    fprintf(stderr, "  -j N        con varios archivos, compila N a la vez (0 = uno por CPU);\n"
+                    "              cada a.meow se escribe en a.txt (a.bin con --emit=bin)\n");
+    fprintf(stderr, "  --emit=F    'text' (por defecto) o 'bin': codificación binaria con\n"
+                    "              etiquetas resueltas (ver fis25dis)\n");
+    fprintf(stderr, "  --program   traduce el programa Meow a FIS-25 (sin letrero)\n");
+    fprintf(stderr, "  --message=M mensaje del letrero (no se pregunta por stdin)\n");
+    fprintf(stderr, "  --server[=SOCKET]  queda atendiendo pedidos JSON (uno por línea) por\n"
+                    "              stdin/stdout o por el socket Unix SOCKET; los fuentes\n"
+                    "              analizados se reutilizan entre pedidos (ver server.h)\n");
+    fprintf(stderr, "  -O0         no optimiza el código FIS-25 generado\n");
+    fprintf(stderr, "  --redraw=M  letrero: 'full' limpia la fila cada frame (por defecto),\n"
+                    "              'incremental' redibuja solo cuando cambia el offset\n");
+    fprintf(stderr, "  --unroll-budget=N  máximo de instrucciones al desenrollar un bucle\n"
+                    "              (por defecto %d; 0 = no desenrollar)\n",
+            FIS25_DEFAULT_UNROLL_BUDGET);
+    fprintf(stderr, "  --frame-budget=N  falla si una iteración de MAIN_LOOP (o del bucle\n"
+                    "              principal del programa) puede pasar de N instrucciones\n");
+    fprintf(stderr, "  --frame-report  instrucciones y PIXEL por frame, por etiqueta (en stderr)\n");
+    fprintf(stderr, "  --input=M   lectura del fuente: 'auto' (por defecto: mmap si es un\n"
+                    "              archivo regular), 'mmap', 'read' (de una vez) o 'stream' (FILE*)\n");
+    fprintf(stderr, "  --syntax-only  solo analiza el fuente (léxico, sintaxis y tipos)\n");
+    fprintf(stderr, "  --dump-tokens  solo el scanner: un token por línea en stdout\n");
+    fprintf(stderr, "  --dump-ir   implica --program: escribe en stdout la representación\n"
+                    "              intermedia (bloques básicos) en lugar de FIS-25\n");
+    fprintf(stderr, "  --no-cache  no usa el caché de compilaciones (por defecto en\n"
+                    "              $MEOW_CACHE_DIR o ~/.cache/meowc)\n");
+    fprintf(stderr, "  --cache-dir=DIR  directorio del caché\n");
+    fprintf(stderr, "  --cache-max=MB   tamaño máximo del caché (por defecto %d MB)\n",
+            CACHE_DEFAULT_MAX_MB);
+    fprintf(stderr, "  --cache-stats  al terminar, aciertos, fallos y tamaño del caché\n");
+    fprintf(stderr, "  -v          también los mensajes de depuración (como MEOW_DEBUG)\n");
+    fprintf(stderr, "  -ferror-limit=N  corta el análisis tras N errores (por defecto %d;\n"
+                    "              0 = sin límite)\n", DIAG_DEFAULT_ERROR_LIMIT);
+    fprintf(stderr, "  -fparse-depth=N  entradas de la pila del parser: acota el anidamiento\n"
+                    "              (por defecto %d, mínimo %d; 0 = solo la memoria)\n",
+            MEOW_DEFAULT_PARSE_DEPTH, MEOW_MIN_PARSE_DEPTH);
+    fprintf(stderr, "  --time-report  tiempos de pared y CPU de cada fase (en stderr)\n");
+    fprintf(stderr, "  --stats[=F]  tiempos, contadores (tokens, nodos, símbolos) y memoria;\n"
+                    "              F = 'text' (por defecto) o 'json' (un objeto por archivo)\n");
 }
 
-int main(int argc, char **argv) {
-    if (argc < 2) {
-        fprintf(stderr, "Uso: %s <archivo.meow>\n", argv[0]);
-        return 1;
-    }
-
-    /* 1) Leer el mensaje para el letrero desde stdin */
+/* Lee el mensaje del letrero desde stdin y lo filtra (solo 0-9 . $) */
+static void read_message(char *msg, size_t msg_size) {
     char raw_msg[256];
-    char msg[64];
 
     fprintf(stderr, "Ingresa el mensaje del letrero (solo 0-9 . $): ");
     fflush(stderr);
@@ -36,61 +78,530 @@ int main(int argc, char **argv) {
         strcpy(msg, "0");
     } else {
         /* 2) Limpiar salto de línea y filtrar solo 0-9 . $ */
-        size_t len = strlen(raw_msg);
-        size_t j = 0;
-
-        for (size_t i = 0; i < len && j < sizeof(msg) - 1; ++i) {
-            char c = raw_msg[i];
-            if (c == '\n' || c == '\r')
-                continue;
-
-            if ((c >= '0' && c <= '9') || c == '.' || c == '$') {
-                msg[j++] = c;
-            } else {
-                fprintf(stderr,
-                        "Advertencia: ignorando caracter no permitido '%c'\n", c);
-            }
+        codegen_marquee_message(raw_msg, msg, msg_size, stderr);
+    }
+}
+
+/* Reporte de instrumentación al terminar cada archivo */
+typedef enum {
+    REPORT_NONE,
+    REPORT_TIME,                  // --time-report: solo la tabla de fases
+    REPORT_TEXT,                  // --stats: fases, contadores y memoria
+    REPORT_JSON                   // --stats=json
+} ReportFormat;
+
+/* Opciones comunes a todos los archivos de una invocación */
+typedef struct {
+    const char *msg;              // mensaje del letrero, o NULL en modo --program
+    const CodegenOptions *codegen;
+    SourceMode input;
+    int syntax_only;
+    int dump_tokens;              // --dump-tokens: solo el scanner
+    int dump_ir;                  // --dump-ir: la IR en lugar de FIS-25
+    ReportFormat report;
+    DiagLevel min_level;          // DIAG_DEBUG con -v o MEOW_DEBUG
+    int error_limit;              // -ferror-limit=N
+    size_t parse_depth;           // -fparse-depth=N
+    MeowCache *cache;             // NULL con --no-cache
+    const char *cache_options;    // opciones que entran en la clave del caché
+} DriverOptions;
+
+/* Solo el código generado va a la salida, de una vez y sin stdio.
+   Devuelve 0, o 5 si no se pudo escribir. */
+static int write_output(MeowContext *ctx, Emitter *out, const char *output_path) {
+    StatsMark mark;
+    size_t bytes = out->len;   // la escritura vacía el búfer
+    stats_begin(&ctx->stats, &mark);
+    int rc = output_path ? emitter_write_file(out, output_path)
+                         : emitter_flush_fd(out, STDOUT_FILENO);
+    stats_end(&ctx->stats, PHASE_EMIT, &mark);
+    if (rc != 0) {
+        fprintf(ctx->diag, "Error escribiendo %s: %s\n",
+                output_path ? output_path : "stdout", strerror(errno));
+        return 5;
+    }
+    ctx->stats.output_bytes = bytes;
+    return 0;
+}
+
+/* Con el caché activo busca la compilación de 'src'; si está, reproduce sus
+   diagnósticos y deja el código en 'out'. */
+static int cache_hit(MeowContext *ctx, const MeowSource *src, const DriverOptions *d,
+                     CacheKey *key, Emitter *out) {
+    char *diag;
+    size_t diag_len;
+
+    cache_key(key, d->cache_options, ctx->path, d->msg, src->data, src->len);
+    if (!cache_lookup(d->cache, key, out, &diag, &diag_len)) return 0;
+
+    fwrite(diag, 1, diag_len, ctx->diag);
+    free(diag);
+    ctx->stats.source_bytes = src->len;
+    ctx->stats.cache_hit = 1;
+    return 1;
+}
+
+static int compile_source(MeowContext *ctx, const char *output_path, const DriverOptions *d) {
+    MeowSource src;
+    if (source_open(&src, ctx->path, d->input) != 0) {
+        fprintf(ctx->diag, "%s: %s\n", ctx->path, strerror(errno));
+        return 1;
+    }
+    if (d->dump_tokens) {
+        int status = meow_dump_tokens(ctx, &src, stdout);
+        source_close(&src);
+        return status;
+    }
+
+    /* Con el fuente en memoria se puede consultar el caché antes de analizar
+       (una tubería no: habría que leerla entera primero). Los diagnósticos
+       se guardan junto al código, así que hacen falta en memoria. */
+    Emitter out;
+    emitter_init(&out);
+    CacheKey key;
+    int use_cache = d->cache != NULL && src.data != NULL && !d->syntax_only &&
+                    !d->dump_ir && ctx->diag != stderr;
+    if (use_cache && cache_hit(ctx, &src, d, &key, &out)) {
+        source_close(&src);
+        int status = write_output(ctx, &out, output_path);
+        emitter_free(&out);
+        return status;
+    }
+
+    int parse_result = meow_parse(ctx, &src);
+    if (src.data != NULL) {
+        ctx->stats.source_bytes = src.len;
+    } else {
+        long pos = ftell(src.stream);   // -1 en una tubería
+        ctx->stats.source_bytes = pos > 0 ? (size_t)pos : 0;
+    }
+    source_close(&src);
+
+    /* Los errores recuperados no detienen el análisis (se informan todos
+       los posibles), pero sí la compilación */
+    unsigned errors = diag_errors(&ctx->diags);
+    if (parse_result != 0 || errors > 0) {
+        if (errors == 0) errors = 1;   // yyparse no recuperó: al menos uno
+        fprintf(ctx->diag, "Compilación fallida: %u %s.\n", errors,
+                errors == 1 ? "error" : "errores");
+        emitter_free(&out);
+        return 2;
+    }
+
+    if (ctx->root == AST_NONE) {
+        fprintf(ctx->diag,
+                "Error: el parser terminó sin construir el AST (ctx->root == AST_NONE).\n");
+        emitter_free(&out);
+        return 3;
+    }
+    if (d->syntax_only) {
+        emitter_free(&out);
+        return 0;
+    }
+    if (d->dump_ir) {
+        emitter_free(&out);
+        return codegen_dump_ir(ctx, d->codegen, stdout) ? 4 : 0;
+    }
+
+    /* Generar código FIS-25: letrero con el mensaje filtrado,
+       o la traducción del programa en modo --program */
+    int codegen_errors = codegen_fis25(ctx, d->msg, d->codegen, &out);
+
+    int write_status = 0;
+    if (codegen_errors == 0) {
+        if (use_cache) {
+            fflush(ctx->diag);
+            cache_store(d->cache, &key, out.buf, out.len, ctx->diag_buf, ctx->diag_len);
         }
-        msg[j] = '\0';
+        write_status = write_output(ctx, &out, output_path);
+    }
+    emitter_free(&out);
+
+    if (yydebug) {
+        ast_report(&ctx->ast, ctx->diag);
+    }
 
-        if (j == 0) {
-            fprintf(stderr,
-                    "Mensaje vacío tras filtrado. Usando mensaje por defecto '0'.\n");
-            strcpy(msg, "0");
+    if (codegen_errors) return 4;
+    return write_status;
+}
+
+/* Nivel de detalle, límite de errores y pila del parser de la línea de comandos */
+static void apply_diag_options(MeowContext *ctx, const DriverOptions *d) {
+    ctx->diags.min_level = d->min_level;
+    ctx->diags.error_limit = d->error_limit;
+    ctx->parse_depth = d->parse_depth;
+}
+
+/*
+ * Compila un archivo con el contexto 'ctx' (ya inicializado) y escribe el
+ * resultado en 'output_path' (o stdout si es NULL). Los mensajes y el
+ * reporte de --time-report / --stats van a ctx->diag. Devuelve el código de
+ * salida de meowc para ese archivo.
+ */
+static int compile_file(MeowContext *ctx, const char *output_path, const DriverOptions *d) {
+    int status = compile_source(ctx, output_path, d);
+
+    // Sin fuente no hay nada que medir
+    if (d->report != REPORT_NONE && status != 1) {
+        stats_finish(&ctx->stats);
+        if (d->report == REPORT_JSON) {
+            stats_report_json(&ctx->stats, ctx->path, ctx->diag);
+        } else {
+            stats_report_text(&ctx->stats, ctx->path, d->report == REPORT_TEXT, ctx->diag);
         }
     }
+    return status;
+}
+
+/* ================= Compilación por lotes (-j N) ================= */
+
+typedef struct {
+    const char *source;
+    char *output;             // a.meow -> a.txt / a.bin
+    MeowContext ctx;          // diagnósticos en memoria hasta el final
+    int status;
+} BatchJob;
+
+typedef struct {
+    BatchJob *jobs;
+    size_t njobs;
+    size_t next;              // siguiente trabajo sin tomar
+    pthread_mutex_t lock;
+    const DriverOptions *opts;
+} BatchQueue;
+
+static char *batch_output_name(const char *source, EmitFormat emit) {
+    const char *ext = emit == EMIT_BIN ? ".bin" : ".txt";
+    size_t len = strlen(source);
+    // Solo se reemplaza la extensión .meow; otra cualquiera se conserva
+    if (len > 5 && strcmp(source + len - 5, ".meow") == 0) len -= 5;
+
+    char *name = (char *)malloc(len + strlen(ext) + 1);
+    if (name == NULL) {
+        perror("Error de memoria");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(name, source, len);
+    strcpy(name + len, ext);
+    return name;
+}
 
-    /* 3) Abrir el archivo fuente Meow */
-    yyin = fopen(argv[1], "r");
-    if (!yyin) {
-        perror(argv[1]);
+static void *batch_worker(void *arg) {
+    BatchQueue *q = (BatchQueue *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&q->lock);
+        size_t i = q->next < q->njobs ? q->next++ : q->njobs;
+        pthread_mutex_unlock(&q->lock);
+        if (i == q->njobs) break;
+
+        BatchJob *job = &q->jobs[i];
+        job->status = compile_file(&job->ctx, job->output, q->opts);
+    }
+    return NULL;
+}
+
+/*
+ * Compila cada fuente en su propio contexto sobre 'nthreads' hilos. Los
+ * diagnósticos de cada archivo se imprimen juntos y en el orden de la línea
+ * de comandos. Devuelve el mayor código de salida de los archivos.
+ */
+static int compile_batch(const char **sources, size_t nsources, int nthreads,
+                         const DriverOptions *opts) {
+    BatchJob *jobs = (BatchJob *)calloc(nsources, sizeof(BatchJob));
+    if (jobs == NULL) {
+        perror("Error de memoria");
+        return 1;
+    }
+    for (size_t i = 0; i < nsources; ++i) {
+        jobs[i].source = sources[i];
+        jobs[i].output = batch_output_name(sources[i], opts->codegen->emit);
+        meow_context_init(&jobs[i].ctx, sources[i], 1, opts->report != REPORT_NONE);
+        apply_diag_options(&jobs[i].ctx, opts);
+    }
+
+    BatchQueue q = { jobs, nsources, 0, PTHREAD_MUTEX_INITIALIZER, opts };
+
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = ncpu > 0 ? (int)ncpu : 1;
+    }
+    if ((size_t)nthreads > nsources) nthreads = (int)nsources;
+
+    /* El hilo principal también compila: se crean nthreads - 1 hilos */
+    pthread_t *threads = (pthread_t *)calloc((size_t)nthreads, sizeof(pthread_t));
+    int started = 0;
+    for (int t = 1; threads != NULL && t < nthreads; ++t) {
+        if (pthread_create(&threads[t], NULL, batch_worker, &q) != 0) break;
+        started++;
+    }
+    batch_worker(&q);
+    for (int t = 1; t <= started; ++t) pthread_join(threads[t], NULL);
+    free(threads);
+
+    int status = 0;
+    for (size_t i = 0; i < nsources; ++i) {
+        BatchJob *job = &jobs[i];
+        if (job->status == 0 && opts->syntax_only) {
+            fprintf(stderr, "== %s: sin errores\n", job->source);
+        } else if (job->status == 0) {
+            fprintf(stderr, "== %s -> %s\n", job->source, job->output);
+        } else {
+            fprintf(stderr, "== %s: fallida (código %d)\n", job->source, job->status);
+        }
+        meow_context_flush_diag(&job->ctx, stderr);
+        if (job->status > status) status = job->status;
+        meow_context_free(&job->ctx);
+        free(job->output);
+    }
+    free(jobs);
+    return status;
+}
+
+int main(int argc, char **argv) {
+    const char *output_path = NULL;
+    int program_mode = 0;
+    int jobs = 1;
+    CodegenOptions cg_opts = { 1, MARQUEE_REDRAW_FULL, FIS25_DEFAULT_UNROLL_BUDGET, EMIT_TEXT,
+                               0, 0 };
+    DriverOptions drv = { NULL, &cg_opts, SOURCE_AUTO, 0, 0, 0, REPORT_NONE,
+                          DIAG_NOTE, DIAG_DEFAULT_ERROR_LIMIT, MEOW_DEFAULT_PARSE_DEPTH,
+                          NULL, NULL };
+    int use_cache = 1, cache_stats = 0;
+    const char *cache_dir = NULL;
+    long cache_max_mb = CACHE_DEFAULT_MAX_MB;
+    const char *message = NULL;       // --message
+    int server = 0;                   // --server
+    const char *server_socket = NULL; // --server=SOCKET
+
+    const char **sources = (const char **)calloc((size_t)argc, sizeof(char *));
+    size_t nsources = 0;
+    if (sources == NULL) {
+        perror("Error de memoria");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--program") == 0) {
+            program_mode = 1;
+        } else if (strcmp(argv[i], "-o") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Falta el archivo de salida después de -o\n");
+                return 1;
+            }
+            output_path = argv[++i];
+        } else if (strncmp(argv[i], "-j", 2) == 0) {
+            const char *arg = argv[i] + 2;
+            if (*arg == '\0') {
+                if (i + 1 >= argc) {
+                    fprintf(stderr, "Falta el número de hilos después de -j\n");
+                    return 1;
+                }
+                arg = argv[++i];
+            }
+            char *end;
+            long n = strtol(arg, &end, 10);
+            if (*end != '\0' || end == arg || n < 0 || n > 1024) {
+                fprintf(stderr, "Valor inválido para -j: %s\n", arg);
+                return 1;
+            }
+            jobs = (int)n;
+        } else if (strcmp(argv[i], "-O0") == 0) {
+            cg_opts.optimize = 0;
+        } else if (strcmp(argv[i], "-O") == 0 || strcmp(argv[i], "-O1") == 0) {
+            cg_opts.optimize = 1;
+        } else if (strcmp(argv[i], "--redraw=full") == 0) {
+            cg_opts.redraw = MARQUEE_REDRAW_FULL;
+        } else if (strcmp(argv[i], "--redraw=incremental") == 0) {
+            cg_opts.redraw = MARQUEE_REDRAW_INCREMENTAL;
+        } else if (strcmp(argv[i], "--emit=text") == 0) {
+            cg_opts.emit = EMIT_TEXT;
+        } else if (strcmp(argv[i], "--emit=bin") == 0) {
+            cg_opts.emit = EMIT_BIN;
+        } else if (strncmp(argv[i], "--input=", 8) == 0) {
+            int mode = source_parse_mode(argv[i] + 8);
+            if (mode < 0) {
+                fprintf(stderr, "Valor inválido para --input: %s\n", argv[i] + 8);
+                return 1;
+            }
+            drv.input = (SourceMode)mode;
+        } else if (strncmp(argv[i], "--message=", 10) == 0) {
+            message = argv[i] + 10;
+        } else if (strcmp(argv[i], "--server") == 0) {
+            server = 1;
+        } else if (strncmp(argv[i], "--server=", 9) == 0) {
+            server = 1;
+            server_socket = argv[i] + 9;
+        } else if (strcmp(argv[i], "--syntax-only") == 0) {
+            drv.syntax_only = 1;
+        } else if (strcmp(argv[i], "--dump-tokens") == 0) {
+            drv.dump_tokens = 1;
+        } else if (strcmp(argv[i], "--dump-ir") == 0) {
+            drv.dump_ir = 1;
+            program_mode = 1;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            use_cache = 0;
+        } else if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+            cache_dir = argv[i] + 12;
+        } else if (strncmp(argv[i], "--cache-max=", 12) == 0) {
+            char *end;
+            cache_max_mb = strtol(argv[i] + 12, &end, 10);
+            if (*end != '\0' || end == argv[i] + 12 || cache_max_mb <= 0 || cache_max_mb > 1048576) {
+                fprintf(stderr, "Valor inválido para --cache-max: %s\n", argv[i] + 12);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cache-stats") == 0) {
+            cache_stats = 1;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            drv.min_level = DIAG_DEBUG;
+        } else if (strncmp(argv[i], "-ferror-limit=", 14) == 0) {
+            char *end;
+            long limit = strtol(argv[i] + 14, &end, 10);
+            if (*end != '\0' || end == argv[i] + 14 || limit < 0 || limit > 1000000) {
+                fprintf(stderr, "Valor inválido para -ferror-limit: %s\n", argv[i] + 14);
+                return 1;
+            }
+            drv.error_limit = (int)limit;
+        } else if (strncmp(argv[i], "-fparse-depth=", 14) == 0) {
+            char *end;
+            long depth = strtol(argv[i] + 14, &end, 10);
+            if (*end != '\0' || end == argv[i] + 14 || depth < 0 ||
+                (depth > 0 && depth < MEOW_MIN_PARSE_DEPTH)) {
+                fprintf(stderr, "Valor inválido para -fparse-depth: %s (0 o al menos %d)\n",
+                        argv[i] + 14, MEOW_MIN_PARSE_DEPTH);
+                return 1;
+            }
+            drv.parse_depth = (size_t)depth;
+        } else if (strcmp(argv[i], "--time-report") == 0) {
+            drv.report = REPORT_TIME;
+        } else if (strcmp(argv[i], "--stats") == 0 || strcmp(argv[i], "--stats=text") == 0) {
+            drv.report = REPORT_TEXT;
+        } else if (strcmp(argv[i], "--stats=json") == 0) {
+            drv.report = REPORT_JSON;
+        } else if (strncmp(argv[i], "--unroll-budget=", 16) == 0) {
+            char *end;
+            long budget = strtol(argv[i] + 16, &end, 10);
+            if (*end != '\0' || end == argv[i] + 16 || budget < 0 || budget > 1000000) {
+                fprintf(stderr, "Valor inválido para --unroll-budget: %s\n", argv[i] + 16);
+                return 1;
+            }
+            cg_opts.unroll_budget = (int)budget;
+        } else if (strncmp(argv[i], "--frame-budget=", 15) == 0) {
+            char *end;
+            long budget = strtol(argv[i] + 15, &end, 10);
+            if (*end != '\0' || end == argv[i] + 15 || budget <= 0) {
+                fprintf(stderr, "Valor inválido para --frame-budget: %s\n", argv[i] + 15);
+                return 1;
+            }
+            cg_opts.frame_budget = budget;
+        } else if (strcmp(argv[i], "--frame-report") == 0) {
+            cg_opts.frame_report = 1;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Opción desconocida: %s\n", argv[i]);
+            usage(argv[0]);
+            return 1;
+        } else {
+            sources[nsources++] = argv[i];
+        }
+    }
+
+    if (server) {
+        if (nsources > 0 || output_path != NULL || drv.syntax_only || drv.dump_tokens ||
+            drv.dump_ir || cg_opts.emit == EMIT_BIN) {
+            fprintf(stderr, "--server no admite archivos, -o, --emit=bin ni los modos de volcado: "
+                            "cada pedido trae su fuente y la respuesta es texto\n");
+            return 1;
+        }
+        /* Los fuentes se guardan por su contenido: hace falta tenerlo en memoria */
+        ServerOptions sv = { &cg_opts, drv.input == SOURCE_STREAM ? SOURCE_READ : drv.input,
+                             drv.min_level, drv.error_limit, drv.parse_depth, program_mode,
+                             SERVER_DEFAULT_MAX_SOURCES };
+        int status = server_socket ? server_run_socket(&sv, server_socket)
+                                   : server_run_stdio(&sv);
+        intern_free_all();
+        free(sources);
+        return status;
+    }
+    if (nsources == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (nsources > 1 && output_path != NULL) {
+        fprintf(stderr, "-o no se puede usar con varios archivos: "
+                        "cada uno se escribe junto a su fuente\n");
+        return 1;
+    }
+    if (nsources > 1 && (drv.dump_tokens || drv.dump_ir)) {
+        fprintf(stderr, "%s acepta un solo archivo\n",
+                drv.dump_tokens ? "--dump-tokens" : "--dump-ir");
         return 1;
     }
 
+    /* 1) Leer el mensaje para el letrero (solo en modo letrero); con varios
+          archivos se usa el mismo mensaje en todos */
+    char msg[64];
+    if (!program_mode && !drv.syntax_only && !drv.dump_tokens) {
+        if (message != NULL) {
+            codegen_marquee_message(message, msg, sizeof(msg), stderr);
+        } else {
+            read_message(msg, sizeof(msg));
+        }
+        drv.msg = msg;
+    }
+
     if (getenv("MEOW_DEBUG") != NULL) {
         yydebug = 1;
+        drv.min_level = DIAG_DEBUG;
         fprintf(stderr, "MEOW_DEBUG enabled: parser debug ON\n");
     }
 
-    int parse_result = yyparse();
-    fclose(yyin);
-
-    if (parse_result != 0) {
-        fprintf(stderr, "Compilación fallida: errores sintácticos.\n");
-        cleanup_symtab();
-        return 2;
+    /* Caché de compilaciones: si no se puede usar el directorio se compila
+       igual, sin caché. Con MEOW_DEBUG no se usa (la salida de depuración
+       no se guarda). */
+    MeowCache cache;
+    char cache_options[160];
+    char *default_dir = NULL;
+    if (use_cache && !yydebug && !drv.syntax_only && !drv.dump_tokens && !drv.dump_ir) {
+        if (cache_dir == NULL) cache_dir = default_dir = cache_default_dir();
+        if (cache_dir == NULL) {
+            fprintf(stderr, "Advertencia: sin directorio para el caché (defina MEOW_CACHE_DIR)\n");
+        } else if (cache_open(&cache, cache_dir, (size_t)cache_max_mb << 20) != 0) {
+            fprintf(stderr, "Advertencia: no se puede usar el caché en %s: %s\n",
+                    cache_dir, strerror(errno));
+        } else {
+            // Los diagnósticos se guardan con el código: su nivel y límite también cuentan
+            snprintf(cache_options, sizeof(cache_options),
+                     "O%d redraw=%d unroll=%d emit=%d diag=%d limit=%d depth=%zu frame=%ld/%d",
+                     cg_opts.optimize, (int)cg_opts.redraw, cg_opts.unroll_budget,
+                     (int)cg_opts.emit, (int)drv.min_level, drv.error_limit,
+                     drv.parse_depth, cg_opts.frame_budget, cg_opts.frame_report);
+            drv.cache = &cache;
+            drv.cache_options = cache_options;
+        }
     }
 
-    if (!ast_root) {
-        fprintf(stderr,
-                "Error: el parser terminó sin construir el AST (ast_root == NULL).\n");
-        cleanup_symtab();
-        return 3;
+    int status;
+    if (nsources > 1) {
+        status = compile_batch(sources, nsources, jobs, &drv);
+    } else {
+        /* Los diagnósticos se juntan en memoria (con caché se guardan con
+           el código) y se imprimen de una vez al terminar. Con MEOW_DEBUG
+           van directo, para que queden intercalados con la traza del parser */
+        MeowContext ctx;
+        meow_context_init(&ctx, sources[0], !yydebug, drv.report != REPORT_NONE);
+        apply_diag_options(&ctx, &drv);
+        status = compile_file(&ctx, output_path, &drv);
+        meow_context_flush_diag(&ctx, stderr);
+        meow_context_free(&ctx);
     }
 
-    /* 4) Generar código FIS-25 usando el mensaje filtrado */
-    codegen_fis25(ast_root, msg);
+    if (drv.cache != NULL) cache_close(&cache, cache_stats ? stderr : NULL);
+    free(default_dir);
 
-    cleanup_symtab();
-    return 0;
+    if (yydebug) {
+        intern_report(stderr);
+    }
+    intern_free_all();
+    free(sources);
+    return status;
 }
@@ -0,0 +1,315 @@
+// meowgen.c
+//
+// Generador de programas Meow sintéticos para medir cómo escala el
+// compilador (make bench). Los programas son válidos: solo usan variables
+// declaradas antes, condiciones bool y divisores distintos de cero. La misma
+// semilla da siempre el mismo programa.
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GEN_VARS 16          // variables int del preludio: v0 .. v15
+#define GEN_LEAVES_PER_LINE 8
+
+typedef enum {
+    SHAPE_DECLS,             // muchas declaraciones de todos los tipos
+    SHAPE_CHAIN,             // cadenas largas de asignaciones en línea recta
+    SHAPE_NEST,              // bloques meowl / meoow anidados
+    SHAPE_EXPR,              // árboles de expresión grandes
+    SHAPE_MIX,               // las cuatro formas alternadas
+    // Anidamiento extremo (make bench-depth): un grupo de --depth niveles
+    SHAPE_BLOCKS,            // { { { ... } } }
+    SHAPE_PARENS,            // v0 + (v1 - (v2 * (...)))
+    SHAPE_ASSIGN             // v0 = v1 = v2 = ... = 1
+} Shape;
+
+static const char *shape_names[] = { "decls", "chain", "nest", "expr", "mix",
+                                     "blocks", "parens", "assign" };
+
+#define GEN_MAX_INDENT 64    // la sangría de nest no crece más (con 10^6 niveles sería cuadrática)
+
+typedef struct {
+    FILE *out;
+    long lines;              // líneas escritas hasta ahora
+    unsigned rng;
+    long decls;              // contador para nombres únicos de SHAPE_DECLS
+    int depth;               // anidamiento (SHAPE_NEST y las formas extremas) o altura del árbol (SHAPE_EXPR)
+} Gen;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--shape=F] [--lines=N] [--depth=D] [--seed=S] [-o salida.meow]\n"
+            "  --shape=F   decls | chain | nest | expr | mix (por defecto mix), o\n"
+            "              blocks | parens | assign: anidamiento extremo\n"
+            "  --lines=N   líneas aproximadas del programa (por defecto 10000; las\n"
+            "              formas extremas son siempre un solo grupo)\n"
+            "  --depth=D   niveles de anidamiento (nest, por defecto 32; blocks,\n"
+            "              parens y assign, por defecto 100000) o altura de cada\n"
+            "              árbol de expresión (expr, por defecto 8)\n"
+            "  --seed=S    semilla del generador (por defecto 1)\n"
+            "  -o ARCHIVO  salida (por defecto stdout)\n",
+            prog);
+}
+
+// xorshift32: suficiente para variar operadores y operandos
+static unsigned next_rand(Gen *g) {
+    unsigned x = g->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g->rng = x;
+    return x;
+}
+
+static unsigned pick(Gen *g, unsigned n) { return next_rand(g) % n; }
+
+// Escribe una línea completa (agrega el salto)
+static void line(Gen *g, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(g->out, fmt, ap);
+    va_end(ap);
+    fputc('\n', g->out);
+    g->lines++;
+}
+
+static void prelude(Gen *g) {
+    line(g, "// Programa generado por meowgen");
+    for (int i = 0; i < GEN_VARS; ++i) line(g, "meow meow v%d = %d;", i, i + 1);
+    line(g, "meowmeow go = meowt;");
+    line(g, "meow meow meow ratio = 0.5;");
+}
+
+// Operando simple: una variable del preludio o un literal entre 1 y 9
+static void operand(Gen *g, char *buf, size_t size) {
+    if (pick(g, 3) == 0) {
+        snprintf(buf, size, "%u", 1 + pick(g, 9));
+    } else {
+        snprintf(buf, size, "v%u", pick(g, GEN_VARS));
+    }
+}
+
+static void gen_decls(Gen *g) {
+    long n = g->decls++;
+    switch (n % 4) {
+        case 0:
+            line(g, "meow meow d%ld = v%u + %ld;", n, pick(g, GEN_VARS), n % 1000);
+            break;
+        case 1:
+            line(g, "meow meow meow f%ld = %u.%u;", n, pick(g, 100), pick(g, 100));
+            break;
+        case 2:
+            line(g, "meowmeow b%ld = %s;", n, pick(g, 2) ? "meowt" : "meowf");
+            break;
+        default:
+            // Sin inicializar (las cadenas no llegan a FIS-25 fuera de miau_print)
+            line(g, "meow meow u%ld;", n);
+            break;
+    }
+}
+
+static void gen_chain(Gen *g) {
+    static const char ops[] = { '+', '-', '*' };
+    char a[16], b[16];
+    operand(g, a, sizeof(a));
+    operand(g, b, sizeof(b));
+    // El divisor es siempre un literal distinto de cero
+    line(g, "v%u = %s %c %s %c v%u / %u;", pick(g, GEN_VARS), a, ops[pick(g, 3)], b,
+         ops[pick(g, 3)], pick(g, GEN_VARS), 1 + pick(g, 9));
+}
+
+// Sangría del nivel 'd' de nest
+static void indent(Gen *g, int d) {
+    int n = d * 2;
+    fprintf(g->out, "%*s", n < GEN_MAX_INDENT ? n : GEN_MAX_INDENT, "");
+}
+
+/* Un grupo de bloques anidados 'depth' niveles: alterna meowl y meoow (con
+   meoow meow en la mitad de los meoow), y en cada nivel declara una 't' que
+   oculta la del nivel de afuera. */
+static void gen_nest(Gen *g) {
+    int depth = g->depth;
+    for (int d = 0; d < depth; ++d) {
+        indent(g, d);
+        line(g, "%s (go) {", d % 2 == 0 ? "meowl" : "meoow");
+        indent(g, d + 1);
+        line(g, "meow meow t = v%u + %d;", pick(g, GEN_VARS), d);
+        indent(g, d + 1);
+        line(g, "v%u = t * 2;", pick(g, GEN_VARS));
+    }
+    indent(g, depth);
+    line(g, "go = meowf;");
+    for (int d = depth - 1; d >= 0; --d) {
+        indent(g, d);
+        if (d % 2 == 1 && pick(g, 2)) {
+            line(g, "} meoow meow {");
+            indent(g, d + 1);
+            line(g, "v%u = v%u - 1;", pick(g, GEN_VARS), pick(g, GEN_VARS));
+            indent(g, d);
+        }
+        line(g, "}");
+    }
+}
+
+/* Las formas extremas escriben GEN_LEAVES_PER_LINE niveles por línea: sin
+   sangría, para que el tamaño del fuente sea lineal en la profundidad */
+static void level_break(Gen *g, int d) {
+    if ((d + 1) % GEN_LEAVES_PER_LINE == 0) {
+        fputc('\n', g->out);
+        g->lines++;
+    }
+}
+
+// 'depth' bloques { } anidados con una asignación en el centro
+static void gen_blocks(Gen *g) {
+    for (int d = 0; d < g->depth; ++d) {
+        fputc('{', g->out);
+        level_break(g, d);
+    }
+    line(g, " v%u = v%u + 1;", pick(g, GEN_VARS), pick(g, GEN_VARS));
+    for (int d = 0; d < g->depth; ++d) {
+        fputc('}', g->out);
+        level_break(g, d);
+    }
+    line(g, "");
+}
+
+// Suma anidada a la derecha: cada nivel abre un paréntesis
+static void gen_parens(Gen *g) {
+    static const char ops[] = { '+', '-', '*' };
+    char buf[16];
+    fprintf(g->out, "v%u = ", pick(g, GEN_VARS));
+    for (int d = 0; d < g->depth; ++d) {
+        operand(g, buf, sizeof(buf));
+        fprintf(g->out, "%s %c (", buf, ops[pick(g, 3)]);
+        level_break(g, d);
+    }
+    operand(g, buf, sizeof(buf));
+    fputs(buf, g->out);
+    for (int d = 0; d < g->depth; ++d) {
+        fputc(')', g->out);
+        level_break(g, d);
+    }
+    line(g, ";");
+}
+
+// Una asignación encadenada de 'depth' variables (recursiva a derecha en la gramática)
+static void gen_assign(Gen *g) {
+    for (int d = 0; d < g->depth; ++d) {
+        fprintf(g->out, "v%u = ", pick(g, GEN_VARS));
+        level_break(g, d);
+    }
+    line(g, "%u;", 1 + pick(g, 9));
+}
+
+/* Árbol binario completo de la altura pedida; corta la línea cada
+   GEN_LEAVES_PER_LINE hojas para que el tamaño se refleje en las líneas. */
+static void expr_tree(Gen *g, int height, long *leaves) {
+    static const char ops[] = { '+', '-', '*' };
+    if (height == 0) {
+        char buf[16];
+        operand(g, buf, sizeof(buf));
+        fputs(buf, g->out);
+        if (++*leaves % GEN_LEAVES_PER_LINE == 0) {
+            fputc('\n', g->out);
+            g->lines++;
+        }
+        return;
+    }
+    fputc('(', g->out);
+    expr_tree(g, height - 1, leaves);
+    if (height == 1 && pick(g, 4) == 0) {
+        // A veces una división, siempre por un literal distinto de cero
+        fprintf(g->out, " / %u)", 1 + pick(g, 9));
+        return;
+    }
+    fprintf(g->out, " %c ", ops[pick(g, 3)]);
+    expr_tree(g, height - 1, leaves);
+    fputc(')', g->out);
+}
+
+static void gen_expr(Gen *g) {
+    long leaves = 0;
+    fprintf(g->out, "v%u = ", pick(g, GEN_VARS));
+    expr_tree(g, g->depth, &leaves);
+    line(g, ";");
+}
+
+int main(int argc, char **argv) {
+    Shape shape = SHAPE_MIX;
+    long target = 10000;
+    int depth = -1;
+    unsigned seed = 1;
+    const char *output_path = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--shape=", 8) == 0) {
+            size_t s;
+            for (s = 0; s < sizeof(shape_names) / sizeof(shape_names[0]); ++s) {
+                if (strcmp(argv[i] + 8, shape_names[s]) == 0) break;
+            }
+            if (s == sizeof(shape_names) / sizeof(shape_names[0])) {
+                fprintf(stderr, "Forma desconocida: %s\n", argv[i] + 8);
+                return 1;
+            }
+            shape = (Shape)s;
+        } else if (strncmp(argv[i], "--lines=", 8) == 0) {
+            target = strtol(argv[i] + 8, NULL, 10);
+        } else if (strncmp(argv[i], "--depth=", 8) == 0) {
+            depth = (int)strtol(argv[i] + 8, NULL, 10);
+        } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = (unsigned)strtoul(argv[i] + 7, NULL, 10);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (target <= 0 || depth == 0 || depth > 100000000) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Gen g = { stdout, 0, seed ? seed : 1, 0, 0 };
+    if (output_path != NULL) {
+        g.out = fopen(output_path, "w");
+        if (g.out == NULL) {
+            perror(output_path);
+            return 1;
+        }
+    }
+
+    prelude(&g);
+    int nest_depth = depth > 0 ? depth : 32;
+    int expr_depth = depth > 0 ? depth : 8;
+    if (shape > SHAPE_MIX) {
+        // Las formas extremas son un solo grupo, sin importar --lines
+        g.depth = depth > 0 ? depth : 100000;
+        switch (shape) {
+            case SHAPE_BLOCKS: gen_blocks(&g); break;
+            case SHAPE_PARENS: gen_parens(&g); break;
+            default:           gen_assign(&g); break;
+        }
+    }
+    long round = 0;
+    while (shape <= SHAPE_MIX && g.lines < target) {
+        Shape s = shape == SHAPE_MIX ? (Shape)(round++ % SHAPE_MIX) : shape;
+        switch (s) {
+            case SHAPE_DECLS: gen_decls(&g); break;
+            case SHAPE_CHAIN: gen_chain(&g); break;
+            case SHAPE_NEST:  g.depth = nest_depth; gen_nest(&g); break;
+            case SHAPE_EXPR:  g.depth = expr_depth; gen_expr(&g); break;
+            default:          break;
+        }
+    }
+    line(&g, "miau_print(v0);");
+
+    if (output_path != NULL && fclose(g.out) != 0) {
+        perror(output_path);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,2128 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "parser.y"
+
+#include "context.h"
+#include "types.h"
+#include "symtab.h"
+#include "ast.h"
+#include "intern.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Ubicación de un símbolo de la regla (@n) para los diagnósticos */
+#define LOC(l) ((DiagLoc){ (l).first_line, (l).first_column })
+
+/* Errores semánticos y trazas con la ubicación 'loc' */
+#define SEM_ERROR(loc, ...) diag_report(&ctx->diags, DIAG_ERROR, "semántico", loc, __VA_ARGS__)
+#define SEM_DEBUG(loc, ...) diag_report(&ctx->diags, DIAG_DEBUG, NULL, loc, __VA_ARGS__)
+
+/* Cierra el ámbito de nivel 'level' (abierto por AbreAmbito) y los que
+   hayan quedado abiertos dentro de él tras recuperarse de un error */
+static void close_scope(MeowContext *ctx, int level) {
+    while (symtab_scope_level(&ctx->symtab) >= level) {
+        symtab_pop_scope(&ctx->symtab);
+    }
+}
+
+/* Comprueba la compatibilidad de una asignación (lhs = rhs).
+   'what' es el texto con el que se nombra el destino en los mensajes. */
+static void check_assign_types(MeowContext *ctx, DiagLoc loc, const char *what,
+                               MeowType lhs_type, MeowType rhs_type)
+{
+    if (lhs_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
+        if (lhs_type != rhs_type) {
+            if (!(lhs_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
+                SEM_ERROR(loc, "Asignación incompatible en '%s'. Esperado: %s, Recibido: %s.",
+                          what,
+                          MeowTypeToString(lhs_type),
+                          MeowTypeToString(rhs_type));
+            } else {
+                SEM_DEBUG(loc, "Promoción implícita INT -> FLOAT en asignación de '%s'.", what);
+            }
+        }
+    }
+}
+
+/* Nodo aritmético binario con el tipo que resulta de sus operandos */
+static ASTExprId make_arith(MeowContext *ctx, DiagLoc loc, ASTBinOp op,
+                            ASTExprId left, ASTExprId right)
+{
+    MeowType t = check_arithmetic_type(ast_expr(&ctx->ast, left)->type,
+                                       ast_expr(&ctx->ast, right)->type, &ctx->diags, loc);
+    return ast_make_binop(&ctx->ast, op, left, right, t);
+}
+
+/* Un índice literal tiene que caer dentro del arreglo */
+static void check_const_index(MeowContext *ctx, DiagLoc loc, const char *id_name, ASTExprId index)
+{
+    const ASTExpr *e = ast_expr(&ctx->ast, index);
+    int length = get_symbol_array_length(&ctx->symtab, id_name);
+    if (e->kind == AST_EXPR_INT && length > 0 && (e->u.ival < 0 || e->u.ival >= length)) {
+        SEM_ERROR(loc, "Índice %d fuera de rango en '%s' (%d elementos).", e->u.ival, id_name, length);
+    }
+}
+
+/* Registra una declaración en la tabla de símbolos, comprueba su
+   inicialización y construye el nodo DECL correspondiente. */
+static ASTStmtId build_decl(MeowContext *ctx, DiagLoc loc, MeowType declared_type,
+                            const char *id_name, int array_len, ASTExprId init)
+{
+    SymbolEntry *entry = NULL;
+
+    if (array_len > 0) {
+        entry = insert_array_symbol(&ctx->symtab, id_name, declared_type, array_len, loc);
+    } else {
+        entry = insert_symbol(&ctx->symtab, id_name, declared_type, loc);
+    }
+
+    if (entry != NULL && init != AST_NONE) {
+        MeowType init_type = ast_expr(&ctx->ast, init)->type;
+        if (array_len > 0) {
+            SEM_ERROR(loc, "Inicialización directa de arreglo '%s' no soportada.", id_name);
+        } else {
+            if (declared_type != init_type && init_type != TYPE_ERROR) {
+                if (!(declared_type == TYPE_FLOAT && init_type == TYPE_INT)) {
+                    SEM_ERROR(loc, "Inicialización incompatible de '%s'. Esperado: %s, Recibido: %s.",
+                              id_name,
+                              MeowTypeToString(declared_type),
+                              MeowTypeToString(init_type));
+                } else {
+                    SEM_DEBUG(loc, "Promoción implícita INT -> FLOAT en inicialización de '%s'.",
+                              id_name);
+                }
+            }
+        }
+    }
+
+    /* Nombre único: distingue la declaración de las externas que oculta */
+    const char *name = entry != NULL ? entry->unique_name : id_name;
+    if (array_len > 0) {
+        return ast_make_array_decl(&ctx->ast, declared_type, name, array_len);
+    }
+    return ast_make_decl(&ctx->ast, declared_type, name, init);
+}
+
+#line 175 "parser.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_T_SEMICOLON = 3,                /* T_SEMICOLON  */
+  YYSYMBOL_T_ASSIGN = 4,                   /* T_ASSIGN  */
+  YYSYMBOL_T_PLUS = 5,                     /* T_PLUS  */
+  YYSYMBOL_T_MINUS = 6,                    /* T_MINUS  */
+  YYSYMBOL_T_MULT = 7,                     /* T_MULT  */
+  YYSYMBOL_T_DIV = 8,                      /* T_DIV  */
+  YYSYMBOL_T_LPAREN = 9,                   /* T_LPAREN  */
+  YYSYMBOL_T_RPAREN = 10,                  /* T_RPAREN  */
+  YYSYMBOL_T_LBRACKET = 11,                /* T_LBRACKET  */
+  YYSYMBOL_T_RBRACKET = 12,                /* T_RBRACKET  */
+  YYSYMBOL_T_DOT = 13,                     /* T_DOT  */
+  YYSYMBOL_T_COMMA = 14,                   /* T_COMMA  */
+  YYSYMBOL_T_LBRACE = 15,                  /* T_LBRACE  */
+  YYSYMBOL_T_RBRACE = 16,                  /* T_RBRACE  */
+  YYSYMBOL_T_LITERAL_INT = 17,             /* T_LITERAL_INT  */
+  YYSYMBOL_T_LITERAL_FLOAT = 18,           /* T_LITERAL_FLOAT  */
+  YYSYMBOL_T_LITERAL_STRING = 19,          /* T_LITERAL_STRING  */
+  YYSYMBOL_T_ID = 20,                      /* T_ID  */
+  YYSYMBOL_T_DECLARACION = 21,             /* T_DECLARACION  */
+  YYSYMBOL_T_IF = 22,                      /* T_IF  */
+  YYSYMBOL_T_ELSE = 23,                    /* T_ELSE  */
+  YYSYMBOL_T_WHILE = 24,                   /* T_WHILE  */
+  YYSYMBOL_T_FOR = 25,                     /* T_FOR  */
+  YYSYMBOL_T_FUNCTION = 26,                /* T_FUNCTION  */
+  YYSYMBOL_T_RETURN = 27,                  /* T_RETURN  */
+  YYSYMBOL_T_MIAU_PIXEL = 28,              /* T_MIAU_PIXEL  */
+  YYSYMBOL_T_MIAU_KEY = 29,                /* T_MIAU_KEY  */
+  YYSYMBOL_T_MIAU_INPUT = 30,              /* T_MIAU_INPUT  */
+  YYSYMBOL_T_MIAU_PRINT = 31,              /* T_MIAU_PRINT  */
+  YYSYMBOL_T_TRUE = 32,                    /* T_TRUE  */
+  YYSYMBOL_T_FALSE = 33,                   /* T_FALSE  */
+  YYSYMBOL_T_INT = 34,                     /* T_INT  */
+  YYSYMBOL_T_FLOAT = 35,                   /* T_FLOAT  */
+  YYSYMBOL_T_BOOL = 36,                    /* T_BOOL  */
+  YYSYMBOL_T_STRING = 37,                  /* T_STRING  */
+  YYSYMBOL_YYACCEPT = 38,                  /* $accept  */
+  YYSYMBOL_Programa = 39,                  /* Programa  */
+  YYSYMBOL_ListaSentencias = 40,           /* ListaSentencias  */
+  YYSYMBOL_Sentencia = 41,                 /* Sentencia  */
+  YYSYMBOL_AbreAmbito = 42,                /* AbreAmbito  */
+  YYSYMBOL_IfStmt = 43,                    /* IfStmt  */
+  YYSYMBOL_WhileStmt = 44,                 /* WhileStmt  */
+  YYSYMBOL_ForStmt = 45,                   /* ForStmt  */
+  YYSYMBOL_Declaracion = 46,               /* Declaracion  */
+  YYSYMBOL_Tipo = 47,                      /* Tipo  */
+  YYSYMBOL_Optinit = 48,                   /* Optinit  */
+  YYSYMBOL_OptArray = 49,                  /* OptArray  */
+  YYSYMBOL_Asignacion = 50,                /* Asignacion  */
+  YYSYMBOL_Expresion = 51,                 /* Expresion  */
+  YYSYMBOL_Termino = 52,                   /* Termino  */
+  YYSYMBOL_Factor = 53,                    /* Factor  */
+  YYSYMBOL_Base = 54,                      /* Base  */
+  YYSYMBOL_MiauPixel = 55,                 /* MiauPixel  */
+  YYSYMBOL_MiauKey = 56,                   /* MiauKey  */
+  YYSYMBOL_MiauInput = 57,                 /* MiauInput  */
+  YYSYMBOL_MiauPrint = 58                  /* MiauPrint  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 130 "parser.y"
+
+#define yylex(lvalp, llocp, scanner) meow_lex(ctx, lvalp, llocp, scanner)
+
+/* La pila crece (duplicándose, con malloc) hasta ctx->parse_depth entradas
+   en lugar de las 10000 fijas de bison: el anidamiento profundo de bloques,
+   paréntesis o asignaciones encadenadas solo está acotado por -fparse-depth */
+#define YYMAXDEPTH meow_parse_depth(ctx)
+
+#line 277 "parser.c"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  3
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   169
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  38
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  21
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  54
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  125
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   292
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   212,   212,   221,   222,   227,   228,   229,   230,   231,
+     232,   233,   234,   235,   236,   244,   245,   254,   261,   268,
+     279,   291,   319,   323,   331,   332,   333,   334,   339,   340,
+     345,   346,   352,   360,   397,   406,   410,   414,   418,   422,
+     426,   430,   434,   435,   448,   449,   450,   451,   452,   453,
+     472,   493,   505,   516,   527
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "T_SEMICOLON",
+  "T_ASSIGN", "T_PLUS", "T_MINUS", "T_MULT", "T_DIV", "T_LPAREN",
+  "T_RPAREN", "T_LBRACKET", "T_RBRACKET", "T_DOT", "T_COMMA", "T_LBRACE",
+  "T_RBRACE", "T_LITERAL_INT", "T_LITERAL_FLOAT", "T_LITERAL_STRING",
+  "T_ID", "T_DECLARACION", "T_IF", "T_ELSE", "T_WHILE", "T_FOR",
+  "T_FUNCTION", "T_RETURN", "T_MIAU_PIXEL", "T_MIAU_KEY", "T_MIAU_INPUT",
+  "T_MIAU_PRINT", "T_TRUE", "T_FALSE", "T_INT", "T_FLOAT", "T_BOOL",
+  "T_STRING", "$accept", "Programa", "ListaSentencias", "Sentencia",
+  "AbreAmbito", "IfStmt", "WhileStmt", "ForStmt", "Declaracion", "Tipo",
+  "Optinit", "OptArray", "Asignacion", "Expresion", "Termino", "Factor",
+  "Base", "MiauPixel", "MiauKey", "MiauInput", "MiauPrint", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-76)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-3)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     -76,     7,    57,   -76,    21,   -76,    14,   118,    17,    32,
+      35,    41,    54,    96,   105,   -76,   -76,   -76,   -76,   -76,
+     -76,   -76,   -76,    62,    79,   120,   123,   124,   129,   130,
+     -76,   -76,    -5,    -5,   122,    -5,    -5,   128,    -5,    -5,
+     136,    -5,   -76,   138,   -76,   -76,   -76,   -76,   -76,    82,
+      -5,   -76,   -76,   -76,    19,   -76,   -76,    33,    68,   -76,
+     -76,    56,   138,    64,    90,   147,    31,    46,   134,   133,
+     140,   154,    13,   -76,   135,    -5,    -5,   139,     2,     2,
+       2,     2,   156,   154,   100,   100,    -5,    -5,   142,   -76,
+     -76,   149,    -5,   -76,   -76,   -76,    33,    61,   -76,    20,
+      68,    68,   -76,   -76,    -5,   -76,   143,   -76,    43,    50,
+     153,   -76,    33,   -76,    33,   100,   128,    -5,   -76,   -76,
+     155,   141,   100,   -76,   -76
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     0,     1,     0,    17,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    24,    25,    26,    27,     4,
+      11,    12,    13,     0,     0,     0,     0,     0,     0,     0,
+      15,     3,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     5,    31,     6,     7,     8,     9,    10,     0,
+       0,    44,    45,    46,    43,    47,    48,    32,    37,    40,
+      41,     0,    31,     0,     0,     0,     0,     0,     0,     0,
+       0,    29,     0,    14,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    29,     0,     0,     0,     0,     0,    53,
+      54,     0,     0,    23,    16,    42,    34,     0,    50,    43,
+      35,    36,    38,    39,     0,    22,    18,    20,     0,     0,
+       0,    30,    28,    49,    33,     0,     0,     0,    52,    19,
+       0,     0,     0,    51,    21
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+     -76,   -76,   137,   -75,   -76,   -76,   -76,   -76,   -76,   157,
+      84,   107,   -36,   -33,    11,    28,   -76,   -76,   -76,   -76,
+     -76
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     1,     2,    19,    31,    20,    21,    22,    23,    24,
+      93,    71,    25,    57,    58,    59,    60,    26,    27,    28,
+      29
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      61,    65,    63,    64,    50,    66,    67,     3,    69,   106,
+     107,    50,    51,    52,    53,    54,    30,    74,    32,    51,
+      52,    53,    99,    75,    30,    33,    35,    55,    56,    94,
+      76,    76,    77,    77,    55,    56,    78,    79,    78,    79,
+     119,    36,    96,    97,    37,    87,   116,   124,    78,    79,
+      38,    78,    79,   108,   109,    78,    79,    -2,     4,   112,
+      88,    78,    79,    39,   117,    42,    78,    79,    82,    78,
+      79,   114,     5,   113,    84,    80,    81,     6,     7,     8,
+     120,     9,    10,    72,   121,    11,    12,    13,    14,   100,
+     101,    15,    16,    17,    18,    78,    79,     5,    73,    43,
+      85,     4,     6,     7,     8,    40,     9,    10,   102,   103,
+      11,    12,    13,    14,    41,     5,    15,    16,    17,    18,
+       6,     7,     8,    44,     9,    10,    45,    46,    11,    12,
+      13,    14,    47,    48,    15,    16,    17,    18,    78,    79,
+      78,    79,    62,    90,    89,    95,    78,    79,     6,    70,
+      86,   123,    15,    16,    17,    18,    68,    91,    92,    98,
+     104,   111,   110,   118,    34,   122,   115,   105,    49,    83
+};
+
+static const yytype_int8 yycheck[] =
+{
+      33,    37,    35,    36,     9,    38,    39,     0,    41,    84,
+      85,     9,    17,    18,    19,    20,     3,    50,     4,    17,
+      18,    19,    20,     4,     3,    11,     9,    32,    33,    16,
+      11,    11,    13,    13,    32,    33,     5,     6,     5,     6,
+     115,     9,    75,    76,     9,    14,     3,   122,     5,     6,
+       9,     5,     6,    86,    87,     5,     6,     0,     1,    92,
+      14,     5,     6,     9,    14,     3,     5,     6,    12,     5,
+       6,   104,    15,    12,    10,     7,     8,    20,    21,    22,
+     116,    24,    25,     1,   117,    28,    29,    30,    31,    78,
+      79,    34,    35,    36,    37,     5,     6,    15,    16,    20,
+      10,     1,    20,    21,    22,     9,    24,    25,    80,    81,
+      28,    29,    30,    31,     9,    15,    34,    35,    36,    37,
+      20,    21,    22,     3,    24,    25,     3,     3,    28,    29,
+      30,    31,     3,     3,    34,    35,    36,    37,     5,     6,
+       5,     6,    20,    10,    10,    10,     5,     6,    20,    11,
+       3,    10,    34,    35,    36,    37,    20,    17,     4,    20,
+       4,    12,    20,    10,     7,    10,    23,    83,    31,    62
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    39,    40,     0,     1,    15,    20,    21,    22,    24,
+      25,    28,    29,    30,    31,    34,    35,    36,    37,    41,
+      43,    44,    45,    46,    47,    50,    55,    56,    57,    58,
+       3,    42,     4,    11,    47,     9,     9,     9,     9,     9,
+       9,     9,     3,    20,     3,     3,     3,     3,     3,    40,
+       9,    17,    18,    19,    20,    32,    33,    51,    52,    53,
+      54,    51,    20,    51,    51,    50,    51,    51,    20,    51,
+      11,    49,     1,    16,    51,     4,    11,    13,     5,     6,
+       7,     8,    12,    49,    10,    10,     3,    14,    14,    10,
+      10,    17,     4,    48,    16,    10,    51,    51,    20,    20,
+      52,    52,    53,    53,     4,    48,    41,    41,    51,    51,
+      20,    12,    51,    12,    51,    23,     3,    14,    10,    41,
+      50,    51,    10,    10,    41
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    38,    39,    40,    40,    41,    41,    41,    41,    41,
+      41,    41,    41,    41,    41,    41,    41,    42,    43,    43,
+      44,    45,    46,    46,    47,    47,    47,    47,    48,    48,
+      49,    49,    50,    50,    51,    51,    51,    51,    52,    52,
+      52,    53,    54,    54,    54,    54,    54,    54,    54,    54,
+      54,    55,    56,    57,    58
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     0,     2,     2,     2,     2,     2,     2,
+       2,     1,     1,     1,     4,     2,     5,     0,     5,     7,
+       5,     9,     5,     4,     1,     1,     1,     1,     2,     0,
+       3,     0,     3,     6,     3,     3,     3,     1,     3,     3,
+       1,     1,     3,     1,     1,     1,     1,     1,     1,     4,
+       3,     8,     6,     4,     4
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, ctx, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, ctx, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, MeowContext *ctx, yyscan_t scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, MeowContext *ctx, yyscan_t scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, ctx, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, MeowContext *ctx, yyscan_t scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), ctx, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, ctx, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, MeowContext *ctx, yyscan_t scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_AbreAmbito: /* AbreAmbito  */
+#line 203 "parser.y"
+            { close_scope(ctx, ((*yyvaluep).scope)); }
+#line 1152 "parser.c"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (MeowContext *ctx, yyscan_t scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* Programa: ListaSentencias  */
+#line 213 "parser.y"
+      {
+          ctx->root = ast_make_block(&ctx->ast, (yyvsp[0].list).head);
+          (yyval.stmt) = ctx->root;
+      }
+#line 1458 "parser.c"
+    break;
+
+  case 3: /* ListaSentencias: %empty  */
+#line 221 "parser.y"
+                                    { (yyval.list) = ast_list_empty(); }
+#line 1464 "parser.c"
+    break;
+
+  case 4: /* ListaSentencias: ListaSentencias Sentencia  */
+#line 222 "parser.y"
+                                   { (yyval.list) = (yyvsp[-1].list); ast_list_append(&ctx->ast, &(yyval.list), (yyvsp[0].stmt)); }
+#line 1470 "parser.c"
+    break;
+
+  case 5: /* Sentencia: Declaracion T_SEMICOLON  */
+#line 227 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1476 "parser.c"
+    break;
+
+  case 6: /* Sentencia: Asignacion T_SEMICOLON  */
+#line 228 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1482 "parser.c"
+    break;
+
+  case 7: /* Sentencia: MiauPixel T_SEMICOLON  */
+#line 229 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1488 "parser.c"
+    break;
+
+  case 8: /* Sentencia: MiauKey T_SEMICOLON  */
+#line 230 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1494 "parser.c"
+    break;
+
+  case 9: /* Sentencia: MiauInput T_SEMICOLON  */
+#line 231 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1500 "parser.c"
+    break;
+
+  case 10: /* Sentencia: MiauPrint T_SEMICOLON  */
+#line 232 "parser.y"
+                                              { (yyval.stmt) = (yyvsp[-1].stmt); }
+#line 1506 "parser.c"
+    break;
+
+  case 11: /* Sentencia: IfStmt  */
+#line 233 "parser.y"
+                                               { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 1512 "parser.c"
+    break;
+
+  case 12: /* Sentencia: WhileStmt  */
+#line 234 "parser.y"
+                                               { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 1518 "parser.c"
+    break;
+
+  case 13: /* Sentencia: ForStmt  */
+#line 235 "parser.y"
+                                               { (yyval.stmt) = (yyvsp[0].stmt); }
+#line 1524 "parser.c"
+    break;
+
+  case 14: /* Sentencia: T_LBRACE AbreAmbito ListaSentencias T_RBRACE  */
+#line 237 "parser.y"
+      {
+          close_scope(ctx, (yyvsp[-2].scope));
+          (yyval.stmt) = ast_make_block(&ctx->ast, (yyvsp[-1].list).head);
+      }
+#line 1533 "parser.c"
+    break;
+
+  case 15: /* Sentencia: error T_SEMICOLON  */
+#line 244 "parser.y"
+                                               { yyerrok; (yyval.stmt) = ast_make_block(&ctx->ast, AST_NONE); }
+#line 1539 "parser.c"
+    break;
+
+  case 16: /* Sentencia: T_LBRACE AbreAmbito ListaSentencias error T_RBRACE  */
+#line 246 "parser.y"
+      {
+          yyerrok;
+          close_scope(ctx, (yyvsp[-3].scope));
+          (yyval.stmt) = ast_make_block(&ctx->ast, (yyvsp[-2].list).head);
+      }
+#line 1549 "parser.c"
+    break;
+
+  case 17: /* AbreAmbito: %empty  */
+#line 254 "parser.y"
+                    { symtab_push_scope(&ctx->symtab); (yyval.scope) = symtab_scope_level(&ctx->symtab); }
+#line 1555 "parser.c"
+    break;
+
+  case 18: /* IfStmt: T_IF T_LPAREN Expresion T_RPAREN Sentencia  */
+#line 262 "parser.y"
+      {
+          if (ast_expr(&ctx->ast, (yyvsp[-2].expr))->type != TYPE_BOOL && ast_expr(&ctx->ast, (yyvsp[-2].expr))->type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-2])), "la condición de if debe ser bool.");
+          }
+          (yyval.stmt) = ast_make_if(&ctx->ast, (yyvsp[-2].expr), (yyvsp[0].stmt));
+      }
+#line 1566 "parser.c"
+    break;
+
+  case 19: /* IfStmt: T_IF T_LPAREN Expresion T_RPAREN Sentencia T_ELSE Sentencia  */
+#line 269 "parser.y"
+      {
+          if (ast_expr(&ctx->ast, (yyvsp[-4].expr))->type != TYPE_BOOL && ast_expr(&ctx->ast, (yyvsp[-4].expr))->type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-4])), "la condición de if debe ser bool.");
+          }
+          (yyval.stmt) = ast_make_if_else(&ctx->ast, (yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt));
+      }
+#line 1577 "parser.c"
+    break;
+
+  case 20: /* WhileStmt: T_WHILE T_LPAREN Expresion T_RPAREN Sentencia  */
+#line 280 "parser.y"
+      {
+          if (ast_expr(&ctx->ast, (yyvsp[-2].expr))->type != TYPE_BOOL && ast_expr(&ctx->ast, (yyvsp[-2].expr))->type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-2])), "la condición de while debe ser bool.");
+          }
+          (yyval.stmt) = ast_make_while(&ctx->ast, (yyvsp[-2].expr), (yyvsp[0].stmt));
+      }
+#line 1588 "parser.c"
+    break;
+
+  case 21: /* ForStmt: T_FOR T_LPAREN Asignacion T_SEMICOLON Expresion T_SEMICOLON Asignacion T_RPAREN Sentencia  */
+#line 295 "parser.y"
+      {
+          if (ast_expr(&ctx->ast, (yyvsp[-4].expr))->type != TYPE_BOOL && ast_expr(&ctx->ast, (yyvsp[-4].expr))->type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-4])), "la condición de for debe ser bool.");
+          }
+          ASTStmtList body = ast_list_empty();
+          ast_list_append(&ctx->ast, &body, (yyvsp[0].stmt));
+          ast_list_append(&ctx->ast, &body, (yyvsp[-2].stmt));
+
+          ASTStmtList block = ast_list_empty();
+          ast_list_append(&ctx->ast, &block, (yyvsp[-6].stmt));
+          ast_list_append(&ctx->ast, &block, ast_make_while(&ctx->ast, (yyvsp[-4].expr), body.head));
+          (yyval.stmt) = ast_make_block(&ctx->ast, block.head);
+      }
+#line 1606 "parser.c"
+    break;
+
+  case 22: /* Declaracion: T_DECLARACION Tipo T_ID OptArray Optinit  */
+#line 320 "parser.y"
+      {
+          (yyval.stmt) = build_decl(ctx, LOC((yylsp[-2])), (yyvsp[-3].type), (yyvsp[-2].sval), (yyvsp[-1].ival), (yyvsp[0].expr));
+      }
+#line 1614 "parser.c"
+    break;
+
+  case 23: /* Declaracion: Tipo T_ID OptArray Optinit  */
+#line 324 "parser.y"
+      {
+          (yyval.stmt) = build_decl(ctx, LOC((yylsp[-2])), (yyvsp[-3].type), (yyvsp[-2].sval), (yyvsp[-1].ival), (yyvsp[0].expr));
+      }
+#line 1622 "parser.c"
+    break;
+
+  case 24: /* Tipo: T_INT  */
+#line 331 "parser.y"
+                 { (yyval.type) = TYPE_INT; }
+#line 1628 "parser.c"
+    break;
+
+  case 25: /* Tipo: T_FLOAT  */
+#line 332 "parser.y"
+                 { (yyval.type) = TYPE_FLOAT; }
+#line 1634 "parser.c"
+    break;
+
+  case 26: /* Tipo: T_BOOL  */
+#line 333 "parser.y"
+                 { (yyval.type) = TYPE_BOOL; }
+#line 1640 "parser.c"
+    break;
+
+  case 27: /* Tipo: T_STRING  */
+#line 334 "parser.y"
+                 { (yyval.type) = TYPE_STRING; }
+#line 1646 "parser.c"
+    break;
+
+  case 28: /* Optinit: T_ASSIGN Expresion  */
+#line 339 "parser.y"
+                          { (yyval.expr) = (yyvsp[0].expr); }
+#line 1652 "parser.c"
+    break;
+
+  case 29: /* Optinit: %empty  */
+#line 340 "parser.y"
+                           { (yyval.expr) = AST_NONE; }
+#line 1658 "parser.c"
+    break;
+
+  case 30: /* OptArray: T_LBRACKET T_LITERAL_INT T_RBRACKET  */
+#line 345 "parser.y"
+                                           { (yyval.ival) = (yyvsp[-1].ival); }
+#line 1664 "parser.c"
+    break;
+
+  case 31: /* OptArray: %empty  */
+#line 346 "parser.y"
+                                            { (yyval.ival) = 0; }
+#line 1670 "parser.c"
+    break;
+
+  case 32: /* Asignacion: T_ID T_ASSIGN Expresion  */
+#line 353 "parser.y"
+      {
+          const char *id_name = (yyvsp[-2].sval);
+          MeowType lhs_type = get_symbol_type(&ctx->symtab, id_name, LOC((yylsp[-2])));
+
+          check_assign_types(ctx, LOC((yylsp[-2])), id_name, lhs_type, ast_expr(&ctx->ast, (yyvsp[0].expr))->type);
+          (yyval.stmt) = ast_make_assign(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), (yyvsp[0].expr));
+      }
+#line 1682 "parser.c"
+    break;
+
+  case 33: /* Asignacion: T_ID T_LBRACKET Expresion T_RBRACKET T_ASSIGN Expresion  */
+#line 361 "parser.y"
+      {
+          const char *id_name = (yyvsp[-5].sval);
+          MeowType arr_type  = get_symbol_type(&ctx->symtab, id_name, LOC((yylsp[-5])));
+          MeowType idx_type  = ast_expr(&ctx->ast, (yyvsp[-3].expr))->type;
+          MeowType rhs_type  = ast_expr(&ctx->ast, (yyvsp[0].expr))->type;
+          MeowType elem_type = get_symbol_element_type(&ctx->symtab, id_name, LOC((yylsp[-5])));
+
+          if (arr_type != TYPE_ARRAY) {
+              SEM_ERROR(LOC((yylsp[-5])), "'%s' no es un arreglo.", id_name);
+          }
+          if (idx_type != TYPE_INT && idx_type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-3])), "Índice de arreglo '%s' debe ser int.", id_name);
+          } else if (arr_type == TYPE_ARRAY) {
+              check_const_index(ctx, LOC((yylsp[-3])), id_name, (yyvsp[-3].expr));
+          }
+
+          if (elem_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
+              if (elem_type != rhs_type) {
+                  if (!(elem_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
+                      SEM_ERROR(LOC((yylsp[-1])), "Asignación incompatible en '%s[...]'. Esperado: %s, Recibido: %s.",
+                                id_name,
+                                MeowTypeToString(elem_type),
+                                MeowTypeToString(rhs_type));
+                  } else {
+                      SEM_DEBUG(LOC((yylsp[-1])), "Promoción implícita INT -> FLOAT en '%s[...]'.", id_name);
+                  }
+              }
+          }
+          (yyval.stmt) = ast_make_index_assign(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), (yyvsp[-3].expr), (yyvsp[0].expr));
+      }
+#line 1717 "parser.c"
+    break;
+
+  case 34: /* Expresion: T_ID T_ASSIGN Expresion  */
+#line 398 "parser.y"
+      {
+          const char *id_name = (yyvsp[-2].sval);
+          MeowType lhs_type = get_symbol_type(&ctx->symtab, id_name, LOC((yylsp[-2])));
+          MeowType rhs_type = ast_expr(&ctx->ast, (yyvsp[0].expr))->type;
+
+          check_assign_types(ctx, LOC((yylsp[-2])), id_name, lhs_type, rhs_type);
+          (yyval.expr) = ast_make_assign_expr(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), (yyvsp[0].expr), rhs_type);
+      }
+#line 1730 "parser.c"
+    break;
+
+  case 35: /* Expresion: Expresion T_PLUS Termino  */
+#line 407 "parser.y"
+      {
+          (yyval.expr) = make_arith(ctx, LOC((yylsp[-1])), AST_BINOP_ADD, (yyvsp[-2].expr), (yyvsp[0].expr));
+      }
+#line 1738 "parser.c"
+    break;
+
+  case 36: /* Expresion: Expresion T_MINUS Termino  */
+#line 411 "parser.y"
+      {
+          (yyval.expr) = make_arith(ctx, LOC((yylsp[-1])), AST_BINOP_SUB, (yyvsp[-2].expr), (yyvsp[0].expr));
+      }
+#line 1746 "parser.c"
+    break;
+
+  case 37: /* Expresion: Termino  */
+#line 414 "parser.y"
+                                 { (yyval.expr) = (yyvsp[0].expr); }
+#line 1752 "parser.c"
+    break;
+
+  case 38: /* Termino: Termino T_MULT Factor  */
+#line 419 "parser.y"
+      {
+          (yyval.expr) = make_arith(ctx, LOC((yylsp[-1])), AST_BINOP_MUL, (yyvsp[-2].expr), (yyvsp[0].expr));
+      }
+#line 1760 "parser.c"
+    break;
+
+  case 39: /* Termino: Termino T_DIV Factor  */
+#line 423 "parser.y"
+      {
+          (yyval.expr) = make_arith(ctx, LOC((yylsp[-1])), AST_BINOP_DIV, (yyvsp[-2].expr), (yyvsp[0].expr));
+      }
+#line 1768 "parser.c"
+    break;
+
+  case 40: /* Termino: Factor  */
+#line 426 "parser.y"
+                             { (yyval.expr) = (yyvsp[0].expr); }
+#line 1774 "parser.c"
+    break;
+
+  case 41: /* Factor: Base  */
+#line 430 "parser.y"
+                             { (yyval.expr) = (yyvsp[0].expr); }
+#line 1780 "parser.c"
+    break;
+
+  case 42: /* Base: T_LPAREN Expresion T_RPAREN  */
+#line 434 "parser.y"
+                                  { (yyval.expr) = (yyvsp[-1].expr); }
+#line 1786 "parser.c"
+    break;
+
+  case 43: /* Base: T_ID  */
+#line 436 "parser.y"
+      {
+          MeowType t = get_symbol_type(&ctx->symtab, (yyvsp[0].sval), LOC((yylsp[0])));
+          if (t == TYPE_ARRAY) {
+              SEM_ERROR(LOC((yylsp[0])), "Uso de arreglo '%s' sin índice.", (yyvsp[0].sval));
+              t = TYPE_ERROR;
+          } else if (t == TYPE_VOID) {
+              diag_report(&ctx->diags, DIAG_ERROR, "interno", LOC((yylsp[0])),
+                          "ID '%s' tiene tipo VOID en expresión.", (yyvsp[0].sval));
+              t = TYPE_ERROR;
+          }
+          (yyval.expr) = ast_make_var(&ctx->ast, get_symbol_unique_name(&ctx->symtab, (yyvsp[0].sval)), t);
+      }
+#line 1803 "parser.c"
+    break;
+
+  case 44: /* Base: T_LITERAL_INT  */
+#line 448 "parser.y"
+                            { (yyval.expr) = ast_make_int(&ctx->ast, (yyvsp[0].ival)); }
+#line 1809 "parser.c"
+    break;
+
+  case 45: /* Base: T_LITERAL_FLOAT  */
+#line 449 "parser.y"
+                            { (yyval.expr) = ast_make_float(&ctx->ast, (yyvsp[0].fval)); }
+#line 1815 "parser.c"
+    break;
+
+  case 46: /* Base: T_LITERAL_STRING  */
+#line 450 "parser.y"
+                            { (yyval.expr) = ast_make_string(&ctx->ast, (yyvsp[0].sval)); }
+#line 1821 "parser.c"
+    break;
+
+  case 47: /* Base: T_TRUE  */
+#line 451 "parser.y"
+                            { (yyval.expr) = ast_make_bool(&ctx->ast, 1); }
+#line 1827 "parser.c"
+    break;
+
+  case 48: /* Base: T_FALSE  */
+#line 452 "parser.y"
+                            { (yyval.expr) = ast_make_bool(&ctx->ast, 0); }
+#line 1833 "parser.c"
+    break;
+
+  case 49: /* Base: T_ID T_LBRACKET Expresion T_RBRACKET  */
+#line 454 "parser.y"
+      {
+          const char *id_name = (yyvsp[-3].sval);
+          MeowType arr_type = get_symbol_type(&ctx->symtab, id_name, LOC((yylsp[-3])));
+          MeowType idx_type = ast_expr(&ctx->ast, (yyvsp[-1].expr))->type;
+          MeowType t;
+
+          if (arr_type != TYPE_ARRAY) {
+              SEM_ERROR(LOC((yylsp[-3])), "'%s' no es un arreglo.", id_name);
+              t = TYPE_ERROR;
+          } else if (idx_type != TYPE_INT && idx_type != TYPE_ERROR) {
+              SEM_ERROR(LOC((yylsp[-1])), "Índice de arreglo debe ser int en '%s'.", id_name);
+              t = TYPE_ERROR;
+          } else {
+              t = get_symbol_element_type(&ctx->symtab, id_name, LOC((yylsp[-3])));
+              check_const_index(ctx, LOC((yylsp[-1])), id_name, (yyvsp[-1].expr));
+          }
+          (yyval.expr) = ast_make_index(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), (yyvsp[-1].expr), t);
+      }
+#line 1856 "parser.c"
+    break;
+
+  case 50: /* Base: T_ID T_DOT T_ID  */
+#line 473 "parser.y"
+      {
+          const char *id_name = (yyvsp[-2].sval);
+          const char *prop    = (yyvsp[0].sval);
+
+          (yyval.expr) = ast_make_length(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name));
+          if (prop == intern("length")) {
+              if (get_symbol_type(&ctx->symtab, id_name, LOC((yylsp[-2]))) != TYPE_ARRAY) {
+                  SEM_ERROR(LOC((yylsp[-2])), "'%s' no es un arreglo y no tiene 'length'.", id_name);
+                  ast_expr(&ctx->ast, (yyval.expr))->type = TYPE_ERROR;
+              }
+          } else {
+              SEM_ERROR(LOC((yylsp[0])), "Propiedad desconocida '%s' en '%s'.", prop, id_name);
+              ast_expr(&ctx->ast, (yyval.expr))->type = TYPE_ERROR;
+          }
+      }
+#line 1876 "parser.c"
+    break;
+
+  case 51: /* MiauPixel: T_MIAU_PIXEL T_LPAREN Expresion T_COMMA Expresion T_COMMA Expresion T_RPAREN  */
+#line 494 "parser.y"
+      {
+          if (!(ast_expr(&ctx->ast, (yyvsp[-5].expr))->type == TYPE_INT &&
+                ast_expr(&ctx->ast, (yyvsp[-3].expr))->type == TYPE_INT &&
+                ast_expr(&ctx->ast, (yyvsp[-1].expr))->type == TYPE_INT)) {
+              SEM_ERROR(LOC((yylsp[-7])), "miau_pixel espera tres argumentos int (x, y, color).");
+          }
+          (yyval.stmt) = ast_make_pixel(&ctx->ast, (yyvsp[-5].expr), (yyvsp[-3].expr), (yyvsp[-1].expr));
+      }
+#line 1889 "parser.c"
+    break;
+
+  case 52: /* MiauKey: T_MIAU_KEY T_LPAREN Expresion T_COMMA T_ID T_RPAREN  */
+#line 506 "parser.y"
+      {
+          int destType = get_symbol_type(&ctx->symtab, (yyvsp[-1].sval), LOC((yylsp[-1])));
+          if (!(ast_expr(&ctx->ast, (yyvsp[-3].expr))->type == TYPE_INT && (destType == TYPE_INT || destType == TYPE_BOOL))) {
+              SEM_ERROR(LOC((yylsp[-5])), "miau_key espera (int, id<int|bool>).");
+          }
+          (yyval.stmt) = ast_make_key(&ctx->ast, (yyvsp[-3].expr), get_symbol_unique_name(&ctx->symtab, (yyvsp[-1].sval)));
+      }
+#line 1901 "parser.c"
+    break;
+
+  case 53: /* MiauInput: T_MIAU_INPUT T_LPAREN T_ID T_RPAREN  */
+#line 517 "parser.y"
+      {
+          int destType = get_symbol_type(&ctx->symtab, (yyvsp[-1].sval), LOC((yylsp[-1])));
+          if (destType != TYPE_INT) {
+              SEM_ERROR(LOC((yylsp[-1])), "miau_input espera un identificador int.");
+          }
+          (yyval.stmt) = ast_make_input(&ctx->ast, get_symbol_unique_name(&ctx->symtab, (yyvsp[-1].sval)));
+      }
+#line 1913 "parser.c"
+    break;
+
+  case 54: /* MiauPrint: T_MIAU_PRINT T_LPAREN Expresion T_RPAREN  */
+#line 528 "parser.y"
+      {
+          MeowType t = ast_expr(&ctx->ast, (yyvsp[-1].expr))->type;
+          if (!(t == TYPE_INT || t == TYPE_FLOAT ||
+                t == TYPE_BOOL || t == TYPE_STRING)) {
+              SEM_ERROR(LOC((yylsp[-1])), "miau_print no acepta este tipo de expresión.");
+          }
+          (yyval.stmt) = ast_make_print(&ctx->ast, (yyvsp[-1].expr));
+      }
+#line 1926 "parser.c"
+    break;
+
+
+#line 1930 "parser.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (&yylloc, ctx, scanner, YY_("syntax error"));
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, ctx, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, ctx, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, ctx, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, ctx, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, ctx, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 538 "parser.y"
+  /* fin de las reglas */
@@ -0,0 +1,166 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_H_INCLUDED
+# define YY_YY_PARSER_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 106 "parser.y"
+
+#include "types.h"
+#include "symtab.h"
+#include "ast.h"
+#include "context.h"
+
+/* Estado del scanner reentrante (el mismo typedef que emite flex) */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+
+#line 62 "parser.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    T_SEMICOLON = 258,             /* T_SEMICOLON  */
+    T_ASSIGN = 259,                /* T_ASSIGN  */
+    T_PLUS = 260,                  /* T_PLUS  */
+    T_MINUS = 261,                 /* T_MINUS  */
+    T_MULT = 262,                  /* T_MULT  */
+    T_DIV = 263,                   /* T_DIV  */
+    T_LPAREN = 264,                /* T_LPAREN  */
+    T_RPAREN = 265,                /* T_RPAREN  */
+    T_LBRACKET = 266,              /* T_LBRACKET  */
+    T_RBRACKET = 267,              /* T_RBRACKET  */
+    T_DOT = 268,                   /* T_DOT  */
+    T_COMMA = 269,                 /* T_COMMA  */
+    T_LBRACE = 270,                /* T_LBRACE  */
+    T_RBRACE = 271,                /* T_RBRACE  */
+    T_LITERAL_INT = 272,           /* T_LITERAL_INT  */
+    T_LITERAL_FLOAT = 273,         /* T_LITERAL_FLOAT  */
+    T_LITERAL_STRING = 274,        /* T_LITERAL_STRING  */
+    T_ID = 275,                    /* T_ID  */
+    T_DECLARACION = 276,           /* T_DECLARACION  */
+    T_IF = 277,                    /* T_IF  */
+    T_ELSE = 278,                  /* T_ELSE  */
+    T_WHILE = 279,                 /* T_WHILE  */
+    T_FOR = 280,                   /* T_FOR  */
+    T_FUNCTION = 281,              /* T_FUNCTION  */
+    T_RETURN = 282,                /* T_RETURN  */
+    T_MIAU_PIXEL = 283,            /* T_MIAU_PIXEL  */
+    T_MIAU_KEY = 284,              /* T_MIAU_KEY  */
+    T_MIAU_INPUT = 285,            /* T_MIAU_INPUT  */
+    T_MIAU_PRINT = 286,            /* T_MIAU_PRINT  */
+    T_TRUE = 287,                  /* T_TRUE  */
+    T_FALSE = 288,                 /* T_FALSE  */
+    T_INT = 289,                   /* T_INT  */
+    T_FLOAT = 290,                 /* T_FLOAT  */
+    T_BOOL = 291,                  /* T_BOOL  */
+    T_STRING = 292                 /* T_STRING  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 151 "parser.y"
+
+    int       ival;
+    float     fval;
+    const char *sval;   /* cadena internada (intern.h) */
+    MeowType  type;     /* tipo de expresiones / declaraciones */
+    ASTExprId expr;     /* índices en el almacén del AST */
+    ASTStmtId stmt;
+    ASTStmtList list;   /* lista con cola para agregar en O(1) */
+    int       scope;    /* ámbito abierto por '{' (ver %destructor) */
+
+#line 127 "parser.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define YYLTYPE_IS_DECLARED 1
+# define YYLTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+int yyparse (MeowContext *ctx, yyscan_t scanner);
+
+/* "%code provides" blocks.  */
+#line 119 "parser.y"
+
+/* Scanner de flex con %option reentrant bison-locations */
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner);
+
+/* Implementación en context.c */
+void yyerror(YYLTYPE *loc, MeowContext *ctx, yyscan_t scanner, const char *s);
+/* yylex con los contadores de ctx->stats y el corte de -ferror-limit */
+int meow_lex(MeowContext *ctx, YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner);
+
+#line 165 "parser.h"
+
+#endif /* !YY_YY_PARSER_H_INCLUDED  */
@@ -1,19 +1,105 @@
 %{
+#include "context.h"
 #include "types.h"
 #include "symtab.h"
 #include "ast.h"
+#include "intern.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Externos del scanner */
-extern int   yylex();
-extern int   yylineno;
-extern char *yytext;
-extern FILE *yyin;
+/* Ubicación de un símbolo de la regla (@n) para los diagnósticos */
+#define LOC(l) ((DiagLoc){ (l).first_line, (l).first_column })
 
-/* Prototipo de la función de error; implementación en main.c */
-void yyerror(const char *s);
+/* Errores semánticos y trazas con la ubicación 'loc' */
+#define SEM_ERROR(loc, ...) diag_report(&ctx->diags, DIAG_ERROR, "semántico", loc, __VA_ARGS__)
+#define SEM_DEBUG(loc, ...) diag_report(&ctx->diags, DIAG_DEBUG, NULL, loc, __VA_ARGS__)
+
+/* Cierra el ámbito de nivel 'level' (abierto por AbreAmbito) y los que
+   hayan quedado abiertos dentro de él tras recuperarse de un error */
+static void close_scope(MeowContext *ctx, int level) {
+    while (symtab_scope_level(&ctx->symtab) >= level) {
+        symtab_pop_scope(&ctx->symtab);
+    }
+}
+
+/* Comprueba la compatibilidad de una asignación (lhs = rhs).
+   'what' es el texto con el que se nombra el destino en los mensajes. */
+static void check_assign_types(MeowContext *ctx, DiagLoc loc, const char *what,
+                               MeowType lhs_type, MeowType rhs_type)
+{
+    if (lhs_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
+        if (lhs_type != rhs_type) {
+            if (!(lhs_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
+                SEM_ERROR(loc, "Asignación incompatible en '%s'. Esperado: %s, Recibido: %s.",
+                          what,
+                          MeowTypeToString(lhs_type),
+                          MeowTypeToString(rhs_type));
+            } else {
+                SEM_DEBUG(loc, "Promoción implícita INT -> FLOAT en asignación de '%s'.", what);
+            }
+        }
+    }
+}
+
+/* Nodo aritmético binario con el tipo que resulta de sus operandos */
+static ASTExprId make_arith(MeowContext *ctx, DiagLoc loc, ASTBinOp op,
+                            ASTExprId left, ASTExprId right)
+{
+    MeowType t = check_arithmetic_type(ast_expr(&ctx->ast, left)->type,
+                                       ast_expr(&ctx->ast, right)->type, &ctx->diags, loc);
+    return ast_make_binop(&ctx->ast, op, left, right, t);
+}
+
+/* Un índice literal tiene que caer dentro del arreglo */
+static void check_const_index(MeowContext *ctx, DiagLoc loc, const char *id_name, ASTExprId index)
+{
+    const ASTExpr *e = ast_expr(&ctx->ast, index);
+    int length = get_symbol_array_length(&ctx->symtab, id_name);
+    if (e->kind == AST_EXPR_INT && length > 0 && (e->u.ival < 0 || e->u.ival >= length)) {
+        SEM_ERROR(loc, "Índice %d fuera de rango en '%s' (%d elementos).", e->u.ival, id_name, length);
+    }
+}
+
+/* Registra una declaración en la tabla de símbolos, comprueba su
+   inicialización y construye el nodo DECL correspondiente. */
+static ASTStmtId build_decl(MeowContext *ctx, DiagLoc loc, MeowType declared_type,
+                            const char *id_name, int array_len, ASTExprId init)
+{
+    SymbolEntry *entry = NULL;
+
+    if (array_len > 0) {
+        entry = insert_array_symbol(&ctx->symtab, id_name, declared_type, array_len, loc);
+    } else {
+        entry = insert_symbol(&ctx->symtab, id_name, declared_type, loc);
+    }
+
+    if (entry != NULL && init != AST_NONE) {
+        MeowType init_type = ast_expr(&ctx->ast, init)->type;
+        if (array_len > 0) {
+            SEM_ERROR(loc, "Inicialización directa de arreglo '%s' no soportada.", id_name);
+        } else {
+            if (declared_type != init_type && init_type != TYPE_ERROR) {
+                if (!(declared_type == TYPE_FLOAT && init_type == TYPE_INT)) {
+                    SEM_ERROR(loc, "Inicialización incompatible de '%s'. Esperado: %s, Recibido: %s.",
+                              id_name,
+                              MeowTypeToString(declared_type),
+                              MeowTypeToString(init_type));
+                } else {
+                    SEM_DEBUG(loc, "Promoción implícita INT -> FLOAT en inicialización de '%s'.",
+                              id_name);
+                }
+            }
+        }
+    }
+
+    /* Nombre único: distingue la declaración de las externas que oculta */
+    const char *name = entry != NULL ? entry->unique_name : id_name;
+    if (array_len > 0) {
+        return ast_make_array_decl(&ctx->ast, declared_type, name, array_len);
+    }
+    return ast_make_decl(&ctx->ast, declared_type, name, init);
+}
 %}
 
 /* ----- Sección visible en los headers generados ----- */
@@ -21,13 +107,43 @@ void yyerror(const char *s);
 #include "types.h"
 #include "symtab.h"
 #include "ast.h"
+#include "context.h"
+
+/* Estado del scanner reentrante (el mismo typedef que emite flex) */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+}
 
-/* Raíz del AST declarada en ast.c */
-extern ASTStmt *ast_root;
+%code provides {
+/* Scanner de flex con %option reentrant bison-locations */
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner);
 
-void yyerror(const char *s);
+/* Implementación en context.c */
+void yyerror(YYLTYPE *loc, MeowContext *ctx, yyscan_t scanner, const char *s);
+/* yylex con los contadores de ctx->stats y el corte de -ferror-limit */
+int meow_lex(MeowContext *ctx, YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner);
 }
 
+/* El parser pide los tokens a través de meow_lex */
+%code {
+#define yylex(lvalp, llocp, scanner) meow_lex(ctx, lvalp, llocp, scanner)
+
+/* La pila crece (duplicándose, con malloc) hasta ctx->parse_depth entradas
+   en lugar de las 10000 fijas de bison: el anidamiento profundo de bloques,
+   paréntesis o asignaciones encadenadas solo está acotado por -fparse-depth */
+#define YYMAXDEPTH meow_parse_depth(ctx)
+}
+
+/* Parser reentrante: todo el estado de la compilación viaja en 'ctx' */
+%define api.pure full
+%parse-param {MeowContext *ctx}
+%param {yyscan_t scanner}
+
+/* Cada token lleva su línea y columna (@n) para los diagnósticos */
+%locations
+
 /* Para debug con MEOW_DEBUG */
 %debug
 
@@ -35,10 +151,12 @@ void yyerror(const char *s);
 %union {
     int       ival;
     float     fval;
-    char     *sval;
+    const char *sval;   /* cadena internada (intern.h) */
     MeowType  type;     /* tipo de expresiones / declaraciones */
-    ASTExpr  *expr;
-    ASTStmt  *stmt;
+    ASTExprId expr;     /* índices en el almacén del AST */
+    ASTStmtId stmt;
+    ASTStmtList list;   /* lista con cola para agregar en O(1) */
+    int       scope;    /* ámbito abierto por '{' (ver %destructor) */
 }
 
 /* ---------------- TOKENS ---------------- */
@@ -68,50 +186,72 @@ void yyerror(const char *s);
 
 /* ---------------- TIPOS DE NO TERMINALES ---------------- */
 
-%type <stmt> Programa ListaSentencias Sentencia
+%type <stmt> Programa Sentencia
+%type <list> ListaSentencias
 %type <stmt> IfStmt WhileStmt ForStmt
+%type <stmt> Declaracion Asignacion
+%type <stmt> MiauPixel MiauKey MiauInput MiauPrint
 
-/* no usamos todavía AST real aquí, pero dejamos el tipo listo */
-%type <type> Declaracion Asignacion
-%type <type> Tipo Expresion Termino Factor Base Optinit
+/* Las expresiones son nodos del AST; su tipo va en ast_expr(&ctx->ast, id)->type */
+%type <type> Tipo
+%type <expr> Expresion Termino Factor Base Optinit
 %type <ival> OptArray
-%type <type> MiauPixel MiauKey MiauInput MiauPrint
+%type <scope> AbreAmbito
+
+/* Si la recuperación de errores descarta un bloque a medio analizar, su
+   ámbito se cierra igual */
+%destructor { close_scope(ctx, $$); } <scope>
 
 %%  /* ============ GRAMÁTICA ============ */
 
 /* ==================== PROGRAMA ==================== */
-/* Versión A con AST mínimo: solo marcamos ast_root como no-NULL
-   para que main pueda llamar a codegen_fis25(ast_root).          */
+/* La raíz del AST es un bloque con la lista de sentencias del programa,
+   así ctx->root nunca es AST_NONE aunque el programa esté vacío.     */
 
 Programa
     : ListaSentencias
       {
-          /* AST mínimo: por ahora solo usamos un sentinel distinto de NULL.
-             Más adelante, cuando tengas nodos reales, aquí se asigna la raíz
-             verdadera del AST (por ejemplo, una lista de sentencias).        */
-          ast_root = (ASTStmt *)1;
-          $$ = NULL;
+          ctx->root = ast_make_block(&ctx->ast, $1.head);
+          $$ = ctx->root;
       }
     ;
 
 /* Lista de sentencias secuenciales */
 ListaSentencias
-    : /* vacío */                  { $$ = NULL; }
-    | ListaSentencias Sentencia    { $$ = NULL; }
+    : /* vacío */                  { $$ = ast_list_empty(); }
+    | ListaSentencias Sentencia    { $$ = $1; ast_list_append(&ctx->ast, &$$, $2); }
     ;
 
 /* Cada Sentencia termina en ';' excepto if / while / for / bloques */
 Sentencia
-    : Declaracion T_SEMICOLON                 { $$ = NULL; }
-    | Asignacion  T_SEMICOLON                 { $$ = NULL; }
-    | MiauPixel   T_SEMICOLON                 { $$ = NULL; }
-    | MiauKey     T_SEMICOLON                 { $$ = NULL; }
-    | MiauInput   T_SEMICOLON                 { $$ = NULL; }
-    | MiauPrint   T_SEMICOLON                 { $$ = NULL; }
-    | IfStmt                                   { $$ = NULL; }
-    | WhileStmt                                { $$ = NULL; }
-    | ForStmt                                  { $$ = NULL; }
-    | T_LBRACE ListaSentencias T_RBRACE        { $$ = NULL; }
+    : Declaracion T_SEMICOLON                 { $$ = $1; }
+    | Asignacion  T_SEMICOLON                 { $$ = $1; }
+    | MiauPixel   T_SEMICOLON                 { $$ = $1; }
+    | MiauKey     T_SEMICOLON                 { $$ = $1; }
+    | MiauInput   T_SEMICOLON                 { $$ = $1; }
+    | MiauPrint   T_SEMICOLON                 { $$ = $1; }
+    | IfStmt                                   { $$ = $1; }
+    | WhileStmt                                { $$ = $1; }
+    | ForStmt                                  { $$ = $1; }
+    | T_LBRACE AbreAmbito ListaSentencias T_RBRACE
+      {
+          close_scope(ctx, $2);
+          $$ = ast_make_block(&ctx->ast, $3.head);
+      }
+
+    /* Recuperación de errores: se descarta hasta el fin de la sentencia (o
+       del bloque) y se sigue analizando para informar todos los errores */
+    | error T_SEMICOLON                        { yyerrok; $$ = ast_make_block(&ctx->ast, AST_NONE); }
+    | T_LBRACE AbreAmbito ListaSentencias error T_RBRACE
+      {
+          yyerrok;
+          close_scope(ctx, $2);
+          $$ = ast_make_block(&ctx->ast, $3.head);
+      }
+    ;
+
+AbreAmbito
+    : /* vacío */  { symtab_push_scope(&ctx->symtab); $$ = symtab_scope_level(&ctx->symtab); }
     ;
 
 /* ==================== CONTROL DE FLUJO ==================== */
@@ -120,19 +260,17 @@ Sentencia
 IfStmt
     : T_IF T_LPAREN Expresion T_RPAREN Sentencia
       {
-          if ($3 != TYPE_BOOL && $3 != TYPE_ERROR) {
-              fprintf(stderr,
-                      "Error semántico: la condición de if debe ser bool.\n");
+          if (ast_expr(&ctx->ast, $3)->type != TYPE_BOOL && ast_expr(&ctx->ast, $3)->type != TYPE_ERROR) {
+              SEM_ERROR(LOC(@3), "la condición de if debe ser bool.");
           }
-          $$ = NULL;
+          $$ = ast_make_if(&ctx->ast, $3, $5);
       }
     | T_IF T_LPAREN Expresion T_RPAREN Sentencia T_ELSE Sentencia
       {
-          if ($3 != TYPE_BOOL && $3 != TYPE_ERROR) {
-              fprintf(stderr,
-                      "Error semántico: la condición de if debe ser bool.\n");
+          if (ast_expr(&ctx->ast, $3)->type != TYPE_BOOL && ast_expr(&ctx->ast, $3)->type != TYPE_ERROR) {
+              SEM_ERROR(LOC(@3), "la condición de if debe ser bool.");
           }
-          $$ = NULL;
+          $$ = ast_make_if_else(&ctx->ast, $3, $5, $7);
       }
     ;
 
@@ -140,26 +278,32 @@ IfStmt
 WhileStmt
     : T_WHILE T_LPAREN Expresion T_RPAREN Sentencia
       {
-          if ($3 != TYPE_BOOL && $3 != TYPE_ERROR) {
-              fprintf(stderr,
-                      "Error semántico: la condición de while debe ser bool.\n");
+          if (ast_expr(&ctx->ast, $3)->type != TYPE_BOOL && ast_expr(&ctx->ast, $3)->type != TYPE_ERROR) {
+              SEM_ERROR(LOC(@3), "la condición de while debe ser bool.");
           }
-          $$ = NULL;
+          $$ = ast_make_while(&ctx->ast, $3, $5);
       }
     ;
 
-/* FOR sencillo: for (asign; expr; asign) Sentencia */
+/* FOR sencillo: for (asign; expr; asign) Sentencia
+   Se traduce a { asign; while (expr) { Sentencia; asign; } }             */
 ForStmt
     : T_FOR T_LPAREN Asignacion T_SEMICOLON
                      Expresion  T_SEMICOLON
                      Asignacion T_RPAREN
                      Sentencia
       {
-          if ($5 != TYPE_BOOL && $5 != TYPE_ERROR) {
-              fprintf(stderr,
-                      "Error semántico: la condición de for debe ser bool.\n");
+          if (ast_expr(&ctx->ast, $5)->type != TYPE_BOOL && ast_expr(&ctx->ast, $5)->type != TYPE_ERROR) {
+              SEM_ERROR(LOC(@5), "la condición de for debe ser bool.");
           }
-          $$ = NULL;
+          ASTStmtList body = ast_list_empty();
+          ast_list_append(&ctx->ast, &body, $9);
+          ast_list_append(&ctx->ast, &body, $7);
+
+          ASTStmtList block = ast_list_empty();
+          ast_list_append(&ctx->ast, &block, $3);
+          ast_list_append(&ctx->ast, &block, ast_make_while(&ctx->ast, $5, body.head));
+          $$ = ast_make_block(&ctx->ast, block.head);
       }
     ;
 
@@ -174,73 +318,11 @@ ForStmt
 Declaracion
     : T_DECLARACION Tipo T_ID OptArray Optinit
       {
-          MeowType declared_type = $2;
-          char *id_name = $3;
-          SymbolEntry *entry = NULL;
-
-          if ($4 > 0) {
-              entry = insert_array_symbol(id_name, declared_type, $4);
-          } else {
-              entry = insert_symbol(id_name, declared_type);
-          }
-
-          if (entry != NULL && $5 != TYPE_VOID) {
-              MeowType init_type = $5;
-              if ($4 > 0) {
-                  fprintf(stderr,
-                          "Error semántico: Inicialización directa de arreglo '%s' no soportada.\n",
-                          id_name);
-              } else {
-                  if (declared_type != init_type) {
-                      if (!(declared_type == TYPE_FLOAT && init_type == TYPE_INT)) {
-                          fprintf(stderr,
-                                  "Error semántico: Inicialización incompatible de '%s'. Esperado: %s, Recibido: %s.\n",
-                                  id_name,
-                                  MeowTypeToString(declared_type),
-                                  MeowTypeToString(init_type));
-                      } else {
-                          printf("DEBUG: Promoción implícita INT -> FLOAT en inicialización de '%s'.\n",
-                                 id_name);
-                      }
-                  }
-              }
-          }
-          $$ = declared_type;
+          $$ = build_decl(ctx, LOC(@3), $2, $3, $4, $5);
       }
     | Tipo T_ID OptArray Optinit
       {
-          MeowType declared_type = $1;
-          char *id_name = $2;
-          SymbolEntry *entry = NULL;
-
-          if ($3 > 0) {
-              entry = insert_array_symbol(id_name, declared_type, $3);
-          } else {
-              entry = insert_symbol(id_name, declared_type);
-          }
-
-          if (entry != NULL && $4 != TYPE_VOID) {
-              MeowType init_type = $4;
-              if ($3 > 0) {
-                  fprintf(stderr,
-                          "Error semántico: Inicialización directa de arreglo '%s' no soportada.\n",
-                          id_name);
-              } else {
-                  if (declared_type != init_type) {
-                      if (!(declared_type == TYPE_FLOAT && init_type == TYPE_INT)) {
-                          fprintf(stderr,
-                                  "Error semántico: Inicialización incompatible de '%s'. Esperado: %s, Recibido: %s.\n",
-                                  id_name,
-                                  MeowTypeToString(declared_type),
-                                  MeowTypeToString(init_type));
-                      } else {
-                          printf("DEBUG: Promoción implícita INT -> FLOAT en inicialización de '%s'.\n",
-                                 id_name);
-                      }
-                  }
-              }
-          }
-          $$ = declared_type;
+          $$ = build_decl(ctx, LOC(@2), $1, $2, $3, $4);
       }
     ;
 
@@ -255,7 +337,7 @@ Tipo
 /* Inicialización opcional:  = Expresion */
 Optinit
     : T_ASSIGN Expresion  { $$ = $2; }
-    | /* vacío */         { $$ = TYPE_VOID; }
+    | /* vacío */         { $$ = AST_NONE; }
     ;
 
 /* Tamaño opcional de arreglo: [N] */
@@ -269,56 +351,42 @@ OptArray
 Asignacion
     : T_ID T_ASSIGN Expresion
       {
-          char *id_name = $1;
-          MeowType lhs_type = get_symbol_type(id_name);
-          MeowType rhs_type = $3;
-
-          if (lhs_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
-              if (lhs_type != rhs_type) {
-                  if (!(lhs_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
-                      fprintf(stderr,
-                              "Error semántico: Asignación incompatible en '%s'. Esperado: %s, Recibido: %s.\n",
-                              id_name,
-                              MeowTypeToString(lhs_type),
-                              MeowTypeToString(rhs_type));
-                  } else {
-                      printf("DEBUG: Promoción implícita INT -> FLOAT en asignación de '%s'.\n",
-                             id_name);
-                  }
-              }
-          }
-          $$ = rhs_type;
+          const char *id_name = $1;
+          MeowType lhs_type = get_symbol_type(&ctx->symtab, id_name, LOC(@1));
+
+          check_assign_types(ctx, LOC(@1), id_name, lhs_type, ast_expr(&ctx->ast, $3)->type);
+          $$ = ast_make_assign(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), $3);
       }
     | T_ID T_LBRACKET Expresion T_RBRACKET T_ASSIGN Expresion
       {
-          char *id_name = $1;
-          MeowType arr_type  = get_symbol_type(id_name);
-          MeowType idx_type  = $3;
-          MeowType rhs_type  = $6;
-          MeowType elem_type = get_symbol_element_type(id_name);
+          const char *id_name = $1;
+          MeowType arr_type  = get_symbol_type(&ctx->symtab, id_name, LOC(@1));
+          MeowType idx_type  = ast_expr(&ctx->ast, $3)->type;
+          MeowType rhs_type  = ast_expr(&ctx->ast, $6)->type;
+          MeowType elem_type = get_symbol_element_type(&ctx->symtab, id_name, LOC(@1));
 
           if (arr_type != TYPE_ARRAY) {
-              fprintf(stderr, "Error semántico: '%s' no es un arreglo.\n", id_name);
+              SEM_ERROR(LOC(@1), "'%s' no es un arreglo.", id_name);
           }
           if (idx_type != TYPE_INT && idx_type != TYPE_ERROR) {
-              fprintf(stderr, "Error semántico: Índice de arreglo '%s' debe ser int.\n", id_name);
+              SEM_ERROR(LOC(@3), "Índice de arreglo '%s' debe ser int.", id_name);
+          } else if (arr_type == TYPE_ARRAY) {
+              check_const_index(ctx, LOC(@3), id_name, $3);
           }
 
           if (elem_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
               if (elem_type != rhs_type) {
                   if (!(elem_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
-                      fprintf(stderr,
-                              "Error semántico: Asignación incompatible en '%s[...]'. Esperado: %s, Recibido: %s.\n",
-                              id_name,
-                              MeowTypeToString(elem_type),
-                              MeowTypeToString(rhs_type));
+                      SEM_ERROR(LOC(@5), "Asignación incompatible en '%s[...]'. Esperado: %s, Recibido: %s.",
+                                id_name,
+                                MeowTypeToString(elem_type),
+                                MeowTypeToString(rhs_type));
                   } else {
-                      printf("DEBUG: Promoción implícita INT -> FLOAT en '%s[...]'.\n",
-                             id_name);
+                      SEM_DEBUG(LOC(@5), "Promoción implícita INT -> FLOAT en '%s[...]'.", id_name);
                   }
               }
           }
-          $$ = rhs_type;
+          $$ = ast_make_index_assign(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), $3, $6);
       }
     ;
 
@@ -328,34 +396,33 @@ Asignacion
 Expresion
     : T_ID T_ASSIGN Expresion
       {
-          char *id_name = $1;
-          MeowType lhs_type = get_symbol_type(id_name);
-          MeowType rhs_type = $3;
-
-          if (lhs_type != TYPE_ERROR && rhs_type != TYPE_ERROR) {
-              if (lhs_type != rhs_type) {
-                  if (!(lhs_type == TYPE_FLOAT && rhs_type == TYPE_INT)) {
-                      fprintf(stderr,
-                              "Error semántico: Asignación incompatible en '%s'. Esperado: %s, Recibido: %s.\n",
-                              id_name,
-                              MeowTypeToString(lhs_type),
-                              MeowTypeToString(rhs_type));
-                  } else {
-                      printf("DEBUG: Promoción implícita INT -> FLOAT en asignación de '%s'.\n",
-                             id_name);
-                  }
-              }
-          }
-          $$ = rhs_type;
+          const char *id_name = $1;
+          MeowType lhs_type = get_symbol_type(&ctx->symtab, id_name, LOC(@1));
+          MeowType rhs_type = ast_expr(&ctx->ast, $3)->type;
+
+          check_assign_types(ctx, LOC(@1), id_name, lhs_type, rhs_type);
+          $$ = ast_make_assign_expr(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), $3, rhs_type);
+      }
+    | Expresion T_PLUS  Termino
+      {
+          $$ = make_arith(ctx, LOC(@2), AST_BINOP_ADD, $1, $3);
+      }
+    | Expresion T_MINUS Termino
+      {
+          $$ = make_arith(ctx, LOC(@2), AST_BINOP_SUB, $1, $3);
       }
-    | Expresion T_PLUS  Termino  { $$ = check_arithmetic_type($1, $3); }
-    | Expresion T_MINUS Termino  { $$ = check_arithmetic_type($1, $3); }
     | Termino                    { $$ = $1; }
     ;
 
 Termino
-    : Termino T_MULT Factor  { $$ = check_arithmetic_type($1, $3); }
-    | Termino T_DIV Factor   { $$ = check_arithmetic_type($1, $3); }
+    : Termino T_MULT Factor
+      {
+          $$ = make_arith(ctx, LOC(@2), AST_BINOP_MUL, $1, $3);
+      }
+    | Termino T_DIV Factor
+      {
+          $$ = make_arith(ctx, LOC(@2), AST_BINOP_DIV, $1, $3);
+      }
     | Factor                 { $$ = $1; }
     ;
 
@@ -367,61 +434,55 @@ Base
     : T_LPAREN Expresion T_RPAREN { $$ = $2; }
     | T_ID
       {
-          MeowType t = get_symbol_type($1);
+          MeowType t = get_symbol_type(&ctx->symtab, $1, LOC(@1));
           if (t == TYPE_ARRAY) {
-              fprintf(stderr, "Error semántico: Uso de arreglo '%s' sin índice.\n", $1);
-              $$ = TYPE_ERROR;
-          } else {
-              $$ = t;
-              if ($$ == TYPE_VOID) {
-                  fprintf(stderr,
-                          "Error interno: ID '%s' tiene tipo VOID en expresión.\n", $1);
-                  $$ = TYPE_ERROR;
-              }
+              SEM_ERROR(LOC(@1), "Uso de arreglo '%s' sin índice.", $1);
+              t = TYPE_ERROR;
+          } else if (t == TYPE_VOID) {
+              diag_report(&ctx->diags, DIAG_ERROR, "interno", LOC(@1),
+                          "ID '%s' tiene tipo VOID en expresión.", $1);
+              t = TYPE_ERROR;
           }
+          $$ = ast_make_var(&ctx->ast, get_symbol_unique_name(&ctx->symtab, $1), t);
       }
-    | T_LITERAL_INT         { $$ = TYPE_INT; }
-    | T_LITERAL_FLOAT       { $$ = TYPE_FLOAT; }
-    | T_LITERAL_STRING      { $$ = TYPE_STRING; }
-    | T_TRUE                { $$ = TYPE_BOOL; }
-    | T_FALSE               { $$ = TYPE_BOOL; }
+    | T_LITERAL_INT         { $$ = ast_make_int(&ctx->ast, $1); }
+    | T_LITERAL_FLOAT       { $$ = ast_make_float(&ctx->ast, $1); }
+    | T_LITERAL_STRING      { $$ = ast_make_string(&ctx->ast, $1); }
+    | T_TRUE                { $$ = ast_make_bool(&ctx->ast, 1); }
+    | T_FALSE               { $$ = ast_make_bool(&ctx->ast, 0); }
     | T_ID T_LBRACKET Expresion T_RBRACKET
       {
-          char *id_name = $1;
-          MeowType arr_type = get_symbol_type(id_name);
-          MeowType idx_type = $3;
+          const char *id_name = $1;
+          MeowType arr_type = get_symbol_type(&ctx->symtab, id_name, LOC(@1));
+          MeowType idx_type = ast_expr(&ctx->ast, $3)->type;
+          MeowType t;
 
           if (arr_type != TYPE_ARRAY) {
-              fprintf(stderr, "Error semántico: '%s' no es un arreglo.\n", id_name);
-              $$ = TYPE_ERROR;
+              SEM_ERROR(LOC(@1), "'%s' no es un arreglo.", id_name);
+              t = TYPE_ERROR;
           } else if (idx_type != TYPE_INT && idx_type != TYPE_ERROR) {
-              fprintf(stderr,
-                      "Error semántico: Índice de arreglo debe ser int en '%s'.\n",
-                      id_name);
-              $$ = TYPE_ERROR;
+              SEM_ERROR(LOC(@3), "Índice de arreglo debe ser int en '%s'.", id_name);
+              t = TYPE_ERROR;
           } else {
-              $$ = get_symbol_element_type(id_name);
+              t = get_symbol_element_type(&ctx->symtab, id_name, LOC(@1));
+              check_const_index(ctx, LOC(@3), id_name, $3);
           }
+          $$ = ast_make_index(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name), $3, t);
       }
     | T_ID T_DOT T_ID
       {
-          char *id_name = $1;
-          char *prop    = $3;
-
-          if (strcmp(prop, "length") == 0) {
-              if (get_symbol_type(id_name) == TYPE_ARRAY) {
-                  $$ = TYPE_INT;
-              } else {
-                  fprintf(stderr,
-                          "Error semántico: '%s' no es un arreglo y no tiene 'length'.\n",
-                          id_name);
-                  $$ = TYPE_ERROR;
+          const char *id_name = $1;
+          const char *prop    = $3;
+
+          $$ = ast_make_length(&ctx->ast, get_symbol_unique_name(&ctx->symtab, id_name));
+          if (prop == intern("length")) {
+              if (get_symbol_type(&ctx->symtab, id_name, LOC(@1)) != TYPE_ARRAY) {
+                  SEM_ERROR(LOC(@1), "'%s' no es un arreglo y no tiene 'length'.", id_name);
+                  ast_expr(&ctx->ast, $$)->type = TYPE_ERROR;
               }
           } else {
-              fprintf(stderr,
-                      "Error semántico: Propiedad desconocida '%s' en '%s'.\n",
-                      prop, id_name);
-              $$ = TYPE_ERROR;
+              SEM_ERROR(LOC(@3), "Propiedad desconocida '%s' en '%s'.", prop, id_name);
+              ast_expr(&ctx->ast, $$)->type = TYPE_ERROR;
           }
       }
     ;
@@ -431,55 +492,46 @@ Base
 MiauPixel
     : T_MIAU_PIXEL T_LPAREN Expresion T_COMMA Expresion T_COMMA Expresion T_RPAREN
       {
-          if ($3 == TYPE_INT && $5 == TYPE_INT && $7 == TYPE_INT) {
-              $$ = TYPE_VOID;
-          } else {
-              fprintf(stderr,
-                      "Error semántico: miau_pixel espera tres argumentos int (x, y, color).\n");
-              $$ = TYPE_ERROR;
+          if (!(ast_expr(&ctx->ast, $3)->type == TYPE_INT &&
+                ast_expr(&ctx->ast, $5)->type == TYPE_INT &&
+                ast_expr(&ctx->ast, $7)->type == TYPE_INT)) {
+              SEM_ERROR(LOC(@1), "miau_pixel espera tres argumentos int (x, y, color).");
           }
+          $$ = ast_make_pixel(&ctx->ast, $3, $5, $7);
       }
     ;
 
 MiauKey
     : T_MIAU_KEY T_LPAREN Expresion T_COMMA T_ID T_RPAREN
       {
-          int destType = get_symbol_type($5);
-          if ($3 == TYPE_INT && (destType == TYPE_INT || destType == TYPE_BOOL)) {
-              $$ = TYPE_VOID;
-          } else {
-              fprintf(stderr,
-                      "Error semántico: miau_key espera (int, id<int|bool>).\n");
-              $$ = TYPE_ERROR;
+          int destType = get_symbol_type(&ctx->symtab, $5, LOC(@5));
+          if (!(ast_expr(&ctx->ast, $3)->type == TYPE_INT && (destType == TYPE_INT || destType == TYPE_BOOL))) {
+              SEM_ERROR(LOC(@1), "miau_key espera (int, id<int|bool>).");
           }
+          $$ = ast_make_key(&ctx->ast, $3, get_symbol_unique_name(&ctx->symtab, $5));
       }
     ;
 
 MiauInput
     : T_MIAU_INPUT T_LPAREN T_ID T_RPAREN
       {
-          int destType = get_symbol_type($3);
-          if (destType == TYPE_INT) {
-              $$ = TYPE_VOID;
-          } else {
-              fprintf(stderr,
-                      "Error semántico: miau_input espera un identificador int.\n");
-              $$ = TYPE_ERROR;
+          int destType = get_symbol_type(&ctx->symtab, $3, LOC(@3));
+          if (destType != TYPE_INT) {
+              SEM_ERROR(LOC(@3), "miau_input espera un identificador int.");
           }
+          $$ = ast_make_input(&ctx->ast, get_symbol_unique_name(&ctx->symtab, $3));
       }
     ;
 
 MiauPrint
     : T_MIAU_PRINT T_LPAREN Expresion T_RPAREN
       {
-          if ($3 == TYPE_INT || $3 == TYPE_FLOAT ||
-              $3 == TYPE_BOOL || $3 == TYPE_STRING) {
-              $$ = TYPE_VOID;
-          } else {
-              fprintf(stderr,
-                      "Error semántico: miau_print no acepta este tipo de expresión.\n");
-              $$ = TYPE_ERROR;
+          MeowType t = ast_expr(&ctx->ast, $3)->type;
+          if (!(t == TYPE_INT || t == TYPE_FLOAT ||
+                t == TYPE_BOOL || t == TYPE_STRING)) {
+              SEM_ERROR(LOC(@3), "miau_print no acepta este tipo de expresión.");
           }
+          $$ = ast_make_print(&ctx->ast, $3);
       }
     ;
 
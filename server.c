@@ -0,0 +1,623 @@
+// server.c
+
+#include "server.h"
+#include "context.h"
+#include "emitter.h"
+#include "sha256.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* ================= Fuentes analizados ================= */
+
+typedef struct {
+    int used;
+    uint8_t key[SHA256_DIGEST_SIZE];   // SHA-256 de nombre y contenido
+    char *name;                        // ctx.path
+    MeowContext ctx;                   // AST y tabla de símbolos del análisis
+    int status;                        // 0, o el código de salida del análisis
+    char *parse_diag;                  // mensajes del análisis
+    size_t parse_diag_len;
+    unsigned long last_use;
+
+    // Traducción del programa: no depende del mensaje, se hace una vez
+    int program_done;
+    int program_status;
+    Emitter program_out;
+    char *program_diag;
+    size_t program_diag_len;
+} WarmSource;
+
+typedef struct {
+    const ServerOptions *opts;
+    WarmSource *sources;
+    size_t nsources;
+    unsigned long clock;
+    pthread_mutex_t lock;     // un pedido a la vez sobre 'sources'
+} Server;
+
+static void server_init(Server *s, const ServerOptions *opts) {
+    memset(s, 0, sizeof(*s));
+    s->opts = opts;
+    s->nsources = opts->max_sources ? opts->max_sources : SERVER_DEFAULT_MAX_SOURCES;
+    s->sources = (WarmSource *)calloc(s->nsources, sizeof(WarmSource));
+    if (s->sources == NULL) {
+        perror("Error de memoria en el servidor");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&s->lock, NULL);
+}
+
+static void warm_free(WarmSource *w) {
+    if (!w->used) return;
+    meow_context_free(&w->ctx);
+    emitter_free(&w->program_out);
+    free(w->program_diag);
+    free(w->parse_diag);
+    free(w->name);
+    memset(w, 0, sizeof(*w));
+}
+
+static void server_free(Server *s) {
+    for (size_t i = 0; i < s->nsources; ++i) warm_free(&s->sources[i]);
+    free(s->sources);
+    pthread_mutex_destroy(&s->lock);
+}
+
+/* Pasa los diagnósticos acumulados en el contexto a un texto propio */
+static void take_diag(MeowContext *ctx, char **text, size_t *len) {
+    *text = NULL;
+    *len = 0;
+    FILE *mem = open_memstream(text, len);
+    if (mem == NULL) return;
+    meow_context_flush_diag(ctx, mem);
+    fclose(mem);
+}
+
+/* Lo mismo que compile_source en main.c hasta tener el AST */
+static int analyze(MeowContext *ctx, MeowSource *src) {
+    int parse_result = meow_parse(ctx, src);
+    unsigned errors = diag_errors(&ctx->diags);
+    if (parse_result != 0 || errors > 0) {
+        if (errors == 0) errors = 1;
+        fprintf(ctx->diag, "Compilación fallida: %u %s.\n", errors,
+                errors == 1 ? "error" : "errores");
+        return 2;
+    }
+    if (ctx->root == AST_NONE) {
+        fprintf(ctx->diag,
+                "Error: el parser terminó sin construir el AST (ctx->root == AST_NONE).\n");
+        return 3;
+    }
+    return 0;
+}
+
+/* Busca el fuente ya analizado; si no está lo analiza en el lugar del
+   menos usado recientemente */
+static WarmSource *warm_source(Server *s, const char *name, MeowSource *src, int *warm) {
+    uint8_t key[SHA256_DIGEST_SIZE];
+    Sha256 h;
+    sha256_init(&h);
+    sha256_update(&h, name, strlen(name) + 1);
+    sha256_update(&h, src->data, src->len);
+    sha256_final(&h, key);
+
+    WarmSource *victim = &s->sources[0];
+    for (size_t i = 0; i < s->nsources; ++i) {
+        WarmSource *w = &s->sources[i];
+        if (w->used && memcmp(w->key, key, sizeof(key)) == 0) {
+            w->last_use = ++s->clock;
+            *warm = 1;
+            return w;
+        }
+        if (!w->used) {
+            if (victim->used) victim = w;
+        } else if (victim->used && w->last_use < victim->last_use) {
+            victim = w;
+        }
+    }
+
+    warm_free(victim);
+    WarmSource *w = victim;
+    w->used = 1;
+    memcpy(w->key, key, sizeof(key));
+    w->name = strdup(name);
+    if (w->name == NULL) {
+        perror("Error de memoria en el servidor");
+        exit(EXIT_FAILURE);
+    }
+    w->last_use = ++s->clock;
+    emitter_init(&w->program_out);
+
+    meow_context_init(&w->ctx, w->name, 1, 0);
+    w->ctx.diags.min_level = s->opts->min_level;
+    w->ctx.diags.error_limit = s->opts->error_limit;
+    w->ctx.parse_depth = s->opts->parse_depth;
+    w->status = analyze(&w->ctx, src);
+    take_diag(&w->ctx, &w->parse_diag, &w->parse_diag_len);
+    *warm = 0;
+    return w;
+}
+
+/* ================= Pedidos (JSON) ================= */
+
+typedef struct {
+    const char *id;           // texto JSON del "id", tal cual (NULL si no vino)
+    size_t id_len;
+    char *path;
+    char *source;             // fuente en línea (puede tener bytes en 0)
+    size_t source_len;
+    char *message;
+    int program;              // -1 si no vino
+} Request;
+
+typedef struct {
+    const char *p, *end;
+} JsonReader;
+
+static void skip_ws(JsonReader *r) {
+    while (r->p < r->end && (*r->p == ' ' || *r->p == '\t' || *r->p == '\n' || *r->p == '\r'))
+        r->p++;
+}
+
+static int hex4(const char *p, const char *end, unsigned *out) {
+    if (end - p < 4) return -1;
+    unsigned v = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (unsigned)(c - 'A' + 10);
+        else return -1;
+    }
+    *out = v;
+    return 0;
+}
+
+static size_t put_utf8(char *out, unsigned cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/* Lee una cadena JSON (r->p en la comilla). El resultado se reserva con
+   malloc; ninguna secuencia de escape ocupa más decodificada que escrita. */
+static const char *json_string(JsonReader *r, char **out, size_t *out_len) {
+    const char *p = r->p + 1;
+    char *buf = (char *)malloc((size_t)(r->end - p) + 1);
+    size_t n = 0;
+    if (buf == NULL) return "sin memoria";
+
+    while (p < r->end && *p != '"') {
+        char c = *p++;
+        if ((unsigned char)c < 0x20) {
+            free(buf);
+            return "carácter de control dentro de una cadena";
+        }
+        if (c != '\\') {
+            buf[n++] = c;
+            continue;
+        }
+        if (p == r->end) break;
+        c = *p++;
+        switch (c) {
+            case '"':  buf[n++] = '"'; break;
+            case '\\': buf[n++] = '\\'; break;
+            case '/':  buf[n++] = '/'; break;
+            case 'b':  buf[n++] = '\b'; break;
+            case 'f':  buf[n++] = '\f'; break;
+            case 'n':  buf[n++] = '\n'; break;
+            case 'r':  buf[n++] = '\r'; break;
+            case 't':  buf[n++] = '\t'; break;
+            case 'u': {
+                unsigned cp, lo;
+                if (hex4(p, r->end, &cp) != 0) {
+                    free(buf);
+                    return "escape \\u inválido";
+                }
+                p += 4;
+                // Par sustituto: \uD83D\uDE00 es un solo carácter
+                if (cp >= 0xD800 && cp < 0xDC00 && r->end - p >= 6 && p[0] == '\\' &&
+                    p[1] == 'u' && hex4(p + 2, r->end, &lo) == 0 && lo >= 0xDC00 && lo < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    p += 6;
+                }
+                n += put_utf8(buf + n, cp);
+                break;
+            }
+            default:
+                free(buf);
+                return "escape inválido en una cadena";
+        }
+    }
+    if (p == r->end) {
+        free(buf);
+        return "cadena sin terminar";
+    }
+    buf[n] = '\0';
+    r->p = p + 1;
+    *out = buf;
+    if (out_len) *out_len = n;
+    return NULL;
+}
+
+/* Salta un valor cualquiera (el "id", o campos que no se usan) */
+static const char *json_skip(JsonReader *r) {
+    int depth = 0;
+    do {
+        skip_ws(r);
+        if (r->p == r->end) return "valor incompleto";
+        char c = *r->p;
+        if (c == '"') {
+            char *tmp;
+            const char *err = json_string(r, &tmp, NULL);
+            if (err) return err;
+            free(tmp);
+        } else if (c == '{' || c == '[') {
+            depth++;
+            r->p++;
+            continue;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) return "valor inválido";
+            depth--;
+            r->p++;
+        } else if (c == ',' || c == ':') {
+            if (depth == 0) return "valor inválido";
+            r->p++;
+            continue;
+        } else {
+            const char *start = r->p;
+            while (r->p < r->end && strchr(",:]} \t\r\n", *r->p) == NULL) r->p++;
+            if (r->p == start) return "valor inválido";
+        }
+    } while (depth > 0);
+    return NULL;
+}
+
+static void request_free(Request *req) {
+    free(req->path);
+    free(req->source);
+    free(req->message);
+}
+
+static const char *parse_request(const char *line, size_t len, Request *req) {
+    JsonReader r = { line, line + len };
+    memset(req, 0, sizeof(*req));
+    req->program = -1;
+
+    skip_ws(&r);
+    if (r.p == r.end || *r.p != '{') return "se esperaba un objeto JSON";
+    r.p++;
+    skip_ws(&r);
+    if (r.p < r.end && *r.p == '}') {
+        r.p++;
+    } else {
+        for (;;) {
+            char *name;
+            skip_ws(&r);
+            if (r.p == r.end || *r.p != '"') return "se esperaba el nombre de un campo";
+            const char *err = json_string(&r, &name, NULL);
+            if (err) return err;
+            skip_ws(&r);
+            if (r.p == r.end || *r.p != ':') {
+                free(name);
+                return "falta ':' después del nombre de un campo";
+            }
+            r.p++;
+            skip_ws(&r);
+
+            char **text = NULL;
+            size_t *text_len = NULL;
+            if (strcmp(name, "path") == 0) text = &req->path;
+            else if (strcmp(name, "source") == 0) text = &req->source, text_len = &req->source_len;
+            else if (strcmp(name, "message") == 0) text = &req->message;
+
+            if (text != NULL) {
+                if (r.p == r.end || *r.p != '"' || *text != NULL) {
+                    err = *text ? "campo repetido" : "se esperaba una cadena";
+                } else {
+                    err = json_string(&r, text, text_len);
+                }
+            } else if (strcmp(name, "program") == 0) {
+                if ((size_t)(r.end - r.p) >= 4 && memcmp(r.p, "true", 4) == 0) {
+                    req->program = 1;
+                    r.p += 4;
+                } else if ((size_t)(r.end - r.p) >= 5 && memcmp(r.p, "false", 5) == 0) {
+                    req->program = 0;
+                    r.p += 5;
+                } else {
+                    err = "\"program\" debe ser true o false";
+                }
+            } else if (strcmp(name, "id") == 0) {
+                const char *start = r.p;
+                err = json_skip(&r);
+                req->id = start;
+                req->id_len = (size_t)(r.p - start);
+            } else {
+                err = json_skip(&r);
+            }
+            free(name);
+            if (err) return err;
+
+            skip_ws(&r);
+            if (r.p < r.end && *r.p == ',') {
+                r.p++;
+                continue;
+            }
+            if (r.p < r.end && *r.p == '}') {
+                r.p++;
+                break;
+            }
+            return "se esperaba ',' o '}'";
+        }
+    }
+    skip_ws(&r);
+    if (r.p != r.end) return "texto de más después del objeto";
+    if (req->path == NULL && req->source == NULL) return "falta \"path\" o \"source\"";
+    return NULL;
+}
+
+/* ================= Respuestas ================= */
+
+static void put_json_string(Emitter *e, const char *s, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    emitter_putc(e, '"');
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        switch (c) {
+            case '"':  emitter_write(e, "\\\"", 2); break;
+            case '\\': emitter_write(e, "\\\\", 2); break;
+            case '\n': emitter_write(e, "\\n", 2); break;
+            case '\r': emitter_write(e, "\\r", 2); break;
+            case '\t': emitter_write(e, "\\t", 2); break;
+            default:
+                if (c < 0x20) {
+                    emitter_write(e, "\\u00", 4);
+                    emitter_putc(e, hex[c >> 4]);
+                    emitter_putc(e, hex[c & 0xF]);
+                } else {
+                    emitter_putc(e, (char)c);
+                }
+        }
+    }
+    emitter_putc(e, '"');
+}
+
+static void put_response_head(Emitter *e, const Request *req, int status) {
+    emitter_puts(e, "{\"id\": ");
+    if (req != NULL && req->id != NULL) emitter_write(e, req->id, req->id_len);
+    else emitter_puts(e, "null");
+    emitter_puts(e, ", \"status\": ");
+    emitter_int(e, status);
+}
+
+/* ================= Compilación de un pedido ================= */
+
+// Los textos vacíos pueden no tener búfer (NULL)
+static void append(Emitter *e, const char *text, size_t len) {
+    if (len > 0) emitter_write(e, text, len);
+}
+
+static void handle_request(Server *s, const Request *req, Emitter *resp) {
+    const ServerOptions *opts = s->opts;
+    const char *name = req->path ? req->path : "<en línea>";
+    int program = req->program >= 0 ? req->program : opts->program;
+
+    // Mensajes de este pedido (los del análisis van antes)
+    char *diag = NULL;
+    size_t diag_len = 0;
+    FILE *mem = open_memstream(&diag, &diag_len);
+    if (mem == NULL) mem = stderr;
+
+    MeowSource src;
+    int rc = req->source ? source_from_memory(&src, req->source, req->source_len)
+                         : source_open(&src, req->path, opts->input);
+    if (rc != 0) {
+        fprintf(mem, "%s: %s\n", name, strerror(errno));
+    } else if (src.data == NULL) {
+        fprintf(mem, "%s: el servidor solo compila archivos regulares\n", name);
+        source_close(&src);
+        rc = -1;
+    }
+
+    int status = 1;
+    int warm = 0;
+    Emitter out;
+    emitter_init(&out);
+    WarmSource *w = NULL;
+
+    if (rc == 0) {
+        w = warm_source(s, name, &src, &warm);
+        source_close(&src);
+        status = w->status;
+    }
+
+    if (w != NULL && status == 0 && program) {
+        if (!w->program_done) {
+            int errors = codegen_fis25(&w->ctx, NULL, opts->codegen, &w->program_out);
+            w->program_status = errors ? 4 : 0;
+            if (errors) w->program_out.len = 0;
+            take_diag(&w->ctx, &w->program_diag, &w->program_diag_len);
+            w->program_done = 1;
+        }
+        status = w->program_status;
+        append(&out, w->program_out.buf, w->program_out.len);
+    } else if (w != NULL && status == 0) {
+        char msg[64];
+        codegen_marquee_message(req->message ? req->message : "", msg, sizeof(msg), mem);
+        if (codegen_fis25(&w->ctx, msg, opts->codegen, &out) != 0) {
+            status = 4;
+            out.len = 0;
+        }
+        meow_context_flush_diag(&w->ctx, mem);
+    }
+    if (mem != stderr) fclose(mem);
+
+    put_response_head(resp, req, status);
+    emitter_puts(resp, ", \"warm\": ");
+    emitter_puts(resp, warm ? "true" : "false");
+    emitter_puts(resp, ", \"output\": ");
+    put_json_string(resp, out.buf, out.len);
+    emitter_puts(resp, ", \"diagnostics\": ");
+
+    // Análisis + (programa guardado o letrero de este pedido)
+    Emitter all;
+    emitter_init(&all);
+    if (w != NULL) {
+        append(&all, w->parse_diag, w->parse_diag_len);
+        if (w->status == 0 && program) append(&all, w->program_diag, w->program_diag_len);
+    }
+    append(&all, diag, diag_len);
+    put_json_string(resp, all.buf, all.len);
+    emitter_puts(resp, "}");
+
+    emitter_free(&all);
+    emitter_free(&out);
+    free(diag);
+}
+
+/* Atiende los pedidos de 'in' hasta el fin de la entrada o hasta que no se
+   pueda escribir la respuesta en 'out_fd' */
+static void serve(Server *s, FILE *in, int out_fd) {
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    Emitter resp;
+    emitter_init(&resp);
+
+    while ((n = getline(&line, &cap, in)) > 0) {
+        size_t len = (size_t)n;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) len--;
+        if (len == 0) continue;
+
+        Request req;
+        const char *err = parse_request(line, len, &req);
+        if (err != NULL) {
+            put_response_head(&resp, req.id ? &req : NULL, 1);
+            emitter_puts(&resp, ", \"error\": ");
+            put_json_string(&resp, err, strlen(err));
+            emitter_puts(&resp, "}");
+        } else {
+            pthread_mutex_lock(&s->lock);
+            handle_request(s, &req, &resp);
+            pthread_mutex_unlock(&s->lock);
+        }
+        request_free(&req);
+
+        emitter_putc(&resp, '\n');
+        if (emitter_flush_fd(&resp, out_fd) != 0) break;   // el cliente se fue
+    }
+    emitter_free(&resp);
+    free(line);
+}
+
+int server_run_stdio(const ServerOptions *opts) {
+    Server s;
+    server_init(&s, opts);
+    serve(&s, stdin, STDOUT_FILENO);
+    int status = ferror(stdin) ? 1 : 0;
+    server_free(&s);
+    return status;
+}
+
+/* ================= Socket Unix ================= */
+
+typedef struct {
+    Server *server;
+    int fd;
+} Connection;
+
+static void *connection_thread(void *arg) {
+    Connection *c = (Connection *)arg;
+    FILE *in = fdopen(c->fd, "r");
+    if (in == NULL) {
+        close(c->fd);
+    } else {
+        serve(c->server, in, c->fd);
+        fclose(in);
+    }
+    free(c);
+    return NULL;
+}
+
+int server_run_socket(const ServerOptions *opts, const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Ruta de socket demasiado larga: %s\n", path);
+        return 1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return 1;
+    }
+    // Un socket que quedó de una corrida anterior se reemplaza; otro archivo no
+    struct stat st;
+    if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        fprintf(stderr, "No se puede escuchar en %s: %s\n", path, strerror(errno));
+        close(fd);
+        return 1;
+    }
+
+    // Un cliente que cierra antes de leer la respuesta no debe terminar el servidor
+    signal(SIGPIPE, SIG_IGN);
+    fprintf(stderr, "meowc: escuchando en %s\n", path);
+
+    Server s;
+    server_init(&s, opts);
+    for (;;) {
+        int client = accept(fd, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("accept");
+            break;
+        }
+        Connection *c = (Connection *)malloc(sizeof(Connection));
+        pthread_t thread;
+        if (c == NULL) {
+            close(client);
+            continue;
+        }
+        c->server = &s;
+        c->fd = client;
+        if (pthread_create(&thread, NULL, connection_thread, c) != 0) {
+            connection_thread(c);   // sin hilos: se atiende aquí
+        } else {
+            pthread_detach(thread);
+        }
+    }
+    close(fd);
+    // Puede haber conexiones abiertas usando 's': no se libera
+    return 1;
+}
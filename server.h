@@ -0,0 +1,64 @@
+// server.h
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stddef.h>
+#include "codegen_fis25.h"
+#include "diag.h"
+#include "source.h"
+
+/*
+ * Servidor de compilación (meowc --server).
+ *
+ * Un proceso que queda vivo y atiende pedidos en JSON, uno por línea, por
+ * la entrada estándar o por un socket Unix:
+ *
+ *   {"id": 7, "path": "letrero.meow", "message": "27.9$"}
+ *   {"id": 8, "source": "meow meow x = 1;\n...", "path": "a.meow", "program": true}
+ *
+ * "path" es el archivo a compilar o, junto con "source" (el fuente en
+ * línea), solo el nombre que aparece en los mensajes. "message" es el
+ * texto del letrero (se filtra como en el modo interactivo) y "program"
+ * pide la traducción del programa en lugar del letrero. "id" es opcional y
+ * se devuelve tal cual. Cada pedido recibe una línea:
+ *
+ *   {"id": 7, "status": 0, "warm": true, "output": "...", "diagnostics": "..."}
+ *
+ * con el mismo código de salida que daría meowc para ese archivo, el
+ * código FIS-25 en texto y los mensajes que habría escrito en stderr.
+ *
+ * Los fuentes ya analizados se guardan por el SHA-256 de su nombre y su
+ * contenido: si un pedido trae el mismo fuente que uno anterior no se
+ * vuelve a analizar (warm), solo se genera el letrero con el mensaje nuevo.
+ * La traducción del programa, que no depende del mensaje, se guarda entera.
+ */
+
+#define SERVER_DEFAULT_MAX_SOURCES 64
+
+typedef struct {
+    const CodegenOptions *codegen;  // -O0, --redraw, --unroll-budget (siempre texto)
+    SourceMode input;
+    DiagLevel min_level;
+    int error_limit;
+    size_t parse_depth;             // -fparse-depth
+    int program;                    // --program: valor por defecto de "program"
+    size_t max_sources;             // fuentes analizados que se mantienen (LRU)
+} ServerOptions;
+
+/**
+ * @brief Atiende los pedidos de stdin (respuestas en stdout) hasta el fin
+ *        de la entrada.
+ * @return int 0, o 1 si no se pudo leer la entrada.
+ */
+int server_run_stdio(const ServerOptions *opts);
+
+/**
+ * @brief Escucha en el socket Unix 'path' (lo reemplaza si ya existe) y
+ *        atiende cada conexión en su propio hilo. Los pedidos comparten los
+ *        fuentes analizados y se compilan de a uno. Solo vuelve si falla.
+ * @return int 1 si no se pudo crear o usar el socket.
+ */
+int server_run_socket(const ServerOptions *opts, const char *path);
+
+#endif // SERVER_H
@@ -0,0 +1,28 @@
+// sha256.h
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * SHA-256 (FIPS 180-4), para las claves del caché de compilación.
+ * Uso incremental: sha256_init, sha256_update las veces que haga falta y
+ * sha256_final.
+ */
+
+#define SHA256_DIGEST_SIZE 32
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t bytes;           // total procesado
+    uint8_t block[64];        // bloque parcial
+    size_t used;              // bytes en 'block'
+} Sha256;
+
+void sha256_init(Sha256 *h);
+void sha256_update(Sha256 *h, const void *data, size_t len);
+void sha256_final(Sha256 *h, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif // SHA256_H
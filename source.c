@@ -0,0 +1,175 @@
+// source.c
+
+#include "source.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Bytes en 0 que flex necesita al final de un búfer de yy_scan_buffer
+#define SOURCE_SENTINELS 2
+
+/*
+ * Reserva una región anónima (en cero) del tamaño del archivo más los
+ * centinelas y mapea el archivo encima. Lo que queda entre el fin del archivo
+ * y el fin de su última página lo llena el kernel con ceros, y si los
+ * centinelas caen en una página más, esa página es la anónima: nunca se lee
+ * más allá del archivo (lo que daría SIGBUS).
+ */
+static int map_file(MeowSource *src, int fd, size_t len) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t map_len = (len + SOURCE_SENTINELS + (size_t)page - 1) & ~((size_t)page - 1);
+
+    void *base = mmap(NULL, map_len, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return -1;
+
+    // Copia privada: flex escribe temporalmente en el búfer (fin de yytext)
+    void *file = mmap(base, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    if (file == MAP_FAILED) {
+        munmap(base, map_len);
+        return -1;
+    }
+    madvise(base, map_len, MADV_SEQUENTIAL);
+
+    src->mode = SOURCE_MMAP;
+    src->data = (char *)base;
+    src->len = len;
+    src->map_len = map_len;
+    return 0;
+}
+
+static int read_file(MeowSource *src, int fd, size_t size_hint) {
+    size_t cap = size_hint + SOURCE_SENTINELS;
+    size_t len = 0;
+    if (cap < 4096) cap = 4096;   // /proc y similares informan tamaño 0
+    char *buf = (char *)malloc(cap);
+    if (buf == NULL) return -1;
+
+    for (;;) {
+        if (len + SOURCE_SENTINELS == cap) {
+            // El archivo creció desde fstat: se sigue leyendo
+            char *bigger = (char *)realloc(buf, cap * 2);
+            if (bigger == NULL) {
+                free(buf);
+                return -1;
+            }
+            buf = bigger;
+            cap *= 2;
+        }
+        ssize_t n = read(fd, buf + len, cap - SOURCE_SENTINELS - len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            int saved = errno;
+            free(buf);
+            errno = saved;
+            return -1;
+        }
+        if (n == 0) break;
+        len += (size_t)n;
+    }
+    memset(buf + len, 0, SOURCE_SENTINELS);
+
+    src->mode = SOURCE_READ;
+    src->data = buf;
+    src->len = len;
+    return 0;
+}
+
+int source_open(MeowSource *src, const char *path, SourceMode mode) {
+    memset(src, 0, sizeof(*src));
+
+    if (mode == SOURCE_STREAM) {
+        src->stream = fopen(path, "r");
+        if (src->stream == NULL) return -1;
+        src->mode = SOURCE_STREAM;
+        return 0;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+
+    // Sin tamaño conocido (tubería, terminal, /dev/stdin): flex lo pide de a poco
+    if (!S_ISREG(st.st_mode)) {
+        src->stream = fdopen(fd, "r");
+        if (src->stream == NULL) {
+            int saved = errno;
+            close(fd);
+            errno = saved;
+            return -1;
+        }
+        src->mode = SOURCE_STREAM;
+        return 0;
+    }
+
+    size_t len = (size_t)st.st_size;
+    int rc = -1;
+    // mmap no admite longitud 0: un archivo vacío se "lee"
+    if (mode != SOURCE_READ && len > 0) rc = map_file(src, fd, len);
+    if (rc != 0) rc = read_file(src, fd, len);
+
+    int saved = errno;
+    close(fd);   // el mapeo sigue válido sin el descriptor
+    errno = saved;
+    return rc;
+}
+
+int source_from_memory(MeowSource *src, const char *data, size_t len) {
+    memset(src, 0, sizeof(*src));
+    char *buf = (char *)malloc(len + SOURCE_SENTINELS);
+    if (buf == NULL) return -1;
+    memcpy(buf, data, len);
+    memset(buf + len, 0, SOURCE_SENTINELS);
+
+    src->mode = SOURCE_READ;
+    src->data = buf;
+    src->len = len;
+    return 0;
+}
+
+void source_close(MeowSource *src) {
+    switch (src->mode) {
+        case SOURCE_MMAP:
+            munmap(src->data, src->map_len);
+            break;
+        case SOURCE_READ:
+            free(src->data);
+            break;
+        case SOURCE_STREAM:
+            if (src->stream != NULL) fclose(src->stream);
+            break;
+        case SOURCE_AUTO:
+            break;
+    }
+    memset(src, 0, sizeof(*src));
+}
+
+const char *source_mode_name(SourceMode mode) {
+    switch (mode) {
+        case SOURCE_AUTO:   return "auto";
+        case SOURCE_MMAP:   return "mmap";
+        case SOURCE_READ:   return "read";
+        case SOURCE_STREAM: return "stream";
+    }
+    return "?";
+}
+
+int source_parse_mode(const char *name) {
+    static const SourceMode modes[] = { SOURCE_AUTO, SOURCE_MMAP, SOURCE_READ, SOURCE_STREAM };
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i) {
+        if (strcmp(name, source_mode_name(modes[i])) == 0) return (int)modes[i];
+    }
+    return -1;
+}
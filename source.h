@@ -0,0 +1,58 @@
+// source.h
+
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * Lectura del archivo fuente para el scanner.
+ *
+ * Un archivo regular se entrega a flex entero en memoria (yy_scan_buffer):
+ * mapeado con mmap o, si no se puede, leído de una sola vez. Flex exige que
+ * el búfer termine en dos bytes en 0, que aquí siempre están después del
+ * último byte del archivo. Las tuberías y demás archivos sin tamaño conocido
+ * siguen por FILE* (yyin), que flex rellena de a poco.
+ */
+
+typedef enum {
+    SOURCE_AUTO,      // mmap si es un archivo regular, si no FILE*
+    SOURCE_MMAP,      // mapeado en memoria (copia privada: flex escribe en él)
+    SOURCE_READ,      // leído entero con read(2)
+    SOURCE_STREAM     // FILE*, lectura incremental de flex
+} SourceMode;
+
+typedef struct {
+    SourceMode mode;  // modo efectivo (nunca SOURCE_AUTO tras abrir)
+    char *data;       // contenido + 2 bytes en 0; NULL en modo SOURCE_STREAM
+    size_t len;       // bytes del archivo (sin los centinelas)
+    size_t map_len;   // bytes mapeados (solo SOURCE_MMAP)
+    FILE *stream;     // solo SOURCE_STREAM
+} MeowSource;
+
+/**
+ * @brief Abre 'path' en el modo pedido. Si mmap falla se cae a SOURCE_READ,
+ *        y un archivo que no es regular (tubería, terminal) siempre va por
+ *        SOURCE_STREAM.
+ * @return int 0 si se pudo abrir, -1 si no (errno queda puesto).
+ */
+int source_open(MeowSource *src, const char *path, SourceMode mode);
+
+/**
+ * @brief Copia 'len' bytes de 'data' (un fuente que no viene de un archivo,
+ *        como los de meowc --server) en un búfer propio en modo SOURCE_READ.
+ * @return int 0, o -1 si no hay memoria.
+ */
+int source_from_memory(MeowSource *src, const char *data, size_t len);
+
+// Libera el búfer o desmapea / cierra el archivo
+void source_close(MeowSource *src);
+
+// Nombre del modo ("mmap", "read", ...) para reportes
+const char *source_mode_name(SourceMode mode);
+
+// Interpreta "auto", "mmap", "read" o "stream"; devuelve -1 si no es ninguno
+int source_parse_mode(const char *name);
+
+#endif // SOURCE_H
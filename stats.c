@@ -0,0 +1,201 @@
+// stats.c
+
+#include "stats.h"
+#include <malloc.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#define STATS_CALIBRATION_READS 4096
+
+uint64_t stats_wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t stats_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int64_t stats_heap_bytes(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi = mallinfo2();
+    return (int64_t)(mi.uordblks + mi.hblkhd);
+#else
+    return 0;   // sin mallinfo2 no se informa el heap
+#endif
+}
+
+static pthread_once_t calibrate_once = PTHREAD_ONCE_INIT;
+static uint64_t clock_overhead;
+
+static void calibrate(void) {
+    uint64_t t0 = stats_wall_ns();
+    for (int i = 0; i < STATS_CALIBRATION_READS; ++i) (void)stats_wall_ns();
+    clock_overhead = (stats_wall_ns() - t0) / (STATS_CALIBRATION_READS + 1);
+}
+
+uint64_t stats_clock_overhead_ns(void) {
+    pthread_once(&calibrate_once, calibrate);
+    return clock_overhead;
+}
+
+void stats_init(MeowStats *s, int enabled) {
+    memset(s, 0, sizeof(*s));
+    s->enabled = enabled;
+    if (enabled) (void)stats_clock_overhead_ns();
+}
+
+void stats_begin(const MeowStats *s, StatsMark *m) {
+    if (!s->enabled) return;
+    m->heap = stats_heap_bytes();
+    m->cpu_ns = stats_cpu_ns();
+    m->wall_ns = stats_wall_ns();
+}
+
+void stats_end(MeowStats *s, MeowPhase phase, const StatsMark *m) {
+    if (!s->enabled) return;
+    uint64_t wall = stats_wall_ns();
+    uint64_t cpu = stats_cpu_ns();
+    PhaseStats *p = &s->phase[phase];
+    p->wall_ns += wall - m->wall_ns;
+    p->cpu_ns += cpu - m->cpu_ns;
+    p->heap_bytes += stats_heap_bytes() - m->heap;
+}
+
+// Tiempo medido por llamada sin el costo de leer el reloj
+static uint64_t net_ns(uint64_t ns, uint64_t calls) {
+    uint64_t overhead = calls * stats_clock_overhead_ns();
+    return ns > overhead ? ns - overhead : 0;
+}
+
+static uint64_t share(uint64_t total, uint64_t part, uint64_t whole) {
+    return whole ? (uint64_t)((double)total * (double)part / (double)whole) : 0;
+}
+
+void stats_split_frontend(MeowStats *s) {
+    if (!s->enabled) return;
+    PhaseStats total = s->phase[PHASE_PARSE];
+
+    // Cada llamada medida lee el reloj dos veces: una lectura cae dentro del
+    // intervalo (la descuenta net_ns) y la otra fuera, en el parser. Se
+    // informa lo que habría tardado el análisis sin medirlo.
+    uint64_t wall = net_ns(total.wall_ns, 2 * (s->lex_calls + s->ast_calls));
+    uint64_t cpu = share(total.cpu_ns, wall, total.wall_ns);
+    uint64_t lex = net_ns(s->lex_ns, s->lex_calls);
+    uint64_t ast = net_ns(s->ast_ns, s->ast_calls);
+    if (lex + ast > wall) {
+        // Solo pasa con análisis de pocos microsegundos: se escala
+        lex = share(wall, lex, lex + ast);
+        ast = wall - lex;
+    }
+
+    s->phase[PHASE_LEX].wall_ns = lex;
+    s->phase[PHASE_AST].wall_ns = ast;
+    s->phase[PHASE_PARSE].wall_ns = wall - lex - ast;
+
+    s->phase[PHASE_LEX].cpu_ns = share(cpu, lex, wall);
+    s->phase[PHASE_AST].cpu_ns = share(cpu, ast, wall);
+    s->phase[PHASE_PARSE].cpu_ns = cpu - s->phase[PHASE_LEX].cpu_ns
+                                       - s->phase[PHASE_AST].cpu_ns;
+
+    // Memoria: cada estructura a su fase; el resto (tabla de símbolos, pila
+    // del parser) queda en parse
+    s->phase[PHASE_LEX].heap_bytes = (int64_t)s->intern_bytes;
+    s->phase[PHASE_AST].heap_bytes = (int64_t)s->ast_bytes;
+    s->phase[PHASE_PARSE].heap_bytes = total.heap_bytes - (int64_t)s->intern_bytes
+                                                        - (int64_t)s->ast_bytes;
+}
+
+void stats_finish(MeowStats *s) {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) s->peak_rss_kb = ru.ru_maxrss;
+}
+
+const char *stats_phase_name(MeowPhase phase) {
+    static const char *names[PHASE_COUNT] = {
+        "lex", "parse", "ast", "codegen", "opt", "emit"
+    };
+    return phase < PHASE_COUNT ? names[phase] : "?";
+}
+
+static double ms(uint64_t ns) { return (double)ns / 1e6; }
+
+static double per_second(uint64_t n, uint64_t ns) {
+    return ns ? (double)n * 1e9 / (double)ns : 0.0;
+}
+
+void stats_report_text(const MeowStats *s, const char *path, int counters, FILE *out) {
+    PhaseStats total = { 0, 0, 0 };
+
+    fprintf(out, "Tiempos de %s:\n", path);
+    fprintf(out, "  %-8s %12s %12s %12s\n", "fase", "pared (ms)", "CPU (ms)", "heap (KB)");
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        const PhaseStats *p = &s->phase[i];
+        fprintf(out, "  %-8s %12.3f %12.3f %+12.1f\n", stats_phase_name((MeowPhase)i),
+                ms(p->wall_ns), ms(p->cpu_ns), (double)p->heap_bytes / 1024.0);
+        total.wall_ns += p->wall_ns;
+        total.cpu_ns += p->cpu_ns;
+        total.heap_bytes += p->heap_bytes;
+    }
+    fprintf(out, "  %-8s %12.3f %12.3f %+12.1f\n", "total",
+            ms(total.wall_ns), ms(total.cpu_ns), (double)total.heap_bytes / 1024.0);
+    if (!counters) return;
+
+    uint64_t frontend_ns = s->phase[PHASE_LEX].wall_ns + s->phase[PHASE_PARSE].wall_ns +
+                           s->phase[PHASE_AST].wall_ns;
+    fprintf(out, "  fuente: %zu bytes, %llu líneas, %llu tokens "
+                 "(%.0f líneas/s, %.0f tokens/s de análisis)\n",
+            s->source_bytes, (unsigned long long)s->lines, (unsigned long long)s->tokens,
+            per_second(s->lines, frontend_ns), per_second(s->tokens, frontend_ns));
+    fprintf(out, "  AST: %u expresiones, %u sentencias, %zu bytes reservados\n",
+            s->ast_exprs, s->ast_stmts, s->ast_bytes);
+    fprintf(out, "  símbolos: %zu (%zu bytes); internado: +%zu bytes\n",
+            s->symbols, s->symtab_bytes, s->intern_bytes);
+    fprintf(out, "  FIS-25: %zu -> %zu instrucciones, %zu VAR, %zu bytes de salida\n",
+            s->fis_lowered, s->fis_final, s->fis_vars, s->output_bytes);
+    if (s->cache_hit) fprintf(out, "  caché: acierto (no se analizó el fuente)\n");
+    fprintf(out, "  RSS máximo del proceso: %ld KB\n", s->peak_rss_kb);
+}
+
+static void json_string(const char *str, FILE *out) {
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)str; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+            fputc(*c, out);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+void stats_report_json(const MeowStats *s, const char *path, FILE *out) {
+    fputs("{\"file\":", out);
+    json_string(path, out);
+    fputs(",\"phases\":{", out);
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        const PhaseStats *p = &s->phase[i];
+        fprintf(out, "%s\"%s\":{\"wall_ns\":%llu,\"cpu_ns\":%llu,\"heap_bytes\":%lld}",
+                i ? "," : "", stats_phase_name((MeowPhase)i),
+                (unsigned long long)p->wall_ns, (unsigned long long)p->cpu_ns,
+                (long long)p->heap_bytes);
+    }
+    fprintf(out, "},\"counters\":{\"source_bytes\":%zu,\"lines\":%llu,\"tokens\":%llu,"
+                 "\"ast_exprs\":%u,\"ast_stmts\":%u,\"symbols\":%zu,"
+                 "\"fis_lowered\":%zu,\"fis_final\":%zu,\"fis_vars\":%zu,\"output_bytes\":%zu,"
+                 "\"cache_hit\":%d}",
+            s->source_bytes, (unsigned long long)s->lines, (unsigned long long)s->tokens,
+            s->ast_exprs, s->ast_stmts, s->symbols,
+            s->fis_lowered, s->fis_final, s->fis_vars, s->output_bytes, s->cache_hit);
+    fprintf(out, ",\"memory\":{\"ast_bytes\":%zu,\"symtab_bytes\":%zu,\"intern_bytes\":%zu,"
+                 "\"peak_rss_kb\":%ld}}\n",
+            s->ast_bytes, s->symtab_bytes, s->intern_bytes, s->peak_rss_kb);
+}
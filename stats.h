@@ -0,0 +1,107 @@
+// stats.h
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Instrumentación de una compilación (--time-report, --stats).
+ *
+ * Las fases de primer nivel (análisis, optimización, traducción, emisión) se
+ * miden con dos relojes: de pared (CLOCK_MONOTONIC) y de CPU del hilo
+ * (CLOCK_THREAD_CPUTIME_ID), y con el crecimiento neto del heap.
+ *
+ * El análisis mezcla tres cosas que se alternan token a token: el scanner,
+ * las acciones del parser (con los chequeos semánticos) y la construcción
+ * del AST. El scanner y los constructores del AST se miden por llamada con
+ * el reloj de pared, descontando el costo calibrado del propio reloj
+ * (también del total del análisis); el resto del análisis es la fase
+ * "parse". Su tiempo de CPU se reparte en la misma proporción que el de
+ * pared (el análisis corre en un solo hilo).
+ */
+
+typedef enum {
+    PHASE_LEX,        // scanner (incluye internar identificadores)
+    PHASE_PARSE,      // parser y chequeos semánticos
+    PHASE_AST,        // reserva de nodos del AST
+    PHASE_CODEGEN,    // traducción a FIS-25 (letrero o programa)
+    PHASE_OPT,        // AST, mirilla, bucles y asignación de VAR
+    PHASE_EMIT,       // texto/binario en memoria y escritura de la salida
+    PHASE_COUNT
+} MeowPhase;
+
+typedef struct {
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    int64_t heap_bytes;     // crecimiento neto del heap durante la fase
+} PhaseStats;
+
+typedef struct MeowStats {
+    int enabled;            // 0 = no se mide nada (salvo contadores baratos)
+    PhaseStats phase[PHASE_COUNT];
+
+    // Subfases medidas por llamada dentro del análisis
+    uint64_t lex_calls, lex_ns;
+    uint64_t ast_calls, ast_ns;
+
+    // Contadores
+    uint64_t tokens;
+    uint64_t lines;
+    size_t source_bytes;
+    uint32_t ast_exprs, ast_stmts;
+    size_t ast_bytes;         // reservados por el almacén del AST
+    size_t symbols;
+    size_t symtab_bytes;      // tabla hash, pila de ámbitos y arena
+    size_t intern_bytes;      // crecimiento de la arena de internado (global)
+    size_t fis_lowered;       // instrucciones ejecutables antes de optimizar
+    size_t fis_final;         // ... y al final
+    size_t fis_vars;          // VAR en la salida
+    size_t output_bytes;
+    int cache_hit;            // la salida salió del caché (sin análisis)
+    long peak_rss_kb;
+} MeowStats;
+
+// Marca de inicio de una fase
+typedef struct {
+    uint64_t wall_ns, cpu_ns;
+    int64_t heap;
+} StatsMark;
+
+uint64_t stats_wall_ns(void);
+uint64_t stats_cpu_ns(void);
+
+// Bytes en uso en el heap del proceso (malloc + bloques mapeados)
+int64_t stats_heap_bytes(void);
+
+// Costo de una lectura de stats_wall_ns, medido una vez por proceso
+uint64_t stats_clock_overhead_ns(void);
+
+void stats_init(MeowStats *s, int enabled);
+void stats_begin(const MeowStats *s, StatsMark *m);
+// Suma a 'phase' lo transcurrido desde 'm'
+void stats_end(MeowStats *s, MeowPhase phase, const StatsMark *m);
+
+/**
+ * @brief Reparte la medición del análisis (de stats_begin a stats_end con
+ *        PHASE_PARSE) entre lex, parse y AST.
+ */
+void stats_split_frontend(MeowStats *s);
+
+// Anota el RSS máximo del proceso (al terminar la compilación)
+void stats_finish(MeowStats *s);
+
+const char *stats_phase_name(MeowPhase phase);
+
+/**
+ * @brief Reporte en texto: tabla de fases y, si 'counters', los contadores
+ *        y la memoria.
+ */
+void stats_report_text(const MeowStats *s, const char *path, int counters, FILE *out);
+
+// Reporte como un objeto JSON en una sola línea
+void stats_report_json(const MeowStats *s, const char *path, FILE *out);
+
+#endif // STATS_H
@@ -1,110 +1,220 @@
 // symtab.c
 
 #include "symtab.h"
+#include "arena.h"
+#include "intern.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Inicialización de la cabeza de la tabla
-SymbolEntry *symbol_table_head = NULL;
+#define SYMTAB_INITIAL_CAP  256   // potencia de 2
+#define SYMTAB_INITIAL_DEPTH 16
 
-SymbolEntry* lookup_symbol(const char *name) {
-    SymbolEntry *current = symbol_table_head;
-    while (current != NULL) {
-        if (strcmp(current->id_name, name) == 0) {
-            return current;
+// Cubeta de la tabla hash: el nombre nunca se borra, solo cambia la
+// declaración visible (NULL si ninguna), así que no hacen falta lápidas.
+typedef struct SymbolBucket {
+    const char *name;       // puntero internado, NULL = cubeta vacía
+    SymbolEntry *visible;   // declaración más interna visible
+} SymbolBucket;
+
+static size_t hash_name(const char *name) {
+    // Hash de Fibonacci sobre el puntero canónico
+    uint64_t h = (uint64_t)(uintptr_t)name * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+static SymbolBucket *find_bucket(const SymTab *st, const char *name) {
+    size_t i = hash_name(name) & (st->capacity - 1);
+    while (st->buckets[i].name != NULL && st->buckets[i].name != name) {
+        i = (i + 1) & (st->capacity - 1);
+    }
+    return &st->buckets[i];
+}
+
+static void grow_buckets(SymTab *st) {
+    size_t old_cap = st->capacity;
+    SymbolBucket *old = st->buckets;
+
+    st->capacity = old_cap ? old_cap * 2 : SYMTAB_INITIAL_CAP;
+    st->buckets = (SymbolBucket *)calloc(st->capacity, sizeof(SymbolBucket));
+    if (st->buckets == NULL) {
+        perror("Error de memoria al crecer la tabla de símbolos");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < old_cap; ++i) {
+        if (old[i].name != NULL) *find_bucket(st, old[i].name) = old[i];
+    }
+    free(old);
+}
+
+static void ensure_scopes(SymTab *st) {
+    if (st->scopes != NULL) return;
+    st->scope_cap = SYMTAB_INITIAL_DEPTH;
+    st->scopes = (SymbolEntry **)calloc((size_t)st->scope_cap, sizeof(SymbolEntry *));
+    if (st->scopes == NULL) {
+        perror("Error de memoria al asignar la pila de ámbitos");
+        exit(EXIT_FAILURE);
+    }
+    st->scope_depth = 0;
+}
+
+void symtab_init(SymTab *st, Diagnostics *diag) {
+    memset(st, 0, sizeof(*st));
+    st->diag = diag;
+}
+
+void symtab_push_scope(SymTab *st) {
+    ensure_scopes(st);
+    if (st->scope_depth + 1 >= st->scope_cap) {
+        st->scope_cap *= 2;
+        st->scopes = (SymbolEntry **)realloc(st->scopes,
+                                             (size_t)st->scope_cap * sizeof(SymbolEntry *));
+        if (st->scopes == NULL) {
+            perror("Error de memoria al crecer la pila de ámbitos");
+            exit(EXIT_FAILURE);
         }
-        current = current->next;
     }
-    return NULL; // No encontrado
+    st->scopes[++st->scope_depth] = NULL;
+}
+
+void symtab_pop_scope(SymTab *st) {
+    if (st->scopes == NULL || st->scope_depth == 0) return;  // el ámbito global no se cierra
+
+    // Restaurar en cada cubeta la declaración que estaba oculta
+    for (SymbolEntry *e = st->scopes[st->scope_depth]; e != NULL; e = e->scope_next) {
+        find_bucket(st, e->id_name)->visible = e->shadowed;
+    }
+    st->scopes[st->scope_depth--] = NULL;
+}
+
+int symtab_scope_level(const SymTab *st) {
+    return st->scope_depth;
+}
+
+SymbolEntry* lookup_symbol(SymTab *st, const char *name) {
+    if (st->buckets == NULL || name == NULL) return NULL;
+    return find_bucket(st, name)->visible; // NULL si no hay declaración visible
 }
 
-SymbolEntry* insert_symbol(const char *name, MeowType type) {
-    if (lookup_symbol(name) != NULL) {
-        fprintf(stderr, "Error semántico: Redefinición de variable '%s'.\n", name);
+static SymbolEntry *new_symbol(SymTab *st, const char *name, DiagLoc loc) {
+    ensure_scopes(st);
+    if ((st->used + 1) * 2 > st->capacity) grow_buckets(st);
+
+    SymbolBucket *b = find_bucket(st, name);
+    if (b->visible != NULL && b->visible->scope_level == st->scope_depth) {
+        diag_report(st->diag, DIAG_ERROR, "semántico", loc, "Redefinición de variable '%s'.", name);
         return NULL;
     }
 
-    SymbolEntry *new_entry = (SymbolEntry*)malloc(sizeof(SymbolEntry));
-    if (new_entry == NULL) {
-        perror("Error de memoria al asignar SymbolEntry");
-        exit(EXIT_FAILURE);
+    SymbolEntry *new_entry = (SymbolEntry*)arena_alloc(&st->arena, sizeof(SymbolEntry));
+    new_entry->id_name = name; // Puntero canónico: no hace falta copiarlo
+    new_entry->scope_level = st->scope_depth;
+
+    // La nueva declaración oculta a la externa (si la hay)
+    if (b->name == NULL) {
+        b->name = name;
+        st->used++;
     }
-    
-    new_entry->id_name = strdup(name); // Duplicar la cadena para evitar problemas de punteros
+    new_entry->shadowed = b->visible;
+    b->visible = new_entry;
+
+    // Si oculta a otra declaración viva, necesita un nombre propio para que
+    // ambas puedan convivir como variables distintas en el código generado.
+    // '$' no aparece en ningún identificador de Meow: "x$1" no choca con
+    // una variable que el programa declare.
+    if (new_entry->shadowed != NULL) {
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%s$%d", name, st->scope_depth);
+        new_entry->unique_name = intern(buf);
+    } else {
+        new_entry->unique_name = name;
+    }
+
+    new_entry->scope_next = st->scopes[st->scope_depth];
+    st->scopes[st->scope_depth] = new_entry;
+
+    // Insertar al inicio de la lista de entradas
+    new_entry->next = st->head;
+    st->head = new_entry;
+    return new_entry;
+}
+
+SymbolEntry* insert_symbol(SymTab *st, const char *name, MeowType type, DiagLoc loc) {
+    SymbolEntry *new_entry = new_symbol(st, name, loc);
+    if (new_entry == NULL) return NULL;
+
     new_entry->id_type = type;
     new_entry->is_array = 0;
     new_entry->element_type = TYPE_ERROR;
     new_entry->array_length = -1;
-    
-    // Insertar al inicio de la lista
-    new_entry->next = symbol_table_head;
-    symbol_table_head = new_entry;
-    
-    fprintf(stderr, "DEBUG: Símbolo '%s' (%s) insertado en la tabla.\n",
-        name, MeowTypeToString(type));
+
+    diag_report(st->diag, DIAG_DEBUG, NULL, loc, "Símbolo '%s' (%s) insertado en la tabla.",
+                name, MeowTypeToString(type));
 
     return new_entry;
 }
 
-SymbolEntry* insert_array_symbol(const char *name, MeowType elem_type, int length) {
-    if (lookup_symbol(name) != NULL) {
-        fprintf(stderr, "Error semántico: Redefinición de variable '%s'.\n", name);
-        return NULL;
-    }
+SymbolEntry* insert_array_symbol(SymTab *st, const char *name, MeowType elem_type, int length,
+                                 DiagLoc loc) {
+    SymbolEntry *new_entry = new_symbol(st, name, loc);
+    if (new_entry == NULL) return NULL;
 
-    SymbolEntry *new_entry = (SymbolEntry*)malloc(sizeof(SymbolEntry));
-    if (new_entry == NULL) {
-        perror("Error de memoria al asignar SymbolEntry");
-        exit(EXIT_FAILURE);
-    }
-    new_entry->id_name = strdup(name);
     new_entry->id_type = TYPE_ARRAY;
     new_entry->is_array = 1;
     new_entry->element_type = elem_type;
     new_entry->array_length = length > 0 ? length : -1;
-    new_entry->next = symbol_table_head;
-    symbol_table_head = new_entry;
 
-    
     return new_entry;
 }
 
-MeowType get_symbol_type(const char *name) {
-    SymbolEntry *entry = lookup_symbol(name);
+MeowType get_symbol_type(SymTab *st, const char *name, DiagLoc loc) {
+    SymbolEntry *entry = lookup_symbol(st, name);
     if (entry != NULL) {
         return entry->id_type;
     }
     // Si no se encuentra, es un error semántico de uso de variable no declarada
-    fprintf(stderr, "Error semántico: Variable no declarada '%s'.\n", name);
+    diag_report(st->diag, DIAG_ERROR, "semántico", loc, "Variable no declarada '%s'.", name);
     return TYPE_ERROR;
 }
 
-MeowType get_symbol_element_type(const char *name) {
-    SymbolEntry *entry = lookup_symbol(name);
+MeowType get_symbol_element_type(SymTab *st, const char *name, DiagLoc loc) {
+    SymbolEntry *entry = lookup_symbol(st, name);
     if (entry != NULL && entry->is_array) {
         return entry->element_type;
     }
-    fprintf(stderr, "Error semántico: '%s' no es un arreglo o no existe.\n", name);
+    diag_report(st->diag, DIAG_ERROR, "semántico", loc, "'%s' no es un arreglo o no existe.", name);
     return TYPE_ERROR;
 }
 
-int get_symbol_array_length(const char *name) {
-    SymbolEntry *entry = lookup_symbol(name);
+int get_symbol_array_length(SymTab *st, const char *name) {
+    SymbolEntry *entry = lookup_symbol(st, name);
     if (entry != NULL && entry->is_array) {
         return entry->array_length;
     }
     return -1;
 }
 
-void cleanup_symtab() {
-    SymbolEntry *current = symbol_table_head;
-    SymbolEntry *next;
-    while (current != NULL) {
-        next = current->next;
-        free(current->id_name);
-        free(current);
-        current = next;
-    }
-    symbol_table_head = NULL;
-}
\ No newline at end of file
+const char *get_symbol_unique_name(SymTab *st, const char *name) {
+    SymbolEntry *entry = lookup_symbol(st, name);
+    return entry != NULL ? entry->unique_name : name;
+}
+
+size_t symtab_count(const SymTab *st) {
+    return st->arena.num_allocs;   // la arena solo guarda entradas
+}
+
+size_t symtab_bytes(const SymTab *st) {
+    return st->capacity * sizeof(SymbolBucket) +
+           (size_t)st->scope_cap * sizeof(SymbolEntry *) +
+           st->arena.bytes_reserved;
+}
+
+void symtab_free(SymTab *st) {
+    Diagnostics *diag = st->diag;
+
+    free(st->buckets);
+    free(st->scopes);
+    arena_free_all(&st->arena);
+    symtab_init(st, diag);
+}
@@ -3,72 +3,149 @@
 #ifndef SYMTAB_H
 #define SYMTAB_H
 
+#include "arena.h"
+#include "diag.h"
 #include "types.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // Estructura de un nodo en la Tabla de Símbolos
 typedef struct SymbolEntry {
-    char *id_name;      // Nombre del identificador
+    const char *id_name; // Nombre del identificador (puntero internado)
     MeowType id_type;   // Tipo del identificador
     // Si es un arreglo, guardamos información adicional
     int is_array;             // 0 = no, 1 = sí
     MeowType element_type;    // tipo del elemento si is_array == 1
     int array_length;         // longitud del arreglo (si conocida, >0)
-    struct SymbolEntry *next; 
+    int scope_level;          // profundidad del ámbito donde se declaró (0 = global)
+    const char *unique_name;  // nombre sin colisiones con declaraciones que oculta (internado)
+    struct SymbolEntry *shadowed;    // declaración externa que oculta (o NULL)
+    struct SymbolEntry *scope_next;  // siguiente símbolo del mismo ámbito
+    struct SymbolEntry *next;        // lista de todas las entradas creadas
 } SymbolEntry;
 
-// Declaración de la tabla de símbolos (puede ser la cabeza de una lista enlazada)
-extern SymbolEntry *symbol_table_head;
+struct SymbolBucket;
+
+/*
+ * Tabla de símbolos de una compilación (cada MeowContext tiene la suya).
+ *
+ * La búsqueda usa una tabla hash de direccionamiento abierto indexada por el
+ * puntero internado del nombre; cada cubeta apunta a la declaración visible
+ * más interna. 'head' se conserva como lista de todas las entradas creadas
+ * (la más reciente primero), visibles o no.
+ */
+typedef struct SymTab {
+    SymbolEntry *head;              // lista de todas las entradas creadas
+    struct SymbolBucket *buckets;
+    size_t capacity, used;
+    SymbolEntry **scopes;           // por nivel, los símbolos declarados en él
+    int scope_depth;                // índice del ámbito actual
+    int scope_cap;
+    Arena arena;                    // las entradas viven hasta symtab_free
+    Diagnostics *diag;              // destino de los mensajes semánticos
+} SymTab;
+
+/*
+ * Todos los nombres que recibe esta API deben venir internados (intern.h):
+ * la tabla guarda el puntero tal cual y compara nombres por puntero.
+ */
+
+/**
+ * @brief Deja la tabla vacía, con el ámbito global abierto.
+ * @param diag Destino de los errores semánticos que detecta la tabla.
+ */
+void symtab_init(SymTab *st, Diagnostics *diag);
 
 /**
  * @brief Busca un símbolo por nombre.
  * * @param name El nombre del identificador.
  * @return SymbolEntry* El puntero a la entrada, o NULL si no se encuentra.
  */
-SymbolEntry* lookup_symbol(const char *name);
+SymbolEntry* lookup_symbol(SymTab *st, const char *name);
+
+/**
+ * @brief Abre un ámbito nuevo (bloque { ... }).
+ */
+void symtab_push_scope(SymTab *st);
+
+/**
+ * @brief Cierra el ámbito actual; sus símbolos dejan de ser visibles y
+ * vuelven a verse las declaraciones externas que ocultaban.
+ */
+void symtab_pop_scope(SymTab *st);
 
 /**
- * @brief Inserta un nuevo símbolo en la tabla.
+ * @brief Profundidad del ámbito actual (0 = global).
+ */
+int symtab_scope_level(const SymTab *st);
+
+/**
+ * @brief Símbolos declarados (todas las entradas creadas, visibles o no).
+ */
+size_t symtab_count(const SymTab *st);
+
+/**
+ * @brief Bytes reservados por la tabla hash, la pila de ámbitos y la arena.
+ */
+size_t symtab_bytes(const SymTab *st);
+
+/**
+ * @brief Inserta un nuevo símbolo en el ámbito actual.
  * * @param name Nombre del identificador.
  * @param type Tipo del identificador.
- * @return SymbolEntry* El puntero a la nueva entrada, o NULL si ya existe.
+ * @param loc Ubicación de la declaración (para los mensajes).
+ * @return SymbolEntry* El puntero a la nueva entrada, o NULL si ya existe en este ámbito.
  */
-SymbolEntry* insert_symbol(const char *name, MeowType type);
+SymbolEntry* insert_symbol(SymTab *st, const char *name, MeowType type, DiagLoc loc);
 
 /**
  * @brief Inserta un símbolo que representa un arreglo unidimensional.
  * @param name Nombre del identificador.
  * @param elem_type Tipo de los elementos.
  * @param length Longitud del arreglo (si <= 0, se considera desconocida).
- * @return SymbolEntry* Puntero a la nueva entrada o NULL si ya existe.
+ * @param loc Ubicación de la declaración (para los mensajes).
+ * @return SymbolEntry* Puntero a la nueva entrada o NULL si ya existe en este ámbito.
  */
-SymbolEntry* insert_array_symbol(const char *name, MeowType elem_type, int length);
+SymbolEntry* insert_array_symbol(SymTab *st, const char *name, MeowType elem_type, int length,
+                                 DiagLoc loc);
 
 /**
  * @brief Obtiene el tipo de un identificador.
  * * @param name El nombre del identificador.
+ * @param loc Ubicación del uso, para el error si no está declarado.
  * @return MeowType El tipo del identificador, o TYPE_ERROR si no se encuentra.
  */
-MeowType get_symbol_type(const char *name);
+MeowType get_symbol_type(SymTab *st, const char *name, DiagLoc loc);
 
 /**
  * @brief Obtiene el tipo de elemento de un arreglo.
  * @param name Nombre del identificador.
+ * @param loc Ubicación del uso, para el error si no es un arreglo.
  * @return MeowType Tipo del elemento si es arreglo, o TYPE_ERROR.
  */
-MeowType get_symbol_element_type(const char *name);
+MeowType get_symbol_element_type(SymTab *st, const char *name, DiagLoc loc);
 
 /**
  * @brief Obtiene la longitud del arreglo declarado.
  * @param name Nombre del identificador.
  * @return int Longitud (>0) o -1 si desconocida o no es arreglo.
  */
-int get_symbol_array_length(const char *name);
+int get_symbol_array_length(SymTab *st, const char *name);
+
+/**
+ * @brief Nombre único del símbolo visible: coincide con el nombre salvo
+ * cuando la declaración oculta a otra externa (p. ej. "a$2"). Los nombres
+ * con '$' no pueden escribirse en el fuente: quedan reservados para los que
+ * genera el compilador.
+ * @param name Nombre del identificador.
+ * @return const char* Nombre único internado, o name si no está declarado.
+ */
+const char *get_symbol_unique_name(SymTab *st, const char *name);
 
 /**
- * @brief Inicializa y limpia la memoria de la tabla.
+ * @brief Libera toda la memoria de la tabla y la deja vacía.
  */
-void cleanup_symtab();
+void symtab_free(SymTab *st);
 
 #endif // SYMTAB_H
\ No newline at end of file
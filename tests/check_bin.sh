@@ -0,0 +1,137 @@
+#!/bin/sh
+# tests/check_bin.sh
+#
+# Formato binario de FIS-25 sobre la salida del letrero y de los programas de
+# tests/programs (--program):
+#   - meowc --emit=bin y fis25dis --emit=bin del texto dan el mismo archivo;
+#   - fis25dis del binario devuelve el texto de meowc sin comentarios, y ese
+#     texto vuelve a dar el mismo binario;
+#   - fis25sim imprime lo mismo (salida y reporte) con el texto y el binario;
+#   - un binario truncado o con la cabecera dañada se rechaza con un error
+#     (salida 1, sin señales) en fis25sim y en fis25dis.
+#
+# Uso: tests/check_bin.sh [MEOWC] [FIS25SIM] [FIS25DIS]
+#      (por defecto ./meowc, ./fis25sim y ./fis25dis)
+
+set -e
+
+MEOWC=${1:-./meowc}
+SIM=${2:-./fis25sim}
+DIS=${3:-./fis25dis}
+DIR=$(dirname "$0")
+MARQUEE=$DIR/../examples/opcion_c_marquee.meow
+
+for tool in "$MEOWC" "$SIM" "$DIS"; do
+    if [ ! -x "$tool" ]; then
+        echo "No se encontró $tool (¿falta make?)" >&2
+        exit 1
+    fi
+done
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+
+failed=0
+total=0
+
+fail() {
+    echo "FALLA $1" >&2
+    failed=$((failed + 1))
+}
+
+# Texto FIS-25 sin comentarios ni líneas vacías (un // dentro de una cadena
+# de PRINT no es comentario)
+strip_comments() {
+    awk '{
+        out = ""; q = 0
+        for (i = 1; i <= length($0); i++) {
+            ch = substr($0, i, 1)
+            if (ch == "\"") q = !q
+            if (!q && substr($0, i, 2) == "//") break
+            out = out ch
+        }
+        sub(/[ \t]+$/, "", out)
+        if (out != "") print out
+    }' "$1"
+}
+
+# check NOMBRE ARGS_SIM...: $TMP/NOMBRE.txt y $TMP/NOMBRE.bin ya compilados
+check() {
+    name=$1
+    shift
+    total=$((total + 1))
+    txt=$TMP/$name.txt
+    bin=$TMP/$name.bin
+
+    "$DIS" --emit=bin -o "$TMP/from_text.bin" "$txt"
+    cmp -s "$bin" "$TMP/from_text.bin" ||
+        fail "$name: fis25dis --emit=bin del texto no da el binario de meowc"
+
+    "$DIS" -o "$TMP/back.txt" "$bin"
+    strip_comments "$txt" > "$TMP/plain.txt"
+    if ! cmp -s "$TMP/plain.txt" "$TMP/back.txt"; then
+        fail "$name: fis25dis del binario no devuelve el texto"
+        diff "$TMP/plain.txt" "$TMP/back.txt" | head -n 10 >&2
+    fi
+    "$DIS" --emit=bin -o "$TMP/again.bin" "$TMP/back.txt"
+    cmp -s "$bin" "$TMP/again.bin" ||
+        fail "$name: binario -> texto -> binario no da el mismo archivo"
+
+    "$SIM" "$@" "$txt" > "$TMP/sim_txt.out" 2> "$TMP/sim_txt.err" || true
+    "$SIM" "$@" "$bin" > "$TMP/sim_bin.out" 2> "$TMP/sim_bin.err" || true
+    if ! cmp -s "$TMP/sim_txt.out" "$TMP/sim_bin.out" ||
+       ! cmp -s "$TMP/sim_txt.err" "$TMP/sim_bin.err"; then
+        fail "$name: fis25sim no se comporta igual con el texto y con el binario"
+        diff "$TMP/sim_txt.out" "$TMP/sim_bin.out" | head -n 5 >&2
+        diff "$TMP/sim_txt.err" "$TMP/sim_bin.err" | head -n 5 >&2
+    fi
+}
+
+# rejects NOMBRE ARCHIVO: los dos programas fallan limpio con un mensaje
+rejects() {
+    for tool in "$SIM" "$DIS"; do
+        total=$((total + 1))
+        rc=0
+        "$tool" "$2" > /dev/null 2> "$TMP/reject.err" || rc=$?
+        if [ $rc -ne 1 ] || [ ! -s "$TMP/reject.err" ]; then
+            fail "$1: $(basename "$tool") terminó con $rc sin rechazar el archivo"
+        fi
+    done
+}
+
+# Letrero: teclas A y D durante unos frames
+echo '27.9$' | "$MEOWC" --no-cache -o "$TMP/marquee.txt" "$MARQUEE" > /dev/null 2>&1
+echo '27.9$' | "$MEOWC" --no-cache --emit=bin -o "$TMP/marquee.bin" "$MARQUEE" > /dev/null 2>&1
+check marquee --frames 80 --key 10:6:1 --key 30:6:0 --key 40:7:1 --key 70:7:0 --dump-fb
+
+for src in "$DIR"/programs/*.meow; do
+    name=$(basename "$src" .meow)
+    input=$(sed -n 's|^// input: *||p' "$src" | head -n 1)
+    "$MEOWC" --program --no-cache -o "$TMP/$name.txt" "$src" > /dev/null 2>&1
+    "$MEOWC" --program --no-cache --emit=bin -o "$TMP/$name.bin" "$src" > /dev/null 2>&1
+    check "$name" ${input:+--input "$input"}
+done
+
+# Binarios dañados, a partir del letrero. patch DESTINO DESPLAZAMIENTO BYTES
+patch() {
+    cp "$TMP/marquee.bin" "$1"
+    printf "$3" | dd of="$1" bs=1 seek="$2" conv=notrunc 2> /dev/null
+}
+size=$(wc -c < "$TMP/marquee.bin")
+head -c 20 "$TMP/marquee.bin" > "$TMP/short_header.bin"
+rejects "cabecera truncada" "$TMP/short_header.bin"
+head -c $((size / 2)) "$TMP/marquee.bin" > "$TMP/short_body.bin"
+rejects "archivo truncado" "$TMP/short_body.bin"
+patch "$TMP/version.bin" 4 '\143\000'
+rejects "versión desconocida" "$TMP/version.bin"
+patch "$TMP/ninsns.bin" 8 '\377\377\377\177'
+rejects "instrucciones de más" "$TMP/ninsns.bin"
+patch "$TMP/nstrings.bin" 16 '\377\377\377\377'
+rejects "cadenas de más" "$TMP/nstrings.bin"
+patch "$TMP/names.bin" 28 '\377\377\377\000'
+rejects "nombres de más" "$TMP/names.bin"
+patch "$TMP/target.bin" $((32 + 12)) '\377\377\377\177'
+rejects "variable fuera de rango" "$TMP/target.bin"
+
+echo "Formato binario: $total comprobaciones, $failed fallidas"
+[ $failed -eq 0 ]
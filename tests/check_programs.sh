@@ -0,0 +1,57 @@
+#!/bin/sh
+# tests/check_programs.sh
+#
+# Programas de regresión de --program: cada tests/programs/*.meow dice en
+# comentarios qué recibe y qué debe imprimir:
+#
+#   // input: 7,2      (valores de miau_input, en orden; opcional)
+#   // expect: 5       (una línea por cada miau_print, en orden)
+#
+# Cada programa se compila con -O0 y con el optimizador y se corre en
+# fis25sim; las dos salidas tienen que ser las esperadas.
+#
+# Uso: tests/check_programs.sh [MEOWC] [FIS25SIM]
+#      (por defecto ./meowc y ./fis25sim)
+
+set -e
+
+MEOWC=${1:-./meowc}
+SIM=${2:-./fis25sim}
+DIR=$(dirname "$0")/programs
+
+for tool in "$MEOWC" "$SIM"; do
+    if [ ! -x "$tool" ]; then
+        echo "No se encontró $tool (¿falta make?)" >&2
+        exit 1
+    fi
+done
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT INT TERM
+
+failed=0
+total=0
+for src in "$DIR"/*.meow; do
+    name=$(basename "$src" .meow)
+    input=$(sed -n 's|^// input: *||p' "$src" | head -n 1)
+    sed -n 's|^// expect: *||p' "$src" > "$TMP/expected.txt"
+
+    for opt in -O0 -O; do
+        total=$((total + 1))
+        if ! "$MEOWC" --program --no-cache $opt -o "$TMP/$name.fis" "$src" 2> "$TMP/err.txt"; then
+            echo "FALLA $name ($opt): no compila" >&2
+            head -n 5 "$TMP/err.txt" >&2
+            failed=$((failed + 1))
+            continue
+        fi
+        "$SIM" ${input:+--input "$input"} "$TMP/$name.fis" > "$TMP/got.txt" 2> /dev/null || true
+        if ! cmp -s "$TMP/expected.txt" "$TMP/got.txt"; then
+            echo "FALLA $name ($opt): la salida no es la esperada" >&2
+            diff "$TMP/expected.txt" "$TMP/got.txt" | head -n 10 >&2
+            failed=$((failed + 1))
+        fi
+    done
+done
+
+echo "Programas: $total corridas, $failed fallidas"
+[ $failed -eq 0 ]
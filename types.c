@@ -16,15 +16,16 @@ const char* MeowTypeToString(MeowType type) {
     }
 }
 
-MeowType check_arithmetic_type(MeowType t1, MeowType t2) {
+MeowType check_arithmetic_type(MeowType t1, MeowType t2, Diagnostics *diag, DiagLoc loc) {
     if (t1 == TYPE_ERROR || t2 == TYPE_ERROR) {
         return TYPE_ERROR;
     }
     
     // Solo permitimos int o float para operaciones aritméticas (sin string/bool)
     if ((t1 != TYPE_INT && t1 != TYPE_FLOAT) || (t2 != TYPE_INT && t2 != TYPE_FLOAT)) {
-        fprintf(stderr, "Error semántico: Operación aritmética inválida. Tipos incompatibles: %s y %s.\n", 
-                MeowTypeToString(t1), MeowTypeToString(t2));
+        diag_report(diag, DIAG_ERROR, "semántico", loc,
+                    "Operación aritmética inválida. Tipos incompatibles: %s y %s.",
+                    MeowTypeToString(t1), MeowTypeToString(t2));
         return TYPE_ERROR;
     }
 
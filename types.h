@@ -4,6 +4,7 @@
 #define TYPES_H
 
 #include <stdio.h>
+#include "diag.h"
 
 // [cite: 18]
 typedef enum {
@@ -27,8 +28,10 @@ const char* MeowTypeToString(MeowType type);
  * @brief Aplica las reglas de promoción de tipo para operadores aritméticos.
  * * @param t1 Tipo del operando izquierdo.
  * @param t2 Tipo del operando derecho.
+ * @param diag Destino del mensaje si los tipos no son compatibles.
+ * @param loc Ubicación del operador.
  * @return MeowType El tipo resultante de la operación.
  */
-MeowType check_arithmetic_type(MeowType t1, MeowType t2);
+MeowType check_arithmetic_type(MeowType t1, MeowType t2, Diagnostics *diag, DiagLoc loc);
 
 #endif // TYPES_H
\ No newline at end of file